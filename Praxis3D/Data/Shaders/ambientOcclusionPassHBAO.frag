@@ -9,6 +9,8 @@ uniform sampler2D positionMap;
 uniform sampler2D normalMap;
 uniform sampler2D noiseTexture;
 
+#include "gbufferLayout.glsl"
+
 uniform mat4 viewMat;
 uniform mat4 transposeInverseViewMat;
 uniform ivec2 screenSize;
@@ -43,7 +45,7 @@ vec2 calcTexCoord(void)
 // Converts the position from position g-buffer that is in world-space to position in view-space
 vec3 getPositionInCameraSpace(vec2 p_texCoord)
 {
-	vec4 fragPos = vec4(texture(positionMap, p_texCoord).xyz, 1.0);
+	vec4 fragPos = vec4(getGBufferPosition(positionMap, p_texCoord), 1.0);
 	fragPos = viewMat * fragPos;
 	return fragPos.xyz;
 }
@@ -51,7 +53,7 @@ vec3 getPositionInCameraSpace(vec2 p_texCoord)
 // Converts the normal from normal g-buffer that is in world-space to normal in view-space
 vec3 getNormalInCameraSpace(vec2 p_texCoord)
 {
-	vec4 normal = vec4(texture(normalMap, p_texCoord).xyz, 1.0);
+	vec4 normal = vec4(getGBufferNormal(normalMap, p_texCoord), 1.0);
 	normal = transposeInverseViewMat * normal;
 	return normalize(normal.xyz);
 }
@@ -7,6 +7,8 @@ uniform sampler2D normalMap;
 uniform sampler2D noiseTexture;
 uniform sampler2D matPropertiesMap;
 
+#include "gbufferLayout.glsl"
+
 uniform mat4 viewMat;
 uniform mat4 transposeInverseViewMat;
 uniform mat4 projMat;
@@ -52,7 +54,7 @@ vec2 calcTexCoord(void)
 // Converts the position from position g-buffer that is in world-space to position in view-space
 vec3 getPositionInCameraSpace(vec2 p_texCoord)
 {
-	vec4 fragPos = vec4(texture(positionMap, p_texCoord).xyz, 1.0);
+	vec4 fragPos = vec4(getGBufferPosition(positionMap, p_texCoord), 1.0);
 	fragPos = viewMat * fragPos;
 	return fragPos.xyz;
 }
@@ -60,7 +62,7 @@ vec3 getPositionInCameraSpace(vec2 p_texCoord)
 // Converts the normal from normal g-buffer that is in world-space to normal in view-space
 vec3 getNormalInCameraSpace(vec2 p_texCoord)
 {
-	vec4 normal = vec4(texture(normalMap, p_texCoord).xyz, 1.0);
+	vec4 normal = vec4(getGBufferNormal(normalMap, p_texCoord), 1.0);
 	normal = transposeInverseViewMat * normal;
 	return normalize(normal.xyz);
 }
@@ -101,6 +103,7 @@ void main(void)
         offset = projMat * offset; // from view to clip-space
         offset.xyz /= offset.w; // perspective divide
         offset.xyz = offset.xyz * 0.5 + 0.5; // transform to range 0.0 - 1.0
+        offset.xy *= renderScale; // transform to the rendered sub-rectangle of the buffers
         
         // Get sample depth (distance from camera to the sample pixel)
 		float sampleDepth = getPositionInCameraSpace(offset.xy).z;
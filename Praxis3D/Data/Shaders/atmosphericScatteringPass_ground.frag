@@ -36,6 +36,8 @@ uniform sampler2D inputColorMap;
 uniform sampler2D positionMap;
 uniform sampler2D normalMap;
 
+#include "gbufferLayout.glsl"
+
 const float kLengthUnitInMeters = 1000.0;
 //const vec3 kSphereCenter = vec3(0.0, 0.0, 1000.0) / kLengthUnitInMeters;
 const vec3 kSphereCenter = vec3(0.0, 1000.0, 0.0) / kLengthUnitInMeters;
@@ -770,9 +772,9 @@ void main()
 	// Get the current fragment color
 	vec3 fragmentColor = texture(inputColorMap, texCoord).xyz;
 	// Get pixel's position in world space
-	vec3 worldPos = texture(positionMap, texCoord).xyz;
+	vec3 worldPos = getGBufferPosition(positionMap, texCoord);
 	// Get normal (in world space) and normalize it to minimize floating point approximation errors
-	vec3 normal = normalize(texture(normalMap, texCoord).xyz);
+	vec3 normal = getGBufferNormal(normalMap, texCoord);
 	
 	float distanceToFrag = length(cameraPosVec - worldPos);
 	vec3 cameraPosition = cameraPosVec / kLengthUnitInMeters;
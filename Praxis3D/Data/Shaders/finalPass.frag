@@ -16,12 +16,15 @@ out vec4 outputColor;
 
 uniform ivec2 screenSize;
 uniform vec2 inverseScreenSize;
+uniform vec2 renderScale;
 
 uniform sampler2D inputColorMap;
 
+// The scene can be rendered to a sub-rectangle of the input buffer (dynamic resolution), so the coordinates are scaled
+// to upscale the sub-rectangle to the whole screen, and clamped half a texel inside it, so its edge isn't blended with the outside
 vec2 calcTexCoord(void)
 {
-    return gl_FragCoord.xy / screenSize;
+    return min(gl_FragCoord.xy / screenSize * renderScale, renderScale - inverseScreenSize * 0.5);
 }
 
 // Convert RGB colors to a luma value
@@ -0,0 +1,72 @@
+/*
+	Geometry buffer layout, shared include (gbufferLayout.glsl)
+	Encodes and decodes the geometry buffer data, for both of the layouts:
+		full layout - world-space position and normal are stored directly in the position and normal buffers
+		thin layout - position is reconstructed from the depth buffer (bound in place of the position buffer)
+					  and the inverse view-projection matrix, normal is octahedral-encoded into two channels
+*/
+
+#define GBUFFER_THIN_LAYOUT 0
+
+// Fraction of the buffers that the scene is rendered to (dynamic resolution)
+uniform vec2 renderScale;
+
+#if GBUFFER_THIN_LAYOUT
+uniform mat4 inverseViewProjMat;
+#endif
+
+// Returns +1.0 or -1.0 for each component, treating zero as positive
+vec2 signNotZero(vec2 p_vector)
+{
+	return vec2(p_vector.x >= 0.0 ? 1.0 : -1.0, p_vector.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Projects the unit vector onto an octahedron and unfolds it onto a [-1, 1] square
+vec2 encodeOctahedralNormal(vec3 p_normal)
+{
+	vec2 octahedron = p_normal.xy * (1.0 / (abs(p_normal.x) + abs(p_normal.y) + abs(p_normal.z)));
+	return (p_normal.z <= 0.0) ? ((1.0 - abs(octahedron.yx)) * signNotZero(octahedron)) : octahedron;
+}
+
+// Folds the [-1, 1] square back onto an octahedron and returns the unit vector
+vec3 decodeOctahedralNormal(vec2 p_encodedNormal)
+{
+	vec3 normal = vec3(p_encodedNormal.xy, 1.0 - abs(p_encodedNormal.x) - abs(p_encodedNormal.y));
+	if(normal.z < 0.0)
+		normal.xy = (1.0 - abs(normal.yx)) * signNotZero(normal.xy);
+	return normalize(normal);
+}
+
+// Returns the value to be written to the normal buffer from a world-space normal
+vec3 encodeGBufferNormal(vec3 p_normal)
+{
+#if GBUFFER_THIN_LAYOUT
+	return vec3(encodeOctahedralNormal(p_normal), 0.0);
+#else
+	return p_normal;
+#endif
+}
+
+// Returns the world-space position of the pixel
+vec3 getGBufferPosition(sampler2D p_positionMap, vec2 p_texCoord)
+{
+#if GBUFFER_THIN_LAYOUT
+	// Convert the depth and screen coordinates to normalized device coordinates and project them back to world space
+	// (texture coordinates only span the rendered sub-rectangle of the buffers, so they are scaled back to the whole screen)
+	float depth = texture(p_positionMap, p_texCoord).x;
+	vec4 worldPos = inverseViewProjMat * vec4(vec3(p_texCoord / renderScale, depth) * 2.0 - 1.0, 1.0);
+	return worldPos.xyz / worldPos.w;
+#else
+	return texture(p_positionMap, p_texCoord).xyz;
+#endif
+}
+
+// Returns the normalized world-space normal of the pixel
+vec3 getGBufferNormal(sampler2D p_normalMap, vec2 p_texCoord)
+{
+#if GBUFFER_THIN_LAYOUT
+	return decodeOctahedralNormal(texture(p_normalMap, p_texCoord).xy);
+#else
+	return normalize(texture(p_normalMap, p_texCoord).xyz);
+#endif
+}
@@ -56,6 +56,8 @@ layout(location = 2) out vec3 normalBuffer;
 layout(location = 3) out vec4 emissiveBuffer;
 layout(location = 4) out vec4 matPropertiesBuffer;
 
+#include "gbufferLayout.glsl"
+
 // Variables from vertex shader
 in mat3 TBN;
 in mat3 normalMatrix;
@@ -539,10 +541,12 @@ void main(void)
 	// Write emissive color into the emissive buffer
 	emissiveBuffer = emissiveColor;
 	
-	// Write fragment's position in world space	to the position buffer
+	// Write fragment's position in world space	to the position buffer (in the thin layout, position is reconstructed from depth instead)
+#if !GBUFFER_THIN_LAYOUT
 	positionBuffer = fragPos;
+#endif
 		
 	// Write fragment's normal direction in world space
 	//normalBuffer = normalize(TBN * normalize(texture(normalTexture, newCoords).rgb * 2.0 - 1.0));
-	normalBuffer = normalize(TBN * normalize(normalColor * 2.0 - 1.0));
+	normalBuffer = encodeGBufferNormal(normalize(TBN * normalize(normalColor * 2.0 - 1.0)));
 }
@@ -10,6 +10,7 @@ layout(location = 0) out vec4 diffuseBuffer;
 flat in float aspectRatio;
 
 uniform ivec2 screenSize;
+uniform vec2 renderScale;
 //uniform sampler2D emissiveMap;
 uniform sampler2D inputColorMap;
 uniform sampler2D ghostGradientTexture;
@@ -46,16 +47,17 @@ vec3 applyThreshold(in vec3 p_color, in float p_threshold)
 	return max(p_color - vec3(p_threshold), vec3(0.0));
 }
 
+// Texture coordinates are relative to the rendered sub-rectangle of the buffers (dynamic resolution), so they are scaled when sampling
 vec3 sampleSceneColor(in vec2 p_texCoord)
 {
 #if DISABLE_CHROMATIC_ABERRATION
-	return textureLod(inputColorMap, p_texCoord, lensFlareParam.m_lensFlaireDownsample).rgb;
+	return textureLod(inputColorMap, p_texCoord * renderScale, lensFlareParam.m_lensFlaireDownsample).rgb;
 #else
 	vec2 offset = normalize(vec2(0.5) - p_texCoord) * lensFlareParam.m_chromaticAberration;
 	return vec3(
-		textureLod(inputColorMap, p_texCoord + offset, lensFlareParam.m_lensFlaireDownsample).r,
-		textureLod(inputColorMap, p_texCoord, lensFlareParam.m_lensFlaireDownsample).g,
-		textureLod(inputColorMap, p_texCoord - offset, lensFlareParam.m_lensFlaireDownsample).b
+		textureLod(inputColorMap, (p_texCoord + offset) * renderScale, lensFlareParam.m_lensFlaireDownsample).r,
+		textureLod(inputColorMap, p_texCoord * renderScale, lensFlareParam.m_lensFlaireDownsample).g,
+		textureLod(inputColorMap, (p_texCoord - offset) * renderScale, lensFlareParam.m_lensFlaireDownsample).b
 		);
 #endif
 }
@@ -113,7 +115,7 @@ vec3 sampleHalo(in vec2 p_texCoord, in float p_radius, in float p_aspectRatio, i
 }
 vec2 calcTexCoord(void)
 {
-    return gl_FragCoord.xy / screenSize;
+    return gl_FragCoord.xy / (screenSize * renderScale);
 }
 
 void main(void)
@@ -100,6 +100,9 @@ uniform sampler2D diffuseMap;
 uniform sampler2D normalMap;
 uniform sampler2D emissiveMap;
 uniform sampler2D matPropertiesMap;
+
+#include "gbufferLayout.glsl"
+
 #if SHADOW_MAPPING
 uniform sampler2DArray csmDepthMap;
 uniform vec2 csmPenumbraScaleRange;
@@ -373,9 +376,9 @@ void main(void)
 	// Get diffuse color (full-bright) from diffuse buffer
 	vec3 diffuseColor = texture(diffuseMap, texCoord).xyz;
 	// Get pixel's position in world space
-	vec3 worldPos = texture(positionMap, texCoord).xyz;
+	vec3 worldPos = getGBufferPosition(positionMap, texCoord);
 	// Get normal (in world space) and normalize it to minimize floating point approximation errors
-	vec3 normal = normalize(texture(normalMap, texCoord).xyz);
+	vec3 normal = getGBufferNormal(normalMap, texCoord);
 	// Get material properties
 	vec4 matProperties = texture(matPropertiesMap, texCoord).xyzw;
 	// Calculate view direction (fragment to eye vector)
@@ -12,6 +12,8 @@ uniform sampler2D diffuseMap;
 uniform sampler2D normalMap;
 uniform sampler2D matPropertiesMap;
 
+#include "gbufferLayout.glsl"
+
 uniform samplerCube staticEnvMap;
 
 uniform mat4 modelViewMat;
@@ -135,9 +137,9 @@ void main(void)
 	// Get diffuse color (full-bright) from diffuse buffer and gamma-correct it
 	vec3 diffuseColor = pow(texture(diffuseMap, texCoord).xyz, vec3(2.2));
 	// Get pixel's position in world space
-	vec3 worldPos = texture(positionMap, texCoord).xyz;
+	vec3 worldPos = getGBufferPosition(positionMap, texCoord);
 	// Get normal (in world space) and normalize it to minimize floating point approximation errors
-	vec3 normal = normalize(texture(normalMap, texCoord).xyz);
+	vec3 normal = getGBufferNormal(normalMap, texCoord);
 	// Get material properties
 	vec4 matProperties = texture(matPropertiesMap, texCoord).xyzw;
 	
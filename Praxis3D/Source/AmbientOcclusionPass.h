@@ -44,6 +44,10 @@ public:
 			// Load the shader to memory
 			if(ErrorCode shaderError = m_hbaoPassShader->loadToMemory(); shaderError == ErrorCode::Success)
 			{
+				// Set the geometry buffer layout
+				if(ErrorCode shaderVariableError = m_hbaoPassShader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_SSAOPass);
+
 				// Queue the shader to be loaded to GPU
 				m_renderer.queueForLoading(*m_hbaoPassShader);
 			}
@@ -64,6 +68,10 @@ public:
 			// Load the shader to memory
 			if(ErrorCode shaderError = m_ssaoPassShader->loadToMemory(); shaderError == ErrorCode::Success)
 			{
+				// Set the geometry buffer layout
+				if(ErrorCode shaderVariableError = m_ssaoPassShader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_SSAOPass);
+
 				// Queue the shader to be loaded to GPU
 				m_renderer.queueForLoading(*m_ssaoPassShader);
 			}
@@ -279,6 +287,17 @@ public:
 		}
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		// Scene color buffers are used as scratch space for the unblurred ambient occlusion
+		p_passBuilder.read(RenderGraphResource::GBufferPosition);
+		p_passBuilder.read(RenderGraphResource::GBufferNormal);
+		p_passBuilder.read(RenderGraphResource::GBufferDepth);
+		p_passBuilder.read(RenderGraphResource::GBufferMatProperties);
+		p_passBuilder.write(RenderGraphResource::GBufferMatProperties);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	float ssaoLerp(float p_a, float p_b, float p_f)
 	{
@@ -43,12 +43,15 @@ of the following C++ code.
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <memory>
 
 #include "AtmScatteringModel.h"
 #include "AtmScatteringShaderDefinitions.h"
 #include "AtmScatteringShaderFunctions.h"
+#include "Filesystem.h"
 #include "RendererFrontend.h"
 
 /*
@@ -1150,6 +1153,170 @@ void AtmScatteringModel::Init(unsigned int num_scattering_orders)
 	assert(glGetError() == 0);
 }
 
+// Precomputed textures cache file identifier and version; the version must be increased whenever the file layout or the precomputation shaders change
+static constexpr char g_precomputedTexturesMagic[4] = { 'P', '3', 'A', 'T' };
+static constexpr unsigned int g_precomputedTexturesVersion = 1;
+
+// Precomputed textures cache file header
+struct PrecomputedTexturesHeader
+{
+	char m_magic[4];
+	unsigned int m_version;
+	uint64_t m_key;
+	uint64_t m_dataSize;
+};
+
+uint64_t AtmScatteringModel::getPrecomputedTexturesKey(unsigned int p_numOfScatteringOrders) const
+{
+	// The precomputation shaders are specialized with the atmosphere parameters and the texture dimensions, so the headers for every
+	// set of precomputed wavelengths (the same sets that Init() uses) fully describe the inputs of the precomputation
+	std::string keySource = 
+		"version:" + std::to_string(g_precomputedTexturesVersion) + 
+		"\nwavelengths:" + std::to_string(num_precomputed_wavelengths_) +
+		"\norders:" + std::to_string(p_numOfScatteringOrders) +
+		"\nhalfPrecision:" + std::to_string(half_precision_) +
+		"\nrgbFormat:" + std::to_string(rgb_format_supported_) + "\n";
+
+	keySource += glsl_header_factory_({ kLambdaR, kLambdaG, kLambdaB });
+
+	if(num_precomputed_wavelengths_ > 3)
+	{
+		int num_iterations = (num_precomputed_wavelengths_ + 2) / 3;
+		double dlambda = (kLambdaMax - kLambdaMin) / (3 * num_iterations);
+		for(int i = 0; i < num_iterations; ++i)
+		{
+			keySource += glsl_header_factory_({
+				kLambdaMin + (3 * i + 0.5) * dlambda,
+				kLambdaMin + (3 * i + 1.5) * dlambda,
+				kLambdaMin + (3 * i + 2.5) * dlambda });
+		}
+	}
+
+	return Utilities::getHashKey64(keySource);
+}
+
+bool AtmScatteringModel::loadPrecomputedTextures(const std::string &p_filename, const uint64_t p_key)
+{
+	std::ifstream cacheFile(p_filename, std::ios::in | std::ios::binary);
+	if(cacheFile.fail())
+		return false;
+
+	const std::vector<PrecomputedTexture> textures = getPrecomputedTextures();
+
+	std::size_t dataSize = 0;
+	for(const auto &texture : textures)
+		dataSize += texture.m_size;
+
+	PrecomputedTexturesHeader header;
+	cacheFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+	// Make sure the file holds the textures of the same atmosphere and in the same formats
+	if(cacheFile.fail() ||
+		std::memcmp(header.m_magic, g_precomputedTexturesMagic, sizeof(g_precomputedTexturesMagic)) != 0 ||
+		header.m_version != g_precomputedTexturesVersion ||
+		header.m_key != p_key ||
+		header.m_dataSize != dataSize)
+		return false;
+
+	// Read all the data before uploading any of it, so the textures are left untouched if the file is incomplete
+	std::vector<char> data(dataSize);
+	cacheFile.read(data.data(), data.size());
+
+	if(cacheFile.fail())
+		return false;
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	std::size_t dataOffset = 0;
+	for(const auto &texture : textures)
+	{
+		glBindTexture(texture.m_target, texture.m_handle);
+
+		if(texture.m_target == GL_TEXTURE_3D)
+			glTexSubImage3D(GL_TEXTURE_3D, 0, 0, 0, 0, texture.m_width, texture.m_height, texture.m_depth, texture.m_format, texture.m_type, data.data() + dataOffset);
+		else
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texture.m_width, texture.m_height, texture.m_format, texture.m_type, data.data() + dataOffset);
+
+		dataOffset += texture.m_size;
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	return true;
+}
+
+ErrorCode AtmScatteringModel::savePrecomputedTextures(const std::string &p_filename, const uint64_t p_key) const
+{
+	const std::vector<PrecomputedTexture> textures = getPrecomputedTextures();
+
+	std::size_t dataSize = 0;
+	for(const auto &texture : textures)
+		dataSize += texture.m_size;
+
+	// Read the textures back from the GPU
+	std::vector<char> data(dataSize);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	std::size_t dataOffset = 0;
+	for(const auto &texture : textures)
+	{
+		glBindTexture(texture.m_target, texture.m_handle);
+		glGetTexImage(texture.m_target, 0, texture.m_format, texture.m_type, data.data() + dataOffset);
+		dataOffset += texture.m_size;
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+	Filesystem::createDirectories(Utilities::stripFilePath(p_filename));
+
+	std::ofstream cacheFile(p_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(cacheFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	PrecomputedTexturesHeader header;
+	std::memcpy(header.m_magic, g_precomputedTexturesMagic, sizeof(g_precomputedTexturesMagic));
+	header.m_version = g_precomputedTexturesVersion;
+	header.m_key = p_key;
+	header.m_dataSize = dataSize;
+
+	cacheFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	cacheFile.write(data.data(), data.size());
+
+	return cacheFile.fail() ? ErrorCode::Failure : ErrorCode::Success;
+}
+
+std::vector<AtmScatteringModel::PrecomputedTexture> AtmScatteringModel::getPrecomputedTextures() const
+{
+	// 3D textures are stored in their own precision, to halve the file size when using half precision
+	const GLenum scatteringType = half_precision_ ? GL_HALF_FLOAT : GL_FLOAT;
+
+	// Texture formats match the ones they are created with in the constructor
+	const GLenum scatteringFormat = optional_single_mie_scattering_texture_ == 0 || !rgb_format_supported_ ? GL_RGBA : GL_RGB;
+	const GLenum singleMieFormat = rgb_format_supported_ ? GL_RGB : GL_RGBA;
+
+	auto getTexture = [](const GLuint p_handle, const GLenum p_target, const GLenum p_format, const GLenum p_type, const int p_width, const int p_height, const int p_depth) {
+		const std::size_t texelSize = (p_format == GL_RGBA ? 4 : 3) * (p_type == GL_HALF_FLOAT ? 2 : 4);
+		return PrecomputedTexture{ p_handle, p_target, p_format, p_type, p_width, p_height, p_depth, (std::size_t)p_width * p_height * p_depth * texelSize };
+	};
+
+	std::vector<PrecomputedTexture> textures;
+
+	textures.push_back(getTexture(transmittance_texture_, GL_TEXTURE_2D, GL_RGBA, GL_FLOAT, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT, 1));
+	textures.push_back(getTexture(scattering_texture_, GL_TEXTURE_3D, scatteringFormat, scatteringType, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH));
+
+	if(optional_single_mie_scattering_texture_ != 0)
+		textures.push_back(getTexture(optional_single_mie_scattering_texture_, GL_TEXTURE_3D, singleMieFormat, scatteringType, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH));
+
+	textures.push_back(getTexture(irradiance_texture_, GL_TEXTURE_2D, GL_RGBA, GL_FLOAT, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT, 1));
+
+	return textures;
+}
+
 /*
 <p>The <code>SetProgramUniforms</code> method is straightforward: it simply
 binds the precomputed textures to the specified texture units, and then sets
@@ -150,9 +150,12 @@ while <i>the API functions returning radiance values are not provided</i>.
 
 #include <array>
 #include <functional>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
+#include "ErrorCodes.h"
+
 // An atmosphere layer of width 'width' (in m), and whose density is defined as
 //   'exp_term' * exp('exp_scale' * h) + 'linear_term' * h + 'constant_term',
 // clamped to [0,1], and where h is the altitude (in m). 'exp_term' and
@@ -284,6 +287,16 @@ public:
 
 	void Init(unsigned int num_scattering_orders = 4);
 
+	// Returns a key identifying the result of the precomputation; it is a hash of the precomputation shader headers (which contain the
+	// atmosphere parameters, sampled at the precomputed wavelengths, and the texture dimensions), the texture formats and the scattering orders
+	uint64_t getPrecomputedTexturesKey(unsigned int p_numOfScatteringOrders = 4) const;
+
+	// Fill the precomputed textures from a cache file, instead of precomputing them with Init(); returns false if the file doesn't exist or was saved with a different key
+	bool loadPrecomputedTextures(const std::string &p_filename, const uint64_t p_key);
+
+	// Read the precomputed textures back from the GPU and save them to a cache file
+	ErrorCode savePrecomputedTextures(const std::string &p_filename, const uint64_t p_key) const;
+
 	unsigned int GetShader() const
 	{
 		return atmosphere_shader_;
@@ -331,6 +344,22 @@ private:
 		bool blend,
 		unsigned int num_scattering_orders);
 
+	// Precomputed texture, as it is stored in the cache file
+	struct PrecomputedTexture
+	{
+		unsigned int m_handle;
+		unsigned int m_target;
+		unsigned int m_format;
+		unsigned int m_type;
+		int m_width;
+		int m_height;
+		int m_depth;
+		std::size_t m_size;
+	};
+
+	// Returns the precomputed textures in the order they are stored in the cache file
+	std::vector<PrecomputedTexture> getPrecomputedTextures() const;
+
 	unsigned int num_precomputed_wavelengths_;
 	bool half_precision_;
 	bool rgb_format_supported_;
@@ -1,4 +1,9 @@
 
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
 #include "AtmScatteringPass.h"
 #include "AtmScatteringShaderPass.h"
 #include "RendererScene.h"
@@ -98,13 +103,53 @@ void AtmScatteringPass::initModel()
 		ground_albedo.push_back(kGroundAlbedo);
 	}
 
+	// Precomputation renders to its own framebuffer and viewport, so save the current ones, to be restored afterwards (the model can be recreated mid-frame)
+	GLint drawFramebuffer = 0, readFramebuffer = 0;
+	GLint viewport[4];
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
 	m_atmScatteringModel.reset(new AtmScatteringModel(wavelengths, solar_irradiance, m_sunAngularRadius,
 		kBottomRadius, kTopRadius, { rayleigh_layer }, rayleigh_scattering,
 		{ mie_layer }, mie_scattering, mie_extinction, kMiePhaseFunctionG,
 		ozone_density, absorption_extinction, ground_albedo, max_sun_zenith_angle,
 		m_lengthUnitInMeters, m_luminanceType == PRECOMPUTED ? 15 : 3,
 		m_useCombinedTextures, m_useHalfPrecision));
-	m_atmScatteringModel->Init();
+	m_modelSunAngularRadius = m_sunAngularRadius;
+
+	if(Config::rendererVar().atm_scattering_lut_cache)
+	{
+		// Cache files are identified by the hash of everything the precomputation depends on, so a cached file is only used for the same atmosphere
+		const uint64_t precomputedTexturesKey = m_atmScatteringModel->getPrecomputedTexturesKey(m_numOfScatteringOrders);
+
+		std::stringstream cacheFilename;
+		cacheFilename << Config::filepathVar().atm_scattering_cache_path << std::hex << std::setw(16) << std::setfill('0') << precomputedTexturesKey << ".bin";
+
+		if(m_atmScatteringModel->loadPrecomputedTextures(cacheFilename.str(), precomputedTexturesKey))
+		{
+			ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_AtmScatteringPass, "Precomputed textures loaded from cache: \"" + cacheFilename.str() + "\"");
+
+			// Mark the cache file as recently used, so it is not removed before the unused ones
+			std::error_code fileError;
+			std::filesystem::last_write_time(cacheFilename.str(), std::filesystem::file_time_type::clock::now(), fileError);
+		}
+		else
+		{
+			m_atmScatteringModel->Init(m_numOfScatteringOrders);
+
+			if(ErrorCode cacheError = m_atmScatteringModel->savePrecomputedTextures(cacheFilename.str(), precomputedTexturesKey); cacheError != ErrorCode::Success)
+				ErrHandlerLoc::get().log(cacheError, cacheFilename.str(), ErrorSource::Source_AtmScatteringPass);
+			else
+				removeStaleCacheFiles();
+		}
+	}
+	else
+		m_atmScatteringModel->Init(m_numOfScatteringOrders);
+
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 
 	double whitePointR = 1.0f;
 	double whitePointG = 1.0f;
@@ -191,6 +236,26 @@ void AtmScatteringPass::initModel()
 	//HandleReshapeEvent(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT));
 }
 
+void AtmScatteringPass::removeStaleCacheFiles()
+{
+	const size_t maxNumOfCacheFiles = (size_t)std::max(Config::rendererVar().atm_scattering_lut_cache_max_files, 1);
+
+	// Gather every cached precomputed texture file, along with its last use time
+	std::error_code fileError;
+	std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> cacheFiles;
+	for(const auto &directoryEntry : std::filesystem::directory_iterator(Config::filepathVar().atm_scattering_cache_path, fileError))
+		if(directoryEntry.is_regular_file(fileError) && directoryEntry.path().extension() == ".bin")
+			cacheFiles.emplace_back(directoryEntry.last_write_time(fileError), directoryEntry.path());
+
+	if(cacheFiles.size() <= maxNumOfCacheFiles)
+		return;
+
+	// Keep the most recently used files, and remove the rest
+	std::sort(cacheFiles.begin(), cacheFiles.end(), [](const auto &p_a, const auto &p_b) -> bool { return p_a.first > p_b.first; });
+	for(decltype(cacheFiles.size()) i = maxNumOfCacheFiles, size = cacheFiles.size(); i < size; i++)
+		std::filesystem::remove(cacheFiles[i].second, fileError);
+}
+
 void AtmScatteringPass::updateAtmScatteringData(const AtmosphericScatteringData &p_atmScatteringData)
 {
 	m_sunAngularRadius = p_atmScatteringData.m_sunSize / 2.0;
@@ -16,6 +16,8 @@ public:
 		m_luminanceType(Luminance::NONE),
 		m_useWhiteBalance(true),
 		m_sunAngularRadius(p_renderer.getFrameData().m_atmScatteringData.m_sunSize / 2.0),
+		m_modelSunAngularRadius(0.0),
+		m_numOfScatteringOrders(4),
 		m_lengthUnitInMeters(1000.0),
 		m_atmParamBuffer(BufferType_Uniform, BufferBindTarget_Uniform, BufferUsageHint_DynamicDraw),
 		m_skyShader(nullptr),
@@ -112,7 +114,13 @@ public:
 		//		|_______GROUND PASS SHADER______|
 		shaderError = m_groundShader->loadToMemory();		// Load shader to memory
 		if(shaderError == ErrorCode::Success)				// Check if shader was loaded successfully
+		{
+			// Set the geometry buffer layout
+			if(ErrorCode shaderVariableError = m_groundShader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_AtmScatteringPass);
+
 			m_renderer.queueForLoading(*m_groundShader);	// Queue the shader to be loaded to GPU
+		}
 		else
 			returnError = shaderError;
 
@@ -151,6 +159,10 @@ public:
 
 				updateAtmScatteringData(m_renderer.getFrameData().m_atmScatteringData);
 
+				// The precomputed textures only depend on the sun size out of the atmosphere data, so only recompute (or load from cache) them when it changes
+				if(m_sunAngularRadius != m_modelSunAngularRadius)
+					initModel();
+
 				// Set atmosphere parameters buffer size and data
 				m_atmParamBuffer.m_size = sizeof(AtmScatteringParameters);
 				m_atmParamBuffer.m_updateSize = sizeof(AtmScatteringParameters);
@@ -235,6 +247,15 @@ public:
 		p_renderPassData.m_atmScatDoSkyPass = !p_renderPassData.m_atmScatDoSkyPass;
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::GBufferPosition);
+		p_passBuilder.read(RenderGraphResource::GBufferNormal);
+		p_passBuilder.read(RenderGraphResource::GBufferDepth);
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	enum Luminance {
 		// Render the spectral radiance at kLambdaR, kLambdaG, kLambdaB.
@@ -252,6 +273,8 @@ private:
 	};
 
 	void initModel();
+	// Deletes the least recently used cached precomputed texture files, so that at most the configured number of them is kept
+	void removeStaleCacheFiles();
 	void updateAtmScatteringData(const AtmosphericScatteringData &p_atmScatteringData);
 	
 	Luminance m_luminanceType;
@@ -262,8 +285,10 @@ private:
 	bool m_useWhiteBalance;
 
 	std::unique_ptr<AtmScatteringModel> m_atmScatteringModel;
+	unsigned int m_numOfScatteringOrders;
 
 	double m_sunAngularRadius;
+	double m_modelSunAngularRadius;	// Sun angular radius that the current precomputed textures were computed with
 	double m_sunSolidAngle;
 	double m_lengthUnitInMeters;
 
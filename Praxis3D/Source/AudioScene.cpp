@@ -3,7 +3,9 @@
 #include "AudioScene.h"
 #include "AudioSystem.h"
 #include "ComponentConstructorInfo.h"
+#include "MemoryTracker.h"
 #include "NullSystemObjects.h"
+#include "Profiler.h"
 #include "TaskManagerLocator.h"
 #include "WorldScene.h"
 
@@ -215,6 +217,8 @@ void AudioScene::deactivate()
 
 void AudioScene::update(const float p_deltaTime)
 {
+	PROFILE_ZONE("AudioScene::update");
+
 	//FMOD::Studio::EventDescription *musicDescription;
 	//m_studioSystem->getEvent("event:/MainMenuMusic", &musicDescription);
 
@@ -557,6 +561,11 @@ void AudioScene::update(const float p_deltaTime)
 
 	// Update the sound system
 	m_studioSystem->update();
+
+	// FMOD keeps track of its own allocations (loaded sound banks, samples and streams)
+	int currentAllocated = 0, maxAllocated = 0;
+	if(FMOD::Memory_GetStats(&currentAllocated, &maxAllocated, false) == FMOD_OK)
+		MemoryTracker::set(MemoryTag_Audio, MemoryType_RAM, currentAllocated);
 }
 
 ErrorCode AudioScene::preload()
@@ -568,9 +577,9 @@ void AudioScene::loadInBackground()
 {
 }
 
-std::vector<SystemObject *> AudioScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> AudioScene::getComponents(const EntityID p_entityID)
 {
-	std::vector<SystemObject *> returnVector;
+	FrameVector<SystemObject *> returnVector;
 
 	// Get the entity registry 
 	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
@@ -0,0 +1,188 @@
+#include <fstream>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Benchmark.h"
+#include "EngineDefinitions.h"
+#include "ErrorHandlerLocator.h"
+#include "FrameAllocator.h"
+#include "OcclusionCuller.h"
+#include "Profiler.h"
+#include "Utilities.h"
+
+Benchmark::Benchmark()
+{
+	m_active = false;
+	m_sceneWasLoaded = false;
+
+	m_numOfFrames = 0;
+	m_numOfWarmupFrames = 0;
+	m_numOfSkippedFrames = 0;
+	m_numOfRecordedFrames = 0;
+	m_numOfHeapAllocations = 0;
+}
+
+Benchmark::~Benchmark()
+{
+}
+
+ErrorCode Benchmark::init()
+{
+	m_active = Config::engineVar().benchmark_num_of_frames > 0;
+
+	if(m_active)
+	{
+		m_numOfFrames = (size_t)Config::engineVar().benchmark_num_of_frames;
+		m_numOfWarmupFrames = (size_t)std::max(Config::engineVar().benchmark_num_of_warmup_frames, 0);
+
+		// Per-system timings are gathered from the profiler zones, so make sure the profiler is recording
+		Profiler::setEnabled(true);
+		Profiler::setPaused(false);
+
+		runOcclusionCullerBenchmark();
+
+		ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Engine, "Benchmark started: " + Utilities::toString((int)m_numOfFrames) + " frames of " + Utilities::toString(Config::engineVar().benchmark_delta_time_ms) + "ms");
+	}
+
+	return ErrorCode::Success;
+}
+
+void Benchmark::update(const bool p_sceneLoaded)
+{
+	// Only record a frame that was fully executed with the scene loaded (loaded both at the start and at the end of it)
+	const bool recordFrame = m_active && m_sceneWasLoaded && p_sceneLoaded && !isFinished();
+	m_sceneWasLoaded = p_sceneLoaded;
+
+	if(!recordFrame)
+		return;
+
+	// Skip the warm-up frames, as they contain the one-off costs of the first frames after loading
+	if(m_numOfSkippedFrames < m_numOfWarmupFrames)
+	{
+		m_numOfSkippedFrames++;
+		return;
+	}
+
+	// Add up the time of each zone during the last frame (the same zone can be entered multiple times per frame)
+	m_currentFrameZones.clear();
+	for(const auto &zone : Profiler::getLastFrameZones())
+	{
+		auto &frameZone = m_currentFrameZones[zone.m_name != nullptr ? zone.m_name : "Unnamed"];
+		frameZone.first += Profiler::ticksToMilliseconds(zone.m_endTicks - zone.m_startTicks);
+		frameZone.second++;
+	}
+
+	for(const auto &frameZone : m_currentFrameZones)
+		m_zoneStatistics[frameZone.first].addFrame(frameZone.second.first, frameZone.second.second);
+
+	m_frameStatistics.addFrame(Profiler::ticksToMilliseconds(Profiler::getLastFrameEndTicks() - Profiler::getLastFrameStartTicks()), 1);
+	m_numOfHeapAllocations += FrameAllocator::getLastFrameNumOfHeapAllocations();
+
+	m_numOfRecordedFrames++;
+}
+
+ErrorCode Benchmark::exportResults(const std::string &p_filename) const
+{
+	std::string output;
+
+	output += "{\n";
+	output += "\t\"scene\": \"" + Config::gameplayVar().play_map + "\",\n";
+	output += "\t\"headless\": " + std::string(Config::engineVar().headless_mode ? "true" : "false") + ",\n";
+	output += "\t\"delta_time_ms\": " + Utilities::toString(Config::engineVar().benchmark_delta_time_ms) + ",\n";
+	output += "\t\"warmup_frames\": " + Utilities::toString((int)m_numOfSkippedFrames) + ",\n";
+	output += "\t\"frames\": " + Utilities::toString((int)m_numOfRecordedFrames) + ",\n";
+#if SETTING_HEAP_ALLOCATION_COUNTING
+	output += "\t\"heap_allocations_per_frame\": " + std::to_string((double)m_numOfHeapAllocations / (double)std::max(m_numOfRecordedFrames, (size_t)1)) + ",\n";
+#else
+	// Heap allocations are not counted when the counting is not compiled in
+	output += "\t\"heap_allocations_per_frame\": null,\n";
+#endif
+	output += "\t\"frame_arena_high_water_mark_bytes\": " + std::to_string(FrameAllocator::getHighWaterMark()) + ",\n";
+	output += "\t\"frame\": ";
+	writeStatistics(output, m_frameStatistics, m_numOfRecordedFrames);
+	output += ",\n\t\"zones\": {";
+
+	bool firstZone = true;
+	for(const auto &zone : m_zoneStatistics)
+	{
+		output += (firstZone ? "\n\t\t\"" : ",\n\t\t\"") + zone.first + "\": ";
+		writeStatistics(output, zone.second, m_numOfRecordedFrames);
+		firstZone = false;
+	}
+
+	output += "\n\t},\n\t\"kernels\": {";
+
+	bool firstKernel = true;
+	for(const auto &kernel : m_kernelStatistics)
+	{
+		output += (firstKernel ? "\n\t\t\"" : ",\n\t\t\"") + kernel.first + "\": ";
+		writeStatistics(output, kernel.second, kernel.second.m_numOfFrames);
+		firstKernel = false;
+	}
+
+	output += "\n\t}\n}\n";
+
+	std::ofstream resultsFile(p_filename, std::ios::out | std::ios::trunc);
+	if(resultsFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	resultsFile << output;
+
+	return resultsFile.fail() ? ErrorCode::Failure : ErrorCode::Success;
+}
+
+void Benchmark::writeStatistics(std::string &p_output, const TimingStatistics &p_statistics, const size_t p_numOfFrames) const
+{
+	// Average over all recorded frames, so that zones that were not entered every frame are not skewed
+	const double numOfFrames = p_numOfFrames > 0 ? (double)p_numOfFrames : 1.0;
+
+	p_output += "{ \"avg_ms\": " + std::to_string(p_statistics.m_totalMS / numOfFrames) +
+		", \"min_ms\": " + std::to_string(p_statistics.m_minMS) +
+		", \"max_ms\": " + std::to_string(p_statistics.m_maxMS) +
+		", \"total_ms\": " + std::to_string(p_statistics.m_totalMS) +
+		", \"calls_per_frame\": " + std::to_string((double)p_statistics.m_numOfCalls / numOfFrames) + " }";
+}
+
+void Benchmark::runOcclusionCullerBenchmark()
+{
+	// Grid of 16 x 8 boxes in front of the camera (looking down the negative Z axis), at increasing distances, so they partially overlap on the screen
+	const glm::vec3 boxPositions[] = {
+		glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, -1.0f), glm::vec3(-1.0f, 1.0f, -1.0f),
+		glm::vec3(-1.0f, -1.0f, 1.0f), glm::vec3(1.0f, -1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(-1.0f, 1.0f, 1.0f) };
+	const unsigned int boxIndices[] = {
+		0, 2, 1, 0, 3, 2,	// Back
+		4, 5, 6, 4, 6, 7,	// Front
+		0, 1, 5, 0, 5, 4,	// Bottom
+		3, 7, 6, 3, 6, 2,	// Top
+		0, 4, 7, 0, 7, 3,	// Left
+		1, 2, 6, 1, 6, 5 };	// Right
+	const unsigned int numOfBoxIndices = sizeof(boxIndices) / sizeof(boxIndices[0]);
+
+	std::vector<glm::mat4> modelMatrices;
+	for(int y = 0; y < 8; y++)
+		for(int x = 0; x < 16; x++)
+			modelMatrices.push_back(glm::translate(glm::mat4(1.0f), glm::vec3((float)x * 4.0f - 30.0f, (float)y * 4.0f - 14.0f, -20.0f - (float)(x + y) * 2.0f)));
+
+	OcclusionCuller occlusionCuller;
+	occlusionCuller.setBufferSize((unsigned int)std::max(Config::rendererVar().occlusion_buffer_width, 1), (unsigned int)std::max(Config::rendererVar().occlusion_buffer_height, 1));
+
+	const auto timeRasterization = [&](const std::string &p_kernelName, const bool p_simdEnabled)
+	{
+		occlusionCuller.setSIMDEnabled(p_simdEnabled);
+
+		for(size_t i = 0; i < NumOfKernelIterations; i++)
+		{
+			occlusionCuller.beginFrame(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f));
+			for(const auto &modelMatrix : modelMatrices)
+				occlusionCuller.addOccluder(boxPositions, boxIndices, numOfBoxIndices, modelMatrix);
+
+			const int64_t startTicks = Profiler::getCurrentTicks();
+			occlusionCuller.rasterize(false);
+			m_kernelStatistics[p_kernelName].addFrame(Profiler::ticksToMilliseconds(Profiler::getCurrentTicks() - startTicks), 1);
+		}
+	};
+
+	timeRasterization("OcclusionCuller::rasterize (scalar)", false);
+#if SETTING_OCCLUSION_CULLING_SIMD >= 1
+	timeRasterization("OcclusionCuller::rasterize (SSE)", true);
+#endif
+}
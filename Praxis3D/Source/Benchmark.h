@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "Config.h"
+#include "ErrorCodes.h"
+
+// Runs the engine for a set number of fixed delta-time frames, and gathers the per-frame timings of every profiler zone
+// (system scene updates, render passes, change distribution, etc.), which are then exported to a JSON file.
+// Also times the CPU kernels that don't depend on the scene (e.g. the occlusion rasterization) on fixed inputs, before the frames are run.
+// Enabled by setting the benchmark_num_of_frames config variable to a value higher than 0.
+class Benchmark
+{
+public:
+	Benchmark();
+	~Benchmark();
+
+	// Reads the benchmark settings from config; must be called after the config and profiler have been initialized
+	ErrorCode init();
+
+	// Must be called once per frame, right after Profiler::newFrame(), so the zones of the finished frame can be gathered.
+	// Frames are only recorded after the scene has been fully loaded and the warm-up frames have passed
+	void update(const bool p_sceneLoaded);
+
+	// Writes the gathered timings to a JSON file
+	ErrorCode exportResults(const std::string &p_filename) const;
+
+	// Getters
+	const inline bool isActive() const { return m_active; }
+	const inline bool isFinished() const { return m_active && m_numOfRecordedFrames >= m_numOfFrames; }
+	const inline size_t getNumOfRecordedFrames() const { return m_numOfRecordedFrames; }
+
+private:
+	struct TimingStatistics
+	{
+		TimingStatistics() : m_totalMS(0.0), m_minMS(0.0), m_maxMS(0.0), m_numOfCalls(0), m_numOfFrames(0) { }
+
+		// Adds the total time of a single frame
+		inline void addFrame(const double p_frameMS, const size_t p_numOfCalls)
+		{
+			if(m_numOfFrames == 0)
+			{
+				m_minMS = p_frameMS;
+				m_maxMS = p_frameMS;
+			}
+			else
+			{
+				m_minMS = std::min(m_minMS, p_frameMS);
+				m_maxMS = std::max(m_maxMS, p_frameMS);
+			}
+
+			m_totalMS += p_frameMS;
+			m_numOfCalls += p_numOfCalls;
+			m_numOfFrames++;
+		}
+
+		double m_totalMS;
+		double m_minMS;
+		double m_maxMS;
+		size_t m_numOfCalls;
+		size_t m_numOfFrames;
+	};
+
+	// Appends the statistics as a JSON object, averaged over the given number of frames
+	void writeStatistics(std::string &p_output, const TimingStatistics &p_statistics, const size_t p_numOfFrames) const;
+
+	// Times the single-threaded occlusion rasterization of a fixed set of box occluders, with the SSE and scalar rasterization
+	void runOcclusionCullerBenchmark();
+
+	bool m_active;
+	bool m_sceneWasLoaded;
+
+	size_t m_numOfFrames;
+	size_t m_numOfWarmupFrames;
+	size_t m_numOfSkippedFrames;
+	size_t m_numOfRecordedFrames;
+	size_t m_numOfHeapAllocations;
+
+	TimingStatistics m_frameStatistics;
+
+	// Statistics of each zone, identified by zone name; ordered map, so the output is sorted and comparable between runs
+	std::map<std::string, TimingStatistics> m_zoneStatistics;
+
+	// Statistics of each kernel run, identified by kernel name; each iteration is added as a frame
+	std::map<std::string, TimingStatistics> m_kernelStatistics;
+	static constexpr size_t NumOfKernelIterations = 100;
+
+	// Per-frame scratch data: the total time and number of calls of each zone during a single frame
+	std::map<std::string, std::pair<double, size_t>> m_currentFrameZones;
+};
@@ -64,6 +64,13 @@ public:
 		p_renderPassData.swapColorInputOutputMaps();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.read(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	ShaderLoader::ShaderProgram	*m_bloomCompositeShader;
 };
\ No newline at end of file
@@ -144,6 +144,12 @@ public:
 			p_renderPassData.swapColorInputOutputMaps();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	ShaderLoader::ShaderProgram *m_bloomDownscaleShader;
 	ShaderLoader::ShaderProgram *m_bloomUpscaleShader;
@@ -124,6 +124,15 @@ public:
 			glDisable(GL_BLEND);
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		// The blurred buffer is selected by the preceding pass (emissive after HDR mapping, diffuse after lens flare), so both are declared
+		p_passBuilder.read(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.read(RenderGraphResource::GBufferDiffuse);
+		p_passBuilder.write(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.write(RenderGraphResource::GBufferDiffuse);
+	}
+
 private:
 	ShaderLoader::ShaderProgram	*m_blurVerticalShader,
 								*m_blurHorizontalShader;
@@ -12,12 +12,15 @@ public:
 	CSMFramebuffer(const UniformFrameData &p_frameData) : Framebuffer(p_frameData.m_shadowMappingData.m_csmResolution, p_frameData.m_shadowMappingData.m_csmResolution)
 	{
 		m_depthBuffers = 0;
+		m_staticDepthBuffers = 0;
 		m_numOfCascades = 0;
 	}
 	~CSMFramebuffer()
 	{
 		if(m_depthBuffers != 0)
 			glDeleteTextures(1, &m_depthBuffers);
+		if(m_staticDepthBuffers != 0)
+			glDeleteTextures(1, &m_staticDepthBuffers);
 	}
 
 	// Generates buffers, set's up FBO
@@ -111,6 +114,57 @@ public:
 		glClear(GL_DEPTH_BUFFER_BIT);	// Make sure to clear the depth buffer for the new frame
 	}
 
+	// Prepares the framebuffer for rendering without clearing the depth buffers, as they are overwritten by the static depth buffers
+	void initCachedFrame()
+	{
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_FBO);
+		glViewport(0, 0, m_bufferWidth, m_bufferHeight);
+		glDepthMask(GL_TRUE);
+		glEnable(GL_DEPTH_TEST);
+		glDepthFunc(GL_LEQUAL);
+	}
+
+	// Static depth buffers hold the cached depth of static shadow casters (one layer per cascade); they are only created when enabled
+	void setStaticDepthBuffersEnabled(const bool p_enabled)
+	{
+		if(p_enabled && m_staticDepthBuffers == 0)
+		{
+			glGenTextures(1, &m_staticDepthBuffers);
+			createStaticDepthBuffers();
+			updateMemorySize();
+		}
+		else if(!p_enabled && m_staticDepthBuffers != 0)
+		{
+			glDeleteTextures(1, &m_staticDepthBuffers);
+			m_staticDepthBuffers = 0;
+			updateMemorySize();
+		}
+	}
+
+	// Attaches a single layer of the static depth buffers for rendering static shadow casters of a cascade, and clears it
+	void bindStaticDepthLayerForWriting(const unsigned int p_cascadeIndex)
+	{
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_staticDepthBuffers, 0, (GLint)p_cascadeIndex);
+		glClear(GL_DEPTH_BUFFER_BIT);
+	}
+
+	// Attaches all the layers of the depth buffers, that are sampled during the lighting pass
+	void bindDepthBuffersForWriting()
+	{
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthBuffers, 0);
+	}
+
+	// Copies the cached static shadow casters depth of every cascade to the depth buffers, so that dynamic shadow casters can be drawn on top
+	void copyStaticDepthBuffers()
+	{
+		glCopyImageSubData(
+			m_staticDepthBuffers, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+			m_depthBuffers, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+			m_bufferWidth, m_bufferHeight, m_numOfCascades);
+	}
+
+	const inline bool staticDepthBuffersEnabled() const { return m_staticDepthBuffers != 0; }
+
 	// Buffer binding functions
 	inline void bindBufferForReading(CSMBufferTextureType p_buffer, int p_activeTexture = 0)
 	{
@@ -130,9 +184,30 @@ private:
 		glTexImage3D(
 			GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, m_bufferWidth, m_bufferHeight, m_numOfCascades,
 			0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+		if(m_staticDepthBuffers != 0)
+			createStaticDepthBuffers();
+
+		updateMemorySize();
+	}
+	inline void updateMemorySize()
+	{
+		const int64_t depthBuffersSize = MemoryTracker::getTextureMemorySize(GL_DEPTH_COMPONENT32F, m_bufferWidth, m_bufferHeight, (unsigned int)m_numOfCascades);
+		m_memoryTracker.setSize(MemoryType_VRAM, m_staticDepthBuffers != 0 ? depthBuffersSize * 2 : depthBuffersSize);
+	}
+	inline void createStaticDepthBuffers()
+	{
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_staticDepthBuffers);
+		glTexImage3D(
+			GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, m_bufferWidth, m_bufferHeight, m_numOfCascades,
+			0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	}
 
 	GLuint m_depthBuffers;
+	GLuint m_staticDepthBuffers;
 
 	int m_numOfCascades;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 
 #include "ChangeController.h"
 #include "ErrorHandlerLocator.h"
+#include "Profiler.h"
 #include "TaskManager.h"
 
 ChangeController::ChangeController() : Observer(Properties::PropertyID::ChangeController), m_lastID(0), m_tlsNotifyList(TLS_OUT_OF_INDEXES), m_taskManager(nullptr)
@@ -212,6 +213,8 @@ ErrorCode ChangeController::removeSubject(ObservedSubject *p_subject)
 
 ErrorCode ChangeController::distributeChanges(BitMask p_systemsToNotify, BitMask p_changesToDistribute)
 {
+	PROFILE_ZONE("ChangeController::distributeChanges");
+
 	// Store the parameters so they can be used by multiple threads
 	m_systemsToNotify = p_systemsToNotify;
 	m_changesToDistribute = p_changesToDistribute;
@@ -66,6 +66,7 @@ private:
 			*m_tickList;
 
 	double	m_currentMS,
+			m_fixedDeltaMS,
 			m_frequency,
 			m_elapsedSeconds;
 
@@ -87,6 +88,7 @@ public:
 		m_currentFPS = 0.0f;
 
 		m_currentMS = 0.0;
+		m_fixedDeltaMS = 0.0;
 		m_frequency = 0.0;
 
 		m_elapsedSeconds = 0.0;
@@ -139,8 +141,8 @@ public:
 		// Get current time
 		QueryPerformanceCounter(&m_timeCurrent);
 
-		// Calculate current delta time milliseconds
-		m_currentMS = double(m_timeCurrent.QuadPart - m_timeLast.QuadPart) / m_frequency;
+		// Calculate current delta time milliseconds; use the fixed delta time instead, if it is set
+		m_currentMS = m_fixedDeltaMS > 0.0 ? m_fixedDeltaMS : double(m_timeCurrent.QuadPart - m_timeLast.QuadPart) / m_frequency;
 
 		// Add current frame delta time to total elapsed time
 		m_elapsedSeconds += (m_currentMS / 1000.0);
@@ -166,6 +168,9 @@ public:
 		m_frameIsEven = !m_frameIsEven;
 	}
 
+	// Makes every frame advance by the given amount of milliseconds, regardless of the real elapsed time (used for deterministic replays); 0 disables it
+	inline void setFixedDeltaMS(const double p_fixedDeltaMS) { m_fixedDeltaMS = p_fixedDeltaMS; }
+
 	// Returns a double of the last frame in milliseconds
 	const double getDeltaMS() const { return m_currentMS; }
 
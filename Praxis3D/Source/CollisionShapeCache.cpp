@@ -0,0 +1,410 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "CollisionShapeCache.h"
+#include "Config.h"
+#include "ErrorHandlerLocator.h"
+#include "Filesystem.h"
+#include "Loaders.h"
+
+// Cooked collider file identifier and version; the version must be increased whenever the file layout changes
+static constexpr char g_cookedColliderMagic[4] = { 'P', '3', 'C', 'C' };
+static constexpr unsigned int g_cookedColliderVersion = 1;
+
+CollisionShapeCache::CollisionShapeCache()
+{
+}
+
+CollisionShapeCache::~CollisionShapeCache()
+{
+	// Delete all the shapes that are still in the cache (the rigid bodies using them have already been deleted)
+	for(auto &shape : m_shapes)
+		deleteShapeEntry(shape.second);
+}
+
+btCollisionShape *CollisionShapeCache::acquireShape(const RigidBodyComponent::CollisionShapeType p_type, const glm::vec3 &p_size, const std::string &p_meshFilename)
+{
+	const bool meshShape = p_type == RigidBodyComponent::CollisionShapeType::CollisionShapeType_ConvexHull || p_type == RigidBodyComponent::CollisionShapeType::CollisionShapeType_TriangleMesh;
+
+	// Mesh colliders are identified by the model only, and primitives by their dimensions only
+	const ShapeKey shapeKey(p_type, meshShape ? glm::vec3(0.0f) : p_size, meshShape ? p_meshFilename : std::string());
+
+	std::map<ShapeKey, ShapeEntry>::iterator shapeIterator;
+	bool shapeBeingCooked = false;
+	{
+		SpinWait::Lock lock(m_mutex);
+
+		// If the shape already exists, share it
+		if(shapeIterator = m_shapes.find(shapeKey); shapeIterator != m_shapes.end())
+		{
+			// A shape that failed to be created is only kept until all the threads that were waiting for it are done with it
+			if(!shapeIterator->second.m_pending && shapeIterator->second.m_collisionShape == nullptr)
+				return nullptr;
+
+			shapeIterator->second.m_referenceCount++;
+
+			if(!shapeIterator->second.m_pending)
+				return shapeIterator->second.m_collisionShape;
+
+			shapeBeingCooked = true;
+		}
+		else if(!meshShape)
+		{
+			// Primitive shapes are cheap to create, so create them while holding the lock
+			ShapeEntry shapeEntry;
+			shapeEntry.m_collisionShape = createPrimitiveShape(p_type, p_size);
+
+			if(shapeEntry.m_collisionShape == nullptr)
+				return nullptr;
+
+			shapeEntry.m_referenceCount = 1;
+
+			shapeIterator = m_shapes.emplace(shapeKey, std::move(shapeEntry)).first;
+			m_shapeEntries[shapeIterator->second.m_collisionShape] = shapeIterator;
+
+			return shapeIterator->second.m_collisionShape;
+		}
+		else
+		{
+			if(p_meshFilename.empty())
+			{
+				ErrHandlerLoc::get().log(ErrorCode::Property_no_filename, ErrorSource::Source_Physics, "Mesh collider is missing a model filename");
+				return nullptr;
+			}
+
+			// Insert a pending entry, so other threads acquiring the same mesh collider wait for it, instead of cooking it again
+			shapeIterator = m_shapes.emplace(shapeKey, ShapeEntry()).first;
+			shapeIterator->second.m_referenceCount = 1;
+			shapeIterator->second.m_pending = true;
+		}
+	}
+
+	// The shape is being cooked by another thread
+	if(shapeBeingCooked)
+		return waitForPendingShape(shapeIterator);
+
+	// Cook the mesh collider outside the lock, as loading the model and building the BVH can take seconds
+	ShapeEntry shapeEntry;
+	if(auto error = createMeshShape(p_type, p_meshFilename, shapeEntry); error != ErrorCode::Success)
+	{
+		ErrHandlerLoc::get().log(error, ErrorSource::Source_Physics, p_meshFilename);
+		deleteShapeEntry(shapeEntry);
+	}
+
+	// Publish the cooked shape to the waiting threads
+	SpinWait::Lock lock(m_mutex);
+
+	ShapeEntry &pendingEntry = shapeIterator->second;
+	pendingEntry.m_collisionShape = shapeEntry.m_collisionShape;
+	pendingEntry.m_vertices = std::move(shapeEntry.m_vertices);
+	pendingEntry.m_indices = std::move(shapeEntry.m_indices);
+	pendingEntry.m_meshInterface = shapeEntry.m_meshInterface;
+	pendingEntry.m_bvhBuffer = shapeEntry.m_bvhBuffer;
+	pendingEntry.m_bvhBufferSize = shapeEntry.m_bvhBufferSize;
+	pendingEntry.m_pending = false;
+
+	if(pendingEntry.m_collisionShape != nullptr)
+	{
+		m_shapeEntries[pendingEntry.m_collisionShape] = shapeIterator;
+		return pendingEntry.m_collisionShape;
+	}
+
+	// Remove the failed entry, once all the waiting threads are done with it
+	if(--pendingEntry.m_referenceCount == 0)
+		m_shapes.erase(shapeIterator);
+
+	return nullptr;
+}
+
+btCollisionShape *CollisionShapeCache::waitForPendingShape(std::map<ShapeKey, ShapeEntry>::iterator p_shapeIterator)
+{
+	// The entry cannot be removed while this thread holds a reference to it, so the iterator stays valid
+	while(true)
+	{
+		std::this_thread::yield();
+
+		SpinWait::Lock lock(m_mutex);
+
+		if(!p_shapeIterator->second.m_pending)
+		{
+			if(p_shapeIterator->second.m_collisionShape != nullptr)
+				return p_shapeIterator->second.m_collisionShape;
+
+			// Creating the shape has failed; remove the failed entry, if this was the last reference to it
+			if(--p_shapeIterator->second.m_referenceCount == 0)
+				m_shapes.erase(p_shapeIterator);
+
+			return nullptr;
+		}
+	}
+}
+
+void CollisionShapeCache::releaseShape(btCollisionShape *p_collisionShape)
+{
+	if(p_collisionShape == nullptr)
+		return;
+
+	SpinWait::Lock lock(m_mutex);
+
+	if(auto entryIterator = m_shapeEntries.find(p_collisionShape); entryIterator != m_shapeEntries.end())
+	{
+		auto shapeIterator = entryIterator->second;
+
+		// Delete the shape if this was the last reference to it
+		if(--shapeIterator->second.m_referenceCount == 0)
+		{
+			deleteShapeEntry(shapeIterator->second);
+			m_shapeEntries.erase(entryIterator);
+			m_shapes.erase(shapeIterator);
+		}
+	}
+}
+
+btCollisionShape *CollisionShapeCache::createPrimitiveShape(const RigidBodyComponent::CollisionShapeType p_type, const glm::vec3 &p_size)
+{
+	btCollisionShape *collisionShape = nullptr;
+
+	switch(p_type)
+	{
+		case RigidBodyComponent::CollisionShapeType::CollisionShapeType_Box:
+			collisionShape = new btBoxShape(Math::toBtVector3(p_size));
+			break;
+
+		case RigidBodyComponent::CollisionShapeType::CollisionShapeType_Cylinder:
+			collisionShape = new btCylinderShape(Math::toBtVector3(p_size));
+			break;
+
+		case RigidBodyComponent::CollisionShapeType::CollisionShapeType_Sphere:
+			collisionShape = new btSphereShape(p_size.x);
+			break;
+
+		default:
+			ErrHandlerLoc::get().log(ErrorCode::Collision_invalid, ErrorSource::Source_Physics);
+			break;
+	}
+
+	return collisionShape;
+}
+
+ErrorCode CollisionShapeCache::createMeshShape(const RigidBodyComponent::CollisionShapeType p_type, const std::string &p_meshFilename, ShapeEntry &p_shapeEntry)
+{
+	const std::string cookedFilename = getCookedColliderFilename(p_type, p_meshFilename);
+	const std::string modelFilename = Config::filepathVar().model_path + p_meshFilename;
+
+	// Use the cooked collider only if it is not older than the model it was cooked from
+	std::error_code fileError;
+	const bool modelExists = std::filesystem::exists(modelFilename, fileError);
+	bool cookedColliderValid = std::filesystem::exists(cookedFilename, fileError);
+	if(cookedColliderValid && modelExists)
+		cookedColliderValid = std::filesystem::last_write_time(cookedFilename, fileError) >= std::filesystem::last_write_time(modelFilename, fileError);
+
+	if(cookedColliderValid && loadCookedCollider(cookedFilename, p_type, p_shapeEntry) == ErrorCode::Success)
+	{
+		createMeshShapeFromTriangles(p_type, p_shapeEntry);
+		return ErrorCode::Success;
+	}
+
+	// Cook the collider from the model data
+	ErrorCode returnError = loadModelTriangles(p_meshFilename, p_shapeEntry);
+	if(returnError == ErrorCode::Success)
+	{
+		createMeshShapeFromTriangles(p_type, p_shapeEntry);
+
+		// Failing to save the cooked collider is not critical, as it can be cooked again next time
+		if(auto saveError = saveCookedCollider(cookedFilename, p_type, p_shapeEntry); saveError != ErrorCode::Success)
+			ErrHandlerLoc::get().log(saveError, ErrorSource::Source_Physics, cookedFilename);
+		else
+			ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Physics, p_meshFilename + " - Collider cooked");
+	}
+
+	return returnError;
+}
+
+ErrorCode CollisionShapeCache::loadModelTriangles(const std::string &p_meshFilename, ShapeEntry &p_shapeEntry)
+{
+	// Load the model data to memory, without starting the background loading, as the data is needed right away
+	auto modelHandle = Loaders::model().load(p_meshFilename, false);
+	if(auto error = modelHandle.loadToMemory(); error != ErrorCode::Success)
+		return error;
+
+	// Keep the vertex data in memory while reading it (it is reloaded, if it was already released after being uploaded to video memory)
+	if(auto error = modelHandle.registerCPUDataInterest(); error != ErrorCode::Success)
+	{
+		modelHandle.unregisterCPUDataInterest();
+		return error;
+	}
+
+	const auto &positions = modelHandle.getPositions();
+	const auto &indices = modelHandle.getIndices();
+
+	if(!positions.empty() && !indices.empty())
+	{
+		p_shapeEntry.m_vertices.reserve(positions.size() * 3);
+		for(const auto &position : positions)
+		{
+			p_shapeEntry.m_vertices.push_back(position.x);
+			p_shapeEntry.m_vertices.push_back(position.y);
+			p_shapeEntry.m_vertices.push_back(position.z);
+		}
+
+		// Indices of each mesh are relative to the base vertex of the mesh
+		for(const auto &mesh : modelHandle.getMeshArray())
+			for(unsigned int i = mesh.m_baseIndex, end = mesh.m_baseIndex + mesh.m_numIndices; i < end && i < indices.size(); i++)
+				p_shapeEntry.m_indices.push_back((int)(mesh.m_baseVertex + indices[i]));
+	}
+
+	modelHandle.unregisterCPUDataInterest();
+
+	return p_shapeEntry.m_indices.size() >= 3 ? ErrorCode::Success : ErrorCode::Collision_mesh_cook_failed;
+}
+
+void CollisionShapeCache::createMeshShapeFromTriangles(const RigidBodyComponent::CollisionShapeType p_type, ShapeEntry &p_shapeEntry)
+{
+	if(p_type == RigidBodyComponent::CollisionShapeType::CollisionShapeType_ConvexHull)
+	{
+		auto *convexHullShape = new btConvexHullShape(p_shapeEntry.m_vertices.data(), (int)(p_shapeEntry.m_vertices.size() / 3), 3 * sizeof(btScalar));
+
+		// Reduce the points to the ones on the hull, when cooking from the full model data
+		if(p_shapeEntry.m_indices.size() > 0)
+		{
+			convexHullShape->optimizeConvexHull();
+
+			// Keep only the hull points, as they are the ones that get saved
+			p_shapeEntry.m_vertices.clear();
+			p_shapeEntry.m_indices.clear();
+			for(int i = 0, size = convexHullShape->getNumPoints(); i < size; i++)
+			{
+				p_shapeEntry.m_vertices.push_back(convexHullShape->getUnscaledPoints()[i].x());
+				p_shapeEntry.m_vertices.push_back(convexHullShape->getUnscaledPoints()[i].y());
+				p_shapeEntry.m_vertices.push_back(convexHullShape->getUnscaledPoints()[i].z());
+			}
+		}
+
+		p_shapeEntry.m_collisionShape = convexHullShape;
+	}
+	else
+	{
+		p_shapeEntry.m_meshInterface = new btTriangleIndexVertexArray(
+			(int)(p_shapeEntry.m_indices.size() / 3), p_shapeEntry.m_indices.data(), 3 * sizeof(int),
+			(int)(p_shapeEntry.m_vertices.size() / 3), p_shapeEntry.m_vertices.data(), 3 * sizeof(btScalar));
+
+		// Only build the BVH if a cooked one was not loaded
+		const bool buildBvh = p_shapeEntry.m_bvhBuffer == nullptr;
+		auto *triangleMeshShape = new btBvhTriangleMeshShape(p_shapeEntry.m_meshInterface, true, buildBvh);
+
+		if(!buildBvh)
+		{
+			auto *optimizedBvh = btOptimizedBvh::deSerializeInPlace(p_shapeEntry.m_bvhBuffer, p_shapeEntry.m_bvhBufferSize, false);
+			triangleMeshShape->setOptimizedBvh(optimizedBvh);
+		}
+
+		p_shapeEntry.m_collisionShape = triangleMeshShape;
+	}
+}
+
+ErrorCode CollisionShapeCache::loadCookedCollider(const std::string &p_filename, const RigidBodyComponent::CollisionShapeType p_type, ShapeEntry &p_shapeEntry)
+{
+	std::ifstream colliderFile(p_filename, std::ios::in | std::ios::binary);
+	if(colliderFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	CookedColliderHeader header;
+	colliderFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+	// Reject files of a different version or shape type; they get cooked again
+	if(colliderFile.fail() || std::memcmp(header.m_magic, g_cookedColliderMagic, sizeof(g_cookedColliderMagic)) != 0 || header.m_version != g_cookedColliderVersion || header.m_collisionShapeType != (unsigned int)p_type)
+		return ErrorCode::Collision_mesh_cook_failed;
+
+	p_shapeEntry.m_vertices.resize((size_t)header.m_numOfVertices * 3);
+	p_shapeEntry.m_indices.resize(header.m_numOfIndices);
+
+	colliderFile.read(reinterpret_cast<char *>(p_shapeEntry.m_vertices.data()), p_shapeEntry.m_vertices.size() * sizeof(btScalar));
+	colliderFile.read(reinterpret_cast<char *>(p_shapeEntry.m_indices.data()), p_shapeEntry.m_indices.size() * sizeof(int));
+
+	// The BVH is deserialized in-place later, so the buffer is kept for the lifetime of the shape; BVH requires 16-byte alignment
+	if(header.m_bvhBufferSize > 0)
+	{
+		p_shapeEntry.m_bvhBuffer = btAlignedAlloc(header.m_bvhBufferSize, 16);
+		p_shapeEntry.m_bvhBufferSize = header.m_bvhBufferSize;
+		colliderFile.read(static_cast<char *>(p_shapeEntry.m_bvhBuffer), header.m_bvhBufferSize);
+	}
+
+	if(colliderFile.fail())
+	{
+		p_shapeEntry.m_vertices.clear();
+		p_shapeEntry.m_indices.clear();
+		if(p_shapeEntry.m_bvhBuffer != nullptr)
+		{
+			btAlignedFree(p_shapeEntry.m_bvhBuffer);
+			p_shapeEntry.m_bvhBuffer = nullptr;
+			p_shapeEntry.m_bvhBufferSize = 0;
+		}
+		return ErrorCode::Collision_mesh_cook_failed;
+	}
+
+	return ErrorCode::Success;
+}
+
+ErrorCode CollisionShapeCache::saveCookedCollider(const std::string &p_filename, const RigidBodyComponent::CollisionShapeType p_type, const ShapeEntry &p_shapeEntry)
+{
+	// Serialize the BVH of the triangle mesh shape
+	std::vector<char> bvhBuffer;
+	if(p_type == RigidBodyComponent::CollisionShapeType::CollisionShapeType_TriangleMesh)
+	{
+		const auto *optimizedBvh = static_cast<btBvhTriangleMeshShape *>(p_shapeEntry.m_collisionShape)->getOptimizedBvh();
+		if(optimizedBvh == nullptr)
+			return ErrorCode::Collision_mesh_cook_failed;
+
+		void *alignedBuffer = btAlignedAlloc(optimizedBvh->calculateSerializeBufferSize(), 16);
+		if(optimizedBvh->serializeInPlace(alignedBuffer, optimizedBvh->calculateSerializeBufferSize(), false))
+			bvhBuffer.assign(static_cast<char *>(alignedBuffer), static_cast<char *>(alignedBuffer) + optimizedBvh->calculateSerializeBufferSize());
+		btAlignedFree(alignedBuffer);
+
+		if(bvhBuffer.empty())
+			return ErrorCode::Collision_mesh_cook_failed;
+	}
+
+	Filesystem::createDirectories(Utilities::stripFilePath(p_filename));
+
+	std::ofstream colliderFile(p_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(colliderFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	CookedColliderHeader header;
+	std::memcpy(header.m_magic, g_cookedColliderMagic, sizeof(g_cookedColliderMagic));
+	header.m_version = g_cookedColliderVersion;
+	header.m_collisionShapeType = (unsigned int)p_type;
+	header.m_numOfVertices = (unsigned int)(p_shapeEntry.m_vertices.size() / 3);
+	header.m_numOfIndices = (unsigned int)p_shapeEntry.m_indices.size();
+	header.m_bvhBufferSize = (unsigned int)bvhBuffer.size();
+
+	colliderFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	colliderFile.write(reinterpret_cast<const char *>(p_shapeEntry.m_vertices.data()), p_shapeEntry.m_vertices.size() * sizeof(btScalar));
+	colliderFile.write(reinterpret_cast<const char *>(p_shapeEntry.m_indices.data()), p_shapeEntry.m_indices.size() * sizeof(int));
+	colliderFile.write(bvhBuffer.data(), bvhBuffer.size());
+
+	return colliderFile.fail() ? ErrorCode::Failure : ErrorCode::Success;
+}
+
+void CollisionShapeCache::deleteShapeEntry(ShapeEntry &p_shapeEntry)
+{
+	// The shape must be deleted before the data it references
+	if(p_shapeEntry.m_collisionShape != nullptr)
+		delete p_shapeEntry.m_collisionShape;
+	p_shapeEntry.m_collisionShape = nullptr;
+
+	if(p_shapeEntry.m_meshInterface != nullptr)
+		delete p_shapeEntry.m_meshInterface;
+	p_shapeEntry.m_meshInterface = nullptr;
+
+	if(p_shapeEntry.m_bvhBuffer != nullptr)
+		btAlignedFree(p_shapeEntry.m_bvhBuffer);
+	p_shapeEntry.m_bvhBuffer = nullptr;
+}
+
+std::string CollisionShapeCache::getCookedColliderFilename(const RigidBodyComponent::CollisionShapeType p_type, const std::string &p_meshFilename)
+{
+	return Config::filepathVar().collider_cache_path + p_meshFilename + (p_type == RigidBodyComponent::CollisionShapeType::CollisionShapeType_ConvexHull ? ".hull" : ".bvh");
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "ErrorCodes.h"
+#include "RigidBodyComponent.h"
+#include "SpinWait.h"
+
+// Shares collision shapes between rigid bodies; shapes are identified by their type and dimensions (or the model
+// filename, for mesh colliders) and are reference counted, so thousands of bodies with identical dimensions use a single shape.
+// Mesh colliders (triangle mesh BVH and convex hull) are cooked from the model data on first use and saved to disk,
+// so subsequent loads read the cooked data directly, without rebuilding the BVH or the hull.
+// Shapes acquired from the cache are shared and must not be modified; a different shape should be acquired instead
+class CollisionShapeCache
+{
+public:
+	CollisionShapeCache();
+	~CollisionShapeCache();
+
+	// Returns a shared collision shape of the given type and size (or of the given model, for mesh colliders), incrementing its reference count.
+	// Returns nullptr if the collision shape type is not supported or the mesh collider could not be created
+	btCollisionShape *acquireShape(const RigidBodyComponent::CollisionShapeType p_type, const glm::vec3 &p_size, const std::string &p_meshFilename = std::string());
+
+	// Decrements the reference count of the shape, deleting it when it is no longer used by any rigid body
+	void releaseShape(btCollisionShape *p_collisionShape);
+
+	// Getters
+	inline size_t getNumOfShapes() const { return m_shapes.size(); }
+	inline size_t getNumOfReferences() const
+	{
+		size_t numOfReferences = 0;
+		for(const auto &shape : m_shapes)
+			numOfReferences += shape.second.m_referenceCount;
+		return numOfReferences;
+	}
+
+private:
+	struct ShapeKey
+	{
+		ShapeKey(const RigidBodyComponent::CollisionShapeType p_type, const glm::vec3 &p_size, const std::string &p_meshFilename) : m_type(p_type), m_size(p_size), m_meshFilename(p_meshFilename) { }
+
+		inline bool operator<(const ShapeKey &p_other) const
+		{
+			return std::tie(m_type, m_size.x, m_size.y, m_size.z, m_meshFilename) < std::tie(p_other.m_type, p_other.m_size.x, p_other.m_size.y, p_other.m_size.z, p_other.m_meshFilename);
+		}
+
+		RigidBodyComponent::CollisionShapeType m_type;
+		glm::vec3 m_size;
+		std::string m_meshFilename;
+	};
+
+	struct ShapeEntry
+	{
+		ShapeEntry() : m_collisionShape(nullptr), m_meshInterface(nullptr), m_bvhBuffer(nullptr), m_bvhBufferSize(0), m_referenceCount(0), m_pending(false) { }
+
+		btCollisionShape *m_collisionShape;
+
+		// Triangle mesh data, referenced (not copied) by the triangle mesh shape, so it must outlive it
+		std::vector<btScalar> m_vertices;
+		std::vector<int> m_indices;
+		btTriangleIndexVertexArray *m_meshInterface;
+
+		// Cooked BVH, deserialized in-place from this buffer
+		void *m_bvhBuffer;
+		unsigned int m_bvhBufferSize;
+
+		size_t m_referenceCount;
+
+		// Set while the mesh collider is being cooked (outside the lock); the shape must not be used until it is cleared
+		bool m_pending;
+	};
+
+	// Cooked collider file header
+	struct CookedColliderHeader
+	{
+		char m_magic[4];
+		unsigned int m_version;
+		unsigned int m_collisionShapeType;
+		unsigned int m_numOfVertices;
+		unsigned int m_numOfIndices;
+		unsigned int m_bvhBufferSize;
+	};
+
+	// Waits until the pending shape has been created by another thread; returns nullptr if creating the shape failed
+	btCollisionShape *waitForPendingShape(std::map<ShapeKey, ShapeEntry>::iterator p_shapeIterator);
+
+	// Creates a primitive collision shape of the given size
+	btCollisionShape *createPrimitiveShape(const RigidBodyComponent::CollisionShapeType p_type, const glm::vec3 &p_size);
+
+	// Creates a mesh collision shape, either from a cooked collider file, or by cooking it from the model data and saving it to a cooked collider file
+	ErrorCode createMeshShape(const RigidBodyComponent::CollisionShapeType p_type, const std::string &p_meshFilename, ShapeEntry &p_shapeEntry);
+
+	// Gathers the triangles of every mesh of the model into the entry vertex and index arrays
+	ErrorCode loadModelTriangles(const std::string &p_meshFilename, ShapeEntry &p_shapeEntry);
+
+	// Creates the mesh collision shape from the entry vertex and index arrays (and the cooked BVH, if it was loaded)
+	void createMeshShapeFromTriangles(const RigidBodyComponent::CollisionShapeType p_type, ShapeEntry &p_shapeEntry);
+
+	ErrorCode loadCookedCollider(const std::string &p_filename, const RigidBodyComponent::CollisionShapeType p_type, ShapeEntry &p_shapeEntry);
+	ErrorCode saveCookedCollider(const std::string &p_filename, const RigidBodyComponent::CollisionShapeType p_type, const ShapeEntry &p_shapeEntry);
+
+	// Deletes the shape and all of its data
+	void deleteShapeEntry(ShapeEntry &p_shapeEntry);
+
+	// Returns the filename of the cooked collider of the given model
+	static std::string getCookedColliderFilename(const RigidBodyComponent::CollisionShapeType p_type, const std::string &p_meshFilename);
+
+	std::map<ShapeKey, ShapeEntry> m_shapes;
+
+	// Used for finding the cache entry of a shape when releasing it
+	std::unordered_map<const btCollisionShape *, std::map<ShapeKey, ShapeEntry>::iterator> m_shapeEntries;
+
+	// Shapes can be acquired while loading multiple scenes at once; the lock is not held while cooking mesh colliders
+	SpinWait m_mutex;
+};
@@ -105,7 +105,9 @@ public:
 
 		m_commands.emplace_back(std::make_pair(
 			sortKey,
-			RendererBackend::LoadCommand(p_shader.m_shaderFilename,
+			RendererBackend::LoadCommand(p_shader.m_combinedFilename,
+										 p_shader.getDefineSetHash(),
+										 p_shader.m_shaderFilename,
 										 p_shader.m_programHandle,
 										 p_shader.getUniformUpdater(),
 										 p_shader.m_shaderSource,
@@ -362,6 +362,14 @@ enum AntiAliasingType : int
 	AntiAliasingType_NumOfTypes
 };
 
+// Residency of the system memory copies of asset data (e.g. mesh vertices and texture pixels)
+enum AssetResidencyPolicy : int
+{
+	AssetResidencyPolicy_KeepInMemory = 0,		// Copies are kept until the asset is unloaded
+	AssetResidencyPolicy_ReleaseAfterUpload,	// Copies are released once uploaded to video memory, unless a consumer registered interest in them
+	AssetResidencyPolicy_NumOfPolicies
+};
+
 enum AudioBusType : unsigned int
 {
 	AudioBusType_Ambient,
@@ -86,6 +86,11 @@ void Config::init()
 	AddVariablePredef(m_componentVar, shader_component_name);
 
 	// Engine variables
+	AddVariablePredef(m_engineVar, benchmark_output_filename);
+	AddVariablePredef(m_engineVar, benchmark_delta_time_ms);
+	AddVariablePredef(m_engineVar, benchmark_num_of_frames);
+	AddVariablePredef(m_engineVar, benchmark_num_of_warmup_frames);
+	AddVariablePredef(m_engineVar, benchmark_random_seed);
 	AddVariablePredef(m_engineVar, change_ctrl_cml_notify_list_reserv);
 	AddVariablePredef(m_engineVar, change_ctrl_grain_size);
 	AddVariablePredef(m_engineVar, change_ctrl_notify_list_reserv);
@@ -93,15 +98,32 @@ void Config::init()
 	AddVariablePredef(m_engineVar, change_ctrl_oneoff_notify_list_reserv);
 	AddVariablePredef(m_engineVar, change_ctrl_subject_list_reserv);
 	AddVariablePredef(m_engineVar, delta_time_divider);
+	AddVariablePredef(m_engineVar, frame_allocator_buffer_size);
 	AddVariablePredef(m_engineVar, glsl_version);
 	AddVariablePredef(m_engineVar, gl_context_major_version);
 	AddVariablePredef(m_engineVar, gl_context_minor_version);
+	AddVariablePredef(m_engineVar, loaders_model_memory_budget_mb);
 	AddVariablePredef(m_engineVar, loaders_num_of_unload_per_frame);
+	AddVariablePredef(m_engineVar, loaders_texture_memory_budget_mb);
 	AddVariablePredef(m_engineVar, log_max_num_of_logs);
+	AddVariablePredef(m_engineVar, log_max_repeats_per_second);
+	AddVariablePredef(m_engineVar, log_ring_buffer_size);
+	AddVariablePredef(m_engineVar, log_sink_interval_ms);
 	AddVariablePredef(m_engineVar, object_directory_init_pool_size);
+	AddVariablePredef(m_engineVar, profiler_zones_per_thread);
 	AddVariablePredef(m_engineVar, smoothing_tick_samples);
 	AddVariablePredef(m_engineVar, task_scheduler_clock_frequency);
+	AddVariablePredef(m_engineVar, headless_mode);
+	AddVariablePredef(m_engineVar, log_async_enabled);
 	AddVariablePredef(m_engineVar, log_store_logs);
+	AddVariablePredef(m_engineVar, pipelined_rendering);
+	AddVariablePredef(m_engineVar, profiler_enabled);
+	AddVariablePredef(m_engineVar, self_check);
+	AddVariablePredef(m_engineVar, profiler_trace_filename);
+	AddVariablePredef(m_engineVar, world_streaming_cell_size);
+	AddVariablePredef(m_engineVar, world_streaming_instantiation_budget_ms);
+	AddVariablePredef(m_engineVar, world_streaming_load_radius);
+	AddVariablePredef(m_engineVar, world_streaming_unload_radius);
 
 	// Frame-buffer variables
 	AddVariablePredef(m_framebfrVar, gl_position_buffer_internal_format);
@@ -119,6 +141,12 @@ void Config::init()
 	AddVariablePredef(m_framebfrVar, gl_mat_properties_buffer_internal_format);
 	AddVariablePredef(m_framebfrVar, gl_mat_properties_buffer_texture_format);
 	AddVariablePredef(m_framebfrVar, gl_mat_properties_buffer_texture_type);
+	AddVariablePredef(m_framebfrVar, gl_normal_buffer_thin_internal_format);
+	AddVariablePredef(m_framebfrVar, gl_normal_buffer_thin_texture_format);
+	AddVariablePredef(m_framebfrVar, gl_normal_buffer_thin_texture_type);
+	AddVariablePredef(m_framebfrVar, gl_mat_properties_buffer_thin_internal_format);
+	AddVariablePredef(m_framebfrVar, gl_mat_properties_buffer_thin_texture_format);
+	AddVariablePredef(m_framebfrVar, gl_mat_properties_buffer_thin_texture_type);
 	AddVariablePredef(m_framebfrVar, gl_blur_buffer_internal_format);
 	AddVariablePredef(m_framebfrVar, gl_blur_buffer_texture_type);
 	AddVariablePredef(m_framebfrVar, gl_blur_buffer_texture_format);
@@ -225,6 +253,7 @@ void Config::init()
 	AddVariablePredef(m_GUIVar, gui_dark_style);
 	AddVariablePredef(m_GUIVar, gui_color_pallet);
 	AddVariablePredef(m_GUIVar, gui_sequence_array_reserve_size);
+	AddVariablePredef(m_GUIVar, editor_entity_changes_max_pending);
 	AddVariablePredef(m_GUIVar, about_window_font_size);
 	AddVariablePredef(m_GUIVar, editor_asset_selection_button_size_multiplier);
 	AddVariablePredef(m_GUIVar, editor_asset_texture_button_size_x);
@@ -305,11 +334,16 @@ void Config::init()
 
 	// Model variables
 	AddVariablePredef(m_modelVar, calcTangentSpace);
+	AddVariablePredef(m_modelVar, cpuResidencyPolicy);
 	AddVariablePredef(m_modelVar, genBoundingBoxes);
+	AddVariablePredef(m_modelVar, generateLODs);
 	AddVariablePredef(m_modelVar, genNormals);
 	AddVariablePredef(m_modelVar, genSmoothNormals);
 	AddVariablePredef(m_modelVar, genUVCoords);
 	AddVariablePredef(m_modelVar, joinIdenticalVertices);
+	AddVariablePredef(m_modelVar, lodMaxNumOfLevels);
+	AddVariablePredef(m_modelVar, lodReductionRatio);
+	AddVariablePredef(m_modelVar, lodTargetError);
 	AddVariablePredef(m_modelVar, makeLeftHanded);
 	AddVariablePredef(m_modelVar, optimizeCacheLocality);
 	AddVariablePredef(m_modelVar, optimizeGraph);
@@ -333,15 +367,19 @@ void Config::init()
 	AddVariablePredef(m_objPoolVar, sound_listener_component_default_pool_size); 
 
 	// File-path variables
+	AddVariablePredef(m_filepathVar, atm_scattering_cache_path);
+	AddVariablePredef(m_filepathVar, collider_cache_path);
 	AddVariablePredef(m_filepathVar, config_path);
 	AddVariablePredef(m_filepathVar, engine_assets_path); 
 	AddVariablePredef(m_filepathVar, font_path);
 	AddVariablePredef(m_filepathVar, gui_assets_path);
+	AddVariablePredef(m_filepathVar, lod_cache_path);
 	AddVariablePredef(m_filepathVar, map_path);
 	AddVariablePredef(m_filepathVar, model_path);
 	AddVariablePredef(m_filepathVar, object_path);
 	AddVariablePredef(m_filepathVar, prefab_path);
 	AddVariablePredef(m_filepathVar, script_path);
+	AddVariablePredef(m_filepathVar, shader_cache_path);
 	AddVariablePredef(m_filepathVar, shader_path);
 	AddVariablePredef(m_filepathVar, sound_path);
 	AddVariablePredef(m_filepathVar, texture_path);
@@ -349,6 +387,8 @@ void Config::init()
 	// Physics variables
 	AddVariablePredef(m_physicsVar, applied_impulse_threshold);
 	AddVariablePredef(m_physicsVar, life_time_threshold);
+	AddVariablePredef(m_physicsVar, spatial_query_grain_size);
+	AddVariablePredef(m_physicsVar, spatial_query_max_queries_per_frame);
 	
 	// Renderer variables
 	AddVariablePredef(m_rendererVar, atm_scattering_ground_vert_shader);
@@ -425,37 +465,65 @@ void Config::init()
 	AddVariablePredef(m_rendererVar, csm_penumbra_size);
 	AddVariablePredef(m_rendererVar, csm_penumbra_size_scale_min);
 	AddVariablePredef(m_rendererVar, csm_penumbra_size_scale_max);
+	AddVariablePredef(m_rendererVar, csm_static_caster_cache_margin);
 	AddVariablePredef(m_rendererVar, dir_light_quad_offset_x);
 	AddVariablePredef(m_rendererVar, dir_light_quad_offset_y);
 	AddVariablePredef(m_rendererVar, dir_light_quad_offset_z);
 	AddVariablePredef(m_rendererVar, dir_light_quad_rotation_x);
 	AddVariablePredef(m_rendererVar, dir_light_quad_rotation_y);
 	AddVariablePredef(m_rendererVar, dir_light_quad_rotation_z);
+	AddVariablePredef(m_rendererVar, dynamic_resolution_adjust_rate);
+	AddVariablePredef(m_rendererVar, dynamic_resolution_headroom);
+	AddVariablePredef(m_rendererVar, dynamic_resolution_max_scale);
+	AddVariablePredef(m_rendererVar, dynamic_resolution_min_scale);
+	AddVariablePredef(m_rendererVar, dynamic_resolution_target_frame_time);
 	AddVariablePredef(m_rendererVar, fxaa_edge_threshold_min);
 	AddVariablePredef(m_rendererVar, fxaa_edge_threshold_max);
 	AddVariablePredef(m_rendererVar, fxaa_edge_subpixel_quality);
+	AddVariablePredef(m_rendererVar, gpu_upload_bytes_per_us);
+	AddVariablePredef(m_rendererVar, gpu_upload_max_time_per_frame_us);
+	AddVariablePredef(m_rendererVar, gpu_upload_object_cost_us);
+	AddVariablePredef(m_rendererVar, lod_bias);
+	AddVariablePredef(m_rendererVar, lod_pixel_error);
+	AddVariablePredef(m_rendererVar, lod_shadow_bias);
+	AddVariablePredef(m_rendererVar, occlusion_occluder_min_screen_size);
 	AddVariablePredef(m_rendererVar, parallax_mapping_min_steps);
 	AddVariablePredef(m_rendererVar, parallax_mapping_max_steps);
+	AddVariablePredef(m_rendererVar, atm_scattering_lut_cache_max_files);
 	AddVariablePredef(m_rendererVar, csm_num_of_pcf_samples);
 	AddVariablePredef(m_rendererVar, csm_resolution);
 	AddVariablePredef(m_rendererVar, csm_face_culling);
 	AddVariablePredef(m_rendererVar, csm_front_face_culling);
+	AddVariablePredef(m_rendererVar, csm_static_caster_caching);
 	AddVariablePredef(m_rendererVar, depth_test_func);
+	AddVariablePredef(m_rendererVar, draw_command_grain_size);
 	AddVariablePredef(m_rendererVar, face_culling_mode);
+	AddVariablePredef(m_rendererVar, frame_ring_buffer_size);
 	AddVariablePredef(m_rendererVar, fxaa_iterations);
+	AddVariablePredef(m_rendererVar, gpu_upload_max_bytes_per_frame);
+	AddVariablePredef(m_rendererVar, gpu_upload_staging_buffer_size);
 	AddVariablePredef(m_rendererVar, heightmap_combine_channel);
 	AddVariablePredef(m_rendererVar, heightmap_combine_texture);
 	AddVariablePredef(m_rendererVar, max_num_point_lights);
 	AddVariablePredef(m_rendererVar, max_num_spot_lights);
 	AddVariablePredef(m_rendererVar, objects_loaded_per_frame);
+	AddVariablePredef(m_rendererVar, occlusion_buffer_height);
+	AddVariablePredef(m_rendererVar, occlusion_buffer_width);
+	AddVariablePredef(m_rendererVar, occlusion_max_occluders);
+	AddVariablePredef(m_rendererVar, occlusion_occluder_max_triangles);
 	AddVariablePredef(m_rendererVar, parallax_mapping_method);
 	AddVariablePredef(m_rendererVar, render_to_texture_buffer);
 	AddVariablePredef(m_rendererVar, shader_pool_size);
 	AddVariablePredef(m_rendererVar, ssao_num_of_samples);
+	AddVariablePredef(m_rendererVar, atm_scattering_lut_cache);
 	AddVariablePredef(m_rendererVar, depth_test);
+	AddVariablePredef(m_rendererVar, dynamic_resolution);
 	AddVariablePredef(m_rendererVar, face_culling);
 	AddVariablePredef(m_rendererVar, fxaa_enabled);
+	AddVariablePredef(m_rendererVar, gbuffer_thin_layout);
 	AddVariablePredef(m_rendererVar, msaa_enabled);
+	AddVariablePredef(m_rendererVar, occlusion_culling);
+	AddVariablePredef(m_rendererVar, shader_binary_cache);
 	AddVariablePredef(m_rendererVar, stochastic_sampling_seam_fix);
 
 	// Script variables
@@ -476,8 +544,10 @@ void Config::init()
 	AddVariablePredef(m_shaderVar, modelViewProjectionMatUniform);
 	AddVariablePredef(m_shaderVar, transposeViewMatUniform);
 	AddVariablePredef(m_shaderVar, transposeInverseViewMatUniform);
+	AddVariablePredef(m_shaderVar, inverseViewProjectionMatUniform);
 	AddVariablePredef(m_shaderVar, screenSizeUniform);
 	AddVariablePredef(m_shaderVar, inverseScreenSizeUniform);
+	AddVariablePredef(m_shaderVar, renderScaleUniform);
 	AddVariablePredef(m_shaderVar, screenNumOfPixelsUniform);
 	AddVariablePredef(m_shaderVar, deltaTimeMSUniform);
 	AddVariablePredef(m_shaderVar, deltaTimeSUniform);
@@ -579,6 +649,7 @@ void Config::init()
 	AddVariablePredef(m_shaderVar, define_fxaa_edge_threshold_max);
 	AddVariablePredef(m_shaderVar, define_fxaa_iterations);
 	AddVariablePredef(m_shaderVar, define_fxaa_subpixel_quality);
+	AddVariablePredef(m_shaderVar, define_gbufferThinLayout);
 	AddVariablePredef(m_shaderVar, define_maxNumOfPointLights);
 	AddVariablePredef(m_shaderVar, define_maxNumOfSpotLights);
 	AddVariablePredef(m_shaderVar, define_normalMapCompression);
@@ -617,6 +688,7 @@ void Config::init()
 	AddVariablePredef(m_textureVar, texture_compression_format_rgb);
 	AddVariablePredef(m_textureVar, texture_compression_format_rgba);
 	AddVariablePredef(m_textureVar, texture_compression_format_normal);
+	AddVariablePredef(m_textureVar, texture_cpu_residency_policy);
 	AddVariablePredef(m_textureVar, texture_downsample_max_resolution);
 	AddVariablePredef(m_textureVar, texture_downsample_scale);
 	AddVariablePredef(m_textureVar, generate_mipmaps);
@@ -698,6 +770,15 @@ ErrorCode Config::loadFromFile(const std::string &p_filename)
 
 	return returnCode;
 }
+ErrorCode Config::loadFromArguments(const int p_argc, char *p_argv[])
+{
+	// Skip the first argument, as it is the executable name
+	for(int i = 1; i + 1 < p_argc; i += 2)
+		setVariable(p_argv[i], p_argv[i + 1]);
+
+	// An odd number of arguments means a variable is missing its value
+	return (p_argc > 1 && p_argc % 2 == 0) ? ErrorCode::Failure : ErrorCode::Success;
+}
 ErrorCode Config::saveToFile(const std::string &p_filename)
 {
 	std::string fileContents;
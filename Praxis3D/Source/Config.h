@@ -465,6 +465,7 @@ namespace Properties
 	Code(ModelObject,) \
 	Code(ModelPoolSize,) \
 	Code(Normal,) \
+	Code(Occluder,) \
 	Code(ParallaxHeightScale,) \
 	Code(PenumbraScale,) \
 	Code(PenumbraSize,) \
@@ -582,6 +583,7 @@ namespace Properties
 	Code(Size,) \
 	Code(Sphere,) \
 	Code(SpinningFriction,) \
+	Code(TriangleMesh,) \
 	Code(Velocity,) \
 	/* Script */ \
 	Code(Angle,) \
@@ -626,8 +628,11 @@ namespace Properties
 	Code(VerticalSync,) \
 	Code(WindowTitle,) \
 	/* World */ \
+	Code(Cells,) \
+	Code(CellSize,) \
 	Code(Children,) \
 	Code(Concrete,) \
+	Code(Coordinates,) \
 	Code(GameObject,) \
 	Code(Glass,) \
 	Code(ID,) \
@@ -642,6 +647,7 @@ namespace Properties
 	Code(SpatialComponent,) \
 	Code(Wood,) \
 	Code(World,) \
+	Code(WorldStreaming,) \
 	/* End of property IDs */ \
 	Code(NumberOfPropertyIDs,) 
 	DECLARE_ENUM(PropertyID, PROPERTYID)
@@ -791,6 +797,16 @@ public:
 	{
 		EngineVariables()
 		{
+			benchmark_output_filename = "benchmark-results.json";
+			profiler_trace_filename = "profiler-trace.json";
+			benchmark_delta_time_ms = 1000.0f / 60.0f;
+			world_streaming_cell_size = 0.0f;
+			world_streaming_instantiation_budget_ms = 2.0f;
+			world_streaming_load_radius = 200.0f;
+			world_streaming_unload_radius = 250.0f;
+			benchmark_num_of_frames = 0;
+			benchmark_num_of_warmup_frames = 10;
+			benchmark_random_seed = 0;
 			change_ctrl_cml_notify_list_reserv = 4096;
 			change_ctrl_grain_size = 50;
 			change_ctrl_notify_list_reserv = 8192;
@@ -798,21 +814,43 @@ public:
 			change_ctrl_oneoff_notify_list_reserv = 64;
 			change_ctrl_subject_list_reserv = 8192;
 			delta_time_divider = 1000;
+			frame_allocator_buffer_size = 1048576;
 			glsl_version = 430;
 			gl_context_major_version = 3;
 			gl_context_minor_version = 3;
+			loaders_model_memory_budget_mb = 256;
 			loaders_num_of_unload_per_frame = 1;
+			loaders_texture_memory_budget_mb = 1024;
 			log_max_num_of_logs = 200;
+			log_max_repeats_per_second = 10;
+			log_ring_buffer_size = 4096;
+			log_sink_interval_ms = 5;
 			object_directory_init_pool_size = 1000;
+			profiler_zones_per_thread = 16384;
 			smoothing_tick_samples = 100;
 			task_scheduler_clock_frequency = 120;
 			running = true;
 			loadingState = true;
+			headless_mode = false;
+			log_async_enabled = true;
 			log_store_logs = true;
+			pipelined_rendering = true;
+			profiler_enabled = true;
+			self_check = false;
 			editorState = false;
 			engineState = EngineStateType::EngineStateType_MainMenu;
 		}
 
+		std::string benchmark_output_filename;
+		std::string profiler_trace_filename;
+		float benchmark_delta_time_ms;
+		float world_streaming_cell_size;
+		float world_streaming_instantiation_budget_ms;
+		float world_streaming_load_radius;
+		float world_streaming_unload_radius;
+		int benchmark_num_of_frames;
+		int benchmark_num_of_warmup_frames;
+		int benchmark_random_seed;
 		int change_ctrl_cml_notify_list_reserv;
 		int change_ctrl_grain_size;
 		int change_ctrl_notify_list_reserv; 
@@ -820,17 +858,29 @@ public:
 		int change_ctrl_oneoff_notify_list_reserv;
 		int change_ctrl_subject_list_reserv;
 		int delta_time_divider;
+		int frame_allocator_buffer_size;
 		int glsl_version;
 		int gl_context_major_version;
 		int gl_context_minor_version;
+		int loaders_model_memory_budget_mb;
 		int loaders_num_of_unload_per_frame;
+		int loaders_texture_memory_budget_mb;
 		int log_max_num_of_logs;
+		int log_max_repeats_per_second;
+		int log_ring_buffer_size;
+		int log_sink_interval_ms;
 		int object_directory_init_pool_size;
+		int profiler_zones_per_thread;
 		int smoothing_tick_samples;
 		int task_scheduler_clock_frequency;
 		bool running;
 		bool loadingState;
+		bool headless_mode;
+		bool log_async_enabled;
 		bool log_store_logs;
+		bool pipelined_rendering;
+		bool profiler_enabled;
+		bool self_check;
 		bool editorState;
 		EngineStateType engineState;
 	};
@@ -858,6 +908,14 @@ public:
 			gl_mat_properties_buffer_texture_format = GL_RGBA;
 			gl_mat_properties_buffer_texture_type = GL_FLOAT;
 
+			gl_normal_buffer_thin_internal_format = GL_RG16_SNORM;
+			gl_normal_buffer_thin_texture_format = GL_RG;
+			gl_normal_buffer_thin_texture_type = GL_FLOAT;
+
+			gl_mat_properties_buffer_thin_internal_format = GL_RGBA8;
+			gl_mat_properties_buffer_thin_texture_format = GL_RGBA;
+			gl_mat_properties_buffer_thin_texture_type = GL_UNSIGNED_BYTE;
+
 			gl_blur_buffer_internal_format = GL_RGBA16F;
 			gl_blur_buffer_texture_format = GL_RGBA;
 			gl_blur_buffer_texture_type = GL_FLOAT;
@@ -907,6 +965,14 @@ public:
 		int gl_mat_properties_buffer_texture_format;
 		int gl_mat_properties_buffer_texture_type;
 
+		int gl_normal_buffer_thin_internal_format;
+		int gl_normal_buffer_thin_texture_format;
+		int gl_normal_buffer_thin_texture_type;
+
+		int gl_mat_properties_buffer_thin_internal_format;
+		int gl_mat_properties_buffer_thin_texture_format;
+		int gl_mat_properties_buffer_thin_texture_type;
+
 		int gl_blur_buffer_internal_format;
 		int gl_blur_buffer_texture_type;
 		int gl_blur_buffer_texture_format;
@@ -1116,6 +1182,7 @@ public:
 			gui_dark_style = true;
 			gui_color_pallet = 1;
 			gui_sequence_array_reserve_size = 50;
+			editor_entity_changes_max_pending = 10000;
 			about_window_font_size = 30.0f;
 			editor_asset_selection_button_size_multiplier = 2.0f;
 			editor_asset_texture_button_size_x = 60.0f;
@@ -1162,6 +1229,7 @@ public:
 		bool gui_dark_style;
 		int gui_color_pallet;
 		int gui_sequence_array_reserve_size;
+		int editor_entity_changes_max_pending;
 		float about_window_font_size;
 		float editor_asset_selection_button_size_multiplier;
 		float editor_asset_texture_button_size_x;
@@ -1283,11 +1351,16 @@ public:
 		ModelVariables()
 		{
 			calcTangentSpace = true;
+			cpuResidencyPolicy = AssetResidencyPolicy::AssetResidencyPolicy_ReleaseAfterUpload;
 			genBoundingBoxes = true;
+			generateLODs = true;
 			genNormals = false;
 			genSmoothNormals = true;
 			genUVCoords = true;
 			joinIdenticalVertices = false;
+			lodMaxNumOfLevels = 4;
+			lodReductionRatio = 0.35f;
+			lodTargetError = 0.02f;
 			makeLeftHanded = false;
 			optimizeCacheLocality = false;
 			optimizeMeshes = true;
@@ -1297,11 +1370,16 @@ public:
 		}
 
 		bool calcTangentSpace;
+		int cpuResidencyPolicy;
 		bool genBoundingBoxes;
+		bool generateLODs;
 		bool genNormals;
 		bool genSmoothNormals;
 		bool genUVCoords;
 		bool joinIdenticalVertices;
+		int lodMaxNumOfLevels;
+		float lodReductionRatio;
+		float lodTargetError;
 		bool makeLeftHanded;
 		bool optimizeCacheLocality;
 		bool optimizeGraph;
@@ -1346,29 +1424,37 @@ public:
 	{
 		PathsVariables()
 		{
+			atm_scattering_cache_path = "Data\\Cache\\Atmosphere\\";
+			collider_cache_path = "Data\\Cache\\Colliders\\";
 			config_path = "Data\\";
 			engine_assets_path = "Default\\";
 			font_path = "Data\\Fonts\\";
 			gui_assets_path = "Default\\GUI\\";
+			lod_cache_path = "Data\\Cache\\LODs\\";
 			map_path = "Data\\Maps\\";
 			model_path = "Data\\Models\\";
 			object_path = "Data\\Objects\\";
 			prefab_path = "Data\\Prefabs\\";
 			script_path = "Data\\Scripts\\";
+			shader_cache_path = "Data\\Cache\\Shaders\\";
 			shader_path = "Data\\Shaders\\";
 			sound_path = "Data\\Sounds\\";
 			texture_path = "Data\\Materials\\";
 		}
 
+		std::string atm_scattering_cache_path;
+		std::string collider_cache_path;
 		std::string config_path;
 		std::string engine_assets_path;
 		std::string font_path;
 		std::string gui_assets_path;
+		std::string lod_cache_path;
 		std::string map_path;
 		std::string model_path;
 		std::string object_path;
 		std::string prefab_path;
 		std::string script_path;
+		std::string shader_cache_path;
 		std::string shader_path;
 		std::string sound_path;
 		std::string texture_path;
@@ -1379,9 +1465,13 @@ public:
 		{
 			applied_impulse_threshold = 1.0f;
 			life_time_threshold = 2;
+			spatial_query_grain_size = 32;
+			spatial_query_max_queries_per_frame = 65536;
 		}
 		float applied_impulse_threshold;
 		int life_time_threshold;
+		int spatial_query_grain_size;
+		int spatial_query_max_queries_per_frame;
 	};
 	struct RendererVariables
 	{
@@ -1461,6 +1551,7 @@ public:
 			csm_penumbra_size = 0.720f;
 			csm_penumbra_size_scale_min = 1.0f;
 			csm_penumbra_size_scale_max = 2000.0f;
+			csm_static_caster_cache_margin = 0.25f;
 			current_viewport_position_x = 0.0f;
 			current_viewport_position_y = 0.0f;
 			dir_light_quad_offset_x = 0.0f;
@@ -1469,33 +1560,60 @@ public:
 			dir_light_quad_rotation_x = 180.0f;
 			dir_light_quad_rotation_y = 0.0f;
 			dir_light_quad_rotation_z = 0.0f;
+			dynamic_resolution_adjust_rate = 0.1f;
+			dynamic_resolution_headroom = 0.1f;
+			dynamic_resolution_max_scale = 1.0f;
+			dynamic_resolution_min_scale = 0.5f;
+			dynamic_resolution_target_frame_time = 16.0f;
 			fxaa_edge_threshold_min = 0.0312f;
 			fxaa_edge_threshold_max = 0.125f;
 			fxaa_edge_subpixel_quality = 0.75f;
+			gpu_upload_bytes_per_us = 1000.0f;
+			gpu_upload_max_time_per_frame_us = 2000.0f;
+			gpu_upload_object_cost_us = 50.0f;
+			lod_bias = 1.0f;
+			lod_pixel_error = 1.0f;
+			lod_shadow_bias = 2.0f;
+			occlusion_occluder_min_screen_size = 0.1f;
 			parallax_mapping_min_steps = 8.0f;
 			parallax_mapping_max_steps = 32.0f;
+			atm_scattering_lut_cache_max_files = 8;
 			csm_num_of_pcf_samples = 16;
 			csm_resolution = 4096;
 			current_viewport_size_x = 0;
 			current_viewport_size_y = 0;
 			depth_test_func = GL_LESS;
+			draw_command_grain_size = 256;
 			face_culling_mode = GL_BACK;
+			frame_ring_buffer_size = 1048576;
 			fxaa_iterations = 12;
+			gpu_upload_max_bytes_per_frame = 16777216;
+			gpu_upload_staging_buffer_size = 67108864;
 			heightmap_combine_channel = 3;
 			heightmap_combine_texture = 1;
 			max_num_point_lights = 450;
 			max_num_spot_lights = 50;
-			objects_loaded_per_frame = 1;
+			objects_loaded_per_frame = 100;
+			occlusion_buffer_height = 128;
+			occlusion_buffer_width = 256;
+			occlusion_max_occluders = 32;
+			occlusion_occluder_max_triangles = 4096;
 			parallax_mapping_method = 5;
 			render_to_texture_buffer = GBufferTextureType::GBufferEmissive;
 			shader_pool_size = 10;
 			ssao_num_of_samples = 64;
+			atm_scattering_lut_cache = true;
 			csm_face_culling = true;
 			csm_front_face_culling = true;
+			csm_static_caster_caching = true;
 			depth_test = true;
+			dynamic_resolution = false;
 			face_culling = true;
 			fxaa_enabled = true;
+			gbuffer_thin_layout = false;
 			msaa_enabled = false;
+			occlusion_culling = true;
+			shader_binary_cache = true;
 			stochastic_sampling_seam_fix = true;
 		}
 		
@@ -1573,6 +1691,7 @@ public:
 		float csm_penumbra_size;
 		float csm_penumbra_size_scale_min;
 		float csm_penumbra_size_scale_max;
+		float csm_static_caster_cache_margin;
 		float current_viewport_position_x;
 		float current_viewport_position_y;
 		float dir_light_quad_offset_x;
@@ -1581,33 +1700,60 @@ public:
 		float dir_light_quad_rotation_x;
 		float dir_light_quad_rotation_y;
 		float dir_light_quad_rotation_z;
+		float dynamic_resolution_adjust_rate;
+		float dynamic_resolution_headroom;
+		float dynamic_resolution_max_scale;
+		float dynamic_resolution_min_scale;
+		float dynamic_resolution_target_frame_time;
 		float fxaa_edge_threshold_min;
 		float fxaa_edge_threshold_max;
 		float fxaa_edge_subpixel_quality;
+		float gpu_upload_bytes_per_us;
+		float gpu_upload_max_time_per_frame_us;
+		float gpu_upload_object_cost_us;
+		float lod_bias;
+		float lod_pixel_error;
+		float lod_shadow_bias;
+		float occlusion_occluder_min_screen_size;
 		float parallax_mapping_min_steps;
 		float parallax_mapping_max_steps;
+		int atm_scattering_lut_cache_max_files;
 		int csm_num_of_pcf_samples;
 		int csm_resolution;
 		int current_viewport_size_x;
 		int current_viewport_size_y;
 		int depth_test_func;
+		int draw_command_grain_size;
 		int face_culling_mode;
+		int frame_ring_buffer_size;
 		int fxaa_iterations;
+		int gpu_upload_max_bytes_per_frame;
+		int gpu_upload_staging_buffer_size;
 		int heightmap_combine_channel;
 		int heightmap_combine_texture;
 		int max_num_point_lights;
 		int max_num_spot_lights;
 		int objects_loaded_per_frame;
+		int occlusion_buffer_height;
+		int occlusion_buffer_width;
+		int occlusion_max_occluders;
+		int occlusion_occluder_max_triangles;
 		int parallax_mapping_method;
 		int render_to_texture_buffer;
 		int shader_pool_size;
 		int ssao_num_of_samples;
+		bool atm_scattering_lut_cache;
 		bool csm_face_culling;
 		bool csm_front_face_culling;
+		bool csm_static_caster_caching;
 		bool depth_test;
+		bool dynamic_resolution;
 		bool face_culling;
 		bool fxaa_enabled;
+		bool gbuffer_thin_layout;
 		bool msaa_enabled;
+		bool occlusion_culling;
+		bool shader_binary_cache;
 		bool stochastic_sampling_seam_fix;
 	};
 	struct ScriptVariables
@@ -1642,8 +1788,10 @@ public:
 			modelViewProjectionMatUniform = "MVP";
 			transposeViewMatUniform = "transposeViewMat";
 			transposeInverseViewMatUniform = "transposeInverseViewMat";
+			inverseViewProjectionMatUniform = "inverseViewProjMat";
 			screenSizeUniform = "screenSize";
 			inverseScreenSizeUniform = "inverseScreenSize";
+			renderScaleUniform = "renderScale";
 			screenNumOfPixelsUniform = "screenNumOfPixels";
 			deltaTimeMSUniform = "deltaTimeMS";
 			deltaTimeSUniform = "deltaTimeS";
@@ -1763,6 +1911,7 @@ public:
 			define_fxaa_edge_threshold_max = "FXAA_EDGE_THRESHOLD_MAX";
 			define_fxaa_iterations = "FXAA_ITERATIONS";
 			define_fxaa_subpixel_quality = "FXAA_SUBPIXEL_QUALITY";
+			define_gbufferThinLayout = "GBUFFER_THIN_LAYOUT";
 			define_maxNumOfPointLights = "MAX_NUM_POINT_LIGHTS";
 			define_maxNumOfSpotLights = "MAX_NUM_SPOT_LIGHTS";
 			define_normalMapCompression = "NORMAL_MAP_COMPRESSION";
@@ -1786,8 +1935,10 @@ public:
 		std::string modelViewProjectionMatUniform;
 		std::string transposeViewMatUniform;
 		std::string transposeInverseViewMatUniform;
+		std::string inverseViewProjectionMatUniform;
 		std::string screenSizeUniform;
 		std::string inverseScreenSizeUniform;
+		std::string renderScaleUniform;
 		std::string screenNumOfPixelsUniform;
 		std::string deltaTimeMSUniform;
 		std::string deltaTimeSUniform;
@@ -1908,6 +2059,7 @@ public:
 		std::string define_fxaa_edge_threshold_max;
 		std::string define_fxaa_iterations;
 		std::string define_fxaa_subpixel_quality;
+		std::string define_gbufferThinLayout;
 		std::string define_maxNumOfPointLights;
 		std::string define_maxNumOfSpotLights;
 		std::string define_normalMapCompression;
@@ -1949,6 +2101,7 @@ public:
 			texture_compression_format_rgb = TextureDataFormat::TextureDataFormat_COMPRESSED_BPTC_RGBA;
 			texture_compression_format_rgba = TextureDataFormat::TextureDataFormat_COMPRESSED_BPTC_RGBA;
 			texture_compression_format_normal = TextureDataFormat::TextureDataFormat_COMPRESSED_RGTC2_RG;
+			texture_cpu_residency_policy = AssetResidencyPolicy::AssetResidencyPolicy_ReleaseAfterUpload;
 			texture_downsample_max_resolution = 1024;
 			texture_downsample_scale = 1;
 			generate_mipmaps = true;
@@ -1981,6 +2134,7 @@ public:
 		int texture_compression_format_rgb;
 		int texture_compression_format_rgba;
 		int texture_compression_format_normal;
+		int texture_cpu_residency_policy;
 		int texture_downsample_scale;
 		int texture_downsample_max_resolution;
 		bool generate_mipmaps;
@@ -2054,6 +2208,8 @@ public:
 	// Register all config variables, so we can search through them later
 	static void init();
 	static ErrorCode loadFromFile(const std::string &p_filename);
+	// Loads variables from command line arguments, given as "name value" pairs, the same way as in the config file
+	static ErrorCode loadFromArguments(const int p_argc, char *p_argv[]);
 	static ErrorCode saveToFile(const std::string &p_filename);
 
 private:
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Config.h"
+#include "DynamicResolution.h"
+
+DynamicResolution::DynamicResolution()
+{
+	for(unsigned int i = 0; i < m_numOfQueries; i++)
+		m_queries[i] = 0;
+
+	m_queryHead = 0;
+	m_queryTail = 0;
+	m_numOfPendingQueries = 0;
+	m_queryActive = false;
+	m_initialized = false;
+	m_renderScale = 1.0f;
+	m_frameTime = 0.0f;
+	m_GPUTime = 0.0f;
+}
+
+DynamicResolution::~DynamicResolution()
+{
+}
+
+void DynamicResolution::init()
+{
+	// Make sure the queries are only created once
+	release();
+
+	glGenQueries(m_numOfQueries, m_queries);
+
+	m_initialized = true;
+
+	reset();
+}
+
+void DynamicResolution::release()
+{
+	if(m_initialized)
+	{
+		if(m_queryActive)
+			glEndQuery(GL_TIME_ELAPSED);
+
+		glDeleteQueries(m_numOfQueries, m_queries);
+
+		for(unsigned int i = 0; i < m_numOfQueries; i++)
+			m_queries[i] = 0;
+
+		m_initialized = false;
+	}
+
+	m_queryHead = 0;
+	m_queryTail = 0;
+	m_numOfPendingQueries = 0;
+	m_queryActive = false;
+}
+
+void DynamicResolution::beginFrame()
+{
+	// Skip measuring this frame if all the queries are still in flight
+	if(!m_initialized || m_queryActive || m_numOfPendingQueries == m_numOfQueries)
+		return;
+
+	glBeginQuery(GL_TIME_ELAPSED, m_queries[m_queryHead]);
+	m_queryActive = true;
+}
+
+void DynamicResolution::endFrame()
+{
+	if(!m_queryActive)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	m_queryActive = false;
+
+	m_queryHead = (m_queryHead + 1) % m_numOfQueries;
+	m_numOfPendingQueries++;
+}
+
+float DynamicResolution::update(const float p_deltaTime)
+{
+	const float minScale = std::clamp(Config::rendererVar().dynamic_resolution_min_scale, 0.1f, 1.0f);
+	const float maxScale = std::clamp(Config::rendererVar().dynamic_resolution_max_scale, minScale, 1.0f);
+	const float targetFrameTime = Config::rendererVar().dynamic_resolution_target_frame_time;
+
+	// Smooth the CPU frame time
+	const float frameTime = p_deltaTime * 1000.0f;
+	m_frameTime = m_frameTime > 0.0f ? m_frameTime + (frameTime - m_frameTime) * m_smoothingFactor : frameTime;
+
+	readQueryResults();
+
+	// Only the GPU time depends on the rendering resolution, so the CPU frame time is only used when the GPU time is not available
+	const float measuredTime = m_GPUTime > 0.0f ? m_GPUTime : m_frameTime;
+
+	if(measuredTime > 0.0f && targetFrameTime > 0.0f)
+	{
+		const float lowerTargetFrameTime = targetFrameTime * (1.0f - std::clamp(Config::rendererVar().dynamic_resolution_headroom, 0.0f, 0.9f));
+
+		if(measuredTime > targetFrameTime || measuredTime < lowerTargetFrameTime)
+		{
+			// Aim for the middle of the target range; the number of pixels (and the rendering cost) is proportional to the square of the scale
+			const float desiredScale = m_renderScale * std::sqrt(((targetFrameTime + lowerTargetFrameTime) * 0.5f) / measuredTime);
+
+			m_renderScale += (desiredScale - m_renderScale) * std::clamp(Config::rendererVar().dynamic_resolution_adjust_rate, 0.0f, 1.0f);
+		}
+	}
+
+	m_renderScale = std::clamp(m_renderScale, minScale, maxScale);
+
+	return m_renderScale;
+}
+
+void DynamicResolution::reset()
+{
+	m_renderScale = std::clamp(Config::rendererVar().dynamic_resolution_max_scale, 0.1f, 1.0f);
+	m_frameTime = 0.0f;
+	m_GPUTime = 0.0f;
+}
+
+void DynamicResolution::readQueryResults()
+{
+	while(m_numOfPendingQueries > 0)
+	{
+		GLint resultAvailable = 0;
+		glGetQueryObjectiv(m_queries[m_queryTail], GL_QUERY_RESULT_AVAILABLE, &resultAvailable);
+
+		if(resultAvailable == 0)
+			break;
+
+		GLuint64 elapsedTime = 0;
+		glGetQueryObjectui64v(m_queries[m_queryTail], GL_QUERY_RESULT, &elapsedTime);
+
+		m_queryTail = (m_queryTail + 1) % m_numOfQueries;
+		m_numOfPendingQueries--;
+
+		// Convert from nanoseconds to milliseconds and smooth it
+		const float GPUTime = (float)((double)elapsedTime / 1000000.0);
+		m_GPUTime = m_GPUTime > 0.0f ? m_GPUTime + (GPUTime - m_GPUTime) * m_smoothingFactor : GPUTime;
+	}
+}
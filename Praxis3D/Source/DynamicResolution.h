@@ -0,0 +1,61 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Adjusts the scale of the rendering resolution, so that the frame time stays close to the target frame time.
+// Frame time is measured on the GPU with timer queries, that are only read once their results are available (a few frames later),
+// so the CPU never waits for the GPU; if no GPU time has been measured, the CPU frame time is used instead.
+// The cost of rendering is roughly proportional to the number of pixels, so the scale is moved towards the square root of the time ratio;
+// it is only changed when the frame time leaves the [target - headroom, target] range, so the resolution doesn't fluctuate every frame
+class DynamicResolution
+{
+public:
+	DynamicResolution();
+	~DynamicResolution();
+
+	// Create the timer queries; must be called on the thread that owns the GL context
+	void init();
+
+	// Delete the timer queries
+	void release();
+
+	// Start and stop measuring the GPU time of the frame; every GPU command of the frame must be issued between them
+	void beginFrame();
+	void endFrame();
+
+	// Read the available GPU times and adjust the render scale; returns the new render scale
+	float update(const float p_deltaTime);
+
+	// Returns the render scale to the maximum scale, and discards the measured times (e.g. when dynamic resolution gets disabled)
+	void reset();
+
+	inline float getRenderScale() const { return m_renderScale; }
+
+	// Smoothed frame times, in milliseconds
+	inline float getFrameTime() const { return m_frameTime; }
+	inline float getGPUTime() const { return m_GPUTime; }
+
+private:
+	// Read the results of all the finished timer queries, in the order they were issued; never waits for the GPU
+	void readQueryResults();
+
+	// Number of timer queries in flight; results are usually available two to three frames after the query was issued
+	static constexpr unsigned int m_numOfQueries = 4;
+
+	// Weight of a new measurement in the smoothed frame times
+	static constexpr float m_smoothingFactor = 0.1f;
+
+	GLuint m_queries[m_numOfQueries];
+
+	// Index of the next query to be issued, and of the oldest query that hasn't been read yet
+	unsigned int m_queryHead;
+	unsigned int m_queryTail;
+	unsigned int m_numOfPendingQueries;
+
+	bool m_queryActive;
+	bool m_initialized;
+
+	float m_renderScale;
+	float m_frameTime;
+	float m_GPUTime;
+};
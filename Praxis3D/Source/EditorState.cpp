@@ -69,6 +69,12 @@ void EditorState::update(Engine &p_engine)
 	m_objectChangeController->distributeChanges();
 	m_sceneChangeController->distributeChanges();
 
+	m_sceneLoader.processSaveRequest();
+
+	m_sceneLoader.updateWorldStreaming();
+
+	captureRenderSnapshot();
+
 	updateSceneLoadingStatus();
 }
 
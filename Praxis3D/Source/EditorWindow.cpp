@@ -6,11 +6,15 @@
 #define IMSPINNER_DEMO
 #include "EngineDefinitions.h"
 #include "EditorWindow.h"
+#include "FrameAllocator.h"
+#include "MemoryTracker.h"
 #include "imgui_internal.h"
 #include "ImGuizmo.h"
 #include "imspinner.h"
+#include "Profiler.h"
 #include "RendererScene.h"
 #include "ShaderUniformUpdater.h"
+#include "ShadowMappingPass.h"
 #include "WorldScene.h"
 
 // Include every component
@@ -95,9 +99,8 @@ void EditorWindow::update(const float p_deltaTime)
             m_nextEntityToSelect = nullptr;
         }
 
-        for(decltype(m_entityList.size()) size = m_entityList.size(), i = 0; i < size; i++)
-            if(m_entityList[i].m_entityID == m_nextEntityIDToSelect)
-                m_selectedEntity.setEntity(m_entityList[i].m_entityID);
+        if(m_entityListIndex.contains(m_nextEntityIDToSelect))
+            m_selectedEntity.setEntity(m_nextEntityIDToSelect);
 
         m_pendingEntityToSelect = false;
     }
@@ -735,16 +738,8 @@ void EditorWindow::update(const float p_deltaTime)
 
                                 // Assign a next available entity ID (start the available ID search from the next ID after the parent)
                                 EntityID newEntityID = m_newEntityConstructionInfo->m_parent + 1;
-                                for(decltype(m_entityList.size()) i = 0, size = m_entityList.size(); i < size;)
-                                {
-                                    if(newEntityID == m_entityList[i].m_entityID)
-                                    {
-                                        newEntityID++;
-                                        i = 0;
-                                    }
-                                    else
-                                        i++;
-                                }
+                                while(m_entityListIndex.contains(newEntityID))
+                                    newEntityID++;
                                 m_newEntityConstructionInfo->m_id = newEntityID;
 
                                 // Assign a next available entity name
@@ -994,13 +989,18 @@ void EditorWindow::update(const float p_deltaTime)
                 }
                 if(ImGui::BeginTabItem("Entities"))
                 {
-                    // Draw every entry from the entities list
-                    for(decltype(m_entityList.size()) size = m_entityList.size(), i = 0; i < size; i++)
+                    // Draw only the visible entries from the entities list
+                    ImGuiListClipper entityListClipper;
+                    entityListClipper.Begin((int)m_entityList.size());
+                    while(entityListClipper.Step())
                     {
-                        // Highlight the previously selected item and set the currently selected item if it is clicked on
-                        if(ImGui::Selectable(m_entityList[i].m_combinedEntityIdAndName.c_str(), m_entityList[i].m_entityID == m_selectedEntity.m_entityID))
+                        for(int i = entityListClipper.DisplayStart; i < entityListClipper.DisplayEnd; i++)
                         {
-                            m_selectedEntity.setEntity(m_entityList[i].m_entityID);
+                            // Highlight the previously selected item and set the currently selected item if it is clicked on
+                            if(ImGui::Selectable(m_entityList[i].m_combinedEntityIdAndName.c_str(), m_entityList[i].m_entityID == m_selectedEntity.m_entityID))
+                            {
+                                m_selectedEntity.setEntity(m_entityList[i].m_entityID);
+                            }
                         }
                     }
 
@@ -1008,14 +1008,19 @@ void EditorWindow::update(const float p_deltaTime)
                 }
                 if(ImGui::BeginTabItem("Components"))
                 {
-                    // Draw every entry from the component list
-                    for(decltype(m_componentList.size()) size = m_componentList.size(), i = 0; i < size; i++)
+                    // Draw only the visible entries from the component list
+                    ImGuiListClipper componentListClipper;
+                    componentListClipper.Begin((int)m_componentList.size());
+                    while(componentListClipper.Step())
                     {
-                        // Highlight all the components that belong to the previously selected entity 
-                        // and set the currently selected entity to an entity that the component belongs to (if it is clicked on)
-                        if(ImGui::Selectable(m_componentList[i].m_combinedEntityIdAndName.c_str(), m_componentList[i].m_entityID == m_selectedEntity.m_entityID))
+                        for(int i = componentListClipper.DisplayStart; i < componentListClipper.DisplayEnd; i++)
                         {
-                            m_selectedEntity.setEntity(m_componentList[i].m_entityID);
+                            // Highlight all the components that belong to the previously selected entity 
+                            // and set the currently selected entity to an entity that the component belongs to (if it is clicked on)
+                            if(ImGui::Selectable(m_componentList[i].m_combinedEntityIdAndName.c_str(), m_componentList[i].m_entityID == m_selectedEntity.m_entityID))
+                            {
+                                m_selectedEntity.setEntity(m_componentList[i].m_entityID);
+                            }
                         }
                     }
 
@@ -1091,6 +1096,9 @@ void EditorWindow::update(const float p_deltaTime)
                                     {
                                         // If the prefab name was changed, send a notification to the Metadata Component
                                         m_systemScene->getSceneLoader()->getChangeController()->sendChange(this, metadataComponent, Systems::Changes::Generic::Name);
+
+                                        // Renames do not go through the entity registry, so mark the entity list entry to be updated next frame, after the change has been applied
+                                        m_entityListChanges.push_back(m_selectedEntity.m_entityID);
                                     }
 
                                     // Draw PREFAB
@@ -3272,6 +3280,14 @@ void EditorWindow::update(const float p_deltaTime)
                         drawLeftAlignedLabelText("Object loads per frame:", inputWidgetOffset, ImGui::GetContentRegionAvail().x - inputWidgetOffset);
                         ImGui::InputInt("##ObjectsLoadedPerFrameInput", &Config::m_rendererVar.objects_loaded_per_frame);
 
+                        // Draw UPLOAD BYTES PER FRAME
+                        drawLeftAlignedLabelText("Upload bytes per frame:", inputWidgetOffset, ImGui::GetContentRegionAvail().x - inputWidgetOffset);
+                        ImGui::InputInt("##UploadBytesPerFrameInput", &Config::m_rendererVar.gpu_upload_max_bytes_per_frame);
+
+                        // Draw UPLOAD TIME PER FRAME
+                        drawLeftAlignedLabelText("Upload time per frame (us):", inputWidgetOffset, ImGui::GetContentRegionAvail().x - inputWidgetOffset);
+                        ImGui::InputFloat("##UploadTimePerFrameInput", &Config::m_rendererVar.gpu_upload_max_time_per_frame_us);
+
                         ImGui::NewLine();
 
                         ImGui::PopStyleVar(); //ImGuiStyleVar_SeparatorTextAlign
@@ -3281,6 +3297,62 @@ void EditorWindow::update(const float p_deltaTime)
                     ImGui::EndTabItem();
                 }
 
+                if(ImGui::BeginTabItem("Memory"))
+                {
+                    ImGui::Text("Total system memory: %s, total video memory: %s (video memory sizes are estimates), system memory released after upload: %s", 
+                        getMemorySizeString(MemoryTracker::getTotalUsage(MemoryType_RAM)).c_str(), 
+                        getMemorySizeString(MemoryTracker::getTotalUsage(MemoryType_VRAM)).c_str(),
+                        getMemorySizeString(MemoryTracker::getTotalSavedUsage()).c_str());
+
+                    if(ImGui::BeginTable("##BottomMemoryTable", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+                    {
+                        ImGui::TableSetupColumn("Tag");
+                        ImGui::TableSetupColumn("System memory");
+                        ImGui::TableSetupColumn("System memory peak");
+                        ImGui::TableSetupColumn("Video memory");
+                        ImGui::TableSetupColumn("Video memory peak");
+                        ImGui::TableSetupColumn("Released after upload");
+                        ImGui::TableSetupColumn("Budget");
+                        ImGui::TableHeadersRow();
+
+                        for(unsigned int i = 0; i < MemoryTag_NumOfTags; i++)
+                        {
+                            const MemoryTag memoryTag = static_cast<MemoryTag>(i);
+                            const int64_t memoryBudget = MemoryTracker::getBudget(memoryTag);
+
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::Text(MemoryTracker::getTagName(memoryTag));
+                            ImGui::TableNextColumn();
+                            ImGui::Text(getMemorySizeString(MemoryTracker::getUsage(memoryTag, MemoryType_RAM)).c_str());
+                            ImGui::TableNextColumn();
+                            ImGui::Text(getMemorySizeString(MemoryTracker::getPeakUsage(memoryTag, MemoryType_RAM)).c_str());
+                            ImGui::TableNextColumn();
+                            ImGui::Text(getMemorySizeString(MemoryTracker::getUsage(memoryTag, MemoryType_VRAM)).c_str());
+                            ImGui::TableNextColumn();
+                            ImGui::Text(getMemorySizeString(MemoryTracker::getPeakUsage(memoryTag, MemoryType_VRAM)).c_str());
+                            ImGui::TableNextColumn();
+                            ImGui::Text(getMemorySizeString(MemoryTracker::getSavedUsage(memoryTag)).c_str());
+                            ImGui::TableNextColumn();
+
+                            // Highlight the budget of tags that are over it
+                            if(memoryBudget > 0)
+                            {
+                                if(MemoryTracker::isOverBudget(memoryTag))
+                                    ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), getMemorySizeString(memoryBudget).c_str());
+                                else
+                                    ImGui::Text(getMemorySizeString(memoryBudget).c_str());
+                            }
+                            else
+                                ImGui::Text("None");
+                        }
+
+                        ImGui::EndTable();
+                    }
+
+                    ImGui::EndTabItem();
+                }
+
                 ImGui::EndTabBar();
             }
         }
@@ -3352,6 +3424,11 @@ void EditorWindow::update(const float p_deltaTime)
                             ImGui::Text(m_textureAssets[i].first->isLoadedToMemory() ? "Loaded to system memory: true" : "Loaded to system memory: false");
                             ImGui::Text(m_textureAssets[i].first->isLoadedToVideoMemory() ? "Loaded to video memory: true" : "Loaded to video memory: false");
 
+                            ImGui::Text(("System memory size: " + getMemorySizeString(m_textureAssets[i].first->getMemorySize(MemoryType_RAM))).c_str());
+                            ImGui::Text(("Video memory size: " + getMemorySizeString(m_textureAssets[i].first->getMemorySize(MemoryType_VRAM))).c_str());
+                            if(m_textureAssets[i].first->isCPUDataReleased())
+                                ImGui::Text(("Released after upload: " + getMemorySizeString(m_textureAssets[i].first->getSavedMemorySize())).c_str());
+
                             ImGui::Separator();
 
                             ImGui::EndTooltip();
@@ -3393,6 +3470,18 @@ void EditorWindow::update(const float p_deltaTime)
                             {
                                 m_selectedModel = m_modelAssets[i].first;
                             }
+
+                            // Show the tool tip with the memory information of the model (if the mouse is hovered over it)
+                            if(ImGui::BeginItemTooltip())
+                            {
+                                ImGui::Text(("Referene counter: " + Utilities::toString(m_modelAssets[i].first->getReferenceCounter())).c_str());
+                                ImGui::Text(("System memory size: " + getMemorySizeString(m_modelAssets[i].first->getMemorySize(MemoryType_RAM))).c_str());
+                                ImGui::Text(("Video memory size: " + getMemorySizeString(m_modelAssets[i].first->getMemorySize(MemoryType_VRAM))).c_str());
+                                if(m_modelAssets[i].first->isCPUDataReleased())
+                                    ImGui::Text(("Released after upload: " + getMemorySizeString(m_modelAssets[i].first->getSavedMemorySize())).c_str());
+
+                                ImGui::EndTooltip();
+                            }
                         }
                     }
                     ImGui::EndChild();
@@ -4042,6 +4131,107 @@ void EditorWindow::update(const float p_deltaTime)
                     ImGui::EndTabItem();
                 }
 
+                if(ImGui::BeginTabItem("Profiler"))
+                {
+                    // Draw profiler controls
+                    bool profilerEnabled = Profiler::isEnabled();
+                    if(ImGui::Checkbox("Enabled##ProfilerEnabled", &profilerEnabled))
+                        Profiler::setEnabled(profilerEnabled);
+
+                    ImGui::SameLine();
+                    bool profilerPaused = Profiler::isPaused();
+                    if(ImGui::Checkbox("Pause##ProfilerPaused", &profilerPaused))
+                        Profiler::setPaused(profilerPaused);
+
+                    ImGui::SameLine();
+                    if(ImGui::Button("Export Chrome trace"))
+                    {
+                        ErrorCode traceError = Profiler::exportChromeTrace(Config::engineVar().profiler_trace_filename);
+                        if(traceError == ErrorCode::Success)
+                            ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_GUIEditor, "Profiler trace exported to \"" + Config::engineVar().profiler_trace_filename + "\"");
+                        else
+                            ErrHandlerLoc::get().log(traceError, Config::engineVar().profiler_trace_filename, ErrorSource::Source_GUIEditor);
+                    }
+
+                    const auto &profilerZones = Profiler::getLastFrameZones();
+                    const int64_t frameStartTicks = Profiler::getLastFrameStartTicks();
+                    const int64_t frameDurationTicks = std::max(Profiler::getLastFrameEndTicks() - frameStartTicks, (int64_t)1);
+
+                    // Heap allocations are only counted when the counting is compiled in
+#if SETTING_HEAP_ALLOCATION_COUNTING
+                    const std::string heapAllocations = Utilities::toString((int)FrameAllocator::getLastFrameNumOfHeapAllocations());
+#else
+                    const std::string heapAllocations = "n/a";
+#endif
+
+                    ImGui::SameLine();
+                    ImGui::Text("Frame time: %.3f ms, zones: %i, heap allocations: %s, frame arena high-water mark: %.1f KB, shadow cascade re-renders: %i", 
+                        Profiler::ticksToMilliseconds(frameDurationTicks), 
+                        (int)profilerZones.size(), 
+                        heapAllocations.c_str(), 
+                        (double)FrameAllocator::getHighWaterMark() / 1024.0,
+                        (int)ShadowMappingPass::getLastFrameNumOfCascadeReRenders());
+
+                    if(ImGui::BeginChild("##BottomProfilerWindow", ImVec2(0.0f, 0.0f), true, ImGuiWindowFlags_::ImGuiWindowFlags_None))
+                    {
+                        // Get the deepest zone of each thread, to calculate the height of each thread row
+                        std::vector<unsigned int> threadDepth(Profiler::getNumberOfThreads(), 0);
+                        for(const auto &zone : profilerZones)
+                            if(zone.m_threadIndex < threadDepth.size())
+                                threadDepth[zone.m_threadIndex] = std::max(threadDepth[zone.m_threadIndex], zone.m_depth + 1);
+
+                        // Calculate the vertical offset of each thread row
+                        const float zoneHeight = ImGui::GetTextLineHeightWithSpacing();
+                        std::vector<float> threadOffset(threadDepth.size(), 0.0f);
+                        float flameViewHeight = 0.0f;
+                        for(decltype(threadDepth.size()) i = 0, size = threadDepth.size(); i < size; i++)
+                        {
+                            threadOffset[i] = flameViewHeight;
+                            if(threadDepth[i] > 0)
+                                flameViewHeight += threadDepth[i] * zoneHeight + m_imguiStyle.ItemSpacing.y;
+                        }
+
+                        const ImVec2 flameViewPosition = ImGui::GetCursorScreenPos();
+                        const float flameViewWidth = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+                        ImDrawList *drawList = ImGui::GetWindowDrawList();
+
+                        // Draw each zone as a bar, positioned horizontally by its time within the frame, and vertically by its thread and depth
+                        for(const auto &zone : profilerZones)
+                        {
+                            if(zone.m_threadIndex >= threadOffset.size())
+                                continue;
+
+                            const float startX = flameViewPosition.x + flameViewWidth * (float)((double)(zone.m_startTicks - frameStartTicks) / (double)frameDurationTicks);
+                            const float endX = flameViewPosition.x + flameViewWidth * (float)((double)(zone.m_endTicks - frameStartTicks) / (double)frameDurationTicks);
+                            const ImVec2 zoneMin(startX, flameViewPosition.y + threadOffset[zone.m_threadIndex] + zone.m_depth * zoneHeight);
+                            const ImVec2 zoneMax(std::max(endX, startX + 1.0f), zoneMin.y + zoneHeight - 1.0f);
+
+                            // Pick the zone color based on its name, so the same zone keeps the same color every frame
+                            const size_t nameHash = std::hash<std::string_view>{}(zone.m_name);
+                            const ImU32 zoneColor = ImGui::ColorConvertFloat4ToU32(ImVec4(
+                                0.3f + 0.5f * (float)((nameHash >> 0) & 0xFF) / 255.0f,
+                                0.3f + 0.5f * (float)((nameHash >> 8) & 0xFF) / 255.0f,
+                                0.3f + 0.5f * (float)((nameHash >> 16) & 0xFF) / 255.0f,
+                                1.0f));
+
+                            drawList->AddRectFilled(zoneMin, zoneMax, zoneColor);
+
+                            // Draw the zone name only if it fits inside the bar
+                            if(ImGui::CalcTextSize(zone.m_name).x < zoneMax.x - zoneMin.x)
+                                drawList->AddText(ImVec2(zoneMin.x + 1.0f, zoneMin.y), IM_COL32(0, 0, 0, 255), zone.m_name);
+
+                            if(ImGui::IsWindowHovered() && ImGui::IsMouseHoveringRect(zoneMin, zoneMax))
+                                ImGui::SetTooltip("%s\nThread: %u\nDuration: %.3f ms", zone.m_name, zone.m_threadIndex, Profiler::ticksToMilliseconds(zone.m_endTicks - zone.m_startTicks));
+                        }
+
+                        // Reserve the space taken by the flame view, so the child window can be scrolled
+                        ImGui::Dummy(ImVec2(flameViewWidth, flameViewHeight));
+                    }
+                    ImGui::EndChild();
+
+                    ImGui::EndTabItem();
+                }
+
                 ImGui::EndTabBar();
             }
         }
@@ -4482,8 +4672,8 @@ void EditorWindow::update(const float p_deltaTime)
                             // Get the filename path in the Maps directory
                             auto filename = m_fileBrowserDialog.m_filePathName.substr(currentDirectory.size());
 
-                            // Save the scene to the chosen file
-                            m_systemScene->getSceneLoader()->saveToFile(filename);
+                            // Save the scene to the chosen file, at the end of the frame
+                            m_systemScene->getSceneLoader()->requestSaveToFile(filename);
 
                             // Send a notification to the editor state of a changed scene filename
                             m_systemScene->getSceneLoader()->getChangeController()->sendEngineChange(EngineChangeData(EngineChangeType::EngineChangeType_SceneFilename, EngineStateType::EngineStateType_Editor, filename));
@@ -5174,7 +5364,10 @@ void EditorWindow::drawSceneData(SceneData &p_sceneData, const bool p_sendChange
 
         // Draw SUN SIZE
         drawLeftAlignedLabelText("Sun size:", inputWidgetOffset);
-        if(ImGui::DragFloat("##AtmSunSizeDrag", &p_sceneData.m_atmScatteringData.m_sunSize, 0.00001f, 0.0f, 10.0f, "%.5f") && p_sendChanges)
+        ImGui::DragFloat("##AtmSunSizeDrag", &p_sceneData.m_atmScatteringData.m_sunSize, 0.00001f, 0.0f, 10.0f, "%.5f");
+
+        // Changing the sun size recomputes the precomputed atmosphere textures, so only send the change once the editing is finished, instead of every drag step
+        if(ImGui::IsItemDeactivatedAfterEdit() && p_sendChanges)
         {
             atmScatteringDataChanged = true;
         }
@@ -5561,9 +5754,28 @@ void EditorWindow::drawEntityHierarchyEntry(EntityHierarchyEntry *p_entityEntry)
 
         ImGui::PopStyleVar(); // ImGuiStyleVar_FramePadding
 
-        for(decltype(p_entityEntry->m_children.size()) size = p_entityEntry->m_children.size(), i = 0; i < size; i++)
+        for(decltype(p_entityEntry->m_children.size()) size = p_entityEntry->m_children.size(), i = 0; i < size;)
         {
-            drawEntityHierarchyEntry(p_entityEntry->m_children[i]);
+            // Entries with children can be expanded to any height, so they are always drawn
+            if(p_entityEntry->m_children[i]->containsChildren())
+            {
+                drawEntityHierarchyEntry(p_entityEntry->m_children[i]);
+                i++;
+                continue;
+            }
+
+            // Consecutive leaf entries are all one row high, so only draw the ones that are visible
+            auto leafEntriesEnd = i;
+            while(leafEntriesEnd < size && !p_entityEntry->m_children[leafEntriesEnd]->containsChildren())
+                leafEntriesEnd++;
+
+            ImGuiListClipper leafEntriesClipper;
+            leafEntriesClipper.Begin((int)(leafEntriesEnd - i));
+            while(leafEntriesClipper.Step())
+                for(int leafIndex = leafEntriesClipper.DisplayStart; leafIndex < leafEntriesClipper.DisplayEnd; leafIndex++)
+                    drawEntityHierarchyEntry(p_entityEntry->m_children[i + leafIndex]);
+
+            i = leafEntriesEnd;
         }
 
         ImGui::TreePop();
@@ -5838,7 +6050,7 @@ void EditorWindow::processMainMenuButton(MainMenuButtonType &p_mainMenuButtonTyp
                     }
                     else
                     {
-                        m_systemScene->getSceneLoader()->saveToFile(m_systemScene->getSceneLoader()->getSceneFilename());
+                        m_systemScene->getSceneLoader()->requestSaveToFile(m_systemScene->getSceneLoader()->getSceneFilename());
                     }
                 }
             }
@@ -6034,6 +6246,61 @@ void EditorWindow::updateSceneData(SceneData &p_sceneData)
 }
 
 void EditorWindow::updateEntityList()
+{
+    auto *worldScene = static_cast<WorldScene *>(m_systemScene->getSceneLoader()->getSystemScene(Systems::World));
+
+    // Get the entities that were created, changed or removed since the last frame
+    const bool changesOverflowed = worldScene->getEntityChanges(m_entityListChanges);
+
+    // Rebuild the whole list on the first update, or if there were too many changes to be tracked
+    if(!m_entityListInitialized || changesOverflowed)
+    {
+        rebuildEntityList();
+        m_entityListChanges.clear();
+        m_entityListInitialized = true;
+        m_componentListRebuildRequired = true;
+        return;
+    }
+
+    if(m_entityListChanges.empty())
+        return;
+
+    // Remove the duplicate changes, so each changed entity is only processed once
+    std::sort(m_entityListChanges.begin(), m_entityListChanges.end());
+    m_entityListChanges.erase(std::unique(m_entityListChanges.begin(), m_entityListChanges.end()), m_entityListChanges.end());
+
+    // Remove the old entries of all changed entities
+    std::erase_if(m_entityList, [&](const EntityListEntry &p_entry) -> bool { return std::binary_search(m_entityListChanges.begin(), m_entityListChanges.end(), p_entry.m_entityID); });
+
+    // Add the new entries of the changed entities that still exist at the end of the list
+    auto &entityRegistry = worldScene->getEntityRegistry();
+    const auto numOfUnchangedEntries = m_entityList.size();
+    for(const auto entity : m_entityListChanges)
+    {
+        if(!entityRegistry.valid(entity))
+            continue;
+
+        if(auto metadataComponent = entityRegistry.try_get<MetadataComponent>(entity); metadataComponent != nullptr)
+        {
+            std::string entityIdPlusName = metadataComponent->getName() + " (" + Utilities::toString(entity) + ")";
+            m_entityList.emplace_back(entity, metadataComponent->getParentEntityID(), metadataComponent->getName(), entityIdPlusName);
+        }
+    }
+
+    // Pass the changed entities to the component list, so only their components are updated
+    m_componentListChanges.insert(m_componentListChanges.end(), m_entityListChanges.begin(), m_entityListChanges.end());
+    m_entityListChanges.clear();
+
+    // Sort only the new entries, and merge them into the already sorted list
+    const auto compareEntries = [](const EntityListEntry &p_a, const EntityListEntry &p_b) -> bool { return p_a.m_name < p_b.m_name; };
+    std::sort(m_entityList.begin() + numOfUnchangedEntries, m_entityList.end(), compareEntries);
+    std::inplace_merge(m_entityList.begin(), m_entityList.begin() + numOfUnchangedEntries, m_entityList.end(), compareEntries);
+
+    updateEntityListIndex();
+    m_hierarchyListDirty = true;
+}
+
+void EditorWindow::rebuildEntityList()
 {
     // Make sure to clear old entity list entries
     m_entityList.clear();
@@ -6058,18 +6325,37 @@ void EditorWindow::updateEntityList()
     // Sort the list based on entity name, so they are shown more conveniently
     std::sort(m_entityList.begin(), m_entityList.end(),
         [](const EntityListEntry &p_a, const EntityListEntry &p_b) -> bool { return p_a.m_name < p_b.m_name; });
+
+    updateEntityListIndex();
+    m_hierarchyListDirty = true;
+}
+
+void EditorWindow::updateEntityListIndex()
+{
+    m_entityListIndex.clear();
+    m_entityListIndex.reserve(m_entityList.size());
+
+    for(decltype(m_entityList.size()) size = m_entityList.size(), i = 0; i < size; i++)
+        m_entityListIndex[m_entityList[i].m_entityID] = i;
 }
 
 void EditorWindow::updateHierarchyList()
 {
+    // Only rebuild the hierarchy if the entity list (or entity component types) have changed
+    if(!m_hierarchyListDirty)
+        return;
+
+    m_hierarchyListDirty = false;
+
     // Clear the old hierarchy list
     m_rootEntityHierarchyEntry.clear();
 
-    // Define a root entity flag and a temp entity list
+    // Define a root entity flag and a map of children of each parent entity
     bool rootEntryPresent = false;
-    std::list<EntityListEntry*> parentlessEntityList;
+    std::unordered_map<EntityID, std::vector<EntityListEntry *>> childrenOfParents;
+    childrenOfParents.reserve(m_entityList.size());
 
-    // Find the root entity and add all non-root entities to the temp entity list
+    // Find the root entity and add all non-root entities as children of their parents (in the same order as the sorted entity list)
     for(decltype(m_entityList.size()) size = m_entityList.size(), i = 0; i < size; i++)
     {
         if(m_entityList[i].m_entityID == 0 && m_entityList[i].m_parentEntityID == 0)
@@ -6079,61 +6365,45 @@ void EditorWindow::updateHierarchyList()
         }
         else
         {
-            parentlessEntityList.push_back(&m_entityList[i]);
+            childrenOfParents[m_entityList[i].m_parentEntityID].push_back(&m_entityList[i]);
         }
     }
 
     // Check if the root entity is present
     if(rootEntryPresent)
     {
-        // Define a list that hold all the children that have been added during the last loop
-        // and add the root entity to it
-        std::vector<EntityHierarchyEntry*> newlyAddedChildren;
+        // Starting from the root entity, add the children of each newly added entry, until there are no new entries left
+        decltype(m_entityList.size()) numOfAddedChildren = 0;
+        std::vector<EntityHierarchyEntry *> newlyAddedChildren;
         newlyAddedChildren.push_back(&m_rootEntityHierarchyEntry);
 
-        // Continue the loop until there are no newly added children
         while(!newlyAddedChildren.empty())
         {
-            // Save a copy of the children list that have been generated during the last loop
-            // and clear the children list for the current loop
-            std::vector<EntityHierarchyEntry *> newChildrenFromPreviousRun = newlyAddedChildren;
-            newlyAddedChildren.clear();
+            EntityHierarchyEntry *parentEntry = newlyAddedChildren.back();
+            newlyAddedChildren.pop_back();
 
-            // Go over each new children from the previous loop
-            for(decltype(newChildrenFromPreviousRun.size()) childrenSize = newChildrenFromPreviousRun.size(), childrenIndex = 0; childrenIndex < childrenSize; childrenIndex++)
+            if(auto children = childrenOfParents.find(parentEntry->m_entityID); children != childrenOfParents.end())
             {
-                // Go over each entity left, that haven't been added as children
-                auto parentlessEntity = parentlessEntityList.begin();
-                while(parentlessEntity != parentlessEntityList.end())
+                for(auto *child : children->second)
                 {
-                    // If the entity ID of the current child and the parent entity ID of the parent-less entity matches, add the parent-less entity as a child
-                    // if it doesn't match, continue to the next entity
-                    if(newChildrenFromPreviousRun[childrenIndex]->m_entityID == (*parentlessEntity)->m_parentEntityID)
-                    {
-                        // Add the parent-less entity as a child
-                        newChildrenFromPreviousRun[childrenIndex]->addChild((*parentlessEntity)->m_entityID, (*parentlessEntity)->m_parentEntityID, (*parentlessEntity)->m_name, (*parentlessEntity)->m_combinedEntityIdAndName, (*parentlessEntity)->m_componentFlag);
-
-                        // Add the newly created child to the child list for the next loop
-                        newlyAddedChildren.push_back(newChildrenFromPreviousRun[childrenIndex]->m_children.back());
-
-                        // Remove the former parent-less entity, as it has been added as a child
-                        parentlessEntityList.erase(parentlessEntity++);
-                    }
-                    else
-                        parentlessEntity++;
+                    parentEntry->addChild(child->m_entityID, child->m_parentEntityID, child->m_name, child->m_combinedEntityIdAndName, child->m_componentFlag);
+                    newlyAddedChildren.push_back(parentEntry->m_children.back());
+                    numOfAddedChildren++;
                 }
+
+                // Remove the children that have been added, so they are not added again
+                childrenOfParents.erase(children);
             }
         }
 
         // Check if all the entities (except root entity) have been added as children
-        if(!parentlessEntityList.empty())
+        if(numOfAddedChildren + 1 < m_entityList.size())
         {
             std::cout << "CONTAINS PARENTLESS CHILDREN:" << std::endl;
 
-            for(auto const &i : parentlessEntityList)
-            {
-                std::cout << i->m_entityID << std::endl;
-            }
+            for(auto const &children : childrenOfParents)
+                for(auto const *child : children.second)
+                    std::cout << child->m_entityID << std::endl;
         }
     }
     else
@@ -6147,104 +6417,152 @@ void EditorWindow::updateHierarchyList()
 
 void EditorWindow::updateComponentList()
 {
-    // Clear the old component list
-    m_componentList.clear();
-
     // Get the entity registry from World Scene
     auto &entityRegistry = static_cast<WorldScene *>(m_systemScene->getSceneLoader()->getSystemScene(Systems::World))->getEntityRegistry();
 
-    for(decltype(m_entityList.size()) size = m_entityList.size(), i = 0; i < size; i++)
+    const auto compareEntries = [](const ComponentListEntry &p_a, const ComponentListEntry &p_b) -> bool { return p_a.m_entityID < p_b.m_entityID; };
+
+    // Rebuild the whole list if the entity list was rebuilt
+    if(m_componentListRebuildRequired)
     {
-        // AUDIO components
-        auto soundComp = entityRegistry.try_get<SoundComponent>(m_entityList[i].m_entityID);
-        if(soundComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, soundComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + soundComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::AudioSoundComponent;
-        }
-        auto soundListenerComp = entityRegistry.try_get<SoundListenerComponent>(m_entityList[i].m_entityID);
-        if(soundListenerComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, soundListenerComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + soundListenerComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::AudioSoundListenerComponent;
-        }
+        m_componentList.clear();
+        m_componentListChanges.clear();
+        m_componentListRebuildRequired = false;
 
-        // GUI components
-        auto guiSequenceComp = entityRegistry.try_get<GUISequenceComponent>(m_entityList[i].m_entityID);
-        if(guiSequenceComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, guiSequenceComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + guiSequenceComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::GUISequenceComponent;
-        }
-        
-        // GRAPHICS components
-        auto cameraComp = entityRegistry.try_get<CameraComponent>(m_entityList[i].m_entityID);
-        if(cameraComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, cameraComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + cameraComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::GraphicsCameraComponent;
-        }
-        auto lightComp = entityRegistry.try_get<LightComponent>(m_entityList[i].m_entityID);
-        if(lightComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, lightComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + lightComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::GraphicsLightingComponent;
-        }
-        auto modelComp = entityRegistry.try_get<ModelComponent>(m_entityList[i].m_entityID);
-        if(modelComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, modelComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + modelComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::GraphicsModelComponent;
-        }
-        auto shaderComp = entityRegistry.try_get<ShaderComponent>(m_entityList[i].m_entityID);
-        if(shaderComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, shaderComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + shaderComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::GraphicsShaderComponent;
-        }
-        
-        // PHYSICS components
-        auto collisionShapeComp = entityRegistry.try_get<CollisionShapeComponent>(m_entityList[i].m_entityID);
-        if(collisionShapeComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, collisionShapeComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + collisionShapeComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::PhysicsCollisionShapeComponent;
-        }
-        auto rigidBodyComp = entityRegistry.try_get<RigidBodyComponent>(m_entityList[i].m_entityID);
-        if(rigidBodyComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, rigidBodyComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + rigidBodyComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::PhysicsRigidBodyComponent;
-        }
-        
-        // SCRIPTING components
-        auto luaComp = entityRegistry.try_get<LuaComponent>(m_entityList[i].m_entityID);
-        if(luaComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, luaComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + luaComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::ScriptingLuaComponent;
-        }
-        
-        // WORLD components
-        auto objectMaterialComp = entityRegistry.try_get<ObjectMaterialComponent>(m_entityList[i].m_entityID);
-        if(objectMaterialComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, objectMaterialComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + objectMaterialComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::WorldObjectMaterialComponent;
-        }
-        auto spatialComp = entityRegistry.try_get<SpatialComponent>(m_entityList[i].m_entityID);
-        if(spatialComp != nullptr)
-        {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, spatialComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + spatialComp->getName());
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::WorldSpatialComponent;
-        }
-        auto metadataComp = entityRegistry.try_get<MetadataComponent>(m_entityList[i].m_entityID);
-        if(metadataComp != nullptr)
+        for(decltype(m_entityList.size()) size = m_entityList.size(), i = 0; i < size; i++)
+            addComponentListEntries(m_entityList[i], entityRegistry);
+
+        // Stable sort keeps the order of components within each entity
+        std::stable_sort(m_componentList.begin(), m_componentList.end(), compareEntries);
+
+        m_hierarchyListDirty = true;
+        return;
+    }
+
+    if(m_componentListChanges.empty())
+        return;
+
+    // Remove the duplicate changes, so each changed entity is only processed once
+    std::sort(m_componentListChanges.begin(), m_componentListChanges.end());
+    m_componentListChanges.erase(std::unique(m_componentListChanges.begin(), m_componentListChanges.end()), m_componentListChanges.end());
+
+    // Remove the old entries of all changed entities
+    std::erase_if(m_componentList, [&](const ComponentListEntry &p_entry) -> bool { return std::binary_search(m_componentListChanges.begin(), m_componentListChanges.end(), p_entry.m_entityID); });
+
+    // Add the new entries of the changed entities that are still in the entity list at the end of the list
+    const auto numOfUnchangedEntries = m_componentList.size();
+    for(const auto entity : m_componentListChanges)
+    {
+        if(auto entityIndex = m_entityListIndex.find(entity); entityIndex != m_entityListIndex.end())
         {
-            m_componentList.emplace_back(m_entityList[i].m_entityID, metadataComp->getName(), Utilities::toString(m_entityList[i].m_entityID) + Config::componentVar().component_name_separator + metadataComp->getName() + Config::componentVar().component_name_separator + GetString(Properties::PropertyID::MetadataComponent));
-            m_entityList[i].m_componentFlag |= Systems::AllComponentTypes::WorldMetadataComponent;
+            // The hierarchy entries hold a copy of the component flags, so rebuild the hierarchy if they have changed
+            if(addComponentListEntries(m_entityList[entityIndex->second], entityRegistry))
+                m_hierarchyListDirty = true;
         }
     }
+    m_componentListChanges.clear();
+
+    // New entries are already ordered by entity ID (as the changes are sorted), so only merge them into the sorted list
+    std::inplace_merge(m_componentList.begin(), m_componentList.begin() + numOfUnchangedEntries, m_componentList.end(), compareEntries);
+}
+
+bool EditorWindow::addComponentListEntries(EntityListEntry &p_entityListEntry, entt::basic_registry<EntityID> &p_entityRegistry)
+{
+    const BitMask previousComponentFlag = p_entityListEntry.m_componentFlag;
+    p_entityListEntry.m_componentFlag = Systems::AllComponentTypes::None;
+
+    // AUDIO components
+    auto soundComp = p_entityRegistry.try_get<SoundComponent>(p_entityListEntry.m_entityID);
+    if(soundComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, soundComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + soundComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::AudioSoundComponent;
+    }
+    auto soundListenerComp = p_entityRegistry.try_get<SoundListenerComponent>(p_entityListEntry.m_entityID);
+    if(soundListenerComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, soundListenerComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + soundListenerComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::AudioSoundListenerComponent;
+    }
+
+    // GUI components
+    auto guiSequenceComp = p_entityRegistry.try_get<GUISequenceComponent>(p_entityListEntry.m_entityID);
+    if(guiSequenceComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, guiSequenceComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + guiSequenceComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::GUISequenceComponent;
+    }
+    
+    // GRAPHICS components
+    auto cameraComp = p_entityRegistry.try_get<CameraComponent>(p_entityListEntry.m_entityID);
+    if(cameraComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, cameraComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + cameraComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::GraphicsCameraComponent;
+    }
+    auto lightComp = p_entityRegistry.try_get<LightComponent>(p_entityListEntry.m_entityID);
+    if(lightComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, lightComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + lightComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::GraphicsLightingComponent;
+    }
+    auto modelComp = p_entityRegistry.try_get<ModelComponent>(p_entityListEntry.m_entityID);
+    if(modelComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, modelComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + modelComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::GraphicsModelComponent;
+    }
+    auto shaderComp = p_entityRegistry.try_get<ShaderComponent>(p_entityListEntry.m_entityID);
+    if(shaderComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, shaderComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + shaderComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::GraphicsShaderComponent;
+    }
+    
+    // PHYSICS components
+    auto collisionShapeComp = p_entityRegistry.try_get<CollisionShapeComponent>(p_entityListEntry.m_entityID);
+    if(collisionShapeComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, collisionShapeComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + collisionShapeComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::PhysicsCollisionShapeComponent;
+    }
+    auto rigidBodyComp = p_entityRegistry.try_get<RigidBodyComponent>(p_entityListEntry.m_entityID);
+    if(rigidBodyComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, rigidBodyComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + rigidBodyComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::PhysicsRigidBodyComponent;
+    }
+    
+    // SCRIPTING components
+    auto luaComp = p_entityRegistry.try_get<LuaComponent>(p_entityListEntry.m_entityID);
+    if(luaComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, luaComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + luaComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::ScriptingLuaComponent;
+    }
+    
+    // WORLD components
+    auto objectMaterialComp = p_entityRegistry.try_get<ObjectMaterialComponent>(p_entityListEntry.m_entityID);
+    if(objectMaterialComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, objectMaterialComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + objectMaterialComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::WorldObjectMaterialComponent;
+    }
+    auto spatialComp = p_entityRegistry.try_get<SpatialComponent>(p_entityListEntry.m_entityID);
+    if(spatialComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, spatialComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + spatialComp->getName());
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::WorldSpatialComponent;
+    }
+    auto metadataComp = p_entityRegistry.try_get<MetadataComponent>(p_entityListEntry.m_entityID);
+    if(metadataComp != nullptr)
+    {
+        m_componentList.emplace_back(p_entityListEntry.m_entityID, metadataComp->getName(), Utilities::toString(p_entityListEntry.m_entityID) + Config::componentVar().component_name_separator + metadataComp->getName() + Config::componentVar().component_name_separator + GetString(Properties::PropertyID::MetadataComponent));
+        p_entityListEntry.m_componentFlag |= Systems::AllComponentTypes::WorldMetadataComponent;
+    }
+
+    // Return true if the component flags have changed
+    return p_entityListEntry.m_componentFlag != previousComponentFlag;
 }
 
 void EditorWindow::updateAssetLists()
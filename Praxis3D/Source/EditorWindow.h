@@ -1,6 +1,7 @@
 #pragma once
 
 #include <TextEditor.h>
+#include <unordered_map>
 
 #include "ComponentConstructorInfo.h"
 #include "ErrorHandlerLocator.h"
@@ -59,6 +60,9 @@ public:
 		m_nextEntityIDToSelect = NULL_ENTITY_ID;
 		m_nextEntityToSelect = nullptr;
 		m_pendingEntityToSelect = false;
+		m_entityListInitialized = false;
+		m_hierarchyListDirty = true;
+		m_componentListRebuildRequired = true;
 
 		m_newEntityConstructionInfo = nullptr;
 		m_openNewEntityPopup = false;
@@ -589,7 +593,7 @@ private:
 	struct EntityListEntry
 	{
 		EntityListEntry(const EntityID p_entityID, const EntityID p_parentEntityID, const std::string &p_name, const std::string &p_combinedEntityIdAndName) : m_entityID(p_entityID), m_parentEntityID(p_parentEntityID), m_name(p_name), m_combinedEntityIdAndName(p_combinedEntityIdAndName), m_componentFlag(Systems::AllComponentTypes::None) { }
-		EntityListEntry(const EntityListEntry &p_entityListEntry) : m_entityID(p_entityListEntry.m_entityID), m_parentEntityID(p_entityListEntry.m_parentEntityID), m_name(p_entityListEntry.m_name), m_combinedEntityIdAndName(p_entityListEntry.m_combinedEntityIdAndName), m_componentFlag(Systems::AllComponentTypes::None) { }
+		EntityListEntry(const EntityListEntry &p_entityListEntry) : m_entityID(p_entityListEntry.m_entityID), m_parentEntityID(p_entityListEntry.m_parentEntityID), m_name(p_entityListEntry.m_name), m_combinedEntityIdAndName(p_entityListEntry.m_combinedEntityIdAndName), m_componentFlag(p_entityListEntry.m_componentFlag) { }
 		bool operator==(const EntityListEntry &p_entityListEntry) { return m_entityID == p_entityListEntry.m_entityID; }
 
 		EntityID m_entityID;
@@ -1049,8 +1053,11 @@ private:
 	void processMainMenuButton(MainMenuButtonType &p_mainMenuButtonType);
 	void updateSceneData(SceneData &p_sceneData);
 	void updateEntityList();
+	void rebuildEntityList();
+	void updateEntityListIndex();
 	void updateHierarchyList();
 	void updateComponentList();
+	bool addComponentListEntries(EntityListEntry &p_entityListEntry, entt::basic_registry<EntityID> &p_entityRegistry);
 	void updateAssetLists();
 
 	void duplicateEntity(const EntityID p_entityID)
@@ -1087,16 +1094,8 @@ private:
 		// Assign a next available entity ID (start the available ID search from the next ID after the parent)
 		{
 			EntityID newEntityID = newEntityConstructionInfo->m_parent + 1;
-			for(decltype(m_entityList.size()) i = 0, size = m_entityList.size(); i < size;)
-			{
-				if(newEntityID == m_entityList[i].m_entityID)
-				{
-					newEntityID++;
-					i = 0;
-				}
-				else
-					i++;
-			}
+			while(m_entityListIndex.contains(newEntityID))
+				newEntityID++;
 			newEntityConstructionInfo->m_id = newEntityID;
 		}
 
@@ -1130,13 +1129,8 @@ private:
 	}
 	EntityListEntry *getEntityListEntry(const EntityID p_entityID)
 	{
-		for(decltype(m_entityList.size()) i = 0, size = m_entityList.size(); i < size; i++)
-		{
-			if(m_entityList[i].m_entityID == p_entityID)
-			{
-				return &m_entityList[i];
-			}
-		}
+		if(auto entityIndex = m_entityListIndex.find(p_entityID); entityIndex != m_entityListIndex.end())
+			return &m_entityList[entityIndex->second];
 
 		return nullptr;
 	}
@@ -1157,6 +1151,22 @@ private:
 
 	void generateNewMap(PropertySet &p_newSceneProperties, SceneData &p_sceneData);
 
+	// Returns the number of bytes as a string in the largest fitting unit (B, KB, MB or GB)
+	inline std::string getMemorySizeString(const int64_t p_bytes) const
+	{
+		char memorySizeString[32];
+
+		if(p_bytes >= 1073741824 || p_bytes <= -1073741824)
+			snprintf(memorySizeString, sizeof(memorySizeString), "%.2f GB", (double)p_bytes / 1073741824.0);
+		else if(p_bytes >= 1048576 || p_bytes <= -1048576)
+			snprintf(memorySizeString, sizeof(memorySizeString), "%.2f MB", (double)p_bytes / 1048576.0);
+		else if(p_bytes >= 1024 || p_bytes <= -1024)
+			snprintf(memorySizeString, sizeof(memorySizeString), "%.1f KB", (double)p_bytes / 1024.0);
+		else
+			snprintf(memorySizeString, sizeof(memorySizeString), "%i B", (int)p_bytes);
+
+		return memorySizeString;
+	}
 	inline std::string getTextureFormatString(const TextureFormat p_textureFormat) const
 	{
 		switch(p_textureFormat)
@@ -1384,6 +1394,15 @@ private:
 	std::vector<ComponentListEntry> m_componentList;
 	std::vector<EntityListEntry> m_entityList;
 	EntityHierarchyEntry m_rootEntityHierarchyEntry;
+
+	// Entity list is kept sorted and only updated when entities are created, changed or removed; the hierarchy is only rebuilt when the entity list changes
+	// Component list is kept sorted by entity ID and only updated for the entities that were changed or had components added or removed
+	std::unordered_map<EntityID, std::size_t> m_entityListIndex;
+	std::vector<EntityID> m_entityListChanges;
+	std::vector<EntityID> m_componentListChanges;
+	bool m_entityListInitialized;
+	bool m_hierarchyListDirty;
+	bool m_componentListRebuildRequired;
 	SelectedEntity m_selectedEntity;
 	SceneData m_currentSceneData;
 	EntityID m_nextEntityIDToSelect; 
@@ -9,12 +9,15 @@
 #include "AudioSystem.h"
 #include "ClockLocator.h"
 #include "Engine.h"
+#include "FrameAllocator.h"
 #include "GUIHandlerLocator.h"
 #include "GUISystem.h"
 #include "ObjectDirectory.h"
 #include "PhysicsSystem.h"
+#include "Profiler.h"
 #include "RendererSystem.h"
 #include "ScriptSystem.h"
+#include "SelfCheck.h"
 #include "TaskManagerLocator.h"
 #include "WindowLocator.h"
 #include "WorldSystem.h"
@@ -70,7 +73,7 @@ Engine::~Engine()
 }
 
 // Some of the initialization sequences are order sensitive. Do not change the order of calls.
-ErrorCode Engine::init()
+ErrorCode Engine::init(const int p_argc, char *p_argv[])
 {
 	// Allow only one instance. If there's more, someone is doing something wrong.
 	if(m_instances > 1)
@@ -80,15 +83,39 @@ ErrorCode Engine::init()
 	}
 
 	// Initialize all services and their locators
-	auto servicesError = initServices();
+	auto servicesError = initServices(p_argc, p_argv);
 	if(servicesError != ErrorCode::Success)
 		return servicesError;
 
+	//  ___________________________________
+	// |								   |
+	// |			SELF-CHECK			   |
+	// |___________________________________|
+	// Run the checks of the modules that don't require a GPU nor a scene, instead of the engine; the engine is not marked as initialized, so it exits right away
+	if(Config::engineVar().self_check)
+	{
+		SelfCheck selfCheck;
+		return selfCheck.run();
+	}
+
 	// Initialize all engine systems
 	auto systemsError = initSystems();
 	if(systemsError != ErrorCode::Success)
 		return systemsError;
 
+	//  ___________________________________
+	// |								   |
+	// |	 BENCHMARK INITIALIZATION	   |
+	// |___________________________________|
+	// When benchmarking, go straight to the play state, and make every frame deterministic by using a fixed delta time and random seed
+	m_benchmark.init();
+	if(m_benchmark.isActive())
+	{
+		m_currentStateType = EngineStateType::EngineStateType_Play;
+		m_clock.setFixedDeltaMS(Config::engineVar().benchmark_delta_time_ms);
+		srand((unsigned int)Config::engineVar().benchmark_random_seed);
+	}
+
 	//  ___________________________________
 	// |								   |
 	// |	ENGINE STATE INITIALIZATION	   |
@@ -113,11 +140,39 @@ void Engine::run()
 	// Infinite main loop
 	while(true)
 	{
+		// Mark the frame boundary for the profiler and the per-frame allocator
+		Profiler::newFrame();
+		FrameAllocator::newFrame();
+
+		// Record the last frame's timings, and stop the engine once all the benchmark frames have been recorded
+		if(m_benchmark.isActive())
+		{
+			const SceneLoader &sceneLoader = m_engineStates[m_currentStateType]->getSceneLoader();
+			m_benchmark.update(!sceneLoader.getFirstLoad() && !sceneLoader.getSceneLoadingStatus());
+
+			if(m_benchmark.isFinished())
+			{
+				ErrorCode benchmarkError = m_benchmark.exportResults(Config::engineVar().benchmark_output_filename);
+				if(benchmarkError == ErrorCode::Success)
+					ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Engine, "Benchmark results exported to \"" + Config::engineVar().benchmark_output_filename + "\"");
+				else
+					ErrHandlerLoc::get().log(benchmarkError, Config::engineVar().benchmark_output_filename, ErrorSource::Source_Engine);
+
+				Config::m_engineVar.running = false;
+				break;
+			}
+		}
+
+		PROFILE_ZONE("Engine::run");
+
 		// Update the clock
 		m_clock.update();
 
 		// Handle window and input events
-		m_window.handleEvents();
+		{
+			PROFILE_ZONE("Window::handleEvents");
+			m_window.handleEvents();
+		}
 
 		// Update all loaders
 		updateLoaders();
@@ -132,6 +187,7 @@ void Engine::run()
 			m_engineStates[m_currentStateType]->update(*this);
 
 			// Swap buffers. If v-sync is enabled, this call should halt for appropriate time
+			PROFILE_ZONE("Window::swapBuffers");
 			m_window.swapBuffers();
 		}
 		else
@@ -247,13 +303,15 @@ void Engine::processEngineChanges()
 
 void Engine::updateLoaders()
 {
+	PROFILE_ZONE("Engine::updateLoaders");
+
 	Loaders::model().processReleaseQueue(m_engineStates[m_currentStateType]->getSceneLoader());
 	Loaders::texture2D().processReleaseQueue(m_engineStates[m_currentStateType]->getSceneLoader());
 	// Not in use for the moment
 	//Loaders::textureCubemap().processReleaseQueue(); 
 }
 
-ErrorCode Engine::initServices()
+ErrorCode Engine::initServices(const int p_argc, char *p_argv[])
 {
 	ErrorCode returnError = ErrorCode::Success;
 	
@@ -291,6 +349,14 @@ ErrorCode Engine::initServices()
 	Config::init();
 	Config::loadFromFile(Config::configFileVar().config_file);
 
+	// Command line arguments take priority over the config file
+	if(p_argc > 1 && Config::loadFromArguments(p_argc, p_argv) != ErrorCode::Success)
+		ErrHandlerLoc::get().log(ErrorType::Warning, ErrorSource::Source_Config, "Command line arguments must be given as \"name value\" pairs");
+
+	// Start processing deferred logs in the background, now that the log settings have been loaded
+	if(errHandlerError == ErrorCode::Success)
+		m_errorHandler.startLogSink();
+
 	//  ___________________________________
 	// |								   |
 	// |	  CLOCK INITIALIZATION		   |
@@ -304,6 +370,21 @@ ErrorCode Engine::initServices()
 		ClockLocator::provide(&m_clock);
 	else
 		ErrHandlerLoc::get().log(clockError, ErrorSource::Source_Engine);
+
+	//  ___________________________________
+	// |								   |
+	// |	 PROFILER INITIALIZATION	   |
+	// |___________________________________|
+	// Initialize the frame profiler. Still continue if there's an error, as profiling is not required for the engine to run
+	ErrorCode profilerError = Profiler::init();
+	if(profilerError != ErrorCode::Success)
+	{
+		Profiler::setEnabled(false);
+		ErrHandlerLoc::get().log(profilerError, ErrorSource::Source_Engine);
+	}
+
+	// Initialize the per-frame allocator used for transient data
+	FrameAllocator::init();
 	
 	//  ___________________________________
 	// |								   |
@@ -333,21 +414,25 @@ ErrorCode Engine::initServices()
 	// |								   |
 	// |	  GLEW INITIALIZATION		   |
 	// |___________________________________|
-	glewExperimental = GL_TRUE;
-	GLenum glewError = glewInit();
+	// There is no GL context in headless mode, so skip loading the GL functions
+	if(!Config::engineVar().headless_mode)
+	{
+		glewExperimental = GL_TRUE;
+		GLenum glewError = glewInit();
 
-	// It falsely gives error 1280, putting a call here clears the error, so it won't trigger anything
-	glGetError();
+		// It falsely gives error 1280, putting a call here clears the error, so it won't trigger anything
+		glGetError();
 
-	// If GLEW failed to initialize, return failure, as the engine would not be able to continue
-	if(glewError != GLEW_OK)
-	{
-		// Get the GLEW error before returning
-		std::stringstream stringstreamGlewError;
-		stringstreamGlewError << glewGetErrorString(glewError);
-		ErrHandlerLoc::get().log(Glew_failed, ErrorSource::Source_Engine, stringstreamGlewError.str());
+		// If GLEW failed to initialize, return failure, as the engine would not be able to continue
+		if(glewError != GLEW_OK)
+		{
+			// Get the GLEW error before returning
+			std::stringstream stringstreamGlewError;
+			stringstreamGlewError << glewGetErrorString(glewError);
+			ErrHandlerLoc::get().log(Glew_failed, ErrorSource::Source_Engine, stringstreamGlewError.str());
 
-		return ErrorCode::Failure;
+			return ErrorCode::Failure;
+		}
 	}
 
 	//  ___________________________________
@@ -412,19 +497,23 @@ ErrorCode Engine::initServices()
 	// |___________________________________|
 	// Initialize GUI handler. Still continue if there's an error, the GUI would just be missing.
 	// The error handler will be responsible for outputting error and asking user if they want to continue in this case.
-	ErrorCode guiError = m_GUIHandler.init();
-
-	// Check if the GUI handler was initialized successfully
-	// If so, register it in GUI Handler locator and Window system
-	// and enable GUI in Window system
-	if(guiError == ErrorCode::Success)
+	// GUI requires a window and a GL context, so the null GUI handler is left in the locator in headless mode
+	if(!Config::engineVar().headless_mode)
 	{
-		GUIHandlerLocator::provide(&m_GUIHandler);
-		m_window.registerGUIHandler(&m_GUIHandler);
-		m_window.setEnableGUI(true);
+		ErrorCode guiError = m_GUIHandler.init();
+
+		// Check if the GUI handler was initialized successfully
+		// If so, register it in GUI Handler locator and Window system
+		// and enable GUI in Window system
+		if(guiError == ErrorCode::Success)
+		{
+			GUIHandlerLocator::provide(&m_GUIHandler);
+			m_window.registerGUIHandler(&m_GUIHandler);
+			m_window.setEnableGUI(true);
+		}
+		else
+			ErrHandlerLoc::get().log(guiError, ErrorSource::Source_Engine);
 	}
-	else
-		ErrHandlerLoc::get().log(guiError, ErrorSource::Source_Engine);
 
 	return returnError;
 }
@@ -524,6 +613,9 @@ void Engine::shutdown()
 	// Shutdown the task manager
 	m_taskManager.shutdown();
 
+	// Process the remaining deferred logs
+	m_errorHandler.stopLogSink();
+
 	// Set the initialized flag to false, so the engine is not run without initializing again
 	m_initialized = false;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Benchmark.h"
 #include "Clock.h"
 #include "Config.h"
 #include "EditorState.h"
@@ -20,7 +21,8 @@ public:
 	~Engine();
 
 	// Initializes required systems and data. Required before entering main loop
-	ErrorCode init();
+	// Command line arguments are optional, and are used to override config variables (given as "name value" pairs)
+	ErrorCode init(const int p_argc = 0, char *p_argv[] = nullptr);
 
 	// Enters the main loop. Returns only after exiting the engine
 	void run();
@@ -165,7 +167,7 @@ private:
 	}
 
 	// Creates and initializes all the services and their locators
-	ErrorCode initServices();
+	ErrorCode initServices(const int p_argc, char *p_argv[]);
 
 	// Creates and initializes all the engine systems
 	ErrorCode initSystems();
@@ -230,6 +232,9 @@ private:
 	Window m_window;
 	Clock m_clock;
 
+	// Runs a fixed number of frames and records the per-system timings, when enabled in config
+	Benchmark m_benchmark;
+
 	// Task manager for multi-threading
 	TaskManager m_taskManager;
 
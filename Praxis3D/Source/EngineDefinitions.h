@@ -6,6 +6,19 @@
 #define SETTING_MULTITHREADING_ENABLED 1
 #define SETTING_ATOMIC_VARIABLES_ENABLED 1
 
+// Enable the frame profiler instrumentation (PROFILE_ZONE); when disabled, all profiling zones are compiled out
+#define SETTING_PROFILER_ENABLED 1
+
+// Replace the global operator new to count every heap allocation, so the number of allocations per frame can be reported by the profiler
+// Adds a small cost to every heap allocation, so it should only be enabled for profiling
+#define SETTING_HEAP_ALLOCATION_COUNTING 0
+
+// Instruction set of the batched spatial transform computation: 0 - scalar only, 1 - SSE (4 transforms at a time), 2 - AVX2 (8 transforms at a time)
+#define SETTING_TRANSFORM_BATCH_SIMD 1
+
+// Instruction set of the software occlusion culling rasterizer: 0 - scalar only, 1 - SSE (4 pixels at a time)
+#define SETTING_OCCLUSION_CULLING_SIMD 1
+
 // Use glBlitFramebuffer to copy the final buffer to the default back-buffer, instead of rendering a full-screen triangle
 //#define SETTING_USE_BLIT_FRAMEBUFFER
 
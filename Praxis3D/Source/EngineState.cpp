@@ -80,6 +80,17 @@ ErrorCode EngineState::init(TaskManager *p_taskManager)
 	return returnError;
 }
 
+void EngineState::captureRenderSnapshot()
+{
+	if(!Config::engineVar().pipelined_rendering)
+		return;
+
+	// Graphics scene is a null scene until a renderer scene is created
+	SystemScene *graphicsScene = m_sceneLoader.getSystemScene(Systems::Graphics);
+	if(graphicsScene->getSystemType() == Systems::Graphics)
+		static_cast<RendererScene *>(graphicsScene)->captureRenderSnapshot();
+}
+
 void EngineState::activate()
 {
 	m_scheduler->execute<>(std::function<void(SystemTask *)>(&SystemTask::activate));
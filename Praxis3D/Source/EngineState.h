@@ -2,6 +2,8 @@
 
 #include "Config.h"
 #include "ErrorCodes.h"
+#include "ErrorHandlerLocator.h"
+#include "MemoryTracker.h"
 #include "SceneLoader.h"
 #include "TaskManager.h"
 #include "TaskScheduler.h"
@@ -43,6 +45,10 @@ public:
 	inline void setSceneFilename(const std::string &p_filename) { m_sceneFilename = p_filename; }
 
 protected:
+	// Captures the scene state needed for rendering, once the frame has been simulated and its changes distributed; when rendering is
+	// pipelined, the captured frame is rendered during the next frame, in parallel with the simulation of that frame
+	void captureRenderSnapshot();
+
 	inline void updateSceneLoadingStatus()
 	{
 		bool loadingStatus = false;
@@ -57,7 +63,14 @@ protected:
 		if(m_sceneLoader.getFirstLoad())
 		{
 			if(!loadingStatus)
+			{
 				m_sceneLoader.setFirstLoad(false);
+
+				// Report the system memory freed by releasing the CPU-side copies of the assets that were uploaded to video memory
+				ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_SceneLoader, "Scene loaded, memory released after upload: models " +
+					std::to_string(MemoryTracker::getSavedUsage(MemoryTag_Models) / 1024) + " KB, textures " +
+					std::to_string(MemoryTracker::getSavedUsage(MemoryTag_Textures) / 1024) + " KB");
+			}
 		}
 
 		m_sceneLoader.setSceneLoadingStatus(loadingStatus);
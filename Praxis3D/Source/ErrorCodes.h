@@ -52,12 +52,15 @@ DECLARE_ENUM(ErrorType, ERROR_TYPES)
     Code(Destroy_obj_not_found,) \
     Code(Glew_failed,) \
     Code(Ifstream_failed,) \
+    Code(Memory_budget_exceeded,) \
 	/* Config Loader */\
 	/* Clock errors */ \
 	Code(Clock_QueryFrequency,) \
 	/* Frame-buffer errors */ \
 	Code(Framebuffer_failed,) \
 	Code(Geometrybuffer_failed,) \
+	Code(Staging_buffer_failed,) \
+	Code(Frame_ring_buffer_failed,) \
 	/* GUI errors */ \
 	Code(Editor_path_outside_current_dir,) \
 	Code(Font_type_missing_construction,) \
@@ -77,6 +80,8 @@ DECLARE_ENUM(ErrorType, ERROR_TYPES)
 	Code(Collision_invalid,) \
 	Code(Collision_max_dynamic_events,) \
 	Code(Collision_max_static_events,) \
+	Code(Collision_mesh_cook_failed,) \
+	Code(Collision_mesh_has_mass,) \
 	Code(Collision_missing,) \
 	Code(Kinematic_has_mass,) \
 	/* Property loader errors */ \
@@ -1,4 +1,6 @@
 
+#include <algorithm>
+#include <chrono>
 #include <Windows.h>
 
 #include "Config.h"
@@ -17,6 +19,10 @@
 ErrorHandler::ErrorHandler()
 {
 	m_console = nullptr;
+	m_logSinkRunning = false;
+	m_numOfDeferredLogsInProgress = 0;
+	m_logTicksPerSecond = 1;
+	m_lastLogRecordRepeats = 0;
 	
 	// Add the error codes to the hash map and also assign their error types in the error type array
 	AssignErrorType(Undefined, Warning);
@@ -36,9 +42,12 @@ ErrorHandler::ErrorHandler()
 	AssignErrorType(Destroy_obj_not_found, Warning);
 	AssignErrorType(Glew_failed, FatalError);
 	AssignErrorType(Ifstream_failed, Warning);
+	AssignErrorType(Memory_budget_exceeded, Warning);
 	AssignErrorType(Clock_QueryFrequency, FatalError);
 	AssignErrorType(Framebuffer_failed, FatalError);
 	AssignErrorType(Geometrybuffer_failed, FatalError);
+	AssignErrorType(Staging_buffer_failed, Warning);
+	AssignErrorType(Frame_ring_buffer_failed, Warning);
 	AssignErrorType(Editor_path_outside_current_dir, Warning);
 	AssignErrorType(Font_type_missing_construction, Warning);
 	AssignErrorType(GL_context_missing, Error);
@@ -53,6 +62,8 @@ ErrorHandler::ErrorHandler()
 	AssignErrorType(Collision_invalid, Warning);
 	AssignErrorType(Collision_max_dynamic_events, Warning);
 	AssignErrorType(Collision_max_static_events, Warning);
+	AssignErrorType(Collision_mesh_cook_failed, Warning);
+	AssignErrorType(Collision_mesh_has_mass, Warning);
 	AssignErrorType(Collision_missing, Warning);
 	AssignErrorType(Kinematic_has_mass, Warning);
 	AssignErrorType(Property_missing_size, Warning);
@@ -94,7 +105,7 @@ ErrorHandler::ErrorHandler()
 }
 ErrorHandler::~ErrorHandler()
 {
-
+	stopLogSink();
 }
 
 ErrorCode ErrorHandler::init()
@@ -220,6 +231,175 @@ void ErrorHandler::log(const ErrorCode p_errorCode, const std::string &p_objectN
 	log(m_errorData[p_errorCode].m_errorType, p_errorSource, "\033[1;33m\'" + p_objectName + "\'\033[0m: " + m_errorData[p_errorCode].m_errorString);
 }
 
+void ErrorHandler::logDeferred(const ErrorCode p_errorCode, const ErrorSource p_errorSource, const char *p_text)
+{
+	// Mark the log as in progress before checking the running flag, so stopping the log sink can wait for the record to be pushed
+	m_numOfDeferredLogsInProgress.fetch_add(1);
+
+	// Errors require user input and fatal errors stop the engine, so they cannot be deferred. If the log sink is not running, there is nothing to process the record later
+	if(!m_logSinkRunning.load() || m_errorData[p_errorCode].m_errorType == ErrorType::Error || m_errorData[p_errorCode].m_errorType == ErrorType::FatalError)
+	{
+		if(p_text != nullptr && p_text[0] != '\0')
+			log(p_errorCode, std::string(p_text), p_errorSource);
+		else
+			log(p_errorCode, p_errorSource);
+	}
+	else
+		m_logRing.push(getLogTimestamp(), p_errorCode, p_errorSource, p_text);
+
+	m_numOfDeferredLogsInProgress.fetch_sub(1);
+}
+
+void ErrorHandler::startLogSink()
+{
+	if(m_logSinkRunning.load() || !Config::engineVar().log_async_enabled)
+		return;
+
+	LARGE_INTEGER ticksPerSec;
+	if(QueryPerformanceFrequency(&ticksPerSec))
+		m_logTicksPerSecond = ticksPerSec.QuadPart;
+
+	if(!m_logRing.isInitialized())
+		m_logRing.init((size_t)std::max(Config::engineVar().log_ring_buffer_size, 2));
+
+	m_logSinkRunning = true;
+	m_logSinkThread = std::thread(&ErrorHandler::logSinkLoop, this);
+}
+
+void ErrorHandler::stopLogSink()
+{
+	if(!m_logSinkRunning.load())
+		return;
+
+	// New deferred logs are processed immediately from now on; the sink thread drains the remaining records before exiting
+	m_logSinkRunning = false;
+
+	if(m_logSinkThread.joinable())
+		m_logSinkThread.join();
+
+	// A deferred log that checked the running flag before it was cleared can push its record after the final drain of the sink thread,
+	// so wait for such logs to finish and drain the remaining records on this thread
+	while(m_numOfDeferredLogsInProgress.load() > 0)
+		std::this_thread::yield();
+
+	processLogRing();
+
+	if(m_lastLogRecordRepeats > 0)
+		displayLogRecord(m_lastLogRecord, m_lastLogRecordRepeats);
+	m_lastLogRecordRepeats = 0;
+}
+
+void ErrorHandler::logSinkLoop()
+{
+	const auto sleepDuration = std::chrono::milliseconds(std::max(Config::engineVar().log_sink_interval_ms, 1));
+
+	while(m_logSinkRunning.load(std::memory_order_relaxed))
+	{
+		processLogRing();
+		std::this_thread::sleep_for(sleepDuration);
+	}
+
+	// Process any records that were written before the sink was stopped, and report the remaining repeats
+	processLogRing();
+
+	if(m_lastLogRecordRepeats > 0)
+		displayLogRecord(m_lastLogRecord, m_lastLogRecordRepeats);
+	m_lastLogRecordRepeats = 0;
+}
+
+void ErrorHandler::processLogRing()
+{
+	LogRecord record;
+	while(m_logRing.pop(record))
+		processLogRecord(record);
+
+	// Report the repeats of the last message, if it has not been repeated for a while
+	if(m_lastLogRecordRepeats > 0 && getLogTimestamp() - m_lastLogRecord.m_timestamp >= m_logTicksPerSecond)
+	{
+		displayLogRecord(m_lastLogRecord, m_lastLogRecordRepeats);
+		m_lastLogRecordRepeats = 0;
+	}
+
+	const size_t numOfDroppedRecords = m_logRing.takeNumOfDroppedRecords();
+	if(numOfDroppedRecords > 0)
+	{
+		const std::string message = std::to_string(numOfDroppedRecords) + " deferred log messages were dropped, because the log ring buffer was full";
+		m_logData.addLogMessage(ErrorType::Warning, ErrorSource::Source_General, message);
+		m_console->displayMessage("\033[31m[" + m_errorTypeStrings[ErrorType::Warning] + "] \033[1;36m[" + m_errorSources[ErrorSource::Source_General] + "]\033[0;37m: " + message + ".\033[0m");
+	}
+}
+
+void ErrorHandler::processLogRecord(const LogRecord &p_record)
+{
+	// Collapse consecutive identical messages into a single one; the number of repeats is reported once a different message arrives, or a second has passed
+	if(p_record.isSameMessage(m_lastLogRecord) && p_record.m_timestamp - m_lastLogRecord.m_timestamp < m_logTicksPerSecond)
+	{
+		m_lastLogRecordRepeats++;
+		return;
+	}
+
+	if(m_lastLogRecordRepeats > 0)
+		displayLogRecord(m_lastLogRecord, m_lastLogRecordRepeats);
+
+	m_lastLogRecord = p_record;
+	m_lastLogRecordRepeats = 0;
+
+	// Limit the number of times the same kind of message (error code and source) can be displayed per second
+	const int maxRepeatsPerSecond = Config::engineVar().log_max_repeats_per_second;
+	if(maxRepeatsPerSecond > 0)
+	{
+		auto &rateLimit = m_logRateLimits[(unsigned int)p_record.m_errorCode * ErrorSource::Source_NumberOfErrorSources + (unsigned int)p_record.m_errorSource];
+
+		// Start a new rate-limit window, and report how many messages were suppressed during the last one
+		if(p_record.m_timestamp - rateLimit.m_windowStart >= m_logTicksPerSecond)
+		{
+			if(rateLimit.m_numOfSuppressed > 0)
+			{
+				const std::string message = "\033[1;33m" + std::to_string(rateLimit.m_numOfSuppressed) + "\033[0m messages suppressed: " + m_errorData[p_record.m_errorCode].m_errorString;
+				m_logData.addLogMessage(ErrorType::Info, p_record.m_errorSource, message);
+				m_console->displayMessage("\033[1;32m[" + m_errorTypeStrings[ErrorType::Info] + "] \033[1;36m[" + m_errorSources[p_record.m_errorSource] + "]\033[0;37m: " + message + ".\033[0m");
+			}
+
+			rateLimit.m_windowStart = p_record.m_timestamp;
+			rateLimit.m_numOfDisplayed = 0;
+			rateLimit.m_numOfSuppressed = 0;
+		}
+
+		if(rateLimit.m_numOfDisplayed >= maxRepeatsPerSecond)
+		{
+			rateLimit.m_numOfSuppressed++;
+			return;
+		}
+
+		rateLimit.m_numOfDisplayed++;
+	}
+
+	displayLogRecord(p_record, 0);
+}
+
+void ErrorHandler::displayLogRecord(const LogRecord &p_record, const int p_numOfRepeats)
+{
+	const ErrorType errorType = m_errorData[p_record.m_errorCode].m_errorType;
+
+	std::string message;
+	if(p_record.m_text[0] != '\0')
+		message = "\033[1;33m\'" + std::string(p_record.m_text) + "\'\033[0m: ";
+	message += m_errorData[p_record.m_errorCode].m_errorString;
+
+	if(p_numOfRepeats > 0)
+		message += " (repeated " + std::to_string(p_numOfRepeats) + " times)";
+
+	m_logData.addLogMessage(errorType, p_record.m_errorSource, message);
+	m_console->displayMessage((errorType == ErrorType::Info ? "\033[1;32m[" : "\033[31m[") + m_errorTypeStrings[errorType] + "] \033[1;36m[" + m_errorSources[p_record.m_errorSource] + "]\033[0;37m: " + message + ".\033[0m");
+}
+
+int64_t ErrorHandler::getLogTimestamp()
+{
+	LARGE_INTEGER currentTime;
+	QueryPerformanceCounter(&currentTime);
+	return currentTime.QuadPart;
+}
+
 ErrorHandler::CoutConsole::CoutConsole()
 {
 	m_stdoutHandle = nullptr;
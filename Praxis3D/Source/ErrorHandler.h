@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <tbb/concurrent_vector.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "Config.h"
 #include "ErrorCodes.h"
@@ -50,6 +55,126 @@ struct LogData
 	tbb::concurrent_vector<std::string>::size_type m_maxLogs;
 };
 
+// A single fixed-size log message, that can be recorded without any memory allocations or string formatting
+struct LogRecord
+{
+	LogRecord() : m_timestamp(0), m_errorCode(ErrorCode::Undefined), m_errorSource(ErrorSource::Source_Unknown) { m_text[0] = '\0'; }
+
+	inline bool isSameMessage(const LogRecord &p_record) const { return m_errorCode == p_record.m_errorCode && m_errorSource == p_record.m_errorSource && strcmp(m_text, p_record.m_text) == 0; }
+
+	int64_t m_timestamp;
+	ErrorCode m_errorCode;
+	ErrorSource m_errorSource;
+
+	// Small inline argument (like an object name); truncated if it does not fit
+	char m_text[64];
+};
+
+// Bounded lock-free ring of log records, with multiple writers and a single reader. Each slot holds a sequence number
+// that marks whether it is free to be written to or ready to be read, so writers only contend on a single atomic index.
+// When the ring is full, new records are dropped (and counted), instead of blocking the logging thread
+class LogRing
+{
+public:
+	LogRing() : m_mask(0), m_writeIndex(0), m_readIndex(0), m_numOfDroppedRecords(0) { }
+
+	// Capacity is rounded up to a power of two; must be called before any records are written
+	void init(const size_t p_capacity)
+	{
+		size_t capacity = 2;
+		while(capacity < p_capacity)
+			capacity <<= 1;
+
+		m_slots = std::vector<Slot>(capacity);
+		for(size_t i = 0; i < capacity; i++)
+			m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+
+		m_mask = capacity - 1;
+	}
+
+	// Writes a record into the ring; returns false if the ring was full. Can be called from any thread
+	inline bool push(const int64_t p_timestamp, const ErrorCode p_errorCode, const ErrorSource p_errorSource, const char *p_text)
+	{
+		Slot *slot = nullptr;
+		size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+
+		// Claim a free slot
+		while(true)
+		{
+			slot = &m_slots[writeIndex & m_mask];
+			const size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+			const intptr_t difference = (intptr_t)sequence - (intptr_t)writeIndex;
+
+			if(difference == 0)
+			{
+				if(m_writeIndex.compare_exchange_weak(writeIndex, writeIndex + 1, std::memory_order_relaxed))
+					break;
+			}
+			else
+				if(difference < 0)
+				{
+					m_numOfDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				else
+					writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		}
+
+		// Fill the record and publish it to the reader
+		slot->m_record.m_timestamp = p_timestamp;
+		slot->m_record.m_errorCode = p_errorCode;
+		slot->m_record.m_errorSource = p_errorSource;
+		if(p_text != nullptr)
+			strncpy_s(slot->m_record.m_text, p_text, _TRUNCATE);
+		else
+			slot->m_record.m_text[0] = '\0';
+
+		slot->m_sequence.store(writeIndex + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Reads the oldest record from the ring; returns false if the ring is empty. Must only be called from a single (reader) thread
+	inline bool pop(LogRecord &p_record)
+	{
+		Slot &slot = m_slots[m_readIndex & m_mask];
+
+		if(slot.m_sequence.load(std::memory_order_acquire) != m_readIndex + 1)
+			return false;
+
+		p_record = slot.m_record;
+
+		// Mark the slot as free for the next lap of writers
+		slot.m_sequence.store(m_readIndex + m_mask + 1, std::memory_order_release);
+		m_readIndex++;
+
+		return true;
+	}
+
+	const inline bool isInitialized() const { return !m_slots.empty(); }
+
+	// Returns the number of dropped records since the last call
+	inline size_t takeNumOfDroppedRecords() { return m_numOfDroppedRecords.exchange(0, std::memory_order_relaxed); }
+
+private:
+	struct Slot
+	{
+		Slot() : m_sequence(0) { }
+		Slot(const Slot &p_slot) : m_sequence(p_slot.m_sequence.load(std::memory_order_relaxed)), m_record(p_slot.m_record) { }
+
+		std::atomic<size_t> m_sequence;
+		LogRecord m_record;
+	};
+
+	std::vector<Slot> m_slots;
+	size_t m_mask;
+
+	// Writer and reader indices are kept on separate cache lines, as they are written by different threads
+	alignas(64) std::atomic<size_t> m_writeIndex;
+	alignas(64) size_t m_readIndex;
+	alignas(64) std::atomic<size_t> m_numOfDroppedRecords;
+};
+
 class ErrorHandlerBase
 {
 public:
@@ -74,6 +199,12 @@ public:
 	virtual void log(ErrorCode p_errorCode, ErrorSource p_errorSource, std::string p_error) = 0;
 	virtual void log(const ErrorCode p_errorCode, const std::string &p_objectName, const ErrorSource p_errorSource) = 0;
 
+	// Structured logging for hot paths (worker threads, per-frame code). Only a fixed-size record is written on the calling thread; the
+	// message is formatted and displayed later by the log sink thread, with repeated messages deduplicated and rate-limited.
+	// The text is an optional small argument (like an object name) that is copied into the record, not allocated.
+	// Errors and fatal errors are still processed immediately, as they may require user input
+	virtual void logDeferred(const ErrorCode p_errorCode, const ErrorSource p_errorSource, const char *p_text = nullptr) = 0;
+
 	// This should be used when trying to pass an error code and an error string as a return. So instead of logging
 	// the error immediately, it is cached and then can be retrieved later (presumably from higher scope / parent, etc).
 	// Note: Unusable at the time - needs to be updated to be thread safe (using TLS for example)
@@ -108,6 +239,15 @@ public:
 	void log(ErrorCode p_errorCode, ErrorSource p_errorSource, std::string p_error);
 	void log(const ErrorCode p_errorCode, const std::string &p_objectName, const ErrorSource p_errorSource);
 
+	void logDeferred(const ErrorCode p_errorCode, const ErrorSource p_errorSource, const char *p_text = nullptr);
+
+	// Starts the log sink thread that processes deferred logs; must be called after the config has been loaded.
+	// Until it is started (or if it is disabled in config), deferred logs are processed immediately
+	void startLogSink();
+
+	// Processes all the remaining deferred logs and stops the log sink thread
+	void stopLogSink();
+
 	// Note: Unusable at the time - needs to be updated to be thread safe (using TLS for example)
 	//inline ErrorCode cacheError(ErrorCode p_errorCode, std::string p_error) { m_cachedError.cache(p_errorCode, p_error); return ErrorCode::CachedError; }
 
@@ -189,8 +329,47 @@ private:
 
 	std::unordered_map<std::string, int> m_errHashmap;
 
+	// Tracks how many times a single kind of message was displayed in the current rate-limit window
+	struct LogRateLimit
+	{
+		LogRateLimit() : m_windowStart(0), m_numOfDisplayed(0), m_numOfSuppressed(0) { }
+
+		int64_t m_windowStart;
+		int m_numOfDisplayed;
+		int m_numOfSuppressed;
+	};
+
+	// Log sink thread loop; drains the log ring until the sink is stopped
+	void logSinkLoop();
+
+	// Processes all the records currently in the log ring
+	void processLogRing();
+
+	// Deduplicates, rate-limits, formats and displays a single deferred record
+	void processLogRecord(const LogRecord &p_record);
+
+	// Displays a deferred record, with the number of times it was repeated
+	void displayLogRecord(const LogRecord &p_record, const int p_numOfRepeats);
+
+	// Returns the current time used for log timestamps, in performance counter ticks
+	static int64_t getLogTimestamp();
+
 	ErrorCache m_cachedError;
 	ConsoleBase *m_console;
+
+	// Deferred logging
+	LogRing m_logRing;
+	std::thread m_logSinkThread;
+	std::atomic<bool> m_logSinkRunning;
+	int64_t m_logTicksPerSecond;
+
+	// Number of deferred logs that have checked the log sink running flag, but have not finished pushing their record yet
+	std::atomic<int> m_numOfDeferredLogsInProgress;
+
+	// Log sink state; only accessed from the log sink thread (and from the thread stopping it, after it has exited)
+	LogRecord m_lastLogRecord;
+	int m_lastLogRecordRepeats;
+	std::unordered_map<unsigned int, LogRateLimit> m_logRateLimits;
 };
 
 class NullErrorHandler : public ErrorHandlerBase
@@ -211,6 +390,7 @@ public:
 	void log(ErrorType p_errorType, ErrorSource p_errorSource, std::string p_error) { printf("Error: %s.\n", p_error.c_str()); }
 	void log(ErrorCode p_errorCode, ErrorSource p_errorSource, std::string p_error) { printf("Error: %i.\n", p_errorCode); }
 	void log(const ErrorCode p_errorCode, const std::string &p_objectName, const ErrorSource p_errorSource) { printf("Error: %s: %i.\n", p_objectName.c_str(), p_errorCode); }
+	void logDeferred(const ErrorCode p_errorCode, const ErrorSource p_errorSource, const char *p_text = nullptr) { printf("Error: %s: %i.\n", p_text != nullptr ? p_text : "", p_errorCode); }
 
 	bool ifSuccessful(ErrorCode p_errorCode, ErrorCode &p_returnCode) { p_returnCode = p_errorCode; return p_errorCode == ErrorCode::Success; }
 
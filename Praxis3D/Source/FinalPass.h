@@ -102,6 +102,9 @@ public:
 			m_renderer.m_backend.getGeometryBuffer()->bindFramebufferForWriting(GeometryBuffer::FramebufferDefault);
 		}
 
+		// The scene might have been rendered to a sub-rectangle of the buffers (dynamic resolution), so draw to the whole framebuffer, and let the shader upscale it
+		glViewport(0, 0, m_renderer.m_frameData.m_screenSize.x, m_renderer.m_frameData.m_screenSize.y);
+
 		// Queue and render a full screen quad using a final pass shader
 		m_renderer.queueForDrawing(m_shaderFinalPass->getShaderHandle(), m_shaderFinalPass->getUniformUpdater(), p_sceneObjects.m_cameraViewMatrix);
 		m_renderer.passScreenSpaceDrawCommandsToBackend();
@@ -109,6 +112,15 @@ public:
 #endif // SETTING_USE_BLIT_FRAMEBUFFER
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		// Scene is drawn to the screen, or to the emissive buffer when it is rendered to a texture (e.g. in the editor)
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.write(RenderGraphResource::Backbuffer);
+		p_passBuilder.setSideEffects();
+	}
+
 private:	
 	ErrorCode loadFinalPassShaderToMemory(ShaderLoader::ShaderProgram *p_shader)
 	{
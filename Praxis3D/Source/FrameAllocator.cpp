@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "Config.h"
+#include "FrameAllocator.h"
+
+size_t FrameAllocator::m_bufferSize = 0;
+std::atomic<size_t> FrameAllocator::m_frameIndex = 0;
+FrameAllocator::HeapAllocationCounter FrameAllocator::m_heapAllocationCounters[FrameAllocator::MaxHeapAllocationCounters] = {};
+std::atomic<unsigned int> FrameAllocator::m_numOfHeapAllocationCounters = 0;
+thread_local FrameAllocator::HeapAllocationCounter *FrameAllocator::m_heapAllocationCounter = nullptr;
+size_t FrameAllocator::m_frameStartNumOfHeapAllocations = 0;
+size_t FrameAllocator::m_lastFrameNumOfHeapAllocations = 0;
+size_t FrameAllocator::m_highWaterMark = 0;
+std::vector<FrameArena *> FrameAllocator::m_threadArenas;
+SpinWait FrameAllocator::m_threadArenasMutex;
+thread_local FrameArena *FrameAllocator::m_threadArena = nullptr;
+thread_local unsigned int FrameAllocator::m_backgroundScopeDepth = 0;
+
+#if SETTING_HEAP_ALLOCATION_COUNTING
+// Replace the global operator new and delete, so that every heap allocation can be counted
+void *operator new(std::size_t p_size)
+{
+	FrameAllocator::countHeapAllocation();
+
+	if(void *pointer = std::malloc(p_size > 0 ? p_size : 1); pointer != nullptr)
+		return pointer;
+
+	throw std::bad_alloc();
+}
+void *operator new[](std::size_t p_size)
+{
+	return operator new(p_size);
+}
+void operator delete(void *p_pointer) noexcept
+{
+	std::free(p_pointer);
+}
+void operator delete[](void *p_pointer) noexcept
+{
+	std::free(p_pointer);
+}
+void operator delete(void *p_pointer, std::size_t p_size) noexcept
+{
+	std::free(p_pointer);
+}
+void operator delete[](void *p_pointer, std::size_t p_size) noexcept
+{
+	std::free(p_pointer);
+}
+#endif
+
+FrameArena::FrameArena(const unsigned int p_threadIndex, const size_t p_bufferSize) : m_currentBuffer(0), m_threadIndex(p_threadIndex), m_bufferSize(p_bufferSize), m_highWaterMark(0)
+{
+	// Mark the buffers as belonging to an invalid frame, so the first allocation resets them
+	m_buffers[0].m_frameIndex = (size_t)-1;
+	m_buffers[1].m_frameIndex = (size_t)-1;
+}
+
+FrameArena::~FrameArena()
+{
+	for(auto &buffer : m_buffers)
+	{
+		for(auto *overflowBlock : buffer.m_overflowBlocks)
+			std::free(overflowBlock);
+
+		std::free(buffer.m_data);
+	}
+}
+
+void FrameArena::swapBuffers(const size_t p_frameIndex)
+{
+	// Record the memory used by the last frame of the current buffer
+	const Buffer &previousBuffer = m_buffers[m_currentBuffer];
+	const size_t previousFrameUsage = previousBuffer.m_offset + previousBuffer.m_overflowSize;
+	if(previousFrameUsage > m_highWaterMark.load(std::memory_order_relaxed))
+		m_highWaterMark.store(previousFrameUsage, std::memory_order_relaxed);
+
+	m_currentBuffer = 1 - m_currentBuffer;
+	Buffer &buffer = m_buffers[m_currentBuffer];
+
+	// If the buffer has overflowed, grow it to fit all the memory that was used, so that it does not overflow again
+	if(!buffer.m_overflowBlocks.empty() || buffer.m_data == nullptr)
+	{
+		for(auto *overflowBlock : buffer.m_overflowBlocks)
+			std::free(overflowBlock);
+		buffer.m_overflowBlocks.clear();
+
+		const size_t requiredSize = std::max(m_bufferSize, buffer.m_offset + buffer.m_overflowSize);
+		if(requiredSize > buffer.m_size)
+		{
+			FrameAllocator::countHeapAllocation();
+			std::free(buffer.m_data);
+			buffer.m_data = static_cast<char *>(std::malloc(requiredSize));
+			buffer.m_size = buffer.m_data != nullptr ? requiredSize : 0;
+		}
+	}
+
+	buffer.m_offset = 0;
+	buffer.m_overflowSize = 0;
+	buffer.m_frameIndex = p_frameIndex;
+}
+
+void *FrameArena::allocateOverflow(const size_t p_size, const size_t p_alignment)
+{
+	Buffer &buffer = m_buffers[m_currentBuffer];
+
+	// Allocate with extra space for alignment; the memory is released when the buffer is reset
+	FrameAllocator::countHeapAllocation();
+	char *overflowBlock = static_cast<char *>(std::malloc(p_size + p_alignment));
+	if(overflowBlock == nullptr)
+		throw std::bad_alloc();
+
+	buffer.m_overflowBlocks.push_back(overflowBlock);
+	buffer.m_overflowSize += p_size + p_alignment;
+
+	return overflowBlock + ((p_alignment - ((size_t)overflowBlock & (p_alignment - 1))) & (p_alignment - 1));
+}
+
+ErrorCode FrameAllocator::init()
+{
+	m_bufferSize = (size_t)std::max(Config::engineVar().frame_allocator_buffer_size, 0);
+	m_frameStartNumOfHeapAllocations = getNumOfHeapAllocations();
+
+	return ErrorCode::Success;
+}
+
+void FrameAllocator::newFrame()
+{
+	const size_t numOfHeapAllocations = getNumOfHeapAllocations();
+	m_lastFrameNumOfHeapAllocations = numOfHeapAllocations - m_frameStartNumOfHeapAllocations;
+	m_frameStartNumOfHeapAllocations = numOfHeapAllocations;
+
+	// Gather the highest memory usage of a single frame across all threads
+	{
+		SpinWait::Lock lock(m_threadArenasMutex);
+
+		for(const auto *threadArena : m_threadArenas)
+			m_highWaterMark = std::max(m_highWaterMark, threadArena->getHighWaterMark());
+	}
+
+	m_frameIndex.store(m_frameIndex.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+FrameArena *FrameAllocator::registerThreadArena()
+{
+	SpinWait::Lock lock(m_threadArenasMutex);
+
+	auto *threadArena = new FrameArena((unsigned int)m_threadArenas.size(), m_bufferSize);
+	m_threadArenas.push_back(threadArena);
+
+	return threadArena;
+}
+
+size_t FrameAllocator::getNumOfHeapAllocations()
+{
+	size_t numOfHeapAllocations = 0;
+
+	for(const auto &counter : m_heapAllocationCounters)
+		numOfHeapAllocations += counter.m_count.load(std::memory_order_relaxed);
+
+	return numOfHeapAllocations;
+}
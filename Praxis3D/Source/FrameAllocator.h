@@ -0,0 +1,212 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EngineDefinitions.h"
+#include "ErrorCodes.h"
+#include "SpinWait.h"
+
+// Linear (bump) allocator of a single thread, with two buffers that are swapped at frame boundaries, so that
+// the data allocated during a frame stays valid until the end of the next frame. Owned and used by a single thread only.
+// Buffers are swapped (and reset) lazily, on the first allocation of a new frame, so no other thread ever modifies them;
+// only work that is synchronized with the frame boundary allocates from it (see FrameAllocator::BackgroundScope)
+class FrameArena
+{
+	friend class FrameAllocator;
+public:
+	FrameArena(const unsigned int p_threadIndex, const size_t p_bufferSize);
+	~FrameArena();
+
+	// Returns memory that is valid until the end of the next frame (the owning thread must not be stalled for longer than that while using it)
+	inline void *allocate(const size_t p_size, const size_t p_alignment, const size_t p_frameIndex)
+	{
+		if(m_buffers[m_currentBuffer].m_frameIndex != p_frameIndex)
+			swapBuffers(p_frameIndex);
+
+		Buffer &buffer = m_buffers[m_currentBuffer];
+
+		// Align the current offset, and bump it past the allocated memory
+		const size_t alignedOffset = (buffer.m_offset + p_alignment - 1) & ~(p_alignment - 1);
+		if(buffer.m_data != nullptr && alignedOffset + p_size <= buffer.m_size)
+		{
+			buffer.m_offset = alignedOffset + p_size;
+			return buffer.m_data + alignedOffset;
+		}
+
+		return allocateOverflow(p_size, p_alignment);
+	}
+
+	// Getters
+	inline unsigned int getThreadIndex() const { return m_threadIndex; }
+	inline size_t getHighWaterMark() const { return m_highWaterMark.load(std::memory_order_relaxed); }
+
+private:
+	struct Buffer
+	{
+		Buffer() : m_data(nullptr), m_size(0), m_offset(0), m_overflowSize(0), m_frameIndex(0) { }
+
+		char *m_data;
+		size_t m_size;
+		size_t m_offset;
+
+		// Memory that did not fit in the buffer during the frame; released (and the buffer grown to fit it) when the buffer is reset
+		std::vector<char *> m_overflowBlocks;
+		size_t m_overflowSize;
+
+		size_t m_frameIndex;
+	};
+
+	// Switches to the other buffer and resets it, as its data is from two frames ago
+	void swapBuffers(const size_t p_frameIndex);
+
+	// Allocates memory directly from the heap, when the buffer is full
+	void *allocateOverflow(const size_t p_size, const size_t p_alignment);
+
+	Buffer m_buffers[2];
+	unsigned int m_currentBuffer;
+	unsigned int m_threadIndex;
+	size_t m_bufferSize;
+
+	// The most memory that was used by a single frame
+	std::atomic<size_t> m_highWaterMark;
+};
+
+// Per-thread, per-frame linear allocator for short-lived (transient) data, like temporary arrays created and discarded during a frame.
+// Allocations are a pointer bump and deallocations do nothing; all the memory of a frame is released at once, one frame later.
+// Also counts heap allocations (global operator new calls) per frame, when SETTING_HEAP_ALLOCATION_COUNTING is enabled.
+// Frame memory is only handed out to work that is synchronized with the frame boundary; background work (that can run across
+// multiple frames) is marked with a BackgroundScope, and the frame allocator containers created within it use the heap instead.
+class FrameAllocator
+{
+	friend class FrameArena;
+public:
+	// Marks the work executed on the calling thread, for the lifetime of the scope, as not synchronized with the frame boundary
+	class BackgroundScope
+	{
+	public:
+		BackgroundScope() { m_backgroundScopeDepth++; }
+		~BackgroundScope() { m_backgroundScopeDepth--; }
+	};
+
+	// Reads the allocator settings from config; must be called after the config has been loaded
+	static ErrorCode init();
+
+	// Marks the frame boundary; must be called once per frame from the primary thread
+	static void newFrame();
+
+	// Allocates memory that is valid until the end of the next frame. Can be called from any thread
+	inline static void *allocate(const size_t p_size, const size_t p_alignment = alignof(std::max_align_t))
+	{
+		return getThreadArena()->allocate(p_size, p_alignment, m_frameIndex.load(std::memory_order_relaxed));
+	}
+
+	// Counts a single heap allocation; called by the global operator new. Each thread counts into its own counter (on a separate cache line), so the threads do not contend
+	inline static void countHeapAllocation()
+	{
+		if(m_heapAllocationCounter == nullptr)
+			m_heapAllocationCounter = &m_heapAllocationCounters[m_numOfHeapAllocationCounters.fetch_add(1, std::memory_order_relaxed) % MaxHeapAllocationCounters];
+
+		m_heapAllocationCounter->m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Getters
+	inline static bool isFrameMemoryAvailable() { return m_backgroundScopeDepth == 0; }
+	inline static size_t getFrameIndex() { return m_frameIndex.load(std::memory_order_relaxed); }
+	inline static size_t getLastFrameNumOfHeapAllocations() { return m_lastFrameNumOfHeapAllocations; }
+	inline static size_t getHighWaterMark() { return m_highWaterMark; }
+	inline static unsigned int getNumberOfThreads() { return (unsigned int)m_threadArenas.size(); }
+
+private:
+	// Returns the arena of the calling thread, creating and registering it on the first call from that thread
+	inline static FrameArena *getThreadArena()
+	{
+		if(m_threadArena == nullptr)
+			m_threadArena = registerThreadArena();
+
+		return m_threadArena;
+	}
+	static FrameArena *registerThreadArena();
+
+	// Sums the heap allocation counters of all threads
+	static size_t getNumOfHeapAllocations();
+
+	// Threads beyond the maximum share counters, which is still correct, as the counters are atomic
+	static constexpr unsigned int MaxHeapAllocationCounters = 64;
+	struct alignas(64) HeapAllocationCounter
+	{
+		std::atomic<size_t> m_count;
+	};
+
+	static size_t m_bufferSize;
+	static std::atomic<size_t> m_frameIndex;
+
+	static HeapAllocationCounter m_heapAllocationCounters[MaxHeapAllocationCounters];
+	static std::atomic<unsigned int> m_numOfHeapAllocationCounters;
+	static thread_local HeapAllocationCounter *m_heapAllocationCounter;
+	static size_t m_frameStartNumOfHeapAllocations;
+	static size_t m_lastFrameNumOfHeapAllocations;
+	static size_t m_highWaterMark;
+
+	// Thread arenas are only ever added, and live until the end of the application
+	static std::vector<FrameArena *> m_threadArenas;
+	static SpinWait m_threadArenasMutex;
+	static thread_local FrameArena *m_threadArena;
+
+	// Number of nested background scopes of the calling thread (a thread can pick up frame work while waiting in a background task, and vice versa)
+	static thread_local unsigned int m_backgroundScopeDepth;
+};
+
+// Adapter for using the frame allocator with standard containers; deallocation does nothing,
+// as the memory is released at the frame boundary. Containers using it must not outlive the next frame.
+// Adapters created within a background scope allocate from the heap instead (and deallocate normally), for the lifetime of the adapter
+template <typename T_Type>
+class FrameAllocatorAdapter
+{
+	template <typename T_Other>
+	friend class FrameAllocatorAdapter;
+public:
+	typedef T_Type value_type;
+
+	// Memory of one adapter cannot be released by another of a different kind, so the adapter is moved and swapped together with the container memory;
+	// copies get the kind of adapter of the scope they are created in, as they can outlive the original container
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+	typedef std::false_type is_always_equal;
+
+	FrameAllocatorAdapter() noexcept : m_heapFallback(!FrameAllocator::isFrameMemoryAvailable()) { }
+	template <typename T_Other>
+	FrameAllocatorAdapter(const FrameAllocatorAdapter<T_Other> &p_other) noexcept : m_heapFallback(p_other.m_heapFallback) { }
+
+	inline FrameAllocatorAdapter select_on_container_copy_construction() const noexcept { return FrameAllocatorAdapter(); }
+
+	inline T_Type *allocate(const std::size_t p_count)
+	{
+		if(m_heapFallback)
+			return std::allocator<T_Type>().allocate(p_count);
+
+		return static_cast<T_Type *>(FrameAllocator::allocate(p_count * sizeof(T_Type), alignof(T_Type)));
+	}
+	inline void deallocate(T_Type *p_pointer, const std::size_t p_count) noexcept
+	{
+		if(m_heapFallback)
+			std::allocator<T_Type>().deallocate(p_pointer, p_count);
+	}
+
+	template <typename T_Other>
+	inline bool operator==(const FrameAllocatorAdapter<T_Other> &p_other) const noexcept { return m_heapFallback == p_other.m_heapFallback; }
+	template <typename T_Other>
+	inline bool operator!=(const FrameAllocatorAdapter<T_Other> &p_other) const noexcept { return m_heapFallback != p_other.m_heapFallback; }
+
+private:
+	bool m_heapFallback;
+};
+
+// Standard containers that allocate from the frame allocator
+template <typename T_Type>
+using FrameVector = std::vector<T_Type, FrameAllocatorAdapter<T_Type>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocatorAdapter<char>>;
@@ -0,0 +1,131 @@
+#include "FrameRingBuffer.h"
+
+FrameRingBuffer::FrameRingBuffer() : m_memoryTracker(MemoryTag_RendererBuffers)
+{
+	m_handle = 0;
+	m_mappedData = nullptr;
+	m_frameSize = 0;
+	m_alignment = 256;
+	m_frameIndex = 0;
+	m_frameAllocatedSize = 0;
+
+	for(unsigned int i = 0; i < NumOfFramesInFlight; i++)
+		m_frameFences[i] = nullptr;
+}
+
+FrameRingBuffer::~FrameRingBuffer()
+{
+	release();
+}
+
+ErrorCode FrameRingBuffer::init(const int64_t p_frameSize)
+{
+	// Make sure there is only one buffer
+	release();
+
+	if(p_frameSize <= 0)
+		return ErrorCode::Frame_ring_buffer_failed;
+
+	// Immutable buffer storage is required for persistent mapping
+	if(!(GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) || glBufferStorage == nullptr)
+		return ErrorCode::Frame_ring_buffer_failed;
+
+	// Every allocation is bound as a uniform buffer range, so it must start at a multiple of the uniform buffer offset alignment
+	GLint uniformBufferAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferAlignment);
+	m_alignment = uniformBufferAlignment > 0 ? (int64_t)uniformBufferAlignment : 256;
+
+	const int64_t frameSize = (p_frameSize + m_alignment - 1) / m_alignment * m_alignment;
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	// Create the buffer and keep it mapped for its whole lifetime
+	glGenBuffers(1, &m_handle);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_handle);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, frameSize * NumOfFramesInFlight, nullptr, flags);
+	m_mappedData = static_cast<unsigned char *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, frameSize * NumOfFramesInFlight, flags));
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if(m_mappedData == nullptr)
+	{
+		glDeleteBuffers(1, &m_handle);
+		m_handle = 0;
+		return ErrorCode::Frame_ring_buffer_failed;
+	}
+
+	m_frameSize = frameSize;
+	m_memoryTracker.setSize(MemoryType_VRAM, m_frameSize * NumOfFramesInFlight);
+
+	return ErrorCode::Success;
+}
+
+void FrameRingBuffer::release()
+{
+	// Delete all the fences; the GL defers the deletion of the buffer until the GPU is done with it
+	for(unsigned int i = 0; i < NumOfFramesInFlight; i++)
+	{
+		if(m_frameFences[i] != nullptr)
+		{
+			glDeleteSync(m_frameFences[i]);
+			m_frameFences[i] = nullptr;
+		}
+	}
+
+	if(m_handle != 0)
+	{
+		if(m_mappedData != nullptr)
+		{
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_handle);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+
+		glDeleteBuffers(1, &m_handle);
+	}
+
+	m_handle = 0;
+	m_mappedData = nullptr;
+	m_frameSize = 0;
+	m_frameIndex = 0;
+	m_frameAllocatedSize = 0;
+	m_memoryTracker.setSize(MemoryType_VRAM, 0);
+}
+
+void FrameRingBuffer::beginFrame()
+{
+	m_frameIndex = (m_frameIndex + 1) % NumOfFramesInFlight;
+	m_frameAllocatedSize = 0;
+
+	// Wait for the GPU to finish the frame that last used this region; it is only reached if the GPU is more frames behind than there are regions
+	GLsync &fence = m_frameFences[m_frameIndex];
+	if(fence != nullptr)
+	{
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		while(result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+void FrameRingBuffer::endFrame()
+{
+	if(m_frameAllocatedSize > 0)
+		m_frameFences[m_frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool FrameRingBuffer::allocate(const int64_t p_size, int64_t &p_offset)
+{
+	if(!isInitialized() || p_size <= 0)
+		return false;
+
+	const int64_t alignedOffset = (m_frameAllocatedSize + m_alignment - 1) / m_alignment * m_alignment;
+
+	if(alignedOffset + p_size > m_frameSize)
+		return false;
+
+	m_frameAllocatedSize = alignedOffset + p_size;
+	p_offset = m_frameIndex * m_frameSize + alignedOffset;
+
+	return true;
+}
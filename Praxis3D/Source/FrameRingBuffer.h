@@ -0,0 +1,65 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <stdint.h>
+
+#include "ErrorCodes.h"
+#include "MemoryTracker.h"
+
+// Persistently mapped buffer for the data that is written by the CPU every frame (e.g. light and shadow uniform buffers), split into one region per frame in flight.
+// Each frame allocates linearly from its own region, and its data is bound to the shaders directly from the buffer (with glBindBufferRange), without the driver-side
+// copies and implicit synchronization of glBufferData / glBufferSubData. A fence is placed after the GPU commands of each frame, and a region is only written to again
+// once the GPU has signaled that it has finished the frame that last used it (waiting for it, if the GPU is that many frames behind).
+// Requires ARB_buffer_storage (OpenGL 4.4); when it is not supported, the buffer fails to initialize and per-frame buffers are updated directly
+class FrameRingBuffer
+{
+public:
+	// Number of frames whose data can be in use by the GPU at the same time
+	static constexpr unsigned int NumOfFramesInFlight = 3;
+
+	FrameRingBuffer();
+	~FrameRingBuffer();
+
+	// Create the buffer with a region of the given size for each frame in flight, and map it persistently; must be called on the thread that owns the GL context
+	ErrorCode init(const int64_t p_frameSize);
+
+	// Unmap and delete the buffer, and delete all pending fences
+	void release();
+
+	// Move on to the region of the next frame, waiting until the GPU has finished reading from it
+	void beginFrame();
+
+	// Place a fence after all the GPU commands of the current frame, that guards its region
+	void endFrame();
+
+	// Allocate a region of the given size for the current frame, aligned for binding as a uniform buffer range;
+	// returns false if the region of the frame doesn't have enough free space (the region is not allocated)
+	bool allocate(const int64_t p_size, int64_t &p_offset);
+
+	// Returns a CPU pointer to the given offset in the buffer; the memory is write-only and coherent
+	inline unsigned char *getMappedData(const int64_t p_offset) const { return m_mappedData + p_offset; }
+
+	inline unsigned int getHandle() const { return m_handle; }
+	inline int64_t getFrameSize() const { return m_frameSize; }
+	inline int64_t getFrameAllocatedSize() const { return m_frameAllocatedSize; }
+	inline bool isInitialized() const { return m_mappedData != nullptr; }
+
+private:
+	unsigned int m_handle;
+	unsigned char *m_mappedData;
+
+	// Size of the region of each frame
+	int64_t m_frameSize;
+
+	// Alignment of each allocation; the uniform buffer offset alignment of the driver
+	int64_t m_alignment;
+
+	// Index of the region of the current frame, and the number of bytes allocated from it
+	unsigned int m_frameIndex;
+	int64_t m_frameAllocatedSize;
+
+	// Fence of the last frame that used each region (null if the region isn't in use)
+	GLsync m_frameFences[NumOfFramesInFlight];
+
+	MemoryTrackerEntry m_memoryTracker;
+};
@@ -2,12 +2,13 @@
 
 #include <GL/glew.h>
 
+#include "MemoryTracker.h"
 #include "UniformData.h"
 
 class Framebuffer
 {
 public:
-	Framebuffer(unsigned int p_bufferWidth, unsigned int p_bufferHeight)
+	Framebuffer(unsigned int p_bufferWidth, unsigned int p_bufferHeight) : m_memoryTracker(MemoryTag_Framebuffers)
 	{
 		m_bufferWidth = p_bufferWidth;
 		m_bufferHeight = p_bufferHeight;
@@ -62,4 +63,7 @@ protected:
 
 	unsigned int m_bufferWidth,
 				 m_bufferHeight;
+
+	// Estimated video memory of all the buffers
+	MemoryTrackerEntry m_memoryTracker;
 };
\ No newline at end of file
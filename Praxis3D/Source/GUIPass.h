@@ -66,6 +66,15 @@ public:
 		GUIHandlerLocator::get().render();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		// Editor GUI displays the scene that was rendered to the emissive buffer
+		p_passBuilder.read(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.read(RenderGraphResource::Backbuffer);
+		p_passBuilder.write(RenderGraphResource::Backbuffer);
+		p_passBuilder.setSideEffects();
+	}
+
 private:
 
 };
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "GUIScene.h"
 #include "imspinner.h"
 #include "NullSystemObjects.h"
+#include "Profiler.h"
 #include "TaskManagerLocator.h"
 
 GUIScene::GUIScene(SystemBase *p_system, SceneLoader *p_sceneLoader) : SystemScene(p_system, p_sceneLoader, Properties::PropertyID::GUI), m_aboutWindow(this)
@@ -92,6 +93,8 @@ void GUIScene::deactivate()
 
 void GUIScene::update(const float p_deltaTime)
 {
+	PROFILE_ZONE("GUIScene::update");
+
 	if(Config::GUIVar().gui_render)
 	{
 		// Get the world scene required for getting components
@@ -270,9 +273,9 @@ void GUIScene::loadInBackground()
 {
 }
 
-std::vector<SystemObject *> GUIScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> GUIScene::getComponents(const EntityID p_entityID)
 {
-	std::vector<SystemObject *> returnVector;
+	FrameVector<SystemObject *> returnVector;
 
 	// Get the entity registry 
 	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
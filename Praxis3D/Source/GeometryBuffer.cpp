@@ -1,5 +1,7 @@
 #include "Config.h"
+#include "ErrorHandlerLocator.h"
 #include "GeometryBuffer.h"
+#include "Utilities.h"
 
 GeometryBuffer::GeometryBuffer(const UniformFrameData &p_frameData) : Framebuffer(p_frameData.m_screenSize.x, p_frameData.m_screenSize.y)
 {
@@ -8,6 +10,9 @@ GeometryBuffer::GeometryBuffer(const UniformFrameData &p_frameData) : Framebuffe
 	m_depthBuffer = 0;
 	m_finalBuffer = 0;
 	m_finalPassBuffer = GBufferFinal;
+	m_renderWidth = m_bufferWidth;
+	m_renderHeight = m_bufferHeight;
+	m_thinLayout = false;
 
 	m_emissiveAndFinalBuffers[0] = GL_COLOR_ATTACHMENT0 + GBufferEmissive;
 	m_emissiveAndFinalBuffers[1] = GL_COLOR_ATTACHMENT0 + GBufferFinal;
@@ -76,9 +81,34 @@ ErrorCode GeometryBuffer::init(const UniformFrameData &p_frameData)
 		m_textureFormats[GBufferEmissive] = Config::FramebfrVariables().gl_emissive_buffer_texture_format;
 		m_textureTypes[GBufferEmissive] = Config::FramebfrVariables().gl_emissive_buffer_texture_type;
 
+		// In the thin layout, positions are reconstructed from the depth buffer, normals are octahedral-encoded into two channels
+		// and material properties are stored with 8-bit precision, so the position buffer is not created at all
+		m_thinLayout = Config::rendererVar().gbuffer_thin_layout;
+		if(m_thinLayout)
+		{
+			m_internalFormats[GBufferNormal] = Config::FramebfrVariables().gl_normal_buffer_thin_internal_format;
+			m_textureFormats[GBufferNormal] = Config::FramebfrVariables().gl_normal_buffer_thin_texture_format;
+			m_textureTypes[GBufferNormal] = Config::FramebfrVariables().gl_normal_buffer_thin_texture_type;
+
+			m_internalFormats[GBufferMatProperties] = Config::FramebfrVariables().gl_mat_properties_buffer_thin_internal_format;
+			m_textureFormats[GBufferMatProperties] = Config::FramebfrVariables().gl_mat_properties_buffer_thin_texture_format;
+			m_textureTypes[GBufferMatProperties] = Config::FramebfrVariables().gl_mat_properties_buffer_thin_texture_type;
+
+			m_texBuffers[GBufferPosition] = GL_NONE;
+		}
+
+		// Report the memory used per pixel by both layouts
+		ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_GeometryBuffer, "G-buffer size per pixel: " + 
+			Utilities::toString(getBytesPerPixel(false)) + " bytes (full layout), " + 
+			Utilities::toString(getBytesPerPixel(true)) + " bytes (thin layout); using the " + (m_thinLayout ? "thin" : "full") + " layout");
+
 		// Create textures
 		for(GLuint i = 0; i < GBufferNumTextures; i++)
 		{
+			// Skip the position buffer if it is not used
+			if(!isBufferUsed(i))
+				continue;
+
 			glBindTexture(GL_TEXTURE_2D, m_GBTextures[i]);
 			glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormats[i], m_bufferWidth, m_bufferHeight, 0, m_textureFormats[i], m_textureTypes[i], NULL);
 
@@ -94,6 +124,10 @@ ErrorCode GeometryBuffer::init(const UniformFrameData &p_frameData)
 		glBindTexture(GL_TEXTURE_2D, m_depthBuffer);
 		glTexImage2D(GL_TEXTURE_2D, 0, Config::FramebfrVariables().gl_depth_buffer_internal_format, m_bufferWidth, m_bufferHeight, 0, 
 					 Config::FramebfrVariables().gl_depth_buffer_texture_format, Config::FramebfrVariables().gl_depth_buffer_texture_type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthBuffer, 0);
 
 		// Create the intermediate buffer, that acts as an intermediate buffer between vertical and horizontal blur passes
@@ -129,6 +163,8 @@ ErrorCode GeometryBuffer::init(const UniformFrameData &p_frameData)
 		m_status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
 		if(m_status != GL_FRAMEBUFFER_COMPLETE)
 			returnCode = ErrorCode::Geometrybuffer_failed;
+
+		updateMemorySize();
 	}
 	return returnCode;
 }
@@ -138,12 +174,18 @@ void GeometryBuffer::setBufferSize(unsigned int p_bufferWidth, unsigned int p_bu
 	{
 		m_bufferWidth = p_bufferWidth;
 		m_bufferHeight = p_bufferHeight;
+		m_renderWidth = m_bufferWidth;
+		m_renderHeight = m_bufferHeight;
 
 		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_FBO);
 
 		// Create textures
 		for (GLuint i = 0; i < GBufferNumTextures; i++)
 		{
+			// Skip the position buffer if it is not used
+			if(!isBufferUsed(i))
+				continue;
+
 			glBindTexture(GL_TEXTURE_2D, m_GBTextures[i]);
 			glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormats[i], m_bufferWidth, m_bufferHeight, 0, m_textureFormats[i], m_textureTypes[i], NULL);
 		}
@@ -166,6 +208,8 @@ void GeometryBuffer::setBufferSize(unsigned int p_bufferWidth, unsigned int p_bu
 		// If HDR bloom is enabled, create mip maps for the final buffer
 		if(Config::graphicsVar().bloom_enabled)
 			generateMipmap(GBufferTextureType::GBufferFinal);
+
+		updateMemorySize();
 	}
 }
 void GeometryBuffer::setBufferSize(GLuint p_buffer, unsigned int p_bufferWidth, unsigned int p_bufferHeight)
@@ -180,6 +224,9 @@ void GeometryBuffer::setBufferSize(GLuint p_buffer, unsigned int p_bufferWidth,
 		case GBufferDiffuse:
 		case GBufferNormal:
 		case GBufferEmissive:
+			if(!isBufferUsed(p_buffer))
+				break;
+
 			// Resize geometry textures
 			glBindTexture(GL_TEXTURE_2D, m_GBTextures[p_buffer]);
 			glTexImage2D(GL_TEXTURE_2D, 0, m_internalFormats[p_buffer], p_bufferWidth, p_bufferHeight, 0, m_textureFormats[p_buffer], m_textureTypes[p_buffer], NULL);
@@ -216,7 +263,7 @@ void GeometryBuffer::setBufferSize(GLuint p_buffer, unsigned int p_bufferWidth,
 void GeometryBuffer::initFrame()
 {
 	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_FBO);
-	glViewport(0, 0, m_bufferWidth, m_bufferHeight);
+	glViewport(0, 0, m_renderWidth, m_renderHeight);				// Only the render sub-rectangle is drawn to, while the clears below still cover the whole buffers
 	glDrawBuffer(GL_COLOR_ATTACHMENT0 + GBufferIntermediate);	// Bind intermediate buffer
 	glClear(GL_COLOR_BUFFER_BIT);								// and clear it
 	glDrawBuffer(GL_COLOR_ATTACHMENT0 + GBufferFinal);			// Bind final buffer
@@ -231,7 +278,7 @@ void GeometryBuffer::initGeometryPass()
 void GeometryBuffer::initLightPass()
 {
 	glActiveTexture(GL_TEXTURE0 + GBufferPosition);
-	glBindTexture(GL_TEXTURE_2D, m_GBTextures[GBufferPosition]);
+	glBindTexture(GL_TEXTURE_2D, getBufferTextureHandle(GBufferPosition));
 
 	glActiveTexture(GL_TEXTURE0 + GBufferDiffuse);
 	glBindTexture(GL_TEXTURE_2D, m_GBTextures[GBufferDiffuse]);
@@ -262,4 +309,29 @@ void GeometryBuffer::initFinalPass()
 	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
 
 #endif // SETTING_USE_BLIT_FRAMEBUFFER
+}
+unsigned int GeometryBuffer::getBytesPerPixel(const bool p_thinLayout)
+{
+	unsigned int bytesPerPixel = MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_diffuse_buffer_internal_format) +
+		MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_emissive_buffer_internal_format) +
+		MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_depth_buffer_internal_format);
+
+	if(p_thinLayout)
+		bytesPerPixel += MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_normal_buffer_thin_internal_format) +
+			MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_mat_properties_buffer_thin_internal_format);
+	else
+		bytesPerPixel += MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_position_buffer_internal_format) +
+			MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_normal_buffer_internal_format) +
+			MemoryTracker::getInternalFormatSize(Config::FramebfrVariables().gl_mat_properties_buffer_internal_format);
+
+	return bytesPerPixel;
+}
+void GeometryBuffer::updateMemorySize()
+{
+	const unsigned int numOfPixels = m_bufferWidth * m_bufferHeight;
+
+	// The final buffer has mipmaps when HDR bloom is enabled
+	m_memoryTracker.setSize(MemoryType_VRAM, (int64_t)getBytesPerPixel(m_thinLayout) * numOfPixels +
+		MemoryTracker::getTextureMemorySize(Config::FramebfrVariables().gl_blur_buffer_internal_format, m_bufferWidth, m_bufferHeight) +
+		MemoryTracker::getTextureMemorySize(Config::FramebfrVariables().gl_final_buffer_internal_format, m_bufferWidth, m_bufferHeight, 1, Config::graphicsVar().bloom_enabled));
 }
\ No newline at end of file
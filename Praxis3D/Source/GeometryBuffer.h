@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "ErrorCodes.h"
 #include "Framebuffer.h"
 
@@ -37,6 +39,9 @@ public:
 		switch(p_buffer)
 		{
 		case GBufferTextureType::GBufferPosition:
+			// In the thin layout, positions are reconstructed from the depth buffer
+			glBindTexture(GL_TEXTURE_2D, m_thinLayout ? m_depthBuffer : m_GBTextures[p_buffer]);
+			break;
 		case GBufferTextureType::GBufferDiffuse:
 		case GBufferTextureType::GBufferNormal:
 		case GBufferTextureType::GBufferEmissive:
@@ -127,7 +132,7 @@ public:
 		switch(p_bufferTextureType)
 		{
 		case GBufferTextureType::GBufferPosition:
-			return m_GBTextures[p_bufferTextureType];
+			return m_thinLayout ? m_depthBuffer : m_GBTextures[p_bufferTextureType];
 			break;
 		case GBufferTextureType::GBufferDiffuse:
 			return m_GBTextures[p_bufferTextureType];
@@ -147,13 +152,36 @@ public:
 		case GBufferTextureType::GBufferIntermediate:
 			return m_intermediateBuffer;
 			break;
+		case GBufferTextureType::GbufferDepth:
+			return m_depthBuffer;
+			break;
 		default:
 			return 0;
 			break;
 		}
 	}
+	inline bool isThinLayout() const { return m_thinLayout; }
+
+	// Set the size of the sub-rectangle (at the bottom-left corner of the buffers) that the scene is rendered to, which is clamped to the buffer size;
+	// used for dynamic resolution, so the rendering resolution can change without reallocating the buffers
+	inline void setRenderSize(const unsigned int p_renderWidth, const unsigned int p_renderHeight)
+	{
+		m_renderWidth = std::max(std::min(p_renderWidth, m_bufferWidth), 1u);
+		m_renderHeight = std::max(std::min(p_renderHeight, m_bufferHeight), 1u);
+	}
+	inline unsigned int getRenderWidth() const { return m_renderWidth; }
+	inline unsigned int getRenderHeight() const { return m_renderHeight; }
+
+	// Returns the total size of all geometry pass buffers (including the depth buffer) of a single pixel, for either of the layouts
+	static unsigned int getBytesPerPixel(const bool p_thinLayout);
 
 protected:
+	// Update the estimated video memory of all the buffers, from their size and formats
+	void updateMemorySize();
+
+	// Position buffer is not used in the thin layout
+	inline bool isBufferUsed(const GLuint p_buffer) const { return !(m_thinLayout && p_buffer == GBufferPosition); }
+
 	inline void bindBufferToImageUnit(const GBufferTextureType p_buffer, const int p_imageUnitIndex, const int p_mipLevel, const GLenum p_access)
 	{
 		switch(p_buffer)
@@ -195,4 +223,11 @@ protected:
 			m_textureTypes[GBufferNumTextures];
 
 	GBufferTextureType m_finalPassBuffer;
+
+	// Size of the sub-rectangle that the scene is rendered to
+	unsigned int m_renderWidth,
+				 m_renderHeight;
+
+	// Set if the thin geometry buffer layout is used (position reconstructed from depth, octahedral normals, packed material properties)
+	bool m_thinLayout;
 };
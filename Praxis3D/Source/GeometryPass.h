@@ -35,7 +35,7 @@ public:
 			m_shaderGeometry = Loaders::shader().load(geomShaderProperties);
 
 			// Load the shader to memory
-			if(ErrorCode shaderError = loadGeometryShaderToMemory(m_shaderGeometry))
+			if(ErrorCode shaderError = loadGeometryShaderToMemory(m_shaderGeometry, false, false))
 				returnError = shaderError;
 		}
 
@@ -51,7 +51,7 @@ public:
 			m_shaderGeometryStochastic = Loaders::shader().load(geomShaderProperties);
 
 			// Load the shader to memory
-			if(ErrorCode shaderError = loadGeometryStochasticShaderToMemory(m_shaderGeometryStochastic))
+			if(ErrorCode shaderError = loadGeometryShaderToMemory(m_shaderGeometryStochastic, true, false))
 				returnError = shaderError;
 		}
 
@@ -67,7 +67,7 @@ public:
 			m_shaderGeometryStochasticParallaxMap = Loaders::shader().load(geomShaderProperties);
 
 			// Load the shader to memory
-			if(ErrorCode shaderError = loadGeometryStochasticParallaxShaderToMemory(m_shaderGeometryStochasticParallaxMap))
+			if(ErrorCode shaderError = loadGeometryShaderToMemory(m_shaderGeometryStochasticParallaxMap, true, true))
 				returnError = shaderError;
 		}
 
@@ -83,7 +83,7 @@ public:
 			m_shaderGeometryParallaxMap = Loaders::shader().load(geomShaderProperties);
 
 			// Load the shader to memory
-			if(ErrorCode shaderError = loadGeometryParallaxShaderToMemory(m_shaderGeometryParallaxMap))
+			if(ErrorCode shaderError = loadGeometryShaderToMemory(m_shaderGeometryParallaxMap, false, true))
 				returnError = shaderError;
 		}
 
@@ -120,8 +120,8 @@ public:
 			m_shaderGeometryStochasticParallaxMap->resetLoadedToVideoMemoryFlag();
 
 			// Reload the affected shaders
-			loadGeometryStochasticShaderToMemory(m_shaderGeometryStochastic);
-			loadGeometryStochasticParallaxShaderToMemory(m_shaderGeometryStochasticParallaxMap);
+			loadGeometryShaderToMemory(m_shaderGeometryStochastic, true, false);
+			loadGeometryShaderToMemory(m_shaderGeometryStochasticParallaxMap, true, true);
 
 			// Process shader load commands
 			m_renderer.passLoadCommandsToBackend();
@@ -182,14 +182,20 @@ public:
 			auto geomShaderHandle = m_shaderGeometry->getShaderHandle();
 			auto &geomUniformUpdater = m_shaderGeometry->getUniformUpdater();
 
-			// Iterate over all objects to be rendered with geometry shader
-			for(auto entity : p_sceneObjects.m_models)
-			{
-				ModelComponent &model = p_sceneObjects.m_models.get<ModelComponent>(entity);
-				if(model.isObjectActive())
+			// Get the camera details used to select the level of detail of each mesh
+			const glm::vec3 cameraPosition = m_renderer.getFrameData().m_cameraPosition;
+			const float lodProjectionScale = m_renderer.getLODProjectionScale();
+			const float lodBias = Config::rendererVar().lod_bias;
+
+			// Iterate over all objects to be rendered with geometry shader; draw commands are generated in parallel, in chunks of objects
+			m_renderer.queueForDrawingParallel(p_sceneObjects.m_renderSnapshot->m_models, [&](RendererBackend::DrawCommands &p_drawCommands, const RenderSnapshot::ModelEntry &p_modelEntry)
 				{
 					// Get the model data from the ModelComponent, that holds all the drawing data
-					auto &modelData = model.getModelData();
+					auto &modelData = p_modelEntry.m_model->getModelData();
+
+					// Calculate model-view-projection matrix
+					const glm::mat4 &modelMatrix = p_modelEntry.m_modelMatrix;
+					const glm::mat4 modelViewProjMatrix = m_renderer.m_viewProjMatrix * modelMatrix;
 
 					// Go over each model
 					for(decltype(modelData.size()) modelIndex = 0, modelSize = modelData.size(); modelIndex < modelSize; modelIndex++)
@@ -197,104 +203,55 @@ public:
 						// Go over each mesh
 						for(decltype(modelData[modelIndex].m_model.getNumMeshes()) meshIndex = 0, meshSize = modelData[modelIndex].m_model.getNumMeshes(); meshIndex < meshSize; meshIndex++)
 						{
-							// Calculate model-view-projection matrix
-							const glm::mat4 &modelMatrix = p_sceneObjects.m_models.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransformWithScale();
-							const glm::mat4 modelViewProjMatrix = m_renderer.m_viewProjMatrix * modelMatrix;
-
-							// Only draw active meshes
-							if(modelData[modelIndex].m_meshes[meshIndex].m_active)
+							// Only draw active meshes that are not hidden behind occluders
+							if(modelData[modelIndex].m_meshes[meshIndex].m_active && !m_renderer.isMeshOccluded(modelData[modelIndex].m_model[meshIndex], modelMatrix))
 							{
 								// Choose a shader based on whether the texture repetition and parallax mapping are turned on for the given mesh
+								ShaderLoader::ShaderProgram *shader = nullptr;
 								if(modelData[modelIndex].m_meshes[meshIndex].m_stochasticSampling)
 								{
 									if(modelData[modelIndex].m_meshes[meshIndex].m_heightScale > 0.0f)
-									{
-										// TEXTURE REPETITION and PARALLAX MAPPING enabled
-										m_renderer.queueForDrawing(
-											modelData[modelIndex].m_model[meshIndex], 
-											modelData[modelIndex].m_meshes[meshIndex], 
-											modelData[modelIndex].m_model.getHandle(), 
-											m_shaderGeometryStochasticParallaxMap->getShaderHandle(), 
-											m_shaderGeometryStochasticParallaxMap->getUniformUpdater(), 
-											DrawCommandTextureBinding::DrawCommandTextureBinding_All,
-											modelData[modelIndex].m_drawFaceCulling,
-											modelMatrix, 
-											modelViewProjMatrix);
-									}
+										shader = m_shaderGeometryStochasticParallaxMap;	// TEXTURE REPETITION and PARALLAX MAPPING enabled
 									else
-									{
-										// TEXTURE REPETITION enabled
-										m_renderer.queueForDrawing(
-											modelData[modelIndex].m_model[meshIndex], 
-											modelData[modelIndex].m_meshes[meshIndex], 
-											modelData[modelIndex].m_model.getHandle(), 
-											m_shaderGeometryStochastic->getShaderHandle(), 
-											m_shaderGeometryStochastic->getUniformUpdater(), 
-											DrawCommandTextureBinding::DrawCommandTextureBinding_All,
-											modelData[modelIndex].m_drawFaceCulling,
-											modelMatrix, 
-											modelViewProjMatrix);
-									}
+										shader = m_shaderGeometryStochastic;				// TEXTURE REPETITION enabled
 								}
 								else
 								{
 									if(modelData[modelIndex].m_meshes[meshIndex].m_heightScale > 0.0f)
-									{
-										// PARALLAX MAPPING enabled
-										m_renderer.queueForDrawing(
-											modelData[modelIndex].m_model[meshIndex], 
-											modelData[modelIndex].m_meshes[meshIndex], 
-											modelData[modelIndex].m_model.getHandle(), 
-											m_shaderGeometryParallaxMap->getShaderHandle(),
-											m_shaderGeometryParallaxMap->getUniformUpdater(), 
-											DrawCommandTextureBinding::DrawCommandTextureBinding_All,
-											modelData[modelIndex].m_drawFaceCulling,
-											modelMatrix, 
-											modelViewProjMatrix);
-									}
-									else
-									{
-										// Regular geometry pass
-										m_renderer.queueForDrawing(
-											modelData[modelIndex].m_model[meshIndex], 
-											modelData[modelIndex].m_meshes[meshIndex], 
-											modelData[modelIndex].m_model.getHandle(), 
-											geomShaderHandle, 
-											geomUniformUpdater, 
-											DrawCommandTextureBinding::DrawCommandTextureBinding_All,
-											modelData[modelIndex].m_drawFaceCulling,
-											modelMatrix, 
-											modelViewProjMatrix);
-									}
+										shader = m_shaderGeometryParallaxMap;				// PARALLAX MAPPING enabled
 								}
+
+								RendererFrontend::queueForDrawing(
+									p_drawCommands,
+									modelData[modelIndex].m_model[meshIndex], 
+									modelData[modelIndex].m_meshes[meshIndex], 
+									modelData[modelIndex].m_model.getHandle(), 
+									shader != nullptr ? shader->getShaderHandle() : geomShaderHandle, 
+									shader != nullptr ? shader->getUniformUpdater() : geomUniformUpdater, 
+									DrawCommandTextureBinding::DrawCommandTextureBinding_All,
+									modelData[modelIndex].m_drawFaceCulling,
+									modelMatrix, 
+									modelViewProjMatrix,
+									RendererFrontend::selectMeshLOD(modelData[modelIndex].m_model[meshIndex], modelMatrix, cameraPosition, lodProjectionScale, lodBias));
 							}
 						}
 					}
-				}
-			}
+				});
 
 			// Iterate over all objects to be rendered with a custom shader
-			for(auto entity : p_sceneObjects.m_modelsWithShaders)
+			for(const auto &modelEntry : p_sceneObjects.m_renderSnapshot->m_modelsWithShaders)
 			{
-				ModelComponent &model = p_sceneObjects.m_modelsWithShaders.get<ModelComponent>(entity);
-				if(model.isObjectActive())
-				{
-					SpatialComponent &spatialData = p_sceneObjects.m_modelsWithShaders.get<SpatialComponent>(entity);
-					ShaderComponent &shader = p_sceneObjects.m_modelsWithShaders.get<ShaderComponent>(entity);
-					if(shader.isLoadedToVideoMemory())
-					{
-						auto &modelData = model.getModelData();
+				auto &modelData = modelEntry.m_model->getModelData();
+				auto &shader = modelEntry.m_shader->getShaderData()->m_shader;
 
-						for(decltype(modelData.size()) i = 0, size = modelData.size(); i < size; i++)
-						{
-							m_renderer.queueForDrawing(modelData[i],
-								shader.getShaderData()->m_shader.getShaderHandle(),
-								shader.getShaderData()->m_shader.getUniformUpdater(),
-								DrawCommandTextureBinding::DrawCommandTextureBinding_All,
-								spatialData.getSpatialDataChangeManager().getWorldTransformWithScale(),
-								m_renderer.m_viewProjMatrix);
-						}
-					}
+				for(decltype(modelData.size()) i = 0, size = modelData.size(); i < size; i++)
+				{
+					m_renderer.queueForDrawing(modelData[i],
+						shader.getShaderHandle(),
+						shader.getUniformUpdater(),
+						DrawCommandTextureBinding::DrawCommandTextureBinding_All,
+						modelEntry.m_modelMatrix,
+						m_renderer.m_viewProjMatrix);
 				}
 			}
 
@@ -303,100 +260,21 @@ public:
 		}
 	}
 
-private:
-	ErrorCode loadGeometryShaderToMemory(ShaderLoader::ShaderProgram *p_shader)
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
 	{
-		ErrorCode shaderError = p_shader->loadToMemory();
-
-		if(shaderError == ErrorCode::Success)
-		{
-			// Set whether the normal texture compression is enabled in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_normalMapCompression, Config::textureVar().texture_normal_compression ? 1 : 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_normalMapCompression, ErrorSource::Source_GeometryPass);
-
-			// Set the number of material types in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_numOfMaterialTypes, MaterialType::MaterialType_NumOfTypes); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_numOfMaterialTypes, ErrorSource::Source_GeometryPass);
-
-			// Disable stochastic sampling in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSampling, 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSampling, ErrorSource::Source_GeometryPass);
-
-			// Disable parallax mapping in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_parallaxMapping, 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMapping, ErrorSource::Source_GeometryPass);
-
-			// Queue the shader to be loaded to GPU
-			m_renderer.queueForLoading(*p_shader);
-		}
-
-		return shaderError;
+		p_passBuilder.write(RenderGraphResource::GBufferPosition);
+		p_passBuilder.write(RenderGraphResource::GBufferDiffuse);
+		p_passBuilder.write(RenderGraphResource::GBufferNormal);
+		p_passBuilder.write(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.write(RenderGraphResource::GBufferMatProperties);
+		p_passBuilder.write(RenderGraphResource::GBufferDepth);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
 	}
-	ErrorCode loadGeometryStochasticShaderToMemory(ShaderLoader::ShaderProgram *p_shader)
-	{
-		ErrorCode shaderError = p_shader->loadToMemory();
-
-		if(shaderError == ErrorCode::Success)
-		{
-			// Set whether the normal texture compression is enabled in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_normalMapCompression, Config::textureVar().texture_normal_compression ? 1 : 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_normalMapCompression, ErrorSource::Source_GeometryPass);
 
-			// Set the number of material types in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_numOfMaterialTypes, MaterialType::MaterialType_NumOfTypes); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_numOfMaterialTypes, ErrorSource::Source_GeometryPass);
-
-			// Enable stochastic sampling in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSampling, 1); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSampling, ErrorSource::Source_GeometryPass);
-
-			// Disable parallax mapping in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_parallaxMapping, 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMapping, ErrorSource::Source_GeometryPass);
-
-			// Set stochastic sampling mipmap seam fix flag in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSamplingSeamFix, m_renderer.getFrameData().m_miscSceneData.m_stochasticSamplingSeamFix ? 1 : 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSamplingSeamFix, ErrorSource::Source_GeometryPass);
-
-			// Queue the shader to be loaded to GPU
-			m_renderer.queueForLoading(*p_shader);
-		}
-
-		return shaderError;
-	}
-	ErrorCode loadGeometryParallaxShaderToMemory(ShaderLoader::ShaderProgram *p_shader)
-	{
-		ErrorCode shaderError = p_shader->loadToMemory();
-
-		if(shaderError == ErrorCode::Success)
-		{
-			// Set whether the normal texture compression is enabled in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_normalMapCompression, Config::textureVar().texture_normal_compression ? 1 : 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_normalMapCompression, ErrorSource::Source_GeometryPass);
-
-			// Set the number of material types in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_numOfMaterialTypes, MaterialType::MaterialType_NumOfTypes); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_numOfMaterialTypes, ErrorSource::Source_GeometryPass);
-
-			// Disable stochastic sampling in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSampling, 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSampling, ErrorSource::Source_GeometryPass);
-
-			// Enable parallax mapping in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_parallaxMapping, 1); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMapping, ErrorSource::Source_GeometryPass);
-
-			// Set the parallax mapping method in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_parallaxMappingMethod, Config::rendererVar().parallax_mapping_method); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMappingMethod, ErrorSource::Source_GeometryPass);
-
-			// Queue the shader to be loaded to GPU
-			m_renderer.queueForLoading(*p_shader);
-		}
-
-		return shaderError;
-	}
-	ErrorCode loadGeometryStochasticParallaxShaderToMemory(ShaderLoader::ShaderProgram *p_shader)
+private:
+	// Set the #define values of the geometry shader permutation (stochastic sampling and parallax mapping enabled or disabled) and queue it to be loaded to GPU.
+	// All permutations share the same (cached) source code and are only compiled if their program binary is not present in the shader binary cache
+	ErrorCode loadGeometryShaderToMemory(ShaderLoader::ShaderProgram *p_shader, const bool p_stochasticSampling, const bool p_parallaxMapping)
 	{
 		ErrorCode shaderError = p_shader->loadToMemory();
 
@@ -410,21 +288,27 @@ private:
 			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_numOfMaterialTypes, MaterialType::MaterialType_NumOfTypes); shaderVariableError != ErrorCode::Success)
 				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_numOfMaterialTypes, ErrorSource::Source_GeometryPass);
 
-			// Enable stochastic sampling in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSampling, 1); shaderVariableError != ErrorCode::Success)
+			// Enable or disable stochastic sampling in the shader
+			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSampling, p_stochasticSampling ? 1 : 0); shaderVariableError != ErrorCode::Success)
 				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSampling, ErrorSource::Source_GeometryPass);
 
-			// Enable parallax mapping in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_parallaxMapping, 1); shaderVariableError != ErrorCode::Success)
+			// Enable or disable parallax mapping in the shader
+			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_parallaxMapping, p_parallaxMapping ? 1 : 0); shaderVariableError != ErrorCode::Success)
 				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMapping, ErrorSource::Source_GeometryPass);
 
 			// Set stochastic sampling mipmap seam fix flag in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSamplingSeamFix, m_renderer.getFrameData().m_miscSceneData.m_stochasticSamplingSeamFix ? 1 : 0); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSamplingSeamFix, ErrorSource::Source_GeometryPass);
+			if(p_stochasticSampling)
+				if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_stochasticSamplingSeamFix, m_renderer.getFrameData().m_miscSceneData.m_stochasticSamplingSeamFix ? 1 : 0); shaderVariableError != ErrorCode::Success)
+					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_stochasticSamplingSeamFix, ErrorSource::Source_GeometryPass);
 
 			// Set the parallax mapping method in the shader
-			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_parallaxMappingMethod, Config::rendererVar().parallax_mapping_method); shaderVariableError != ErrorCode::Success)
-				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMappingMethod, ErrorSource::Source_GeometryPass);
+			if(p_parallaxMapping)
+				if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_parallaxMappingMethod, Config::rendererVar().parallax_mapping_method); shaderVariableError != ErrorCode::Success)
+					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_parallaxMappingMethod, ErrorSource::Source_GeometryPass);
+
+			// Set the geometry buffer layout
+			if(ErrorCode shaderVariableError = p_shader->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_GeometryPass);
 
 			// Queue the shader to be loaded to GPU
 			m_renderer.queueForLoading(*p_shader);
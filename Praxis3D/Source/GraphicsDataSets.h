@@ -8,66 +8,12 @@
 #include "Math.h"
 #include "Loaders.h"
 
-struct MaterialParameters
-{
-	MaterialParameters() : m_color(1.0f), m_scale(1.0f), m_framing(0.0f) { }
-
-	inline bool operator==(const MaterialParameters &p_matOaram)
-	{
-		return	m_color == p_matOaram.m_color &&
-				m_scale == p_matOaram.m_scale &&
-				m_framing == p_matOaram.m_framing;
-	}
-
-	glm::vec4 m_color;
-	glm::vec2 m_scale;
-	glm::vec2 m_framing;
-};
-
-struct MaterialData
-{
-	MaterialData() { }
-
-	inline bool operator==(const MaterialData &p_matData)
-	{
-		for(unsigned int i = 0; i < MaterialType::MaterialType_NumOfTypes; i++)
-			if(m_parameters[i] != p_matData.m_parameters[i])
-				return false;
-
-		return true;
-	}
-
-	MaterialParameters m_parameters[MaterialType::MaterialType_NumOfTypes];
-};
-
-// Contains data of a single mesh and its materials
+// Contains data of a single mesh and its material
 struct MeshData
 {
 	MeshData(
 		const Model::Mesh &p_mesh,
-		const float p_heightScale,
-		const float p_alphaThreshold,
-		const float p_emissiveIntensity,
-		const bool p_textureRepetition,
-		const float p_rextureRepetitionScale,
-		const TextureWrapType p_textureWrapMode,
-		const bool p_active = true) :
-		m_mesh(&p_mesh),
-		m_materials(MaterialType::MaterialType_NumOfTypes, Loaders::texture2D().getDefaultTexture()),
-		m_heightScale(p_heightScale),
-		m_alphaThreshold(p_alphaThreshold),
-		m_emissiveIntensity(p_emissiveIntensity),
-		m_textureWrapMode(p_textureWrapMode),
-		m_stochasticSampling(p_textureRepetition),
-		m_textureRepetitionScale(p_rextureRepetitionScale),
-		m_active(p_active)
-	{
-	}
-
-	MeshData(
-		const Model::Mesh &p_mesh,
-		const std::vector<TextureLoader2D::Texture2DHandle> &p_materials,
-		const MaterialData &p_materialData,
+		const MaterialID p_materialID,
 		const float p_heightScale, 
 		const float p_alphaThreshold, 
 		const float p_emissiveIntensity, 
@@ -76,8 +22,7 @@ struct MeshData
 		const TextureWrapType p_textureWrapMode, 
 		const bool p_active = true) :
 		m_mesh(&p_mesh),
-		m_materials(p_materials),
-		m_materialData(p_materialData),
+		m_materialID(p_materialID),
 		m_heightScale(p_heightScale),
 		m_alphaThreshold(p_alphaThreshold),
 		m_emissiveIntensity(p_emissiveIntensity),
@@ -86,11 +31,11 @@ struct MeshData
 		m_textureRepetitionScale(p_textureRepetitionScale),
 		m_active(p_active)
 	{
-		// Make sure the material arrays are of the right size
-		if(m_materials.size() != MaterialType::MaterialType_NumOfTypes)
-			m_materials.resize(MaterialType::MaterialType_NumOfTypes, Loaders::texture2D().getDefaultTexture());
 	}
 
+	// Returns the interned material (textures and material parameters) of the mesh
+	inline const MaterialRegistry::Material &getMaterial() const { return Loaders::material().getMaterial(m_materialID); }
+
 	// Texture parallax effect scale (height multiplier)
 	float m_heightScale;
 	// Transparency threshold after which the fragment is discarded
@@ -109,9 +54,8 @@ struct MeshData
 	// Handle to a mesh
 	const Model::Mesh *m_mesh;
 
-	// An array of materials of each type
-	std::vector<TextureLoader2D::Texture2DHandle> m_materials;
-	MaterialData m_materialData;
+	// Material shared between all meshes with identical textures and material parameters
+	MaterialID m_materialID;
 };
 
 // Contains data of a single model and its meshes
@@ -111,6 +111,14 @@ public:
 		p_renderPassData.swapColorInputOutputMaps();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.read(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::GBufferEmissive);
+	}
+
 private:
 	// Buffer handles used for binding
 	std::vector<GeometryBuffer::GBufferTexture> m_emissiveAndOutputBuffers;
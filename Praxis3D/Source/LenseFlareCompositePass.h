@@ -93,6 +93,13 @@ public:
 		p_renderPassData.swapColorInputOutputMaps();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.read(RenderGraphResource::GBufferDiffuse);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	// Buffer handles used for binding
 	std::vector<GeometryBuffer::GBufferTexture> m_diffuseAndOutputBuffers;
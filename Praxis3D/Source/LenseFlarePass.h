@@ -137,6 +137,13 @@ public:
 		p_renderPassData.m_numOfBlurPasses = Config::graphicsVar().lens_flare_blur_passes;
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		// Lens flare is drawn to the diffuse buffer, which is no longer needed after the lighting
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::GBufferDiffuse);
+	}
+
 private:
 	// Buffer handles used for binding
 	std::vector<GeometryBuffer::GBufferTexture> m_diffuseAndOutputBuffers;
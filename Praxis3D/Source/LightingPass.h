@@ -29,6 +29,10 @@ public:
 		m_pointLightBuffer.m_bindingIndex = UniformBufferBinding_PointLights;
 		m_spotLightBuffer.m_bindingIndex = UniformBufferBinding_SpotLights;
 
+		// Light buffers are updated every frame
+		m_pointLightBuffer.m_perFrame = true;
+		m_spotLightBuffer.m_perFrame = true;
+
 		// Set the light buffer sizes
 		m_pointLightBuffer.m_size = sizeof(PointLightDataSet) * m_maxNumPointLights;
 		m_spotLightBuffer.m_size = sizeof(SpotLightDataSet) * m_maxNumSpotLights;
@@ -75,6 +79,10 @@ public:
 				if(ErrorCode shaderVariableError = m_shaderLightPass->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_shadowMapping, 0); shaderVariableError != ErrorCode::Success)
 					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_shadowMapping, ErrorSource::Source_LightingPass);
 
+				// Set the geometry buffer layout
+				if(ErrorCode shaderVariableError = m_shaderLightPass->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_LightingPass);
+
 				// Queue the shader to be loaded to GPU
 				m_renderer.queueForLoading(*m_shaderLightPass);
 			}
@@ -118,6 +126,10 @@ public:
 				if(ErrorCode shaderVariableError = m_shaderLightCSMPass->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_numOfPCFSamples, m_numOfPCFSamples); shaderVariableError != ErrorCode::Success)
 					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_numOfPCFSamples, ErrorSource::Source_LightingPass);
 
+				// Set the geometry buffer layout
+				if(ErrorCode shaderVariableError = m_shaderLightCSMPass->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+					ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_LightingPass);
+
 				// Queue the shader to be loaded to GPU
 				m_renderer.queueForLoading(*m_shaderLightCSMPass);
 			}
@@ -148,62 +160,14 @@ public:
 		glDepthFunc(GL_GREATER);
 		glDepthMask(GL_FALSE);
 
-		// Clear light arrays from previous frame
-		m_pointLights.clear();
-		m_spotLights.clear();
-		m_directionalLight.clear();
-
-		// Iterate over all objects to be rendered with geometry shader
-		for(auto entity : p_sceneObjects.m_lights)
-		{
-			LightComponent &lightComponent = p_sceneObjects.m_lights.get<LightComponent>(entity);
-
-			// Check if the light is enabled
-			if(lightComponent.isObjectActive())
-			{
-				SpatialComponent &spatialComponent = p_sceneObjects.m_lights.get<SpatialComponent>(entity);
-
-				// Add the light data to the corresponding array, based on the light type
-				switch(lightComponent.getLightType())
-				{
-				case LightComponent::LightComponentType_point:
-				{
-					if(m_pointLights.size() < m_maxNumPointLights)
-					{
-						// Update position of the light data set
-						PointLightDataSet *lightDataSet = lightComponent.getPointLight();
-						lightDataSet->m_position = spatialComponent.getSpatialDataChangeManager().getWorldTransform()[3];
-
-						m_pointLights.push_back(*lightDataSet);
-					}
-				}
-				break;
+		// Copy the lights captured in the render snapshot, up to the maximum number of each light type
+		const RenderSnapshot &renderSnapshot = *p_sceneObjects.m_renderSnapshot;
+		m_pointLights.assign(renderSnapshot.m_pointLights.begin(), renderSnapshot.m_pointLights.begin() + std::min(renderSnapshot.m_pointLights.size(), (std::size_t)m_maxNumPointLights));
+		m_spotLights.assign(renderSnapshot.m_spotLights.begin(), renderSnapshot.m_spotLights.begin() + std::min(renderSnapshot.m_spotLights.size(), (std::size_t)m_maxNumSpotLights));
 
-				case LightComponent::LightComponentType_spot:
-				{
-					if(m_spotLights.size() < m_maxNumSpotLights)
-					{
-						// Update position and rotation of the light data set
-						SpotLightDataSet *lightDataSet = lightComponent.getSpotLight();
-						lightDataSet->m_position = spatialComponent.getSpatialDataChangeManager().getWorldTransform()[3];
-						lightDataSet->m_direction = spatialComponent.getSpatialDataChangeManager().getWorldTransform()[2];
-
-						m_spotLights.push_back(*lightDataSet);
-					}
-				}
-				break;
-
-				case LightComponent::LightComponentType_directional:
-				{
-					DirectionalLightDataSet *lightDataSet = lightComponent.getDirectionalLight();
-					lightDataSet->m_direction = spatialComponent.getSpatialDataChangeManager().getWorldTransform()[2];
-
-					m_directionalLight = *lightDataSet;
-				}
-				break;
-				}
-			}
-		}
+		m_directionalLight.clear();
+		if(renderSnapshot.m_directionalLightPresent)
+			m_directionalLight = renderSnapshot.m_directionalLight;
 
 		// Set the directional light data so it can be sent to the shader
 		m_renderer.m_frameData.m_directionalLight = m_directionalLight;
@@ -301,6 +265,20 @@ public:
 		p_renderPassData.swapColorInputOutputMaps();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::GBufferPosition);
+		p_passBuilder.read(RenderGraphResource::GBufferDiffuse);
+		p_passBuilder.read(RenderGraphResource::GBufferNormal);
+		p_passBuilder.read(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.read(RenderGraphResource::GBufferMatProperties);
+		p_passBuilder.read(RenderGraphResource::GBufferDepth);
+		p_passBuilder.read(RenderGraphResource::CSMDepth);
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::GBufferEmissive);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	ShaderLoader::ShaderProgram *m_shaderLightPass;
 	ShaderLoader::ShaderProgram	*m_shaderLightCSMPass;
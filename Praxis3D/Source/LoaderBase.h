@@ -7,6 +7,9 @@
 #include <queue>
 
 #include "ErrorCodes.h"
+#include "ErrorHandlerLocator.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "TaskManagerLocator.h"
 
 template <class TDerived, class TObject>
@@ -19,7 +22,7 @@ public:
 		friend class LoaderBase;
 	public:
 		UniqueObject(LoaderBase *p_loaderBase, size_t p_uniqueIDs, std::string p_filename)
-			: m_loaderBase(p_loaderBase), m_uniqueID(p_uniqueIDs), m_filename(p_filename)
+			: m_loaderBase(p_loaderBase), m_uniqueID(p_uniqueIDs), m_filename(p_filename), m_memoryTracker(p_loaderBase->m_memoryTag)
 		{
 			m_loadingToMemoryError = ErrorCode::Failure;
 			m_queuedLoadToVideoMemory = false;
@@ -27,6 +30,9 @@ public:
 			m_loadedToVideoMemory = false;
 			m_beingLoaded = false;
 			m_refCounter = 0;
+			m_cpuDataInterest = 0;
+			m_cpuDataReleased = false;
+			m_unused = false;
 		}
 		virtual ~UniqueObject()
 		{
@@ -62,6 +68,36 @@ public:
 		inline const std::string &getFilename() const		{ return m_filename;				}
 		inline size_t getReferenceCounter() const			{ return m_refCounter;				}
 
+		// Returns the number of bytes the object occupies in the given memory (video memory sizes are estimates)
+		inline int64_t getMemorySize(const MemoryType p_type) const	{ return m_memoryTracker.getSize(p_type);	}
+		inline int64_t getMemorySize() const						{ return m_memoryTracker.getSize();			}
+		// Returns the number of system memory bytes released after the object was uploaded to video memory
+		inline int64_t getSavedMemorySize() const					{ return m_memoryTracker.getSavedSize();	}
+
+		// Register a consumer that reads the system memory copy of the data (e.g. physics mesh cooking), so that it isn't released after
+		// the object is uploaded to video memory. If the data has already been released, it is reloaded before returning
+		inline ErrorCode registerCPUDataInterest()
+		{
+			bool reloadRequired = false;
+			{
+				SpinWait::Lock lock(m_mutex);
+				m_cpuDataInterest++;
+				reloadRequired = m_cpuDataReleased;
+			}
+
+			return reloadRequired ? static_cast<TObject *>(this)->reloadCPUData() : ErrorCode::Success;
+		}
+		// Unregister a consumer; the data is kept until it is uploaded again or the object is unloaded
+		inline void unregisterCPUDataInterest()
+		{
+			SpinWait::Lock lock(m_mutex);
+			if(m_cpuDataInterest > 0)
+				m_cpuDataInterest--;
+		}
+
+		// Returns true if the system memory copy of the data was released after the upload to video memory
+		inline const bool isCPUDataReleased() const { return m_cpuDataReleased; }
+
 		// Equality operator; compares filenames
 		inline bool operator==(std::string p_string) { return m_filename == p_string; }
 
@@ -69,22 +105,37 @@ public:
 	protected:
 		inline const bool isBeingLoaded() { return m_beingLoaded; }
 
+		// Set the number of bytes the object occupies in the given memory, which is accounted to the memory tag of the loader
+		inline void setMemorySize(const MemoryType p_type, const int64_t p_bytes) { m_memoryTracker.setSize(p_type, p_bytes); }
+		inline void setSavedMemorySize(const int64_t p_bytes) { m_memoryTracker.setSavedSize(p_bytes); }
+
+		inline LoaderBase *getLoaderBase() const { return m_loaderBase; }
+
 		std::atomic_bool	m_beingLoaded,
 							m_queuedLoadToVideoMemory,
 							m_loadedToMemory,
-							m_loadedToVideoMemory;
+							m_loadedToVideoMemory,
+							m_cpuDataReleased;
 
 		ErrorCode m_loadingToMemoryError;
 		std::string m_filename;
 		SpinWait m_mutex;
 		size_t m_uniqueID;
 		int m_refCounter;
+		MemoryTrackerEntry m_memoryTracker;
+
+		// Number of consumers that need the system memory copy of the data to be kept after the upload to video memory
+		int m_cpuDataInterest;
 
 	private:
 		LoaderBase *m_loaderBase;
+
+		// Set while the object is in the list of unused objects that are kept loaded, and its position in the list
+		bool m_unused;
+		typename std::list<UniqueObject *>::iterator m_unusedObjectsIterator;
 	};
 
-	LoaderBase() : m_queueIsEmpty(true) 
+	LoaderBase(const MemoryTag p_memoryTag, const ErrorSource p_errorSource) : m_queueIsEmpty(true), m_memoryTag(p_memoryTag), m_errorSource(p_errorSource), m_budgetExceededLogged(false)
 	{ 
 		m_objectPool.reserve(SETTING_LOADER_RESERVE_SIZE);
 	}
@@ -102,14 +153,22 @@ public:
 		m_objectPool.clear();
 	}
 
-	// Unloads the oldest object in the queue (if there are any)
-	// Only process one object, and should be called once per frame, to level out performance degradation
+	// Unloads the oldest objects in the queue (if there are any), up to the configured number of objects per frame,
+	// and should be called once per frame, to level out performance degradation.
+	// If the loader's memory tag has a budget, objects that are no longer used are kept loaded (so they can be reused without
+	// loading them again), and the least recently used of them are only unloaded while the memory of the loader's objects is over the budget
 	inline void processReleaseQueue(SceneLoader &p_sceneLoader)
 	{
+		PROFILE_ZONE("LoaderBase::processReleaseQueue");
+
+		const int64_t memoryBudget = MemoryTracker::getBudget(m_memoryTag);
+		const auto maxNumOfUnloads = Config::engineVar().loaders_num_of_unload_per_frame;
+		decltype(Config::engineVar().loaders_num_of_unload_per_frame) numOfUnloads = 0;
+
 		// First check if the queue isn't empty
 		if(!m_queueIsEmpty)
 		{
-			for(decltype(Config::engineVar().loaders_num_of_unload_per_frame) i = 0, max = Config::engineVar().loaders_num_of_unload_per_frame; i < max;)
+			while(numOfUnloads < maxNumOfUnloads)
 			{
 				auto *object = m_objectUnloadQueue.front();
 
@@ -118,10 +177,24 @@ public:
 				// so just remove it without deleting it
 				if(object->m_refCounter < 1)
 				{
-					// Unload the object from RAM and VRAM
-					unload(*static_cast<TObject *>(object), p_sceneLoader);
-					m_objectRemoveQueue.push_back(object);
-					i++;
+					if(memoryBudget > 0)
+					{
+						// Keep the object loaded, as the most recently used of the unused objects
+						if(object->m_unused)
+							m_unusedObjects.splice(m_unusedObjects.end(), m_unusedObjects, object->m_unusedObjectsIterator);
+						else
+						{
+							object->m_unusedObjectsIterator = m_unusedObjects.insert(m_unusedObjects.end(), object);
+							object->m_unused = true;
+						}
+					}
+					else if(!object->m_unused)
+					{
+						// Unload the object from RAM and VRAM
+						unload(*static_cast<TObject *>(object), p_sceneLoader);
+						m_objectRemoveQueue.push_back(object);
+						numOfUnloads++;
+					}
 				}
 
 				// Remove object from queue
@@ -130,11 +203,42 @@ public:
 				if(m_objectUnloadQueue.empty())
 				{
 					m_queueIsEmpty = true;
-					return;
+					break;
 				}
 			}
 		}
 
+		// Unload the least recently used of the unused objects while over the budget (or all of them, if the budget was removed);
+		// the memory of unloaded objects is only released once they are removed, so it is subtracted from the usage here
+		int64_t memoryUsage = MemoryTracker::getUsage(m_memoryTag);
+		while(!m_unusedObjects.empty() && numOfUnloads < maxNumOfUnloads && (memoryBudget <= 0 || memoryUsage > memoryBudget))
+		{
+			auto *object = m_unusedObjects.front();
+			m_unusedObjects.pop_front();
+			object->m_unused = false;
+
+			// Objects that were acquired again after being released are still in use
+			if(object->m_refCounter < 1)
+			{
+				unload(*static_cast<TObject *>(object), p_sceneLoader);
+				m_objectRemoveQueue.push_back(object);
+				memoryUsage -= object->getMemorySize();
+				numOfUnloads++;
+			}
+		}
+
+		// Report when the objects that are in use don't fit into the budget on their own (only once, until the usage falls below the budget)
+		if(memoryBudget > 0 && memoryUsage > memoryBudget && m_unusedObjects.empty())
+		{
+			if(!m_budgetExceededLogged)
+			{
+				ErrHandlerLoc::get().log(ErrorCode::Memory_budget_exceeded, m_errorSource, MemoryTracker::getTagName(m_memoryTag));
+				m_budgetExceededLogged = true;
+			}
+		}
+		else
+			m_budgetExceededLogged = false;
+
 		if(!m_objectRemoveQueue.empty())
 		{
 			for(decltype(m_objectRemoveQueue.size()) i = 0, size = m_objectRemoveQueue.size(); i < size; i++)
@@ -200,4 +304,12 @@ private:
 	
 	std::queue<UniqueObject *> m_objectUnloadQueue;
 	std::vector<UniqueObject *> m_objectRemoveQueue;
+
+	// Objects that are no longer used, but are kept loaded while within the memory budget; ordered from the least recently used one
+	std::list<UniqueObject *> m_unusedObjects;
+
+	// Tag that the memory of the objects is accounted to, and the source of the logged errors
+	const MemoryTag m_memoryTag;
+	const ErrorSource m_errorSource;
+	bool m_budgetExceededLogged;
 };
\ No newline at end of file
@@ -4,3 +4,6 @@ ModelLoader Loaders::m_modelLoader;
 ShaderLoader Loaders::m_shaderLoader;
 TextureLoader2D Loaders::m_texture2DLoader;
 TextureLoaderCubemap Loaders::m_textureCubemapLoader;
+
+// Defined after the texture loaders, as materials hold texture handles and must be destroyed first
+MaterialRegistry Loaders::m_materialRegistry;
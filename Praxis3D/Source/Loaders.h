@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MaterialRegistry.h"
 #include "ModelLoader.h"
 #include "ShaderLoader.h"
 #include "TextureLoader.h"
@@ -13,10 +14,12 @@ public:
 	inline static ShaderLoader &shader() { return m_shaderLoader; }
 	inline static TextureLoader2D &texture2D() { return m_texture2DLoader; }
 	inline static TextureLoaderCubemap &textureCubemap() { return m_textureCubemapLoader; }
+	inline static MaterialRegistry &material() { return m_materialRegistry; }
 	
 private:
 	static ModelLoader m_modelLoader;
 	static ShaderLoader m_shaderLoader;
 	static TextureLoader2D m_texture2DLoader;
 	static TextureLoaderCubemap m_textureCubemapLoader;
+	static MaterialRegistry m_materialRegistry;
 };
\ No newline at end of file
@@ -235,6 +235,7 @@ void LuaScript::setFunctions()
 	m_luaState.set_function("importPrefab", sol::overload(
 		[this](ComponentsConstructionInfo &p_constructionInfo, const std::string &p_filename) -> bool { return m_scriptScene->getSceneLoader()->importPrefab(p_constructionInfo, p_filename, false) == ErrorCode::Success; },
 		[this](ComponentsConstructionInfo &p_constructionInfo, const std::string &p_filename, const bool p_forceReload) -> bool { return m_scriptScene->getSceneLoader()->importPrefab(p_constructionInfo, p_filename, p_forceReload) == ErrorCode::Success; }));
+	m_luaState.set_function("spawnPrefab", [this](const std::string &p_filename, const sol::table &p_transforms) -> sol::as_table_t<std::vector<EntityID>> { return sol::as_table(spawnPrefab(p_filename, p_transforms)); });
 
 	// Entity component functions
 	m_luaState.set_function("getRigidBodyComponent", [this](const EntityID p_entityID) -> RigidBodyComponent *{ return static_cast<WorldScene *>(m_scriptScene->getSceneLoader()->getSystemScene(Systems::World))->getEntityRegistry().try_get<RigidBodyComponent>(p_entityID); });
@@ -372,6 +373,9 @@ void LuaScript::setFunctions()
 
 	// Physics functions
 	m_luaState.set_function("getPhysicsSimulationRunning", [this]() -> const bool { return static_cast<PhysicsScene *>(m_scriptScene->getSceneLoader()->getSystemScene(Systems::Physics))->getSimulationRunning(); });
+	m_luaState.set_function("submitSpatialQueries", [this](const sol::table &p_queries) -> SpatialQueryBatchID { return submitSpatialQueries(p_queries); });
+	m_luaState.set_function("getSpatialQueryResults", [this](const SpatialQueryBatchID p_batchID) -> sol::as_table_t<std::vector<SpatialQueryResult>> { return sol::as_table(getSpatialQueryResults(p_batchID)); });
+	m_luaState.set_function("getSpatialQueryOverlaps", [this](const SpatialQueryBatchID p_batchID) -> sol::as_table_t<std::vector<EntityID>> { return sol::as_table(getSpatialQueryOverlaps(p_batchID)); });
 }
 
 void LuaScript::setUsertypes()
@@ -403,6 +407,11 @@ void LuaScript::setUsertypes()
 		"Emissive", MaterialType::MaterialType_Emissive,
 		"Combined", MaterialType::MaterialType_Combined);
 
+	m_luaState.new_enum("SpatialQueryType",
+		"Ray", SpatialQueryType::SpatialQueryType_Ray,
+		"SphereSweep", SpatialQueryType::SpatialQueryType_SphereSweep,
+		"AabbOverlap", SpatialQueryType::SpatialQueryType_AabbOverlap);
+
 	m_luaState.new_enum("SystemType",
 		GetString(Systems::TypeID::Null), Systems::TypeID::Null,
 		GetString(Systems::TypeID::Audio), Systems::TypeID::Audio,
@@ -475,6 +484,7 @@ void LuaScript::setUsertypes()
 		"mouse_sensitivity", &Config::InputVariables::mouse_sensitivity);
 
 	m_luaState.new_usertype<Config::PathsVariables>("PathsVariables",
+		"collider_cache_path", &Config::PathsVariables::collider_cache_path,
 		"config_path", &Config::PathsVariables::config_path,
 		"engine_assets_path", &Config::PathsVariables::engine_assets_path,
 		"gui_assets_path", &Config::PathsVariables::gui_assets_path,
@@ -483,6 +493,7 @@ void LuaScript::setUsertypes()
 		"object_path", &Config::PathsVariables::object_path,
 		"prefab_path", &Config::PathsVariables::prefab_path,
 		"script_path", &Config::PathsVariables::script_path,
+		"shader_cache_path", &Config::PathsVariables::shader_cache_path,
 		"shader_path", &Config::PathsVariables::shader_path,
 		"sound_path", &Config::PathsVariables::sound_path,
 		"texture_path", &Config::PathsVariables::texture_path);
@@ -732,6 +743,31 @@ void LuaScript::setUsertypes()
 		"spatialPresent", [](const WorldComponentsConstructionInfo &c1) -> bool { return c1.m_spatialConstructionInfo != nullptr; },
 		"createSpatial", [](WorldComponentsConstructionInfo &c1) -> void { if(c1.m_spatialConstructionInfo != nullptr) delete c1.m_spatialConstructionInfo; c1.m_spatialConstructionInfo = new SpatialComponent::SpatialComponentConstructionInfo(); });
 
+	m_luaState.new_usertype<PrefabSpawnTransform>("PrefabSpawnTransform",
+		sol::constructors<PrefabSpawnTransform(), PrefabSpawnTransform(const glm::vec3 &), PrefabSpawnTransform(const glm::vec3 &, const glm::quat &, const glm::vec3 &)>(),
+		"m_position", &PrefabSpawnTransform::m_position,
+		"m_rotation", &PrefabSpawnTransform::m_rotation,
+		"m_scale", &PrefabSpawnTransform::m_scale);
+
+	m_luaState.new_usertype<SpatialQuery>("SpatialQuery",
+		sol::constructors<SpatialQuery(), SpatialQuery(const SpatialQueryType, const glm::vec3 &, const glm::vec3 &), SpatialQuery(const SpatialQueryType, const glm::vec3 &, const glm::vec3 &, const float)>(),
+		"ray", &SpatialQuery::ray,
+		"sphereSweep", &SpatialQuery::sphereSweep,
+		"aabbOverlap", &SpatialQuery::aabbOverlap,
+		"m_type", &SpatialQuery::m_type,
+		"m_from", &SpatialQuery::m_from,
+		"m_to", &SpatialQuery::m_to,
+		"m_radius", &SpatialQuery::m_radius);
+
+	m_luaState.new_usertype<SpatialQueryResult>("SpatialQueryResult",
+		"m_hitPosition", sol::readonly(&SpatialQueryResult::m_hitPosition),
+		"m_hitNormal", sol::readonly(&SpatialQueryResult::m_hitNormal),
+		"m_hitFraction", sol::readonly(&SpatialQueryResult::m_hitFraction),
+		"m_entityID", sol::readonly(&SpatialQueryResult::m_entityID),
+		"m_firstOverlap", sol::readonly(&SpatialQueryResult::m_firstOverlap),
+		"m_numOfOverlaps", sol::readonly(&SpatialQueryResult::m_numOfOverlaps),
+		"m_hit", sol::readonly(&SpatialQueryResult::m_hit));
+
 	m_luaState.new_usertype<CameraComponent::CameraComponentConstructionInfo>("CameraComponentConstructionInfo",
 		"m_active", &CameraComponent::CameraComponentConstructionInfo::m_active,
 		"m_name", &CameraComponent::CameraComponentConstructionInfo::m_name,
@@ -750,6 +786,8 @@ void LuaScript::setUsertypes()
 	m_luaState.new_usertype<ModelComponent::ModelComponentConstructionInfo>("ModelComponentConstructionInfo",
 		"m_active", &ModelComponent::ModelComponentConstructionInfo::m_active,
 		"m_name", &ModelComponent::ModelComponentConstructionInfo::m_name,
+		"m_staticShadowCaster", &ModelComponent::ModelComponentConstructionInfo::m_staticShadowCaster,
+		"m_occluder", &ModelComponent::ModelComponentConstructionInfo::m_occluder,
 		"setMaterialColor", [=](ModelComponent::ModelComponentConstructionInfo &p_this, const int p_modelIndex, const int p_meshIndex, const MaterialType p_materialType, const glm::vec4 &p_color) -> void { p_this.m_modelsProperties.m_models[p_modelIndex].m_meshData[p_meshIndex].m_meshMaterialColors[p_materialType] = p_color; });
 
 	m_luaState.new_usertype<ShaderComponent::ShaderComponentConstructionInfo>("ShaderComponentConstructionInfo",
@@ -1023,3 +1061,72 @@ void LuaScript::createObjectInLua(const unsigned int p_objectType, const std::st
 		}
 	}
 }
+
+std::vector<EntityID> LuaScript::spawnPrefab(const std::string &p_filename, const sol::table &p_transforms)
+{
+	std::vector<EntityID> spawnedEntities;
+
+	// Gather the transforms into a contiguous array; entries that are not a position or a transform are skipped
+	FrameVector<PrefabSpawnTransform> transforms;
+	transforms.reserve(p_transforms.size());
+
+	for(const auto &transform : p_transforms)
+	{
+		if(transform.second.is<PrefabSpawnTransform>())
+			transforms.push_back(transform.second.as<PrefabSpawnTransform>());
+		else
+			if(transform.second.is<glm::vec3>())
+				transforms.emplace_back(transform.second.as<glm::vec3>());
+	}
+
+	spawnedEntities.reserve(transforms.size());
+	m_scriptScene->getSceneLoader()->spawnPrefab(p_filename, transforms, &spawnedEntities);
+
+	return spawnedEntities;
+}
+
+SpatialQueryBatchID LuaScript::submitSpatialQueries(const sol::table &p_queries)
+{
+	// Gather the queries into a contiguous array; results are returned in the same order as the queries, so a batch
+	// containing an entry that is not a spatial query is rejected as a whole, instead of shifting the result indices
+	FrameVector<SpatialQuery> queries;
+	queries.reserve(p_queries.size());
+
+	for(const auto &query : p_queries)
+	{
+		if(!query.second.is<SpatialQuery>())
+		{
+			ErrHandlerLoc::get().log(ErrorType::Error, ErrorSource::Source_LuaScript, "submitSpatialQueries: entry #" + Utilities::toString(queries.size() + 1) + " is not a SpatialQuery; the whole batch was rejected");
+			return 0;
+		}
+
+		queries.push_back(query.second.as<SpatialQuery>());
+	}
+
+	if(queries.empty())
+		return 0;
+
+	return static_cast<PhysicsScene *>(m_scriptScene->getSceneLoader()->getSystemScene(Systems::Physics))->getSpatialQueryService().submitBatch(queries);
+}
+
+std::vector<SpatialQueryResult> LuaScript::getSpatialQueryResults(const SpatialQueryBatchID p_batchID)
+{
+	std::span<const SpatialQueryResult> results;
+	std::span<const EntityID> overlaps;
+
+	if(static_cast<PhysicsScene *>(m_scriptScene->getSceneLoader()->getSystemScene(Systems::Physics))->getSpatialQueryService().getBatchResults(p_batchID, results, overlaps))
+		return std::vector<SpatialQueryResult>(results.begin(), results.end());
+
+	return std::vector<SpatialQueryResult>();
+}
+
+std::vector<EntityID> LuaScript::getSpatialQueryOverlaps(const SpatialQueryBatchID p_batchID)
+{
+	std::span<const SpatialQueryResult> results;
+	std::span<const EntityID> overlaps;
+
+	if(static_cast<PhysicsScene *>(m_scriptScene->getSceneLoader()->getSystemScene(Systems::Physics))->getSpatialQueryService().getBatchResults(p_batchID, results, overlaps))
+		return std::vector<EntityID>(overlaps.begin(), overlaps.end());
+
+	return std::vector<EntityID>();
+}
@@ -4,7 +4,9 @@
 #include "ErrorHandlerLocator.h"
 #include "GUIDataManager.h"
 #include "GUIHandler.h"
+#include "MemoryTracker.h"
 #include "SpatialDataManager.h"
+#include "SpatialQueryService.h"
 #include "WindowLocator.h"
 
 #include <functional>
@@ -108,7 +110,7 @@ class LuaScript
 	friend class LuaComponent;
 public:
 	LuaScript(SystemScene *p_scriptScene, SystemObject *p_luaComponent, SpatialDataManager &p_spatialData, GUIDataManager &p_GUIData) : 
-		m_scriptScene(p_scriptScene), m_luaComponent(p_luaComponent), m_spatialData(p_spatialData), m_GUIData(p_GUIData)
+		m_scriptScene(p_scriptScene), m_luaComponent(p_luaComponent), m_spatialData(p_spatialData), m_GUIData(p_GUIData), m_memoryTracker(MemoryTag_Scripting)
 	{ 
 		m_keyCommands.reserve(10);
 		m_conditionals.reserve(10);
@@ -116,7 +118,7 @@ public:
 		resetErrorFlag();
 	}
 	LuaScript(SystemScene *p_scriptScene, SystemObject *p_luaComponent, SpatialDataManager &p_spatialData, GUIDataManager &p_GUIData, std::string &p_scriptFilename) : 
-		m_scriptScene(p_scriptScene), m_luaComponent(p_luaComponent), m_spatialData(p_spatialData), m_GUIData(p_GUIData), m_luaScriptFilename(p_scriptFilename)
+		m_scriptScene(p_scriptScene), m_luaComponent(p_luaComponent), m_spatialData(p_spatialData), m_GUIData(p_GUIData), m_luaScriptFilename(p_scriptFilename), m_memoryTracker(MemoryTag_Scripting)
 	{
 		m_keyCommands.reserve(10);
 		m_conditionals.reserve(10);
@@ -168,6 +170,8 @@ public:
 			returnError = ErrorCode::Lua_load_script_failed;
 		}
 
+		m_memoryTracker.setSize(MemoryType_RAM, (int64_t)m_luaState.memory_used());
+
 		return returnError;
 	}
 
@@ -201,6 +205,9 @@ public:
 				else
 					m_updateFuncRanWithNoErrors = true;
 			}
+
+			// Lua state allocations change with every update, as the script creates and collects its objects
+			m_memoryTracker.setSize(MemoryType_RAM, (int64_t)m_luaState.memory_used());
 		}
 	}
 
@@ -295,6 +302,22 @@ private:
 	// Should only be called from the lua script
 	void createObjectInLua(const unsigned int p_objectType, const std::string p_variableName);
 
+	// Spawns an entity of the given prefab for every entry in the table (each entry being either a Vec3 position or a PrefabSpawnTransform)
+	// Returns the created entity IDs. Should only be called from the lua script
+	std::vector<EntityID> spawnPrefab(const std::string &p_filename, const sol::table &p_transforms);
+
+	// Submits the spatial queries in the table as a single batch, executed after the next physics simulation step
+	// Returns the batch ID, or zero if the batch was rejected. Should only be called from the lua script
+	SpatialQueryBatchID submitSpatialQueries(const sol::table &p_queries);
+
+	// Returns the results of the batch (one per submitted query), or an empty array if the results are not available (yet or anymore)
+	// Should only be called from the lua script
+	std::vector<SpatialQueryResult> getSpatialQueryResults(const SpatialQueryBatchID p_batchID);
+
+	// Returns the overlapping entities of all AABB overlap queries of the batch; each result's m_firstOverlap is a zero-based offset into it
+	// Should only be called from the lua script
+	std::vector<EntityID> getSpatialQueryOverlaps(const SpatialQueryBatchID p_batchID);
+
 	// Registers a change in some data
 	// Should only be called from the lua script
 	void registerChange(const Int64Packer &p_packer)
@@ -317,6 +340,9 @@ private:
 	sol::state m_luaState;
 	std::string m_luaScriptFilename;
 
+	// Memory held by the Lua state, accounted to scripting
+	MemoryTrackerEntry m_memoryTracker;
+
 	// Function binds that call functions inside the lua script
 	sol::protected_function m_luaInit;
 	sol::protected_function m_luaUpdate;
@@ -156,6 +156,12 @@ public:
 
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	ShaderLoader::ShaderProgram *m_luminanceHistogramShader;
 	ShaderLoader::ShaderProgram *m_luminanceAverageShader;
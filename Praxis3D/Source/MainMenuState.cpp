@@ -25,5 +25,11 @@ void MainMenuState::update(Engine &p_engine)
 	m_objectChangeController->distributeChanges();
 	m_sceneChangeController->distributeChanges();
 
+	m_sceneLoader.processSaveRequest();
+
+	m_sceneLoader.updateWorldStreaming();
+
+	captureRenderSnapshot();
+
 	updateSceneLoadingStatus();
 }
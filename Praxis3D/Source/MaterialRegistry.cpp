@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cassert>
+
+#include "MaterialRegistry.h"
+
+std::size_t MaterialRegistry::MaterialKeyHasher::operator()(const MaterialKey &p_key) const
+{
+	std::size_t hash = 0;
+	const auto combine = [&hash](const std::size_t p_value) { hash ^= p_value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+	for(unsigned int i = 0; i < MaterialType::MaterialType_NumOfTypes; i++)
+	{
+		combine(std::hash<std::string>{}(p_key.m_textureFilenames[i]));
+
+		const MaterialParameters &parameters = p_key.m_materialData.m_parameters[i];
+		for(unsigned int component = 0; component < 4; component++)
+			combine(std::hash<float>{}(parameters.m_color[component]));
+		for(unsigned int component = 0; component < 2; component++)
+		{
+			combine(std::hash<float>{}(parameters.m_scale[component]));
+			combine(std::hash<float>{}(parameters.m_framing[component]));
+		}
+	}
+
+	return hash;
+}
+
+MaterialRegistry::MaterialRegistry()
+{
+	m_numOfAllocatedMaterials = 0;
+}
+
+MaterialRegistry::~MaterialRegistry()
+{
+}
+
+MaterialID MaterialRegistry::acquireMaterial(const std::vector<TextureLoader2D::Texture2DHandle> &p_textures, const MaterialData &p_materialData)
+{
+	MaterialKey key;
+	for(decltype(p_textures.size()) i = 0, size = std::min(p_textures.size(), (size_t)MaterialType::MaterialType_NumOfTypes); i < size; i++)
+		key.m_textureFilenames[i] = p_textures[i].getFilename();
+	key.m_materialData = p_materialData;
+
+	SpinWait::Lock lock(m_mutex);
+
+	// If the material already exists, reference it
+	auto materialID = m_materialIDs.find(key);
+	if(materialID != m_materialIDs.end())
+	{
+		getEntry(materialID->second).m_referenceCount++;
+		return materialID->second;
+	}
+
+	// Reuse the ID of a released material, or allocate a new one
+	MaterialID newMaterialID = NULL_MATERIAL_ID;
+	if(!m_freeMaterialIDs.empty())
+	{
+		newMaterialID = m_freeMaterialIDs.back();
+		m_freeMaterialIDs.pop_back();
+	}
+	else
+	{
+		newMaterialID = m_numOfAllocatedMaterials++;
+
+		// Allocate a new chunk when the previous ones are full
+		if(newMaterialID % MaterialChunkSize == 0)
+		{
+			assert(newMaterialID / MaterialChunkSize < MaxNumOfMaterialChunks && "Material registry is full");
+			m_chunks[newMaterialID / MaterialChunkSize] = std::make_unique<MaterialEntry[]>(MaterialChunkSize);
+		}
+	}
+
+	auto &newEntry = getEntry(newMaterialID);
+	newEntry.m_material.m_textures = p_textures;
+	newEntry.m_material.m_materialData = p_materialData;
+	newEntry.m_key = &m_materialIDs.emplace(std::move(key), newMaterialID).first->first;
+	newEntry.m_referenceCount = 1;
+
+	return newMaterialID;
+}
+
+void MaterialRegistry::releaseMaterial(const MaterialID p_materialID)
+{
+	if(p_materialID == NULL_MATERIAL_ID)
+		return;
+
+	SpinWait::Lock lock(m_mutex);
+
+	auto &entry = getEntry(p_materialID);
+	if(entry.m_referenceCount == 0)
+		return;
+
+	entry.m_referenceCount--;
+
+	// Release the textures and the ID, once the material is no longer used
+	if(entry.m_referenceCount == 0)
+	{
+		m_materialIDs.erase(m_materialIDs.find(*entry.m_key));
+		entry.m_key = nullptr;
+		entry.m_material.m_textures.clear();
+		m_freeMaterialIDs.push_back(p_materialID);
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SpinWait.h"
+#include "TextureLoader.h"
+
+struct MaterialParameters
+{
+	MaterialParameters() : m_color(1.0f), m_scale(1.0f), m_framing(0.0f) { }
+
+	inline bool operator==(const MaterialParameters &p_matOaram) const
+	{
+		return	m_color == p_matOaram.m_color &&
+				m_scale == p_matOaram.m_scale &&
+				m_framing == p_matOaram.m_framing;
+	}
+
+	glm::vec4 m_color;
+	glm::vec2 m_scale;
+	glm::vec2 m_framing;
+};
+
+struct MaterialData
+{
+	MaterialData() { }
+
+	inline bool operator==(const MaterialData &p_matData) const
+	{
+		for(unsigned int i = 0; i < MaterialType::MaterialType_NumOfTypes; i++)
+			if(m_parameters[i] != p_matData.m_parameters[i])
+				return false;
+
+		return true;
+	}
+
+	MaterialParameters m_parameters[MaterialType::MaterialType_NumOfTypes];
+};
+
+// Identifies an interned material; 32 bits wide, so it can be packed into the draw command sort key
+typedef std::uint32_t MaterialID;
+constexpr MaterialID NULL_MATERIAL_ID = std::numeric_limits<MaterialID>::max();
+
+// Interns materials: a material (a texture of each material type and the material parameters) is created once,
+// and every mesh using identical textures and parameters references it by its ID, instead of holding its own copy.
+// Meshes that override any texture or parameter reference a separate material, made of that exact combination.
+// Materials are reference counted and released when no mesh references them anymore
+class MaterialRegistry
+{
+public:
+	struct Material
+	{
+		// A texture of each material type
+		std::vector<TextureLoader2D::Texture2DHandle> m_textures;
+		MaterialData m_materialData;
+	};
+
+	MaterialRegistry();
+	~MaterialRegistry();
+
+	// Returns the ID of the material made of the given textures (one for each material type) and parameters,
+	// creating the material if it doesn't exist yet, and increments its reference count. Thread-safe
+	MaterialID acquireMaterial(const std::vector<TextureLoader2D::Texture2DHandle> &p_textures, const MaterialData &p_materialData);
+
+	// Decrements the reference count of the material, releasing it (and its textures) when it is no longer referenced. Thread-safe
+	void releaseMaterial(const MaterialID p_materialID);
+
+	// Material storage is never moved, so an acquired material can be read without locking, while other materials are being acquired
+	inline Material &getMaterial(const MaterialID p_materialID) { return getEntry(p_materialID).m_material; }
+	inline const Material &getMaterial(const MaterialID p_materialID) const { return getEntry(p_materialID).m_material; }
+
+	// Getters
+	inline size_t getNumOfMaterials() const { return m_materialIDs.size(); }
+
+private:
+	static constexpr MaterialID MaterialChunkSize = 1024;
+	static constexpr MaterialID MaxNumOfMaterialChunks = 65536;
+
+	struct MaterialKey
+	{
+		inline bool operator==(const MaterialKey &p_other) const
+		{
+			for(unsigned int i = 0; i < MaterialType::MaterialType_NumOfTypes; i++)
+				if(m_textureFilenames[i] != p_other.m_textureFilenames[i])
+					return false;
+
+			return m_materialData == p_other.m_materialData;
+		}
+
+		std::string m_textureFilenames[MaterialType::MaterialType_NumOfTypes];
+		MaterialData m_materialData;
+	};
+
+	struct MaterialKeyHasher
+	{
+		std::size_t operator()(const MaterialKey &p_key) const;
+	};
+
+	struct MaterialEntry
+	{
+		MaterialEntry() : m_key(nullptr), m_referenceCount(0) { }
+
+		Material m_material;
+
+		// Key of the material inside the ID map (map elements are never moved, unlike its iterators, which are invalidated when rehashing)
+		const MaterialKey *m_key;
+		size_t m_referenceCount;
+	};
+
+	inline MaterialEntry &getEntry(const MaterialID p_materialID) { return m_chunks[p_materialID / MaterialChunkSize][p_materialID % MaterialChunkSize]; }
+	inline const MaterialEntry &getEntry(const MaterialID p_materialID) const { return m_chunks[p_materialID / MaterialChunkSize][p_materialID % MaterialChunkSize]; }
+
+	// Fixed-size chunks of materials, allocated on demand; chunks are never reallocated, so material references stay valid
+	std::unique_ptr<MaterialEntry[]> m_chunks[MaxNumOfMaterialChunks];
+	MaterialID m_numOfAllocatedMaterials;
+
+	// IDs of released materials, reused before allocating new ones
+	std::vector<MaterialID> m_freeMaterialIDs;
+
+	std::unordered_map<MaterialKey, MaterialID, MaterialKeyHasher> m_materialIDs;
+
+	// Materials are acquired while loading multiple models at once
+	SpinWait m_mutex;
+};
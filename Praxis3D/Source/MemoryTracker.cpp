@@ -0,0 +1,165 @@
+#include <GL/glew.h>
+
+#include "Config.h"
+#include "MemoryTracker.h"
+
+std::atomic<int64_t> MemoryTracker::m_usage[MemoryTag_NumOfTags][MemoryType_NumOfTypes] = {};
+std::atomic<int64_t> MemoryTracker::m_peakUsage[MemoryTag_NumOfTags][MemoryType_NumOfTypes] = {};
+std::atomic<int64_t> MemoryTracker::m_savedUsage[MemoryTag_NumOfTags] = {};
+
+int64_t MemoryTracker::getTotalUsage(const MemoryType p_type)
+{
+	int64_t totalUsage = 0;
+
+	for(unsigned int i = 0; i < MemoryTag_NumOfTags; i++)
+		totalUsage += getUsage(static_cast<MemoryTag>(i), p_type);
+
+	return totalUsage;
+}
+
+int64_t MemoryTracker::getTotalSavedUsage()
+{
+	int64_t totalSavedUsage = 0;
+
+	for(unsigned int i = 0; i < MemoryTag_NumOfTags; i++)
+		totalSavedUsage += getSavedUsage(static_cast<MemoryTag>(i));
+
+	return totalSavedUsage;
+}
+
+int64_t MemoryTracker::getBudget(const MemoryTag p_tag)
+{
+	// Budgets are set in megabytes
+	switch(p_tag)
+	{
+		case MemoryTag_Models:
+			return (int64_t)Config::engineVar().loaders_model_memory_budget_mb * 1048576;
+		case MemoryTag_Textures:
+			return (int64_t)Config::engineVar().loaders_texture_memory_budget_mb * 1048576;
+		default:
+			return 0;
+	}
+}
+
+const char *MemoryTracker::getTagName(const MemoryTag p_tag)
+{
+	switch(p_tag)
+	{
+		case MemoryTag_Models:
+			return "Models";
+		case MemoryTag_Textures:
+			return "Textures";
+		case MemoryTag_Framebuffers:
+			return "Framebuffers";
+		case MemoryTag_RendererBuffers:
+			return "Renderer buffers";
+		case MemoryTag_Audio:
+			return "Audio";
+		case MemoryTag_Scripting:
+			return "Scripting";
+		default:
+			return "Unknown";
+	}
+}
+
+unsigned int MemoryTracker::getInternalFormatSize(const int p_internalFormat)
+{
+	switch(p_internalFormat)
+	{
+	case GL_R8:
+	case GL_R8_SNORM:
+		return 1;
+	case GL_R16F:
+	case GL_R16:
+	case GL_R16_SNORM:
+	case GL_R16I:
+	case GL_R16UI:
+	case GL_RG8:
+	case GL_RG8_SNORM:
+	case GL_DEPTH_COMPONENT16:
+		return 2;
+	case GL_RGB8:
+	case GL_RGB8_SNORM:
+	case GL_DEPTH_COMPONENT24:
+		return 3;
+	case GL_R32F:
+	case GL_R32I:
+	case GL_R32UI:
+	case GL_RG16F:
+	case GL_RG16:
+	case GL_RG16_SNORM:
+	case GL_RGBA8:
+	case GL_RGBA8_SNORM:
+	case GL_RGB10_A2:
+	case GL_R11F_G11F_B10F:
+	case GL_DEPTH_COMPONENT32:
+	case GL_DEPTH_COMPONENT32F:
+	case GL_DEPTH24_STENCIL8:
+		return 4;
+	case GL_RGB16F:
+	case GL_RGB16:
+	case GL_RGB16_SNORM:
+		return 6;
+	case GL_RG32F:
+	case GL_RGBA16F:
+	case GL_RGBA16:
+	case GL_RGBA16_SNORM:
+	case GL_DEPTH32F_STENCIL8:
+		return 8;
+	case GL_RGB32F:
+		return 12;
+	case GL_RGBA32F:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+int64_t MemoryTracker::getTextureMemorySize(const int p_internalFormat, const unsigned int p_width, const unsigned int p_height, const unsigned int p_numOfLayers, const bool p_mipmaps)
+{
+	// Size of a 4x4 block of compressed formats; the generic compressed formats are left up to the driver, and are assumed to be the BC1 and BC3 equivalents
+	int64_t blockSize = 0;
+	switch(p_internalFormat)
+	{
+	case GL_COMPRESSED_RGB:
+	case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+	case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+	case GL_COMPRESSED_RED_RGTC1:
+	case GL_COMPRESSED_R11_EAC:
+	case GL_COMPRESSED_RGB8_ETC2:
+		blockSize = 8;
+		break;
+	case GL_COMPRESSED_RGBA:
+	case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+	case GL_COMPRESSED_RG_RGTC2:
+	case GL_COMPRESSED_RGBA_BPTC_UNORM:
+	case GL_COMPRESSED_RG11_EAC:
+	case GL_COMPRESSED_RGBA8_ETC2_EAC:
+		blockSize = 16;
+		break;
+	}
+
+	const int64_t pixelSize = getInternalFormatSize(p_internalFormat);
+
+	int64_t textureSize = 0;
+	unsigned int width = p_width;
+	unsigned int height = p_height;
+
+	// Add the size of each mipmap level, down to a single pixel
+	while(true)
+	{
+		if(blockSize > 0)
+			textureSize += (int64_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+		else
+			textureSize += (int64_t)width * height * pixelSize;
+
+		if(!p_mipmaps || (width <= 1 && height <= 1))
+			break;
+
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	return textureSize * p_numOfLayers;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Subsystems and asset types that memory is accounted to
+enum MemoryTag : unsigned int
+{
+	MemoryTag_Models = 0,
+	MemoryTag_Textures,
+	MemoryTag_Framebuffers,
+	MemoryTag_RendererBuffers,
+	MemoryTag_Audio,
+	MemoryTag_Scripting,
+	MemoryTag_NumOfTags
+};
+
+enum MemoryType : unsigned int
+{
+	MemoryType_RAM = 0,
+	MemoryType_VRAM,
+	MemoryType_NumOfTypes
+};
+
+// Engine-wide memory accounting: holds the number of bytes in system memory (RAM) and video memory (VRAM) for each tag, which are updated
+// by the code that allocates and frees the memory, or sampled from libraries that report their own totals. Video memory sizes are estimates,
+// calculated from the sizes and formats of the uploaded data (the driver doesn't report them). Asset tags can be given a budget, which the
+// loaders enforce by unloading their least recently used unused assets
+class MemoryTracker
+{
+public:
+	// Add the given number of bytes (subtract, if negative) to the tag's counter; can be called from any thread
+	inline static void add(const MemoryTag p_tag, const MemoryType p_type, const int64_t p_bytes)
+	{
+		if(p_bytes != 0)
+			updatePeakUsage(p_tag, p_type, m_usage[p_tag][p_type].fetch_add(p_bytes, std::memory_order_relaxed) + p_bytes);
+	}
+
+	// Replace the tag's counter with the given number of bytes; used for libraries that report their own totals (e.g. audio and scripting)
+	inline static void set(const MemoryTag p_tag, const MemoryType p_type, const int64_t p_bytes)
+	{
+		m_usage[p_tag][p_type].store(p_bytes, std::memory_order_relaxed);
+		updatePeakUsage(p_tag, p_type, p_bytes);
+	}
+
+	// Getters
+	inline static int64_t getUsage(const MemoryTag p_tag, const MemoryType p_type) { return m_usage[p_tag][p_type].load(std::memory_order_relaxed); }
+	inline static int64_t getUsage(const MemoryTag p_tag) { return getUsage(p_tag, MemoryType_RAM) + getUsage(p_tag, MemoryType_VRAM); }
+	inline static int64_t getPeakUsage(const MemoryTag p_tag, const MemoryType p_type) { return m_peakUsage[p_tag][p_type].load(std::memory_order_relaxed); }
+	static int64_t getTotalUsage(const MemoryType p_type);
+
+	// Add the given number of bytes (subtract, if negative) to the tag's saved system memory, that was released by objects that are still in use
+	// (e.g. copies of asset data that are only needed until the asset is uploaded to video memory)
+	inline static void addSaved(const MemoryTag p_tag, const int64_t p_bytes) { m_savedUsage[p_tag].fetch_add(p_bytes, std::memory_order_relaxed); }
+	inline static int64_t getSavedUsage(const MemoryTag p_tag) { return m_savedUsage[p_tag].load(std::memory_order_relaxed); }
+	static int64_t getTotalSavedUsage();
+
+	// Returns the budget (in bytes) of the tag's total memory usage, or 0 if the tag has no budget
+	static int64_t getBudget(const MemoryTag p_tag);
+
+	// Returns true if the tag has a budget and its total memory usage is above it
+	inline static bool isOverBudget(const MemoryTag p_tag)
+	{
+		const int64_t budget = getBudget(p_tag);
+		return budget > 0 && getUsage(p_tag) > budget;
+	}
+
+	static const char *getTagName(const MemoryTag p_tag);
+
+	// Returns the size of a single pixel of the given sized, uncompressed internal format, in bytes (0 for unknown and compressed formats)
+	static unsigned int getInternalFormatSize(const int p_internalFormat);
+
+	// Returns the estimated video memory size of a texture (or all the layers of a texture array) of the given internal format, including all
+	// of its mipmap levels, if it has any; compressed formats are estimated by their block size
+	static int64_t getTextureMemorySize(const int p_internalFormat, const unsigned int p_width, const unsigned int p_height, const unsigned int p_numOfLayers = 1, const bool p_mipmaps = false);
+
+private:
+	inline static void updatePeakUsage(const MemoryTag p_tag, const MemoryType p_type, const int64_t p_usage)
+	{
+		int64_t peakUsage = m_peakUsage[p_tag][p_type].load(std::memory_order_relaxed);
+		while(p_usage > peakUsage && !m_peakUsage[p_tag][p_type].compare_exchange_weak(peakUsage, p_usage, std::memory_order_relaxed));
+	}
+
+	static std::atomic<int64_t> m_usage[MemoryTag_NumOfTags][MemoryType_NumOfTypes];
+	static std::atomic<int64_t> m_peakUsage[MemoryTag_NumOfTags][MemoryType_NumOfTypes];
+	static std::atomic<int64_t> m_savedUsage[MemoryTag_NumOfTags];
+};
+
+// Memory held by a single object, accounted to a tag. Keeps the sizes that were last set, so the tag's counters are adjusted by the difference
+// whenever a size changes, and the object's memory is subtracted from them when it is destroyed. Sizes of each memory type must be set from one thread at a time
+class MemoryTrackerEntry
+{
+public:
+	MemoryTrackerEntry(const MemoryTag p_tag) : m_tag(p_tag)
+	{
+		for(unsigned int i = 0; i < MemoryType_NumOfTypes; i++)
+			m_size[i] = 0;
+
+		m_savedSize = 0;
+	}
+	~MemoryTrackerEntry()
+	{
+		for(unsigned int i = 0; i < MemoryType_NumOfTypes; i++)
+			MemoryTracker::add(m_tag, static_cast<MemoryType>(i), -m_size[i]);
+
+		MemoryTracker::addSaved(m_tag, -m_savedSize);
+	}
+
+	// The memory is owned by a single object, so it cannot be copied
+	MemoryTrackerEntry(const MemoryTrackerEntry &p_entry) = delete;
+	MemoryTrackerEntry &operator=(const MemoryTrackerEntry &p_entry) = delete;
+
+	inline void setSize(const MemoryType p_type, const int64_t p_bytes)
+	{
+		MemoryTracker::add(m_tag, p_type, p_bytes - m_size[p_type]);
+		m_size[p_type] = p_bytes;
+	}
+
+	// Set the number of system memory bytes that the object has released while still being in use
+	inline void setSavedSize(const int64_t p_bytes)
+	{
+		MemoryTracker::addSaved(m_tag, p_bytes - m_savedSize);
+		m_savedSize = p_bytes;
+	}
+
+	inline MemoryTag getTag() const { return m_tag; }
+	inline int64_t getSize(const MemoryType p_type) const { return m_size[p_type]; }
+	inline int64_t getSize() const { return m_size[MemoryType_RAM] + m_size[MemoryType_VRAM]; }
+	inline int64_t getSavedSize() const { return m_savedSize; }
+
+private:
+	const MemoryTag m_tag;
+	int64_t m_size[MemoryType_NumOfTypes];
+	int64_t m_savedSize;
+};
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include "MeshSimplifier.h"
+
+namespace
+{
+	// Lexicographic comparison of vectors, used to sort vertices so that identical ones are consecutive
+	template <typename Vector>
+	inline int compareVectors(const Vector &p_left, const Vector &p_right)
+	{
+		for(glm::length_t i = 0; i < p_left.length(); i++)
+		{
+			if(p_left[i] < p_right[i])
+				return -1;
+			if(p_left[i] > p_right[i])
+				return 1;
+		}
+		return 0;
+	}
+
+	// Key of an undirected edge between two welded vertices
+	inline uint64_t getEdgeKey(const unsigned int p_vertex0, const unsigned int p_vertex1)
+	{
+		return p_vertex0 < p_vertex1 ? ((uint64_t)p_vertex0 << 32) | p_vertex1 : ((uint64_t)p_vertex1 << 32) | p_vertex0;
+	}
+}
+
+MeshSimplifier::MeshSimplifier(const glm::vec3 *p_positions, const glm::vec3 *p_normals, const glm::vec2 *p_texCoords, const std::size_t p_numVertices) :
+	m_positions(p_positions), m_normals(p_normals), m_texCoords(p_texCoords), m_numVertices(p_numVertices), m_boundingSphereCenter(0.0f), m_boundingSphereRadius(0.0f)
+{
+	m_weldedVertices.resize(m_numVertices);
+	m_uniqueVertices.resize(m_numVertices);
+	m_weldedVertexVariantOffsets.resize(m_numVertices, 0);
+	m_weldedVertexVariantCounts.resize(m_numVertices, 0);
+
+	// Sort the vertices by position, normal and texture coordinates, so that vertices at the same position (and identical vertices) are consecutive
+	std::vector<unsigned int> sortedVertices(m_numVertices);
+	std::iota(sortedVertices.begin(), sortedVertices.end(), 0);
+	std::sort(sortedVertices.begin(), sortedVertices.end(), [this](const unsigned int p_left, const unsigned int p_right)
+		{
+			if(int result = compareVectors(m_positions[p_left], m_positions[p_right]); result != 0)
+				return result < 0;
+			if(int result = compareVectors(m_normals[p_left], m_normals[p_right]); result != 0)
+				return result < 0;
+			if(int result = compareVectors(m_texCoords[p_left], m_texCoords[p_right]); result != 0)
+				return result < 0;
+			return p_left < p_right;
+		});
+
+	// Weld the vertices at the same position to the first one, and gather the distinct vertices of each welded vertex
+	m_weldedVertexVariants.reserve(m_numVertices);
+	for(std::size_t i = 0; i < m_numVertices; i++)
+	{
+		const unsigned int vertex = sortedVertices[i];
+
+		if(i > 0 && m_positions[vertex] == m_positions[sortedVertices[i - 1]])
+		{
+			const unsigned int previousVertex = sortedVertices[i - 1];
+			m_weldedVertices[vertex] = m_weldedVertices[previousVertex];
+
+			if(m_normals[vertex] == m_normals[previousVertex] && m_texCoords[vertex] == m_texCoords[previousVertex])
+				m_uniqueVertices[vertex] = m_uniqueVertices[previousVertex];
+			else
+			{
+				m_uniqueVertices[vertex] = vertex;
+				m_weldedVertexVariants.push_back(vertex);
+				m_weldedVertexVariantCounts[m_weldedVertices[vertex]]++;
+			}
+		}
+		else
+		{
+			m_weldedVertices[vertex] = vertex;
+			m_uniqueVertices[vertex] = vertex;
+			m_weldedVertexVariantOffsets[vertex] = (unsigned int)m_weldedVertexVariants.size();
+			m_weldedVertexVariantCounts[vertex] = 1;
+			m_weldedVertexVariants.push_back(vertex);
+		}
+	}
+
+	// Calculate the bounding sphere around the center of the bounding box
+	if(m_numVertices > 0)
+	{
+		glm::vec3 min = m_positions[0];
+		glm::vec3 max = m_positions[0];
+		for(std::size_t i = 1; i < m_numVertices; i++)
+		{
+			min = glm::min(min, m_positions[i]);
+			max = glm::max(max, m_positions[i]);
+		}
+
+		m_boundingSphereCenter = (min + max) * 0.5f;
+		for(std::size_t i = 0; i < m_numVertices; i++)
+			m_boundingSphereRadius = std::max(m_boundingSphereRadius, glm::length(m_positions[i] - m_boundingSphereCenter));
+	}
+}
+
+MeshSimplifier::~MeshSimplifier()
+{
+}
+
+float MeshSimplifier::simplify(const std::vector<unsigned int> &p_indices, const std::size_t p_targetNumOfIndices, const float p_targetError, std::vector<unsigned int> &p_simplifiedIndices) const
+{
+	// Work on the unique vertices, so that identical vertices are treated as one
+	p_simplifiedIndices.resize(p_indices.size() - p_indices.size() % 3);
+	for(std::size_t i = 0, size = p_simplifiedIndices.size(); i < size; i++)
+		p_simplifiedIndices[i] = m_uniqueVertices[p_indices[i]];
+
+	if(m_boundingSphereRadius <= 0.0f)
+		return 0.0f;
+
+	// Quadric error is a squared distance
+	const double maxError = (double)p_targetError * (double)m_boundingSphereRadius * (double)p_targetError * (double)m_boundingSphereRadius;
+	double simplifiedError = 0.0;
+
+	// Accumulate the quadrics of the triangle planes, weighted by the triangle area, at each welded vertex
+	std::vector<Quadric> quadrics(m_numVertices);
+	for(std::size_t i = 0, size = p_simplifiedIndices.size(); i < size; i += 3)
+	{
+		const glm::dvec3 position0 = m_positions[p_simplifiedIndices[i]];
+		const glm::dvec3 normal = glm::cross(glm::dvec3(m_positions[p_simplifiedIndices[i + 1]]) - position0, glm::dvec3(m_positions[p_simplifiedIndices[i + 2]]) - position0);
+		const double normalLength = glm::length(normal);
+
+		if(normalLength > 0.0)
+		{
+			const glm::dvec3 unitNormal = normal / normalLength;
+			const Quadric quadric(unitNormal, -glm::dot(unitNormal, position0), normalLength * 0.5);
+
+			for(std::size_t corner = 0; corner < 3; corner++)
+				quadrics[getWeldedVertex(p_simplifiedIndices[i + corner])] += quadric;
+		}
+	}
+
+	// Lock the vertices on attribute seams (welded vertices with more than one distinct vertex) and on open borders (edges used by a single triangle)
+	std::vector<unsigned char> lockedVertices(m_numVertices, 0);
+	for(std::size_t i = 0; i < m_numVertices; i++)
+		if(m_weldedVertices[i] == i && m_weldedVertexVariantCounts[i] > 1)
+			lockedVertices[i] = 1;
+
+	{
+		std::unordered_map<uint64_t, unsigned int> edgeTriangleCounts;
+		edgeTriangleCounts.reserve(p_simplifiedIndices.size());
+		for(std::size_t i = 0, size = p_simplifiedIndices.size(); i < size; i += 3)
+			for(std::size_t corner = 0; corner < 3; corner++)
+				edgeTriangleCounts[getEdgeKey(getWeldedVertex(p_simplifiedIndices[i + corner]), getWeldedVertex(p_simplifiedIndices[i + (corner + 1) % 3]))]++;
+
+		for(const auto &edge : edgeTriangleCounts)
+		{
+			if(edge.second == 1)
+			{
+				lockedVertices[(unsigned int)(edge.first >> 32)] = 1;
+				lockedVertices[(unsigned int)(edge.first & 0xffffffff)] = 1;
+			}
+		}
+	}
+
+	std::vector<Collapse> collapses;
+	std::vector<unsigned int> collapseTargets(m_numVertices);
+	std::vector<unsigned char> touchedVertices(m_numVertices);
+	std::vector<unsigned int> triangleOffsets(m_numVertices + 1);
+	std::vector<unsigned int> vertexTriangles;
+
+	// Collapse edges in passes; each pass collapses the cheapest edges whose surroundings were not changed by other collapses of the same pass
+	while(p_simplifiedIndices.size() > p_targetNumOfIndices)
+	{
+		const std::size_t numOfTriangles = p_simplifiedIndices.size() / 3;
+
+		// Find the cheapest collapse direction of each edge (each edge of a closed mesh is visited once, in the direction of increasing vertex index)
+		collapses.clear();
+		for(std::size_t i = 0, size = p_simplifiedIndices.size(); i < size; i += 3)
+		{
+			for(std::size_t corner = 0; corner < 3; corner++)
+			{
+				const unsigned int vertex0 = getWeldedVertex(p_simplifiedIndices[i + corner]);
+				const unsigned int vertex1 = getWeldedVertex(p_simplifiedIndices[i + (corner + 1) % 3]);
+
+				if(vertex0 >= vertex1 || (lockedVertices[vertex0] && lockedVertices[vertex1]))
+					continue;
+
+				Quadric quadric = quadrics[vertex0];
+				quadric += quadrics[vertex1];
+
+				const double error0To1 = lockedVertices[vertex0] ? std::numeric_limits<double>::max() : quadric.getError(m_positions[vertex1]);
+				const double error1To0 = lockedVertices[vertex1] ? std::numeric_limits<double>::max() : quadric.getError(m_positions[vertex0]);
+
+				if(error0To1 <= error1To0)
+					collapses.emplace_back(vertex0, vertex1, error0To1);
+				else
+					collapses.emplace_back(vertex1, vertex0, error1To0);
+			}
+		}
+
+		if(collapses.empty())
+			break;
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse &p_left, const Collapse &p_right) { return p_left.m_error < p_right.m_error; });
+
+		// Build the list of triangles around each welded vertex
+		std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+		for(std::size_t i = 0, size = p_simplifiedIndices.size(); i < size; i++)
+			triangleOffsets[getWeldedVertex(p_simplifiedIndices[i]) + 1]++;
+		for(std::size_t i = 1; i <= m_numVertices; i++)
+			triangleOffsets[i] += triangleOffsets[i - 1];
+
+		vertexTriangles.resize(p_simplifiedIndices.size());
+		{
+			std::vector<unsigned int> triangleCounts(m_numVertices, 0);
+			for(std::size_t i = 0, size = p_simplifiedIndices.size(); i < size; i++)
+			{
+				const unsigned int vertex = getWeldedVertex(p_simplifiedIndices[i]);
+				vertexTriangles[triangleOffsets[vertex] + triangleCounts[vertex]++] = (unsigned int)(i / 3);
+			}
+		}
+
+		std::iota(collapseTargets.begin(), collapseTargets.end(), 0);
+		std::fill(touchedVertices.begin(), touchedVertices.end(), 0);
+
+		const std::size_t numOfTrianglesToRemove = (p_simplifiedIndices.size() - p_targetNumOfIndices + 2) / 3;
+		std::size_t numOfRemovedTriangles = 0;
+		std::size_t numOfCollapses = 0;
+
+		for(const auto &collapse : collapses)
+		{
+			if(collapse.m_error > maxError || numOfRemovedTriangles >= numOfTrianglesToRemove)
+				break;
+
+			if(touchedVertices[collapse.m_from] || touchedVertices[collapse.m_to])
+				continue;
+
+			const unsigned int *triangles = vertexTriangles.data() + triangleOffsets[collapse.m_from];
+			const std::size_t numOfVertexTriangles = triangleOffsets[collapse.m_from + 1] - triangleOffsets[collapse.m_from];
+
+			if(collapseFlipsTriangles(collapse.m_from, collapse.m_to, p_simplifiedIndices, triangles, numOfVertexTriangles))
+				continue;
+
+			// Mark all the vertices around the collapsed vertex as touched, as their triangles are changing
+			for(std::size_t i = 0; i < numOfVertexTriangles; i++)
+			{
+				bool triangleRemoved = false;
+				for(std::size_t corner = 0; corner < 3; corner++)
+				{
+					const unsigned int vertex = getWeldedVertex(p_simplifiedIndices[triangles[i] * 3 + corner]);
+					touchedVertices[vertex] = 1;
+					triangleRemoved = triangleRemoved || vertex == collapse.m_to;
+				}
+
+				if(triangleRemoved)
+					numOfRemovedTriangles++;
+			}
+
+			collapseTargets[collapse.m_from] = collapse.m_to;
+			quadrics[collapse.m_to] += quadrics[collapse.m_from];
+			simplifiedError = std::max(simplifiedError, collapse.m_error);
+			numOfCollapses++;
+		}
+
+		if(numOfCollapses == 0)
+			break;
+
+		// Move the collapsed vertices and remove the triangles that became degenerate
+		std::size_t numOfIndices = 0;
+		for(std::size_t i = 0; i < numOfTriangles; i++)
+		{
+			unsigned int triangle[3];
+			for(std::size_t corner = 0; corner < 3; corner++)
+			{
+				const unsigned int vertex = p_simplifiedIndices[i * 3 + corner];
+				const unsigned int weldedVertex = getWeldedVertex(vertex);
+
+				triangle[corner] = collapseTargets[weldedVertex] == weldedVertex ? vertex : getClosestVertex(collapseTargets[weldedVertex], vertex);
+			}
+
+			const unsigned int weldedVertex0 = getWeldedVertex(triangle[0]);
+			const unsigned int weldedVertex1 = getWeldedVertex(triangle[1]);
+			const unsigned int weldedVertex2 = getWeldedVertex(triangle[2]);
+
+			if(weldedVertex0 != weldedVertex1 && weldedVertex1 != weldedVertex2 && weldedVertex0 != weldedVertex2)
+			{
+				p_simplifiedIndices[numOfIndices++] = triangle[0];
+				p_simplifiedIndices[numOfIndices++] = triangle[1];
+				p_simplifiedIndices[numOfIndices++] = triangle[2];
+			}
+		}
+		p_simplifiedIndices.resize(numOfIndices);
+	}
+
+	return (float)(std::sqrt(simplifiedError) / (double)m_boundingSphereRadius);
+}
+
+unsigned int MeshSimplifier::getClosestVertex(const unsigned int p_targetWeldedVertex, const unsigned int p_vertex) const
+{
+	const unsigned int *variants = m_weldedVertexVariants.data() + m_weldedVertexVariantOffsets[p_targetWeldedVertex];
+	const unsigned int numOfVariants = m_weldedVertexVariantCounts[p_targetWeldedVertex];
+
+	unsigned int closestVertex = variants[0];
+	float closestDistance = std::numeric_limits<float>::max();
+
+	for(unsigned int i = 0; i < numOfVariants && numOfVariants > 1; i++)
+	{
+		const glm::vec2 texCoordDifference = m_texCoords[variants[i]] - m_texCoords[p_vertex];
+		const glm::vec3 normalDifference = m_normals[variants[i]] - m_normals[p_vertex];
+		const float distance = glm::dot(texCoordDifference, texCoordDifference) + glm::dot(normalDifference, normalDifference);
+
+		if(distance < closestDistance)
+		{
+			closestDistance = distance;
+			closestVertex = variants[i];
+		}
+	}
+
+	return closestVertex;
+}
+
+bool MeshSimplifier::collapseFlipsTriangles(const unsigned int p_from, const unsigned int p_to, const std::vector<unsigned int> &p_indices, const unsigned int *p_triangles, const std::size_t p_numOfTriangles) const
+{
+	for(std::size_t i = 0; i < p_numOfTriangles; i++)
+	{
+		glm::vec3 positions[3];
+		glm::vec3 movedPositions[3];
+		bool triangleRemoved = false;
+
+		for(std::size_t corner = 0; corner < 3; corner++)
+		{
+			const unsigned int vertex = getWeldedVertex(p_indices[p_triangles[i] * 3 + corner]);
+
+			positions[corner] = m_positions[vertex];
+			movedPositions[corner] = vertex == p_from ? m_positions[p_to] : m_positions[vertex];
+			triangleRemoved = triangleRemoved || vertex == p_to;
+		}
+
+		// Triangles that contain both vertices are removed by the collapse
+		if(triangleRemoved)
+			continue;
+
+		const glm::vec3 normal = glm::cross(positions[1] - positions[0], positions[2] - positions[0]);
+		const glm::vec3 movedNormal = glm::cross(movedPositions[1] - movedPositions[0], movedPositions[2] - movedPositions[0]);
+
+		if(glm::dot(normal, movedNormal) <= 0.0f)
+			return true;
+	}
+
+	return false;
+}
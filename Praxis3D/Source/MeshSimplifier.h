@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+
+#include "Math.h"
+
+// Simplifies triangle meshes by collapsing edges in the order of their quadric error (Garland-Heckbert quadrics), without creating
+// new vertices, so the simplified indices reference the vertices of the original mesh and can share its vertex buffers.
+// Vertices are welded by position, so that edges can be collapsed across duplicated vertices; vertices on open borders
+// and on attribute seams (where duplicated vertices have different normals or texture coordinates) are never moved
+class MeshSimplifier
+{
+public:
+	// Takes the vertex attributes of a single mesh; indices passed to the simplifier are relative to the first vertex
+	MeshSimplifier(const glm::vec3 *p_positions, const glm::vec3 *p_normals, const glm::vec2 *p_texCoords, const std::size_t p_numVertices);
+	~MeshSimplifier();
+
+	// Simplifies the triangles down to the target number of indices, or until the error of the next collapse would exceed the target error
+	// (relative to the bounding sphere radius of the mesh). Returns the error of the simplified triangles, relative to the bounding sphere radius
+	float simplify(const std::vector<unsigned int> &p_indices, const std::size_t p_targetNumOfIndices, const float p_targetError, std::vector<unsigned int> &p_simplifiedIndices) const;
+
+	// Getters
+	const inline glm::vec3 &getBoundingSphereCenter() const { return m_boundingSphereCenter; }
+	const inline float getBoundingSphereRadius() const { return m_boundingSphereRadius; }
+
+private:
+	// Symmetric 4x4 matrix of the squared distance to a set of planes
+	struct Quadric
+	{
+		Quadric() : m_a00(0.0), m_a01(0.0), m_a02(0.0), m_a03(0.0), m_a11(0.0), m_a12(0.0), m_a13(0.0), m_a22(0.0), m_a23(0.0), m_a33(0.0) { }
+
+		// Quadric of a plane (normal and distance), weighted
+		Quadric(const glm::dvec3 &p_normal, const double p_distance, const double p_weight) :
+			m_a00(p_weight * p_normal.x * p_normal.x), m_a01(p_weight * p_normal.x * p_normal.y), m_a02(p_weight * p_normal.x * p_normal.z), m_a03(p_weight * p_normal.x * p_distance),
+			m_a11(p_weight * p_normal.y * p_normal.y), m_a12(p_weight * p_normal.y * p_normal.z), m_a13(p_weight * p_normal.y * p_distance),
+			m_a22(p_weight * p_normal.z * p_normal.z), m_a23(p_weight * p_normal.z * p_distance),
+			m_a33(p_weight * p_distance * p_distance) { }
+
+		inline Quadric &operator+=(const Quadric &p_other)
+		{
+			m_a00 += p_other.m_a00; m_a01 += p_other.m_a01; m_a02 += p_other.m_a02; m_a03 += p_other.m_a03;
+			m_a11 += p_other.m_a11; m_a12 += p_other.m_a12; m_a13 += p_other.m_a13;
+			m_a22 += p_other.m_a22; m_a23 += p_other.m_a23;
+			m_a33 += p_other.m_a33;
+			return *this;
+		}
+
+		// Returns the weighted sum of squared distances from the given position to the planes
+		inline double getError(const glm::vec3 &p_position) const
+		{
+			const double x = p_position.x, y = p_position.y, z = p_position.z;
+
+			return	x * x * m_a00 + 2.0 * x * y * m_a01 + 2.0 * x * z * m_a02 + 2.0 * x * m_a03 +
+					y * y * m_a11 + 2.0 * y * z * m_a12 + 2.0 * y * m_a13 +
+					z * z * m_a22 + 2.0 * z * m_a23 +
+					m_a33;
+		}
+
+		double m_a00, m_a01, m_a02, m_a03, m_a11, m_a12, m_a13, m_a22, m_a23, m_a33;
+	};
+
+	// Collapse of a welded vertex onto another welded vertex
+	struct Collapse
+	{
+		Collapse(const unsigned int p_from, const unsigned int p_to, const double p_error) : m_from(p_from), m_to(p_to), m_error(p_error) { }
+
+		unsigned int m_from;
+		unsigned int m_to;
+		double m_error;
+	};
+
+	// Returns the vertex (out of the vertices welded to the target vertex) whose attributes are the closest to the given vertex
+	unsigned int getClosestVertex(const unsigned int p_targetWeldedVertex, const unsigned int p_vertex) const;
+
+	// Returns true if moving the welded vertex to the position of the target welded vertex would flip any of the given triangles
+	bool collapseFlipsTriangles(const unsigned int p_from, const unsigned int p_to, const std::vector<unsigned int> &p_indices, const unsigned int *p_triangles, const std::size_t p_numOfTriangles) const;
+
+	inline unsigned int getWeldedVertex(const unsigned int p_vertex) const { return m_weldedVertices[p_vertex]; }
+
+	const glm::vec3 *m_positions;
+	const glm::vec3 *m_normals;
+	const glm::vec2 *m_texCoords;
+	std::size_t m_numVertices;
+
+	// Vertex that each vertex was welded to (the first vertex at the same position)
+	std::vector<unsigned int> m_weldedVertices;
+
+	// Vertex that each vertex is identical to (the first vertex with the same position, normal and texture coordinates)
+	std::vector<unsigned int> m_uniqueVertices;
+
+	// Distinct (unique) vertices of each welded vertex, stored contiguously, with the offset and count of each welded vertex
+	std::vector<unsigned int> m_weldedVertexVariants;
+	std::vector<unsigned int> m_weldedVertexVariantOffsets;
+	std::vector<unsigned int> m_weldedVertexVariantCounts;
+
+	glm::vec3 m_boundingSphereCenter;
+	float m_boundingSphereRadius;
+};
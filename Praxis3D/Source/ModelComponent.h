@@ -105,10 +105,17 @@ public:
 	{
 		ModelComponentConstructionInfo()
 		{
-
+			m_staticShadowCaster = false;
+			m_occluder = false;
 		}
 
 		ModelsProperties m_modelsProperties;
+
+		// Static shadow casters never move, so their shadows are rendered once and cached, instead of every frame
+		bool m_staticShadowCaster;
+
+		// Occluders are rasterized into the occlusion culling depth buffer, hiding the models behind them
+		bool m_occluder;
 	};
 
 	ModelComponent(SystemScene *p_systemScene, std::string p_name, const EntityID p_entityID, std::size_t p_id = 0) : SystemObject(p_systemScene, p_name, Properties::PropertyID::ModelComponent, p_entityID)
@@ -117,6 +124,9 @@ public:
 		m_modelsNeedLoading = false;
 		m_texturesNeedLoading = false;
 		m_loadPending = false;
+		m_staticShadowCaster = false;
+		m_staticRigidBody = false;
+		m_occluder = false;
 	}
 	~ModelComponent() { }
 
@@ -139,6 +149,7 @@ public:
 
 		if(m_modelsProperties != nullptr)
 		{
+			releaseMaterials();
 			m_modelData.clear();
 
 			// Go over each model
@@ -211,8 +222,7 @@ public:
 						// Add the data for this mesh. Include materials loaded from the model itself, if they were present, otherwise, include default textures instead
 						newModelData.m_meshes.push_back(MeshData(
 							newModelData.m_model.getMeshArray()[meshIndex],
-							materials,
-							materialData,
+							Loaders::material().acquireMaterial(materials, materialData),
 							m_modelsProperties->m_models[modelIndex].m_meshData[meshIndex].m_heightScale,
 							m_modelsProperties->m_models[modelIndex].m_meshData[meshIndex].m_alphaThreshold,
 							m_modelsProperties->m_models[modelIndex].m_meshData[meshIndex].m_emissiveIntensity,
@@ -238,8 +248,7 @@ public:
 
 						newModelData.m_meshes.push_back(MeshData(
 							newModelData.m_model.getMeshArray()[meshIndex], 
-							materials,
-							materialData,
+							Loaders::material().acquireMaterial(materials, materialData),
 							Config::graphicsVar().height_scale, 
 							Config::graphicsVar().alpha_threshold, 
 							Config::graphicsVar().emissive_multiplier, 
@@ -297,8 +306,8 @@ public:
 			for(decltype(m_modelData[modelIndex].m_meshes.size()) meshIndex = 0, meshSize = m_modelData[modelIndex].m_meshes.size(); meshIndex < meshSize; meshIndex++)
 			{
 				// Go over each material type
-				for(unsigned int iMatType = 0; iMatType < MaterialType::MaterialType_NumOfTypes; iMatType++)
-					m_modelData[modelIndex].m_meshes[meshIndex].m_materials[iMatType].loadToMemory();
+				for(auto &texture : Loaders::material().getMaterial(m_modelData[modelIndex].m_meshes[meshIndex].m_materialID).m_textures)
+					texture.loadToMemory();
 			}
 		}
 
@@ -351,9 +360,9 @@ public:
 			for(decltype(m_modelData[modelIndex].m_meshes.size()) meshIndex = 0, meshSize = m_modelData[modelIndex].m_meshes.size(); meshIndex < meshSize; meshIndex++)
 			{
 				// Go over each material type
-				for(unsigned int iMatType = 0; iMatType < MaterialType::MaterialType_NumOfTypes; iMatType++)
-					if(m_modelData[modelIndex].m_meshes[meshIndex].m_materials[iMatType].isLoadedToMemory() && m_modelData[modelIndex].m_meshes[meshIndex].m_materials[iMatType].isLoadedToVideoMemory())
-						if(auto error = m_modelData[modelIndex].m_meshes[meshIndex].m_materials[iMatType].unloadFromMemory(); error != ErrorCode::Success)
+				for(auto &texture : Loaders::material().getMaterial(m_modelData[modelIndex].m_meshes[meshIndex].m_materialID).m_textures)
+					if(texture.isLoadedToMemory() && texture.isLoadedToVideoMemory())
+						if(auto error = texture.unloadFromMemory(); error != ErrorCode::Success)
 							ErrHandlerLoc::get().log(error, m_name, ErrorSource::Source_ModelComponent);
 			}
 		}
@@ -406,8 +415,8 @@ public:
 
 			// Go over each mesh -> go over each material -> add texture handle to the loadable object list
 			for(decltype(m_modelData[modelIndex].m_meshes.size()) meshSize = m_modelData[modelIndex].m_meshes.size(), meshIndex = 0; meshIndex < meshSize; meshIndex++)
-				for(unsigned int materialIndex = 0; materialIndex < MaterialType::MaterialType_NumOfTypes; materialIndex++)
-					loadableObjects.emplace_back(m_modelData[modelIndex].m_meshes[meshIndex].m_materials[materialIndex]);
+				for(auto &texture : Loaders::material().getMaterial(m_modelData[modelIndex].m_meshes[meshIndex].m_materialID).m_textures)
+					loadableObjects.emplace_back(texture);
 		}
 
 		return loadableObjects;
@@ -424,9 +433,9 @@ public:
 
 			for(decltype(m_modelData[modelIndex].m_meshes.size()) meshSize = m_modelData[modelIndex].m_meshes.size(), meshIndex = 0; meshIndex < meshSize; meshIndex++)
 			{
-				for(unsigned int materialIndex = 0; materialIndex < MaterialType::MaterialType_NumOfTypes; materialIndex++)
+				for(const auto &texture : m_modelData[modelIndex].m_meshes[meshIndex].getMaterial().m_textures)
 				{
-					if(!m_modelData[modelIndex].m_meshes[meshIndex].m_materials[materialIndex].isLoadedToVideoMemory())
+					if(!texture.isLoadedToVideoMemory())
 						return;
 				}
 			}
@@ -439,6 +448,11 @@ public:
 	const inline bool getLoadPending() const { return m_loadPending; }
 	const inline bool getModelsNeedsLoading() const { return m_modelsNeedLoading; }
 	const inline bool getTexturesNeedsLoading() const { return m_texturesNeedLoading; }
+	const inline bool getStaticShadowCasterFlag() const { return m_staticShadowCaster; }
+	const inline bool getOccluderFlag() const { return m_occluder; }
+
+	// Model is a static shadow caster if it was flagged as one, or if it belongs to a static rigid body (zero mass and not kinematic)
+	const inline bool isStaticShadowCaster() const { return m_staticShadowCaster || m_staticRigidBody; }
 
 	inline void getModelsProperties(ModelsProperties &p_modelsProperties) const
 	{
@@ -470,24 +484,27 @@ public:
 				std::vector<glm::vec4> meshMaterialColors;
 				bool materialPresent = false;
 
+				// Get the shared material of the mesh
+				const auto &material = m_modelData[modelIndex].m_meshes[meshIndex].getMaterial();
+
 				// Loop over each material
 				for(unsigned int materialIndex = 0; materialIndex < MaterialType::MaterialType_NumOfTypes; materialIndex++)
 				{
 					// Mark material as present if any of the textures are not default
-					if(!Loaders::texture2D().isTextureDefault(m_modelData[modelIndex].m_meshes[meshIndex].m_materials[materialIndex]))
+					if(!Loaders::texture2D().isTextureDefault(material.m_textures[materialIndex]))
 						materialPresent = true;
 
 					// Add texture filename
-					meshMaterials.push_back(m_modelData[modelIndex].m_meshes[meshIndex].m_materials[materialIndex].getFilename());
+					meshMaterials.push_back(material.m_textures[materialIndex].getFilename());
 
 					// Add texture scale
-					meshMaterialScales.push_back(m_modelData[modelIndex].m_meshes[meshIndex].m_materialData.m_parameters[materialIndex].m_scale);
+					meshMaterialScales.push_back(material.m_materialData.m_parameters[materialIndex].m_scale);
 
 					// Add texture framing
-					meshMaterialFramings.push_back(m_modelData[modelIndex].m_meshes[meshIndex].m_materialData.m_parameters[materialIndex].m_framing);
+					meshMaterialFramings.push_back(material.m_materialData.m_parameters[materialIndex].m_framing);
 
 					// Add texture color
-					meshMaterialColors.push_back(m_modelData[modelIndex].m_meshes[meshIndex].m_materialData.m_parameters[materialIndex].m_color);
+					meshMaterialColors.push_back(material.m_materialData.m_parameters[materialIndex].m_color);
 				}
 
 				newModelEntry.m_meshData.push_back(SingleMeshData(
@@ -509,10 +526,25 @@ public:
 		}
  	}
 
+	// Releases the shared materials of every mesh; must be called before the mesh data is discarded
+	void releaseMaterials()
+	{
+		for(auto &modelData : m_modelData)
+			for(auto &meshData : modelData.m_meshes)
+			{
+				Loaders::material().releaseMaterial(meshData.m_materialID);
+				meshData.m_materialID = NULL_MATERIAL_ID;
+			}
+	}
+
 	const inline void resetLoadPending() { m_loadPending = false; }
 	const inline void resetModelsNeedsLoading() { m_modelsNeedLoading = false; }
 	const inline void resetTexturesNeedsLoading() { m_texturesNeedLoading = false; }
 
+	inline void setStaticShadowCasterFlag(const bool p_staticShadowCaster) { m_staticShadowCaster = p_staticShadowCaster; }
+	inline void setStaticRigidBody(const bool p_staticRigidBody) { m_staticRigidBody = p_staticRigidBody; }
+	inline void setOccluderFlag(const bool p_occluder) { m_occluder = p_occluder; }
+
 private:
 	inline void adjustMeshArraySizes()
 	{
@@ -603,4 +635,11 @@ private:
 	bool m_texturesNeedLoading;
 
 	bool m_loadPending;
+
+	// Static shadow caster flag, and whether the entity has a static rigid body (set by the renderer scene)
+	bool m_staticShadowCaster;
+	bool m_staticRigidBody;
+
+	// Occluder flag; models that are not flagged can still be selected as occluders automatically, based on their screen size
+	bool m_occluder;
 };
\ No newline at end of file
@@ -1,12 +1,18 @@
 #include <assimp\Importer.hpp>
 #include <assimp\postprocess.h>
 #include <assimp\ProgressHandler.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iostream>
 
 #include "Config.h"
 #include "ErrorHandlerLocator.h"
+#include "Filesystem.h"
+#include "MeshSimplifier.h"
 #include "ModelLoader.h"
+#include "Profiler.h"
 #include "SceneLoader.h"
 #include "TaskManagerLocator.h"
 
@@ -15,8 +21,14 @@
 // This initialization depends on the order of BufferType enum entries
 const int Model::m_numElements[ModelBuffer_NumAllTypes] = { 3, 3, 2, 3, 3, 0 };
 
+// LOD cache file identifier and version; the version must be increased whenever the file layout changes
+static constexpr char g_cachedLODMagic[4] = { 'P', '3', 'L', 'C' };
+static constexpr unsigned int g_cachedLODVersion = 1;
+
 ErrorCode Model::loadToMemory()
 {
+	PROFILE_ZONE("Model::loadToMemory");
+
 	// If the model is not currently already being loaded in another thread
 	if(!m_isBeingLoaded)
 	{
@@ -78,6 +90,8 @@ ErrorCode Model::loadToMemory()
 			{
 				ErrHandlerLoc::get().log(m_loadingToMemoryError, ErrorSource::Source_ModelLoader, m_filename);
 			}
+
+			updateMemorySize();
 		}
 
 		m_isBeingLoaded = false;
@@ -105,6 +119,73 @@ ErrorCode Model::unloadMemory()
 	for(int matType = 0; matType < MaterialType_NumOfTypes; matType++)
 		m_materials.m_materials[matType].clear();
 
+	updateMemorySize();
+
+	return returnError;
+}
+void Model::releaseCPUData(const bool p_keepPositionsAndIndices)
+{
+	SpinWait::Lock lock(m_mutex);
+
+	// Consumers that registered interest still read the data
+	if(m_cpuDataInterest > 0)
+		return;
+
+	const int64_t memorySize = getMemorySize(MemoryType_RAM);
+
+	// Swap with empty arrays, as clearing them doesn't free the reserved space
+	std::vector<glm::vec3>().swap(m_normals);
+	std::vector<glm::vec2>().swap(m_texCoords);
+	std::vector<glm::vec3>().swap(m_tangents);
+	std::vector<glm::vec3>().swap(m_bitangents);
+
+	if(!p_keepPositionsAndIndices)
+	{
+		std::vector<glm::vec3>().swap(m_positions);
+		std::vector<unsigned int>().swap(m_indices);
+	}
+
+	m_cpuDataReleased = true;
+
+	updateMemorySize();
+	setSavedMemorySize(getSavedMemorySize() + memorySize - getMemorySize(MemoryType_RAM));
+}
+ErrorCode Model::reloadCPUData()
+{
+	// Load the data into a temporary model, as meshes of this model might be in use while the file is loading
+	Model reloadedModel(getLoaderBase(), m_filename, 0, 0);
+	ErrorCode returnError = reloadedModel.loadToMemory();
+
+	if(returnError == ErrorCode::Success)
+	{
+		SpinWait::Lock lock(m_mutex);
+
+		// Data might have been reloaded by another consumer in the meantime
+		if(m_cpuDataReleased)
+		{
+			// Only take the data if it matches the uploaded buffers, as the file might have changed since
+			if(reloadedModel.m_numVertices == m_numVertices && reloadedModel.m_indices.size() * sizeof(unsigned int) == m_bufferSize[ModelBuffer_Index])
+			{
+				m_positions.swap(reloadedModel.m_positions);
+				m_normals.swap(reloadedModel.m_normals);
+				m_texCoords.swap(reloadedModel.m_texCoords);
+				m_tangents.swap(reloadedModel.m_tangents);
+				m_bitangents.swap(reloadedModel.m_bitangents);
+				m_indices.swap(reloadedModel.m_indices);
+
+				m_cpuDataReleased = false;
+
+				updateMemorySize();
+				setSavedMemorySize(0);
+			}
+			else
+			{
+				ErrHandlerLoc::get().log(ErrorCode::Load_to_memory_failure, ErrorSource::Source_ModelLoader, m_filename);
+				returnError = ErrorCode::Load_to_memory_failure;
+			}
+		}
+	}
+
 	return returnError;
 }
 
@@ -156,10 +237,16 @@ ErrorCode Model::loadFromScene(const aiScene &p_assimpScene)
 	m_bufferSize[ModelBuffer_TexCoord]		= sizeof(m_texCoords[0])	* m_numVertices;
 	m_bufferSize[ModelBuffer_Tangents]		= sizeof(m_tangents[0])		* m_numVertices;
 	m_bufferSize[ModelBuffer_Bitangents]	= sizeof(m_bitangents[0])	* m_numVertices;
-	m_bufferSize[ModelBuffer_Index]			= sizeof(m_indices[0])		* m_numVertices;
 
 	// Deal with each mesh
 	returnError = loadMeshes(p_assimpScene);
+
+	// Generate the levels of detail of each mesh
+	if(returnError == ErrorCode::Success)
+		returnError = generateLODs();
+
+	// Index buffer holds the indices of every LOD, so its size is only known after generating them
+	m_bufferSize[ModelBuffer_Index]			= sizeof(m_indices[0])		* m_indices.size();
 	
 	// Load material file names
 	if(returnError == ErrorCode::Success)
@@ -276,6 +363,196 @@ ErrorCode Model::loadMeshes(const aiScene &p_assimpScene)
 
 	return returnError;
 }
+ErrorCode Model::generateLODs()
+{
+	ErrorCode returnError = ErrorCode::Success;
+
+	// Set the original mesh as the first LOD
+	for(decltype(m_meshPool.size()) i = 0, size = m_meshPool.size(); i < size; i++)
+	{
+		m_meshPool[i].m_lods[0].m_numIndices = m_meshPool[i].m_numIndices;
+		m_meshPool[i].m_lods[0].m_baseIndex = m_meshPool[i].m_baseIndex;
+		m_meshPool[i].m_lods[0].m_error = 0.0f;
+		m_meshPool[i].m_numLODs = 1;
+	}
+
+	// There is nothing to simplify in a model without vertices
+	if(m_numVertices == 0 || m_positions.empty())
+		return returnError;
+
+	// Use the LOD cache only if it is not older than the model it was generated from
+	const std::string cacheFilename = Config::filepathVar().lod_cache_path + m_filename + ".lod";
+	const std::string modelFilename = Config::filepathVar().model_path + m_filename;
+
+	std::error_code fileError;
+	bool lodCacheValid = std::filesystem::exists(cacheFilename, fileError);
+	if(lodCacheValid && std::filesystem::exists(modelFilename, fileError))
+		lodCacheValid = std::filesystem::last_write_time(cacheFilename, fileError) >= std::filesystem::last_write_time(modelFilename, fileError);
+
+	if(lodCacheValid && loadCachedLODs(cacheFilename) == ErrorCode::Success)
+		return returnError;
+
+	// Calculate the bounding sphere of each mesh
+	std::vector<MeshSimplifier> simplifiers;
+	simplifiers.reserve(m_meshPool.size());
+	for(decltype(m_meshPool.size()) i = 0, size = m_meshPool.size(); i < size; i++)
+	{
+		const auto numOfMeshVertices = (i + 1 < size ? m_meshPool[i + 1].m_baseVertex : (unsigned int)m_numVertices) - m_meshPool[i].m_baseVertex;
+
+		// Pointer arithmetic instead of indexing, as the base vertex of an empty mesh can be past the end of the arrays
+		simplifiers.emplace_back(m_positions.data() + m_meshPool[i].m_baseVertex, m_normals.data() + m_meshPool[i].m_baseVertex, m_texCoords.data() + m_meshPool[i].m_baseVertex, numOfMeshVertices);
+
+		m_meshPool[i].m_boundingSphereCenter = simplifiers[i].getBoundingSphereCenter();
+		m_meshPool[i].m_boundingSphereRadius = simplifiers[i].getBoundingSphereRadius();
+	}
+
+	const unsigned int maxNumOfLODs = (unsigned int)std::clamp(Config::modelVar().lodMaxNumOfLevels, 1, (int)MaxNumOfLODs);
+	if(Config::modelVar().generateLODs && maxNumOfLODs > 1)
+	{
+		const float reductionRatio = std::clamp(Config::modelVar().lodReductionRatio, 0.01f, 0.99f);
+
+		// Simplify the meshes in parallel; the indices of each LOD are kept separately until all the meshes are done
+		std::vector<std::vector<std::vector<unsigned int>>> lodIndices(m_meshPool.size());
+		std::vector<std::vector<float>> lodErrors(m_meshPool.size());
+
+		TaskManagerLocator::get().parallelFor(size_t(0), m_meshPool.size(), size_t(1), [&](size_t i)
+			{
+				const std::vector<unsigned int> meshIndices(m_indices.begin() + m_meshPool[i].m_baseIndex, m_indices.begin() + m_meshPool[i].m_baseIndex + m_meshPool[i].m_numIndices);
+				const std::vector<unsigned int> *previousLODIndices = &meshIndices;
+
+				for(unsigned int lod = 1; lod < maxNumOfLODs; lod++)
+				{
+					// Each LOD is simplified from the original mesh, with the allowed error growing with every level
+					const std::size_t targetNumOfIndices = (std::size_t)((float)previousLODIndices->size() * reductionRatio) / 3 * 3;
+					std::vector<unsigned int> simplifiedIndices;
+					const float error = simplifiers[i].simplify(meshIndices, targetNumOfIndices, Config::modelVar().lodTargetError * (float)lod, simplifiedIndices);
+
+					// Stop when the mesh cannot be simplified further in a meaningful way
+					if(simplifiedIndices.empty() || simplifiedIndices.size() * 10 > previousLODIndices->size() * 9)
+						break;
+
+					lodIndices[i].push_back(std::move(simplifiedIndices));
+					lodErrors[i].push_back(error);
+					previousLODIndices = &lodIndices[i].back();
+				}
+			});
+
+		// Append the indices of every LOD to the index buffer, so all LODs share the vertex and index buffers of the model
+		for(decltype(m_meshPool.size()) i = 0, size = m_meshPool.size(); i < size; i++)
+		{
+			for(decltype(lodIndices[i].size()) lod = 0, numOfLODs = lodIndices[i].size(); lod < numOfLODs; lod++)
+			{
+				auto &meshLOD = m_meshPool[i].m_lods[m_meshPool[i].m_numLODs++];
+				meshLOD.m_numIndices = (unsigned int)lodIndices[i][lod].size();
+				meshLOD.m_baseIndex = (unsigned int)m_indices.size();
+				meshLOD.m_error = lodErrors[i][lod];
+
+				m_indices.insert(m_indices.end(), lodIndices[i][lod].begin(), lodIndices[i][lod].end());
+			}
+		}
+	}
+
+	// Failing to save the LOD cache is not critical, as the LODs can be generated again next time
+	if(auto saveError = saveCachedLODs(cacheFilename); saveError != ErrorCode::Success)
+		ErrHandlerLoc::get().log(saveError, ErrorSource::Source_ModelLoader, cacheFilename);
+
+	return returnError;
+}
+ErrorCode Model::loadCachedLODs(const std::string &p_filename)
+{
+	std::ifstream lodCacheFile(p_filename, std::ios::in | std::ios::binary);
+	if(lodCacheFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	CachedLODHeader header;
+	lodCacheFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+	// Reject files of a different version, of different model data, or generated with different LOD settings; the LODs get generated again
+	if(lodCacheFile.fail() || std::memcmp(header.m_magic, g_cachedLODMagic, sizeof(g_cachedLODMagic)) != 0 || header.m_version != g_cachedLODVersion ||
+		header.m_numOfMeshes != (unsigned int)m_meshPool.size() || header.m_numOfVertices != (unsigned int)m_numVertices || header.m_numOfIndices != (unsigned int)m_indices.size() ||
+		header.m_generateLODs != (unsigned int)Config::modelVar().generateLODs || header.m_maxNumOfLODs != (unsigned int)Config::modelVar().lodMaxNumOfLevels ||
+		header.m_reductionRatio != Config::modelVar().lodReductionRatio || header.m_targetError != Config::modelVar().lodTargetError)
+		return ErrorCode::Failure;
+
+	// Read everything before modifying the meshes, so they are left untouched if the file is incomplete
+	std::vector<CachedMeshLODs> meshLODs(header.m_numOfMeshes);
+	std::vector<unsigned int> lodIndices(header.m_numOfLODIndices);
+	lodCacheFile.read(reinterpret_cast<char *>(meshLODs.data()), meshLODs.size() * sizeof(CachedMeshLODs));
+	lodCacheFile.read(reinterpret_cast<char *>(lodIndices.data()), lodIndices.size() * sizeof(unsigned int));
+
+	if(lodCacheFile.fail())
+		return ErrorCode::Failure;
+
+	// Make sure every LOD is within the index buffer, and every index is within the vertex buffer
+	const size_t numOfIndices = m_indices.size() + lodIndices.size();
+	for(decltype(meshLODs.size()) i = 0, size = meshLODs.size(); i < size; i++)
+	{
+		if(meshLODs[i].m_numLODs < 1 || meshLODs[i].m_numLODs > MaxNumOfLODs)
+			return ErrorCode::Failure;
+
+		for(unsigned int lod = 1; lod < meshLODs[i].m_numLODs; lod++)
+			if((size_t)meshLODs[i].m_lods[lod].m_baseIndex + meshLODs[i].m_lods[lod].m_numIndices > numOfIndices)
+				return ErrorCode::Failure;
+	}
+	for(const auto index : lodIndices)
+		if(index >= m_numVertices)
+			return ErrorCode::Failure;
+
+	for(decltype(meshLODs.size()) i = 0, size = meshLODs.size(); i < size; i++)
+	{
+		for(unsigned int lod = 1; lod < meshLODs[i].m_numLODs; lod++)
+			m_meshPool[i].m_lods[lod] = meshLODs[i].m_lods[lod];
+
+		m_meshPool[i].m_numLODs = meshLODs[i].m_numLODs;
+		m_meshPool[i].m_boundingSphereCenter = meshLODs[i].m_boundingSphereCenter;
+		m_meshPool[i].m_boundingSphereRadius = meshLODs[i].m_boundingSphereRadius;
+	}
+	m_indices.insert(m_indices.end(), lodIndices.begin(), lodIndices.end());
+
+	return ErrorCode::Success;
+}
+ErrorCode Model::saveCachedLODs(const std::string &p_filename) const
+{
+	// The LOD indices are appended after the indices of the original meshes
+	unsigned int numOfOriginalIndices = 0;
+	for(const auto &mesh : m_meshPool)
+		numOfOriginalIndices += mesh.m_numIndices;
+
+	Filesystem::createDirectories(Utilities::stripFilePath(p_filename));
+
+	std::ofstream lodCacheFile(p_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(lodCacheFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	CachedLODHeader header;
+	std::memcpy(header.m_magic, g_cachedLODMagic, sizeof(g_cachedLODMagic));
+	header.m_version = g_cachedLODVersion;
+	header.m_numOfMeshes = (unsigned int)m_meshPool.size();
+	header.m_numOfVertices = (unsigned int)m_numVertices;
+	header.m_numOfIndices = numOfOriginalIndices;
+	header.m_numOfLODIndices = (unsigned int)m_indices.size() - numOfOriginalIndices;
+	header.m_generateLODs = (unsigned int)Config::modelVar().generateLODs;
+	header.m_maxNumOfLODs = (unsigned int)Config::modelVar().lodMaxNumOfLevels;
+	header.m_reductionRatio = Config::modelVar().lodReductionRatio;
+	header.m_targetError = Config::modelVar().lodTargetError;
+
+	std::vector<CachedMeshLODs> meshLODs(m_meshPool.size());
+	for(decltype(m_meshPool.size()) i = 0, size = m_meshPool.size(); i < size; i++)
+	{
+		for(unsigned int lod = 0; lod < m_meshPool[i].m_numLODs; lod++)
+			meshLODs[i].m_lods[lod] = m_meshPool[i].m_lods[lod];
+
+		meshLODs[i].m_numLODs = m_meshPool[i].m_numLODs;
+		meshLODs[i].m_boundingSphereCenter = m_meshPool[i].m_boundingSphereCenter;
+		meshLODs[i].m_boundingSphereRadius = m_meshPool[i].m_boundingSphereRadius;
+	}
+
+	lodCacheFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	lodCacheFile.write(reinterpret_cast<const char *>(meshLODs.data()), meshLODs.size() * sizeof(CachedMeshLODs));
+	lodCacheFile.write(reinterpret_cast<const char *>(m_indices.data() + numOfOriginalIndices), header.m_numOfLODIndices * sizeof(unsigned int));
+
+	return lodCacheFile.fail() ? ErrorCode::Failure : ErrorCode::Success;
+}
 ErrorCode Model::loadMaterials(const aiScene &p_assimpScene)
 {
 	ErrorCode returnError = ErrorCode::Success;
@@ -323,8 +600,23 @@ ErrorCode Model::loadTextures(aiTexture **p_assimpTextures, size_t p_numTextures
 {
 	return ErrorCode::Success;
 }
+void Model::updateMemorySize()
+{
+	// Cleared arrays keep their reserved space, so it is still accounted for
+	int64_t memorySize = 0;
+	memorySize += m_meshPool.capacity()		* sizeof(Mesh);
+	memorySize += m_meshNames.capacity()	* sizeof(std::string);
+	memorySize += m_indices.capacity()		* sizeof(unsigned int);
+	memorySize += m_positions.capacity()	* sizeof(glm::vec3);
+	memorySize += m_normals.capacity()		* sizeof(glm::vec3);
+	memorySize += m_texCoords.capacity()	* sizeof(glm::vec2);
+	memorySize += m_tangents.capacity()		* sizeof(glm::vec3);
+	memorySize += m_bitangents.capacity()	* sizeof(glm::vec3);
+
+	setMemorySize(MemoryType_RAM, memorySize);
+}
 
-ModelLoader::ModelLoader()
+ModelLoader::ModelLoader() : LoaderBase(MemoryTag_Models, ErrorSource::Source_ModelLoader)
 {
 	m_defaultModel = new Model(this, "null_model", 0, 0);
 	m_defaultModelHandle = new ModelHandle(*m_defaultModel);
@@ -23,6 +23,24 @@ public:
 	// Note: caution with modifying. Correlates with enum in Renderer class, for convenience
 	// Note: the order is sensitive
 
+	static constexpr unsigned int MaxNumOfLODs = 8;
+
+	// Level of detail of a mesh: a range of simplified indices that reference the vertices of the original mesh
+	struct MeshLOD
+	{
+		MeshLOD()
+		{
+			m_numIndices = 0;
+			m_baseIndex = 0;
+			m_error = 0.0f;
+		}
+
+		unsigned int m_numIndices;
+		unsigned int m_baseIndex;
+
+		// Simplification error, relative to the bounding sphere radius of the mesh
+		float m_error;
+	};
 	struct Mesh
 	{
 		Mesh()
@@ -31,12 +49,23 @@ public:
 			m_numIndices = 0;
 			m_baseVertex = 0;
 			m_baseIndex = 0;
+			m_numLODs = 1;
+			m_boundingSphereCenter = glm::vec3(0.0f);
+			m_boundingSphereRadius = 0.0f;
 		}
 
 		unsigned int m_materialIndex;
 		unsigned int m_numIndices;
 		unsigned int m_baseVertex;
 		unsigned int m_baseIndex;
+
+		// Levels of detail, from the most detailed one; the first LOD is the original mesh
+		MeshLOD m_lods[MaxNumOfLODs];
+		unsigned int m_numLODs;
+
+		// Bounding sphere in model space, used to calculate the screen size of the mesh when selecting its LOD
+		glm::vec3 m_boundingSphereCenter;
+		float m_boundingSphereRadius;
 	};
 	struct Material
 	{
@@ -99,10 +128,37 @@ public:
 			m_bufferSize[i] = 0;
 	}
 
+	// LOD cache file header, followed by the LODs of each mesh and the indices of all LODs (except the first ones, which are the original meshes)
+	struct CachedLODHeader
+	{
+		char m_magic[4];
+		unsigned int m_version;
+		unsigned int m_numOfMeshes;
+		unsigned int m_numOfVertices;
+		unsigned int m_numOfIndices;
+		unsigned int m_numOfLODIndices;
+		unsigned int m_generateLODs;
+		unsigned int m_maxNumOfLODs;
+		float m_reductionRatio;
+		float m_targetError;
+	};
+	struct CachedMeshLODs
+	{
+		MeshLOD m_lods[MaxNumOfLODs];
+		unsigned int m_numLODs;
+		glm::vec3 m_boundingSphereCenter;
+		float m_boundingSphereRadius;
+	};
+
 	// Loads data from HDD to RAM and restructures it to be used to fill buffers later
 	ErrorCode loadToMemory();
 	// Deletes data stored in RAM. Does not delete buffers that are loaded on GPU VRAM.
 	ErrorCode unloadMemory();
+	// Deletes the vertex data and indices stored in RAM after they were uploaded to VRAM, unless a consumer registered interest in them.
+	// Positions and indices can be kept for consumers that read them without registering (e.g. occlusion culling). Meshes and materials are kept
+	void releaseCPUData(const bool p_keepPositionsAndIndices);
+	// Reloads the released vertex data and indices from the model file
+	ErrorCode reloadCPUData();
 
 	// Loads the model data from file (using internal filename)
 	void loadFromFile();
@@ -110,10 +166,17 @@ public:
 	ErrorCode loadFromScene(const aiScene &p_assimpScene);
 	// Fills mesh buffers
 	ErrorCode loadMeshes(const aiScene &p_assimpScene);
+	// Generates simplified levels of detail of each mesh, appending their indices to the index buffer.
+	// Generated LODs are saved to the LOD cache, and loaded from it instead, while the model file and LOD settings are unchanged
+	ErrorCode generateLODs();
+	ErrorCode loadCachedLODs(const std::string &p_filename);
+	ErrorCode saveCachedLODs(const std::string &p_filename) const;
 	// Gets material filenames from model file
 	ErrorCode loadMaterials(const aiScene &p_assimpScene);
 	// Load textures embedded in the model file. Note: currently unused / no implementation
 	ErrorCode loadTextures(aiTexture **p_assimpTextures, size_t p_numTextures);
+	// Sets the system memory size from the reserved space of the data arrays
+	void updateMemorySize();
 
 	inline MaterialArrays &getMaterialArrays() { return m_materials; }
 
@@ -226,6 +289,10 @@ public:
 		ModelHandle(ModelHandle &&p_modelHandle) noexcept : m_model(p_modelHandle.m_model) { m_model->incRefCounter(); }
 		~ModelHandle() { m_model->decRefCounter(); }
 		
+		// Register a consumer that reads the vertex data and indices in RAM, so they are kept after uploading to VRAM (and reloaded, if they were released)
+		inline ErrorCode registerCPUDataInterest() { return m_model->registerCPUDataInterest(); }
+		inline void unregisterCPUDataInterest() { m_model->unregisterCPUDataInterest(); }
+
 		// Loads data from HDD to RAM and restructures it to be used to fill buffers later
 		ErrorCode loadToMemory(bool p_setLoadedToMemoryFlag = true)
 		{
@@ -271,6 +338,8 @@ public:
 		// Getters
 		inline Model::MaterialArrays &getMaterialArrays() const		{ return m_model->getMaterialArrays();		}
 		inline const std::vector<Model::Mesh> &getMeshArray() const	{ return m_model->m_meshPool;				}
+		inline const std::vector<glm::vec3> &getPositions() const	{ return m_model->m_positions;				}
+		inline const std::vector<unsigned int> &getIndices() const	{ return m_model->m_indices;				}
 		inline size_t getNumMeshes() const							{ return m_model->m_numMeshes;				}
 		inline MeshIterator getMeshIterator() const					{ return MeshIterator(*m_model);			}
 		inline const size_t getMeshSize() const						{ return m_model->m_numMeshes;				}
@@ -289,7 +358,18 @@ public:
 	private:
 		ModelHandle(Model &p_model) : m_model(&p_model) { m_model->incRefCounter(); }
 
-		void setLoadedToVideoMemory(bool p_loaded) { m_model->m_loadedToVideoMemory = p_loaded; }
+		void setLoadedToVideoMemory(bool p_loaded)
+		{
+			m_model->m_loadedToVideoMemory = p_loaded;
+
+			// Video memory holds all the buffers while the model is loaded
+			int64_t videoMemorySize = 0;
+			if(p_loaded)
+				for(int i = 0; i < ModelBuffer_NumAllTypes; i++)
+					videoMemorySize += m_model->m_bufferSize[i];
+
+			m_model->setMemorySize(MemoryType_VRAM, videoMemorySize);
+		}
 
 		Model *m_model;
 	};
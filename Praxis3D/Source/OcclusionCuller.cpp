@@ -0,0 +1,492 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "OcclusionCuller.h"
+#include "TaskManagerLocator.h"
+
+#if SETTING_OCCLUSION_CULLING_SIMD > 0
+#include <immintrin.h>
+#endif
+
+// Number of depth buffer rows in each band that is rasterized as a single task
+static constexpr int g_occlusionBandHeight = 16;
+
+// Triangles are clipped against planes placed at this multiple of the screen extents, so the screen-space coordinates stay small enough for the edge functions to be precise
+static constexpr float g_occlusionGuardBand = 2.0f;
+
+// Maximum number of vertices of a triangle clipped against the near plane and the four guard band planes
+static constexpr unsigned int g_occlusionMaxClippedVertices = 8;
+
+OcclusionCuller::OcclusionCuller()
+{
+	m_width = 0;
+	m_height = 0;
+	m_viewProjMatrix = glm::mat4(1.0f);
+	m_rasterized = false;
+	m_simdEnabled = true;
+}
+
+OcclusionCuller::~OcclusionCuller()
+{
+}
+
+void OcclusionCuller::setBufferSize(const unsigned int p_width, const unsigned int p_height)
+{
+	const unsigned int width = std::max((p_width + 3u) & ~3u, 4u);
+	const unsigned int height = std::max(p_height, 1u);
+
+	if(m_width == width && m_height == height)
+		return;
+
+	m_width = width;
+	m_height = height;
+	m_rasterized = false;
+
+	// Each level is half the size of the previous one (rounded up), down to a single texel
+	m_levels.clear();
+
+	unsigned int levelWidth = m_width;
+	unsigned int levelHeight = m_height;
+	while(true)
+	{
+		m_levels.emplace_back();
+		m_levels.back().m_width = levelWidth;
+		m_levels.back().m_height = levelHeight;
+		m_levels.back().m_depth.resize((std::size_t)levelWidth * levelHeight, 1.0f);
+
+		if(levelWidth == 1 && levelHeight == 1)
+			break;
+
+		levelWidth = (levelWidth + 1) / 2;
+		levelHeight = (levelHeight + 1) / 2;
+	}
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4 &p_viewProjMatrix)
+{
+	m_viewProjMatrix = p_viewProjMatrix;
+	m_occluders.clear();
+	m_rasterized = false;
+}
+
+void OcclusionCuller::rasterize(const bool p_parallel)
+{
+	if(m_levels.empty())
+		return;
+
+	// Clear the depth buffer to the far plane
+	std::fill(m_levels[0].m_depth.begin(), m_levels[0].m_depth.end(), 1.0f);
+
+	// Set up the screen-space triangles of each occluder
+	if(m_occluderTriangles.size() < m_occluders.size())
+		m_occluderTriangles.resize(m_occluders.size());
+
+	const auto setupOccluder = [this](const std::size_t p_occluderIndex)
+	{
+		m_occluderTriangles[p_occluderIndex].clear();
+		setupTriangles(m_occluders[p_occluderIndex], m_occluderTriangles[p_occluderIndex]);
+	};
+
+	// Rasterize the triangles of every occluder into each band of rows; bands don't overlap, so they can be written to concurrently
+	const std::size_t numOfBands = (m_height + g_occlusionBandHeight - 1) / g_occlusionBandHeight;
+	const auto rasterizeBandIndex = [this](const std::size_t p_bandIndex)
+	{
+		rasterizeBand((int)p_bandIndex * g_occlusionBandHeight, std::min((int)(p_bandIndex + 1) * g_occlusionBandHeight, (int)m_height));
+	};
+
+	if(p_parallel)
+	{
+		TaskManagerLocator::get().parallelFor(std::size_t(0), m_occluders.size(), std::size_t(1), setupOccluder);
+		TaskManagerLocator::get().parallelFor(std::size_t(0), numOfBands, std::size_t(1), rasterizeBandIndex);
+	}
+	else
+	{
+		for(std::size_t i = 0, size = m_occluders.size(); i < size; i++)
+			setupOccluder(i);
+		for(std::size_t i = 0; i < numOfBands; i++)
+			rasterizeBandIndex(i);
+	}
+
+	buildHiZPyramid();
+
+	m_rasterized = true;
+}
+
+bool OcclusionCuller::isBoundingBoxOccluded(const glm::vec3 &p_min, const glm::vec3 &p_max) const
+{
+	if(!m_rasterized)
+		return false;
+
+	// Project the corners of the box to the screen, and find the screen-space rectangle and the nearest depth of the box
+	glm::vec2 screenMin(std::numeric_limits<float>::max());
+	glm::vec2 screenMax(std::numeric_limits<float>::lowest());
+	float nearestDepth = std::numeric_limits<float>::max();
+
+	for(unsigned int i = 0; i < 8; i++)
+	{
+		const glm::vec4 corner((i & 1) ? p_max.x : p_min.x, (i & 2) ? p_max.y : p_min.y, (i & 4) ? p_max.z : p_min.z, 1.0f);
+		const glm::vec4 clipCorner = m_viewProjMatrix * corner;
+
+		// The box crosses the near plane, so it cannot be hidden behind anything
+		if(clipCorner.w <= 0.0f || clipCorner.z < -clipCorner.w)
+			return false;
+
+		const glm::vec3 ndcCorner = glm::vec3(clipCorner) / clipCorner.w;
+		screenMin = glm::min(screenMin, glm::vec2(ndcCorner));
+		screenMax = glm::max(screenMax, glm::vec2(ndcCorner));
+		nearestDepth = std::min(nearestDepth, ndcCorner.z * 0.5f + 0.5f);
+	}
+
+	// Convert to the depth buffer pixels
+	screenMin = (screenMin * 0.5f + 0.5f) * glm::vec2((float)m_width, (float)m_height);
+	screenMax = (screenMax * 0.5f + 0.5f) * glm::vec2((float)m_width, (float)m_height);
+
+	// Boxes outside the screen are left to the frustum culling
+	if(screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= (float)m_width || screenMin.y >= (float)m_height)
+		return false;
+
+	// Expand the rectangle by a pixel, as occluder pixels are covered if only their center is inside a triangle
+	int minX = std::max((int)std::floor(screenMin.x) - 1, 0);
+	int minY = std::max((int)std::floor(screenMin.y) - 1, 0);
+	int maxX = std::min((int)std::floor(screenMax.x) + 1, (int)m_width - 1);
+	int maxY = std::min((int)std::floor(screenMax.y) + 1, (int)m_height - 1);
+
+	// Go up the pyramid until the rectangle covers at most 4x4 texels
+	std::size_t level = 0;
+	while((maxX - minX > 3 || maxY - minY > 3) && level + 1 < m_levels.size())
+	{
+		minX >>= 1;
+		minY >>= 1;
+		maxX >>= 1;
+		maxY >>= 1;
+		level++;
+	}
+
+	// The box is occluded only if it is farther than the farthest occluder depth of every texel under it
+	const HiZLevel &hiZLevel = m_levels[level];
+	for(int y = minY; y <= maxY; y++)
+	{
+		const float *row = &hiZLevel.m_depth[(std::size_t)y * hiZLevel.m_width];
+
+		for(int x = minX; x <= maxX; x++)
+			if(row[x] >= nearestDepth)
+				return false;
+	}
+
+	return true;
+}
+
+std::size_t OcclusionCuller::getNumOfRasterizedTriangles() const
+{
+	std::size_t numOfTriangles = 0;
+
+	for(std::size_t i = 0, size = std::min(m_occluders.size(), m_occluderTriangles.size()); i < size; i++)
+		numOfTriangles += m_occluderTriangles[i].size();
+
+	return numOfTriangles;
+}
+
+void OcclusionCuller::setupTriangles(const Occluder &p_occluder, std::vector<ScreenTriangle> &p_triangles) const
+{
+	// Clipping planes in clip space: near plane (z >= -w) and the guard band around the screen edges
+	const glm::vec4 clipPlanes[] = {
+		glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+		glm::vec4(1.0f, 0.0f, 0.0f, g_occlusionGuardBand),
+		glm::vec4(-1.0f, 0.0f, 0.0f, g_occlusionGuardBand),
+		glm::vec4(0.0f, 1.0f, 0.0f, g_occlusionGuardBand),
+		glm::vec4(0.0f, -1.0f, 0.0f, g_occlusionGuardBand) };
+	constexpr unsigned int numOfClipPlanes = sizeof(clipPlanes) / sizeof(clipPlanes[0]);
+
+	p_triangles.reserve(p_occluder.m_numOfIndices / 3);
+
+	for(unsigned int i = 0, numOfIndices = p_occluder.m_numOfIndices - p_occluder.m_numOfIndices % 3; i < numOfIndices; i += 3)
+	{
+		glm::vec4 vertices[3];
+		unsigned int outsideMasks[3];
+
+		for(unsigned int v = 0; v < 3; v++)
+		{
+			vertices[v] = p_occluder.m_modelViewProjMatrix * glm::vec4(p_occluder.m_positions[p_occluder.m_indices[i + v]], 1.0f);
+
+			outsideMasks[v] = 0;
+			for(unsigned int plane = 0; plane < numOfClipPlanes; plane++)
+				if(glm::dot(clipPlanes[plane], vertices[v]) < 0.0f)
+					outsideMasks[v] |= 1u << plane;
+		}
+
+		// Discard triangles that are completely outside any of the planes
+		if((outsideMasks[0] & outsideMasks[1] & outsideMasks[2]) != 0)
+			continue;
+
+		// Triangles that are completely inside don't need clipping
+		if((outsideMasks[0] | outsideMasks[1] | outsideMasks[2]) == 0)
+		{
+			addScreenTriangles(vertices, 3, p_triangles);
+			continue;
+		}
+
+		// Clip the triangle against each plane that any of its vertices is outside of (Sutherland-Hodgman)
+		glm::vec4 polygon[2][g_occlusionMaxClippedVertices];
+		unsigned int numOfVertices = 3;
+		unsigned int current = 0;
+		std::copy(vertices, vertices + 3, polygon[current]);
+
+		for(unsigned int plane = 0; plane < numOfClipPlanes && numOfVertices > 0; plane++)
+		{
+			if(((outsideMasks[0] | outsideMasks[1] | outsideMasks[2]) & (1u << plane)) == 0)
+				continue;
+
+			const glm::vec4 *input = polygon[current];
+			glm::vec4 *output = polygon[current ^ 1];
+			unsigned int numOfOutputVertices = 0;
+
+			for(unsigned int v = 0; v < numOfVertices; v++)
+			{
+				const glm::vec4 &start = input[v];
+				const glm::vec4 &end = input[(v + 1) % numOfVertices];
+				const float startDistance = glm::dot(clipPlanes[plane], start);
+				const float endDistance = glm::dot(clipPlanes[plane], end);
+
+				if(startDistance >= 0.0f)
+					output[numOfOutputVertices++] = start;
+
+				// Intersection is always interpolated from the inside vertex, so the triangles that share the edge get the exact same point
+				if((startDistance >= 0.0f) != (endDistance >= 0.0f))
+				{
+					if(startDistance >= 0.0f)
+						output[numOfOutputVertices++] = start + (end - start) * (startDistance / (startDistance - endDistance));
+					else
+						output[numOfOutputVertices++] = end + (start - end) * (endDistance / (endDistance - startDistance));
+				}
+			}
+
+			numOfVertices = numOfOutputVertices;
+			current ^= 1;
+		}
+
+		if(numOfVertices >= 3)
+			addScreenTriangles(polygon[current], numOfVertices, p_triangles);
+	}
+}
+
+void OcclusionCuller::addScreenTriangles(const glm::vec4 *p_vertices, const unsigned int p_numOfVertices, std::vector<ScreenTriangle> &p_triangles) const
+{
+	// Perspective divide and viewport transform
+	glm::vec3 screenVertices[g_occlusionMaxClippedVertices];
+	for(unsigned int v = 0; v < p_numOfVertices; v++)
+	{
+		const glm::vec3 ndcVertex = glm::vec3(p_vertices[v]) / p_vertices[v].w;
+		screenVertices[v] = glm::vec3((ndcVertex.x * 0.5f + 0.5f) * (float)m_width, (ndcVertex.y * 0.5f + 0.5f) * (float)m_height, ndcVertex.z * 0.5f + 0.5f);
+	}
+
+	for(unsigned int v = 1; v + 1 < p_numOfVertices; v++)
+	{
+		const glm::vec3 &v0 = screenVertices[0];
+		const glm::vec3 &v1 = screenVertices[v];
+		const glm::vec3 &v2 = screenVertices[v + 1];
+
+		// Discard back-facing (clockwise) and degenerate triangles
+		const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+		if(area <= 0.0f)
+			continue;
+
+		ScreenTriangle triangle;
+		triangle.m_vertices[0] = v0;
+		triangle.m_vertices[1] = v1;
+		triangle.m_vertices[2] = v2;
+		triangle.m_minY = std::max((int)std::floor(std::min(v0.y, std::min(v1.y, v2.y))), 0);
+		triangle.m_maxY = std::min((int)std::floor(std::max(v0.y, std::max(v1.y, v2.y))), (int)m_height - 1);
+
+		if(triangle.m_minY <= triangle.m_maxY)
+			p_triangles.push_back(triangle);
+	}
+}
+
+void OcclusionCuller::rasterizeBand(const int p_beginY, const int p_endY)
+{
+	for(std::size_t occluderIndex = 0, numOfOccluders = m_occluders.size(); occluderIndex < numOfOccluders; occluderIndex++)
+	{
+		for(const auto &triangle : m_occluderTriangles[occluderIndex])
+		{
+			if(triangle.m_maxY < p_beginY || triangle.m_minY >= p_endY)
+				continue;
+
+#if SETTING_OCCLUSION_CULLING_SIMD >= 1
+			if(m_simdEnabled)
+				rasterizeTriangleSSE(triangle, p_beginY, p_endY);
+			else
+				rasterizeTriangleScalar(triangle, p_beginY, p_endY);
+#else
+			rasterizeTriangleScalar(triangle, p_beginY, p_endY);
+#endif
+		}
+	}
+}
+
+// Edge functions and the depth plane of a screen-space triangle, each in the form of a * x + b * y + c.
+// Pixels whose centers lie exactly on an edge are only covered if the edge is inclusive (a top-left rule), so the pixels on the edge
+// shared by two triangles are covered exactly once; a pixel left uncovered would leave a hole that propagates up the whole depth pyramid
+struct OcclusionTriangleSetup
+{
+	OcclusionTriangleSetup(const glm::vec3 (&p_vertices)[3])
+	{
+		const glm::vec3 &v0 = p_vertices[0];
+		const glm::vec3 &v1 = p_vertices[1];
+		const glm::vec3 &v2 = p_vertices[2];
+
+		// Each edge function is positive on the inner side of the edge, and equals the triangle area (times two) at the opposite vertex
+		const auto setEdge = [](glm::vec3 &p_edge, bool &p_inclusive, const glm::vec3 &p_start, const glm::vec3 &p_end)
+		{
+			p_edge.x = p_start.y - p_end.y;
+			p_edge.y = p_end.x - p_start.x;
+
+			// The constant is calculated from the same vertex in both directions of the edge, so that the triangles sharing the edge get exactly negated values
+			const glm::vec3 &origin = (p_start.x < p_end.x || (p_start.x == p_end.x && p_start.y < p_end.y)) ? p_start : p_end;
+			p_edge.z = -(p_edge.x * origin.x + p_edge.y * origin.y);
+
+			// Exactly one of the two directions of an edge is inclusive
+			p_inclusive = p_edge.x > 0.0f || (p_edge.x == 0.0f && p_edge.y < 0.0f);
+		};
+		setEdge(m_edges[0], m_inclusive[0], v1, v2);
+		setEdge(m_edges[1], m_inclusive[1], v2, v0);
+		setEdge(m_edges[2], m_inclusive[2], v0, v1);
+
+		// Depth is interpolated with the barycentric coordinates (edge functions divided by the area)
+		const float inverseArea = 1.0f / (m_edges[2].x * v2.x + m_edges[2].y * v2.y + m_edges[2].z);
+		m_depth = (m_edges[0] * v0.z + m_edges[1] * v1.z + m_edges[2] * v2.z) * inverseArea;
+	}
+
+	// Returns true if the pixel center with the given value of the edge function is on the inner side of the edge
+	inline bool isInside(const unsigned int p_edgeIndex, const float p_edgeValue) const { return p_edgeValue > 0.0f || (p_edgeValue == 0.0f && m_inclusive[p_edgeIndex]); }
+
+	glm::vec3 m_edges[3];
+	glm::vec3 m_depth;
+	bool m_inclusive[3];
+};
+
+void OcclusionCuller::rasterizeTriangleScalar(const ScreenTriangle &p_triangle, const int p_beginY, const int p_endY)
+{
+	const glm::vec3 (&vertices)[3] = p_triangle.m_vertices;
+	const OcclusionTriangleSetup setup(vertices);
+
+	const int minX = std::max((int)std::floor(std::min(vertices[0].x, std::min(vertices[1].x, vertices[2].x))), 0);
+	const int maxX = std::min((int)std::floor(std::max(vertices[0].x, std::max(vertices[1].x, vertices[2].x))), (int)m_width - 1);
+	const int minY = std::max(p_triangle.m_minY, p_beginY);
+	const int maxY = std::min(p_triangle.m_maxY, p_endY - 1);
+
+	for(int y = minY; y <= maxY; y++)
+	{
+		const float pixelY = (float)y + 0.5f;
+		float *row = &m_levels[0].m_depth[(std::size_t)y * m_width];
+
+		// Parts of the functions that are constant along the row
+		const float rowEdge0 = setup.m_edges[0].y * pixelY + setup.m_edges[0].z;
+		const float rowEdge1 = setup.m_edges[1].y * pixelY + setup.m_edges[1].z;
+		const float rowEdge2 = setup.m_edges[2].y * pixelY + setup.m_edges[2].z;
+		const float rowDepth = setup.m_depth.y * pixelY + setup.m_depth.z;
+
+		for(int x = minX; x <= maxX; x++)
+		{
+			const float pixelX = (float)x + 0.5f;
+
+			if(setup.isInside(0, setup.m_edges[0].x * pixelX + rowEdge0) &&
+				setup.isInside(1, setup.m_edges[1].x * pixelX + rowEdge1) &&
+				setup.isInside(2, setup.m_edges[2].x * pixelX + rowEdge2))
+			{
+				row[x] = std::min(row[x], setup.m_depth.x * pixelX + rowDepth);
+			}
+		}
+	}
+}
+
+void OcclusionCuller::rasterizeTriangleSSE(const ScreenTriangle &p_triangle, const int p_beginY, const int p_endY)
+{
+#if SETTING_OCCLUSION_CULLING_SIMD >= 1
+	const glm::vec3 (&vertices)[3] = p_triangle.m_vertices;
+	const OcclusionTriangleSetup setup(vertices);
+
+	// Pixels are processed in aligned groups of 4; the buffer width is a multiple of 4, so groups never cross the end of a row
+	const int minX = std::max((int)std::floor(std::min(vertices[0].x, std::min(vertices[1].x, vertices[2].x))), 0) & ~3;
+	const int maxX = std::min((int)std::floor(std::max(vertices[0].x, std::max(vertices[1].x, vertices[2].x))), (int)m_width - 1);
+	const int minY = std::max(p_triangle.m_minY, p_beginY);
+	const int maxY = std::min(p_triangle.m_maxY, p_endY - 1);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 four = _mm_set1_ps(4.0f);
+	const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+	const __m128 edgeA0 = _mm_set1_ps(setup.m_edges[0].x), edgeB0 = _mm_set1_ps(setup.m_edges[0].y), edgeC0 = _mm_set1_ps(setup.m_edges[0].z);
+	const __m128 edgeA1 = _mm_set1_ps(setup.m_edges[1].x), edgeB1 = _mm_set1_ps(setup.m_edges[1].y), edgeC1 = _mm_set1_ps(setup.m_edges[1].z);
+	const __m128 edgeA2 = _mm_set1_ps(setup.m_edges[2].x), edgeB2 = _mm_set1_ps(setup.m_edges[2].y), edgeC2 = _mm_set1_ps(setup.m_edges[2].z);
+	const __m128 depthA = _mm_set1_ps(setup.m_depth.x), depthB = _mm_set1_ps(setup.m_depth.y), depthC = _mm_set1_ps(setup.m_depth.z);
+
+	// All bits set for inclusive edges, so the pixel centers on them are also covered
+	const __m128 inclusive0 = _mm_castsi128_ps(_mm_set1_epi32(setup.m_inclusive[0] ? -1 : 0));
+	const __m128 inclusive1 = _mm_castsi128_ps(_mm_set1_epi32(setup.m_inclusive[1] ? -1 : 0));
+	const __m128 inclusive2 = _mm_castsi128_ps(_mm_set1_epi32(setup.m_inclusive[2] ? -1 : 0));
+
+	for(int y = minY; y <= maxY; y++)
+	{
+		const __m128 pixelY = _mm_set1_ps((float)y + 0.5f);
+		float *row = &m_levels[0].m_depth[(std::size_t)y * m_width];
+
+		// Parts of the functions that are constant along the row
+		const __m128 rowEdge0 = _mm_add_ps(_mm_mul_ps(edgeB0, pixelY), edgeC0);
+		const __m128 rowEdge1 = _mm_add_ps(_mm_mul_ps(edgeB1, pixelY), edgeC1);
+		const __m128 rowEdge2 = _mm_add_ps(_mm_mul_ps(edgeB2, pixelY), edgeC2);
+		const __m128 rowDepth = _mm_add_ps(_mm_mul_ps(depthB, pixelY), depthC);
+
+		__m128 pixelX = _mm_add_ps(_mm_set1_ps((float)minX), pixelOffsets);
+
+		for(int x = minX; x <= maxX; x += 4, pixelX = _mm_add_ps(pixelX, four))
+		{
+			const __m128 edge0 = _mm_add_ps(_mm_mul_ps(edgeA0, pixelX), rowEdge0);
+			const __m128 edge1 = _mm_add_ps(_mm_mul_ps(edgeA1, pixelX), rowEdge1);
+			const __m128 edge2 = _mm_add_ps(_mm_mul_ps(edgeA2, pixelX), rowEdge2);
+
+			const __m128 inside0 = _mm_or_ps(_mm_cmpgt_ps(edge0, zero), _mm_and_ps(_mm_cmpeq_ps(edge0, zero), inclusive0));
+			const __m128 inside1 = _mm_or_ps(_mm_cmpgt_ps(edge1, zero), _mm_and_ps(_mm_cmpeq_ps(edge1, zero), inclusive1));
+			const __m128 inside2 = _mm_or_ps(_mm_cmpgt_ps(edge2, zero), _mm_and_ps(_mm_cmpeq_ps(edge2, zero), inclusive2));
+
+			const __m128 insideMask = _mm_and_ps(_mm_and_ps(inside0, inside1), inside2);
+			if(_mm_movemask_ps(insideMask) == 0)
+				continue;
+
+			const __m128 depth = _mm_add_ps(_mm_mul_ps(depthA, pixelX), rowDepth);
+			const __m128 currentDepth = _mm_loadu_ps(&row[x]);
+			const __m128 nearestDepth = _mm_min_ps(currentDepth, depth);
+
+			_mm_storeu_ps(&row[x], _mm_or_ps(_mm_and_ps(insideMask, nearestDepth), _mm_andnot_ps(insideMask, currentDepth)));
+		}
+	}
+#endif
+}
+
+void OcclusionCuller::buildHiZPyramid()
+{
+	for(std::size_t level = 1, numOfLevels = m_levels.size(); level < numOfLevels; level++)
+	{
+		const HiZLevel &previousLevel = m_levels[level - 1];
+		HiZLevel &currentLevel = m_levels[level];
+
+		for(unsigned int y = 0; y < currentLevel.m_height; y++)
+		{
+			// Odd-sized levels have their last texel cover only the last row or column of the previous level
+			const unsigned int previousY0 = y * 2;
+			const unsigned int previousY1 = std::min(previousY0 + 1, previousLevel.m_height - 1);
+
+			const float *previousRow0 = &previousLevel.m_depth[(std::size_t)previousY0 * previousLevel.m_width];
+			const float *previousRow1 = &previousLevel.m_depth[(std::size_t)previousY1 * previousLevel.m_width];
+			float *row = &currentLevel.m_depth[(std::size_t)y * currentLevel.m_width];
+
+			for(unsigned int x = 0; x < currentLevel.m_width; x++)
+			{
+				const unsigned int previousX0 = x * 2;
+				const unsigned int previousX1 = std::min(previousX0 + 1, previousLevel.m_width - 1);
+
+				row[x] = std::max(std::max(previousRow0[previousX0], previousRow0[previousX1]), std::max(previousRow1[previousX0], previousRow1[previousX1]));
+			}
+		}
+	}
+}
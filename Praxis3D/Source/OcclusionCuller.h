@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+
+#include "EngineDefinitions.h"
+#include "Math.h"
+
+// Software occlusion culling: a small set of occluder meshes is rasterized on the CPU into a low-resolution depth buffer, which is then reduced
+// into a hierarchical depth (Hi-Z) pyramid, where each texel holds the farthest depth of the texels it covers. Bounding volumes are projected
+// to the screen and tested against the pyramid level at which they cover only a few texels; a volume is occluded if its nearest depth is
+// farther than every occluder depth under it. Rasterization is split into horizontal bands that are processed in parallel on worker threads,
+// 4 pixels at a time (SSE) or one at a time, depending on SETTING_OCCLUSION_CULLING_SIMD.
+// Only covers pixels whose centers are inside the (front-facing) triangles, and tests bounding volumes expanded by one texel, so that
+// it errs on the side of visibility. Contains no graphics API calls, so it can be used and validated without a GPU
+class OcclusionCuller
+{
+public:
+	OcclusionCuller();
+	~OcclusionCuller();
+
+	// Set the resolution of the depth buffer; the width is rounded up to a multiple of 4 pixels
+	void setBufferSize(const unsigned int p_width, const unsigned int p_height);
+
+	// Remove the occluders of the previous frame and set the view-projection matrix used for both the rasterization and the tests.
+	// Tests return false (not occluded) until the occluders are rasterized
+	void beginFrame(const glm::mat4 &p_viewProjMatrix);
+
+	// Add an occluder mesh to be rasterized; indices are relative to the given positions, which must stay valid until rasterize() returns
+	inline void addOccluder(const glm::vec3 *p_positions, const unsigned int *p_indices, const unsigned int p_numOfIndices, const glm::mat4 &p_modelMatrix)
+	{
+		m_occluders.emplace_back(p_positions, p_indices, p_numOfIndices, m_viewProjMatrix * p_modelMatrix);
+	}
+
+	// Transform and clip the triangles of all occluders, rasterize them into the depth buffer and build the Hi-Z pyramid.
+	// Work is split between worker threads, unless p_parallel is false
+	void rasterize(const bool p_parallel = true);
+
+	// Disable the tests until the next frame is rasterized
+	inline void reset() { m_rasterized = false; }
+
+	// Select between the SSE and scalar rasterization (e.g. to validate that both produce the same depth buffer); has no effect if SETTING_OCCLUSION_CULLING_SIMD is 0
+	inline void setSIMDEnabled(const bool p_simdEnabled) { m_simdEnabled = p_simdEnabled; }
+
+	// Returns true if the world-space axis-aligned bounding box is hidden behind the rasterized occluders; only reads the depth pyramid, so it can be called from multiple threads
+	bool isBoundingBoxOccluded(const glm::vec3 &p_min, const glm::vec3 &p_max) const;
+
+	// Returns true if the world-space bounding sphere is hidden behind the rasterized occluders
+	inline bool isBoundingSphereOccluded(const glm::vec3 &p_center, const float p_radius) const
+	{
+		return p_radius > 0.0f && isBoundingBoxOccluded(p_center - glm::vec3(p_radius), p_center + glm::vec3(p_radius));
+	}
+
+	// Getters
+	inline bool isRasterized() const { return m_rasterized; }
+	inline unsigned int getBufferWidth() const { return m_width; }
+	inline unsigned int getBufferHeight() const { return m_height; }
+	inline std::size_t getNumOfOccluders() const { return m_occluders.size(); }
+	inline std::size_t getNumOfLevels() const { return m_levels.size(); }
+	inline unsigned int getLevelWidth(const std::size_t p_level) const { return m_levels[p_level].m_width; }
+	inline unsigned int getLevelHeight(const std::size_t p_level) const { return m_levels[p_level].m_height; }
+
+	// Depth (in the [0, 1] range, 1 being the far plane) of a texel of the given pyramid level; level 0 is the rasterized depth buffer
+	inline float getDepth(const std::size_t p_level, const unsigned int p_x, const unsigned int p_y) const { return m_levels[p_level].m_depth[(std::size_t)p_y * m_levels[p_level].m_width + p_x]; }
+
+	// Total number of triangles that were rasterized during the last frame (after back-face culling and clipping)
+	std::size_t getNumOfRasterizedTriangles() const;
+
+private:
+	struct Occluder
+	{
+		Occluder(const glm::vec3 *p_positions, const unsigned int *p_indices, const unsigned int p_numOfIndices, const glm::mat4 &p_modelViewProjMatrix) :
+			m_positions(p_positions), m_indices(p_indices), m_numOfIndices(p_numOfIndices), m_modelViewProjMatrix(p_modelViewProjMatrix) { }
+
+		const glm::vec3 *m_positions;
+		const unsigned int *m_indices;
+		unsigned int m_numOfIndices;
+		glm::mat4 m_modelViewProjMatrix;
+	};
+
+	// Triangle in screen space (pixels, with the origin at the bottom-left corner), with depth in the [0, 1] range
+	struct ScreenTriangle
+	{
+		glm::vec3 m_vertices[3];
+		int m_minY;
+		int m_maxY;
+	};
+
+	struct HiZLevel
+	{
+		HiZLevel() : m_width(0), m_height(0) { }
+
+		unsigned int m_width;
+		unsigned int m_height;
+		std::vector<float> m_depth;
+	};
+
+	// Transform the triangles of the occluder to screen space, discarding back-facing ones and clipping them against the near plane (and the guard band)
+	void setupTriangles(const Occluder &p_occluder, std::vector<ScreenTriangle> &p_triangles) const;
+
+	// Add the clip-space polygon to the triangle list, as a triangle fan
+	void addScreenTriangles(const glm::vec4 *p_vertices, const unsigned int p_numOfVertices, std::vector<ScreenTriangle> &p_triangles) const;
+
+	// Rasterize all the triangles into the rows of the depth buffer in the given range
+	void rasterizeBand(const int p_beginY, const int p_endY);
+	void rasterizeTriangleScalar(const ScreenTriangle &p_triangle, const int p_beginY, const int p_endY);
+	void rasterizeTriangleSSE(const ScreenTriangle &p_triangle, const int p_beginY, const int p_endY);
+
+	// Build every level of the pyramid above the first one
+	void buildHiZPyramid();
+
+	unsigned int m_width;
+	unsigned int m_height;
+
+	glm::mat4 m_viewProjMatrix;
+
+	std::vector<Occluder> m_occluders;
+
+	// Screen-space triangles of each occluder, set up in parallel
+	std::vector<std::vector<ScreenTriangle>> m_occluderTriangles;
+
+	// Levels of the Hi-Z pyramid, from the full resolution depth buffer to a single texel
+	std::vector<HiZLevel> m_levels;
+
+	bool m_rasterized;
+	bool m_simdEnabled;
+};
@@ -1,6 +1,7 @@
 #include "ComponentConstructorInfo.h"
 #include "NullSystemObjects.h"
 #include "PhysicsScene.h"
+#include "Profiler.h"
 #include "TaskManagerLocator.h"
 #include "WorldScene.h"
 
@@ -33,14 +34,6 @@ PhysicsScene::~PhysicsScene()
 		delete obj;
 	}
 
-	// Delete collision shapes
-	for(int i = 0; i < m_collisionShapes.size(); i++)
-	{
-		btCollisionShape *shape = m_collisionShapes[i];
-		m_collisionShapes[i] = nullptr;
-		//delete shape;
-	}
-
 	// Delete dynamics world
 	if(m_dynamicsWorld != nullptr)
 		delete m_dynamicsWorld;
@@ -60,9 +53,6 @@ PhysicsScene::~PhysicsScene()
 	// Delete collision configuration
 	if(m_collisionConfiguration != nullptr)
 		delete m_collisionConfiguration;
-
-	// Next line is optional: it will be cleared by the destructor when the array goes out of scope
-	m_collisionShapes.clear();
 }
 
 ErrorCode PhysicsScene::init()
@@ -129,6 +119,8 @@ void PhysicsScene::exportSetup(PropertySet &p_propertySet)
 
 void PhysicsScene::update(const float p_deltaTime)
 {
+	PROFILE_ZONE("PhysicsScene::update");
+
 	// Reset errors for this frame
 	resetErrors();
 
@@ -154,9 +146,14 @@ void PhysicsScene::update(const float p_deltaTime)
 	if(m_simulationRunning && !(m_sceneLoader->getFirstLoad() && m_sceneLoader->getSceneLoadingStatus()))
 	{
 		// Perform the physics simulation for the time step of the last frame
+		PROFILE_ZONE("PhysicsScene::stepSimulation");
 		m_dynamicsWorld->stepSimulation(p_deltaTime);
 	}
 
+	// Execute the spatial queries submitted during the last frame against the updated collision world (unless objects are still being added during the first scene load)
+	if(!(m_sceneLoader->getFirstLoad() && m_sceneLoader->getSceneLoadingStatus()))
+		m_spatialQueryService.executeQueries(*static_cast<btDbvtBroadphase *>(m_collisionBroadphase));
+
 	// Get the rigid body component view and iterate every entity that contains is
 	auto rigidBodyView = worldScene->getEntityRegistry().view<RigidBodyComponent>();
 	for(auto entity : rigidBodyView)
@@ -227,7 +224,7 @@ void PhysicsScene::internalTickCallback(btDynamicsWorld *p_world, btScalar p_tim
 							m_maxDynamicCollisionsErrorIssued = true;
 
 							// Log an error if the dynamic collision event count exceeds the maximum number of supported dynamic events
-							ErrHandlerLoc::get().log(ErrorCode::Collision_max_dynamic_events, ErrorSource::Source_Physics);
+							ErrHandlerLoc::get().logDeferred(ErrorCode::Collision_max_dynamic_events, ErrorSource::Source_Physics);
 						}
 					}
 
@@ -250,7 +247,7 @@ void PhysicsScene::internalTickCallback(btDynamicsWorld *p_world, btScalar p_tim
 							m_maxStaticCollisionsErrorIssued = true;
 
 							// Log an error if the dynamic collision event count exceeds the maximum number of supported dynamic events
-							ErrHandlerLoc::get().log(ErrorCode::Collision_max_dynamic_events, ErrorSource::Source_Physics);
+							ErrHandlerLoc::get().logDeferred(ErrorCode::Collision_max_dynamic_events, ErrorSource::Source_Physics);
 						}
 					}
 				}
@@ -271,7 +268,7 @@ void PhysicsScene::internalTickCallback(btDynamicsWorld *p_world, btScalar p_tim
 					else
 					{
 						// Log an error if the static collision event count exceeds the maximum number of supported static events
-						ErrHandlerLoc::get().log(ErrorCode::Collision_max_static_events, ErrorSource::Source_Physics);
+						ErrHandlerLoc::get().logDeferred(ErrorCode::Collision_max_static_events, ErrorSource::Source_Physics);
 					}
 
 					// Process the static collision event on the second object
@@ -289,7 +286,7 @@ void PhysicsScene::internalTickCallback(btDynamicsWorld *p_world, btScalar p_tim
 					else
 					{
 						// Log an error if the static collision event count exceeds the maximum number of supported static events
-						ErrHandlerLoc::get().log(ErrorCode::Collision_max_static_events, ErrorSource::Source_Physics);
+						ErrHandlerLoc::get().logDeferred(ErrorCode::Collision_max_static_events, ErrorSource::Source_Physics);
 					}
 				}
 			}
@@ -316,9 +313,9 @@ void PhysicsScene::loadInBackground()
 {
 }
 
-std::vector<SystemObject *> PhysicsScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> PhysicsScene::getComponents(const EntityID p_entityID)
 {
-	std::vector<SystemObject *> returnVector;
+	FrameVector<SystemObject *> returnVector;
 
 	// Get the entity registry 
 	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
@@ -373,41 +370,22 @@ SystemObject *PhysicsScene::createComponent(const EntityID &p_entityID, const Ri
 	auto componentInitError = component.init();
 	if(componentInitError == ErrorCode::Success)
 	{
-		component.m_collisionShapeType = p_constructionInfo.m_collisionShapeType;
+		component.m_collisionShapeType = RigidBodyComponent::CollisionShapeType::CollisionShapeType_Null;
+		component.m_collisionMeshFilename = p_constructionInfo.m_collisionMeshFilename;
 		component.m_kinematic = p_constructionInfo.m_kinematic;
 		component.m_objectType = Properties::PropertyID::RigidBodyComponent;
 		component.setActive(p_constructionInfo.m_active);
 		component.setLoadedToMemory(true);
 		component.setLoadedToVideoMemory(true);
 
-		if(component.m_collisionShapeType != RigidBodyComponent::CollisionShapeType::CollisionShapeType_Null)
-		{
-			switch(component.m_collisionShapeType)
-			{
-				case RigidBodyComponent::CollisionShapeType::CollisionShapeType_Box:
-					{
-						btVector3 boxHalfExtents = Math::toBtVector3(p_constructionInfo.m_collisionShapeSize);
-						component.m_collisionShape.m_boxShape = new btBoxShape(boxHalfExtents);
-					}
-					break;
+		// Get a shared collision shape of the same type and size (or of the same model, for mesh colliders)
+		btCollisionShape *collisionShape = nullptr;
+		if(p_constructionInfo.m_collisionShapeType != RigidBodyComponent::CollisionShapeType::CollisionShapeType_Null)
+			collisionShape = m_collisionShapeCache.acquireShape(p_constructionInfo.m_collisionShapeType, p_constructionInfo.m_collisionShapeSize, p_constructionInfo.m_collisionMeshFilename);
 
-				case RigidBodyComponent::CollisionShapeType::CollisionShapeType_Sphere:
-					{
-						float radius = p_constructionInfo.m_collisionShapeSize.x;
-						component.m_collisionShape.m_sphereShape = new btSphereShape(radius);
-					}
-					break;
-
-				case RigidBodyComponent::CollisionShapeType::CollisionShapeType_Cylinder:
-					{
-						btVector3 cylinderHalfExtents = Math::toBtVector3(p_constructionInfo.m_collisionShapeSize);
-						component.m_collisionShape.m_cylinderShape = new btCylinderShape(cylinderHalfExtents);
-					}
-					break;
-			}
-
-			// Success on the loaded collision shape
-			ErrHandlerLoc().get().log(ErrorType::Info, ErrorSource::Source_RigidBodyComponent, component.getName() + " - Collision shape loaded");
+		if(collisionShape != nullptr)
+		{
+			component.setCollisionShape(p_constructionInfo.m_collisionShapeType, collisionShape);
 
 			// Create the struct that holds all the required information for constructing a rigid body
 			component.m_constructionInfo = new btRigidBody::btRigidBodyConstructionInfo(p_constructionInfo.m_mass, &component.m_motionState, component.getCollisionShape());
@@ -426,6 +404,12 @@ SystemObject *PhysicsScene::createComponent(const EntityID &p_entityID, const Ri
 					component.m_constructionInfo->m_mass = 0.0f;
 					ErrHandlerLoc().get().log(ErrorCode::Kinematic_has_mass, component.getName(), ErrorSource::Source_RigidBodyComponent);
 				}
+				else if(component.m_collisionShapeType == RigidBodyComponent::CollisionShapeType::CollisionShapeType_TriangleMesh)
+				{
+					// Triangle mesh shapes can only be used by static objects, so they must have a mass of zero
+					component.m_constructionInfo->m_mass = 0.0f;
+					ErrHandlerLoc().get().log(ErrorCode::Collision_mesh_has_mass, component.getName(), ErrorSource::Source_RigidBodyComponent);
+				}
 				else
 					component.getCollisionShape()->calculateLocalInertia(component.m_constructionInfo->m_mass, component.m_constructionInfo->m_localInertia);
 			}
@@ -444,9 +428,6 @@ SystemObject *PhysicsScene::createComponent(const EntityID &p_entityID, const Ri
 				component.m_motionState.updateMotionStateTrans();
 			}
 
-			// Add the collision shape
-			m_collisionShapes.push_back(component.getCollisionShape());
-
 			// Create the rigid body by passing the rigid body construction info
 			component.m_rigidBody = new btRigidBody(*component.m_constructionInfo);
 
@@ -505,8 +486,10 @@ void PhysicsScene::releaseObject(SystemObject *p_systemObject)
 				if(component->m_rigidBody != nullptr)
 				{
 					//delete component->m_rigidBody->getMotionState();
-					delete component->m_rigidBody->getCollisionShape();
 					m_dynamicsWorld->removeRigidBody(component->m_rigidBody);
+
+					// Collision shapes are shared, so only release the reference to it
+					m_collisionShapeCache.releaseShape(component->m_rigidBody->getCollisionShape());
 				}
 			}
 			break;
@@ -32,10 +32,12 @@
 #include <bullet3/btBulletDynamicsCommon.h>
 
 #include "CollisionEventComponent.h"
+#include "CollisionShapeCache.h"
 #include "ObjectPool.h"
 #include "System.h"
 #include "PhysicsObject.h"
 #include "PhysicsTask.h"
+#include "SpatialQueryService.h"
 
 class PhysicsSystem;
 struct ComponentsConstructionInfo;
@@ -93,7 +95,7 @@ public:
 	void loadInBackground();
 
 	// Get all the created components of the given entity that belong to this scene
-	std::vector<SystemObject *> getComponents(const EntityID p_entityID);
+	FrameVector<SystemObject *> getComponents(const EntityID p_entityID);
 
 	std::vector<SystemObject*> createComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true);
 	std::vector<SystemObject*> createComponents(const EntityID p_entityID, const PhysicsComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true)
@@ -129,6 +131,7 @@ public:
 		p_constructionInfo.m_kinematic = p_component.getRigidBody()->isKinematicObject();
 		p_constructionInfo.m_collisionShapeType = p_component.getCollisionShapeType();
 		p_constructionInfo.m_collisionShapeSize = p_component.getCollisionShapeSize();
+		p_constructionInfo.m_collisionMeshFilename = p_component.getCollisionMeshFilename();
 		p_constructionInfo.m_linearVelocity = Math::toGlmVec3(p_component.getRigidBody()->getLinearVelocity());
 	}
 
@@ -147,6 +150,8 @@ public:
 
 	const inline glm::vec3 getGravity() const { return Math::toGlmVec3(m_dynamicsWorld->getGravity()); }
 	const inline bool getSimulationRunning() const { return m_simulationRunning; }
+	inline CollisionShapeCache &getCollisionShapeCache() { return m_collisionShapeCache; }
+	inline SpatialQueryService &getSpatialQueryService() { return m_spatialQueryService; }
 
 	// Flush the collision contacts of a rigid body (used after changing the collision shape dimensions)
 	void cleanProxyFromPairs(btRigidBody &p_rigidBody)
@@ -197,8 +202,11 @@ private:
 	// Bullet world
 	btDiscreteDynamicsWorld *m_dynamicsWorld;
 
-	// An array of all collision shapes
-	btAlignedObjectArray<btCollisionShape*> m_collisionShapes;
+	// Shared collision shapes of all rigid bodies
+	CollisionShapeCache m_collisionShapeCache;
+
+	// Batched raycasts, sweeps and overlap queries, executed after each simulation step
+	SpatialQueryService m_spatialQueryService;
 
 	static PhysicsScene *s_currentPhysicsScene;
 
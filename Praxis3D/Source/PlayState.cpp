@@ -24,5 +24,11 @@ void PlayState::update(Engine &p_engine)
 	m_objectChangeController->distributeChanges();
 	m_sceneChangeController->distributeChanges();
 
+	m_sceneLoader.processSaveRequest();
+
+	m_sceneLoader.updateWorldStreaming();
+
+	captureRenderSnapshot();
+
 	updateSceneLoadingStatus();
 }
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <fstream>
+
+#include "Config.h"
+#include "Profiler.h"
+
+std::atomic_bool Profiler::m_enabled = false;
+std::atomic_bool Profiler::m_paused = false;
+double Profiler::m_millisecondsPerTick = 0.0;
+size_t Profiler::m_zonesPerThread = 0;
+std::atomic<size_t> Profiler::m_frameIndex = 0;
+int64_t Profiler::m_currentFrameStartTicks = 0;
+int64_t Profiler::m_lastFrameStartTicks = 0;
+int64_t Profiler::m_lastFrameEndTicks = 0;
+std::vector<ProfilerZone> Profiler::m_lastFrameZones;
+std::vector<ProfilerThreadBuffer *> Profiler::m_threadBuffers;
+SpinWait Profiler::m_threadBuffersMutex;
+thread_local ProfilerThreadBuffer *Profiler::m_threadBuffer = nullptr;
+
+ErrorCode Profiler::init()
+{
+	LARGE_INTEGER ticksPerSec;
+	if(!QueryPerformanceFrequency(&ticksPerSec))
+		return ErrorCode::Clock_QueryFrequency;
+
+	m_millisecondsPerTick = 1000.0 / (double)ticksPerSec.QuadPart;
+
+	// Round the ring size up to a power of two, so the write index can be wrapped with a mask
+	m_zonesPerThread = 1;
+	while(m_zonesPerThread < (size_t)std::max(Config::engineVar().profiler_zones_per_thread, 1))
+		m_zonesPerThread <<= 1;
+
+	m_lastFrameZones.reserve(m_zonesPerThread);
+	m_currentFrameStartTicks = getCurrentTicks();
+
+	m_enabled.store(Config::engineVar().profiler_enabled, std::memory_order_relaxed);
+
+	return ErrorCode::Success;
+}
+
+void Profiler::newFrame()
+{
+	const int64_t frameEndTicks = getCurrentTicks();
+	const size_t finishedFrameIndex = getFrameIndex();
+
+	if(isEnabled() && !isPaused())
+	{
+		m_lastFrameZones.clear();
+		m_lastFrameStartTicks = m_currentFrameStartTicks;
+		m_lastFrameEndTicks = frameEndTicks;
+
+		SpinWait::Lock lock(m_threadBuffersMutex);
+
+		// Gather the zones of the finished frame from every thread (background threads might already be recording the next frame)
+		for(const auto *threadBuffer : m_threadBuffers)
+			threadBuffer->copyZones(m_lastFrameZones, finishedFrameIndex);
+
+		std::erase_if(m_lastFrameZones, [finishedFrameIndex](const ProfilerZone &p_zone) { return p_zone.m_frameIndex != finishedFrameIndex; });
+
+		// Order by start time, so the parent zones are always drawn before their children
+		std::sort(m_lastFrameZones.begin(), m_lastFrameZones.end(), [](const ProfilerZone &p_left, const ProfilerZone &p_right) { return p_left.m_startTicks < p_right.m_startTicks; });
+	}
+
+	m_currentFrameStartTicks = frameEndTicks;
+	m_frameIndex.store(finishedFrameIndex + 1, std::memory_order_relaxed);
+}
+
+ErrorCode Profiler::exportChromeTrace(const std::string &p_filename)
+{
+	std::ofstream traceFile(p_filename, std::ios::out | std::ios::trunc);
+
+	if(traceFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	// Copy the zones out of the rings first, as the threads keep recording while the file is being written
+	std::vector<std::vector<ProfilerZone>> threadZones;
+	{
+		SpinWait::Lock lock(m_threadBuffersMutex);
+
+		threadZones.resize(m_threadBuffers.size());
+		for(decltype(m_threadBuffers.size()) i = 0, size = m_threadBuffers.size(); i < size; i++)
+			m_threadBuffers[i]->copyZones(threadZones[i], 0);
+	}
+
+	// Find the earliest recorded zone, so the trace timestamps start from zero
+	int64_t baseTicks = getCurrentTicks();
+	for(const auto &zones : threadZones)
+		for(const auto &zone : zones)
+			baseTicks = std::min(baseTicks, zone.m_startTicks);
+
+	traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	for(decltype(threadZones.size()) threadIndex = 0, numOfThreads = threadZones.size(); threadIndex < numOfThreads; threadIndex++)
+	{
+		// Name the thread track (thread buffers are registered in the order of their thread indices)
+		traceFile << (threadIndex == 0 ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIndex
+			<< ",\"args\":{\"name\":\"" << (threadIndex == 0 ? "Primary thread" : "Worker thread " + std::to_string(threadIndex)) << "\"}}";
+
+		// Write the zones from the oldest to the newest, as complete ("X") events, with timestamps in microseconds
+		for(const auto &zone : threadZones[threadIndex])
+		{
+			traceFile << ",\n{\"name\":\"" << (zone.m_name != nullptr ? zone.m_name : "Unnamed") << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.m_threadIndex
+				<< ",\"ts\":" << ticksToMilliseconds(zone.m_startTicks - baseTicks) * 1000.0
+				<< ",\"dur\":" << ticksToMilliseconds(zone.m_endTicks - zone.m_startTicks) * 1000.0
+				<< ",\"args\":{\"frame\":" << zone.m_frameIndex << "}}";
+		}
+	}
+
+	traceFile << "\n]}\n";
+
+	return traceFile.fail() ? ErrorCode::Failure : ErrorCode::Success;
+}
+
+void ProfilerThreadBuffer::copyZones(std::vector<ProfilerZone> &p_zones, const size_t p_firstFrameIndex) const
+{
+	const auto firstCopiedZone = p_zones.size();
+	const size_t capacity = m_zones.size();
+	const size_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+	const size_t numOfZones = std::min(writeIndex, capacity);
+
+	// Walk the ring backwards from the newest zone, until the zones of an earlier frame are reached
+	size_t numOfCopiedZones = 0;
+	for(; numOfCopiedZones < numOfZones; numOfCopiedZones++)
+	{
+		const ProfilerZone &zone = m_zones[(writeIndex - 1 - numOfCopiedZones) & m_mask];
+
+		if(zone.m_frameIndex < p_firstFrameIndex)
+			break;
+
+		p_zones.push_back(zone);
+	}
+
+	// A zone slot is reused once the ring wraps around; the zones whose slots were written to (or are being written to) since the
+	// write index was first read are discarded. They are the oldest copied ones (a torn zone that ended the walk early is among them, too)
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const size_t currentWriteIndex = m_writeIndex.load(std::memory_order_relaxed);
+	const size_t numOfIntactZones = writeIndex + capacity > currentWriteIndex + 1 ? writeIndex + capacity - currentWriteIndex - 1 : 0;
+
+	if(numOfCopiedZones > numOfIntactZones)
+		p_zones.resize(firstCopiedZone + numOfIntactZones);
+
+	std::reverse(p_zones.begin() + firstCopiedZone, p_zones.end());
+}
+
+ProfilerThreadBuffer *Profiler::registerThreadBuffer()
+{
+	SpinWait::Lock lock(m_threadBuffersMutex);
+
+	// The first thread to record a zone is the primary thread, as the engine main loop is the first to be instrumented
+	auto *threadBuffer = new ProfilerThreadBuffer((unsigned int)m_threadBuffers.size(), m_zonesPerThread > 0 ? m_zonesPerThread : 1);
+	m_threadBuffers.push_back(threadBuffer);
+
+	return threadBuffer;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+
+#include "EngineDefinitions.h"
+#include "ErrorCodes.h"
+#include "SpinWait.h"
+
+// A single completed profiling zone, recorded by the thread that executed it
+struct ProfilerZone
+{
+	ProfilerZone() : m_name(nullptr), m_startTicks(0), m_endTicks(0), m_frameIndex(0), m_threadIndex(0), m_depth(0) { }
+	ProfilerZone(const char *p_name, const int64_t p_startTicks, const int64_t p_endTicks, const size_t p_frameIndex, const unsigned int p_threadIndex, const unsigned int p_depth)
+		: m_name(p_name), m_startTicks(p_startTicks), m_endTicks(p_endTicks), m_frameIndex(p_frameIndex), m_threadIndex(p_threadIndex), m_depth(p_depth) { }
+
+	// Zone name is not copied; it must outlive the profiler (string literals, render pass names, etc.)
+	const char *m_name;
+	int64_t m_startTicks;
+	int64_t m_endTicks;
+	size_t m_frameIndex;
+	unsigned int m_threadIndex;
+	unsigned int m_depth;
+};
+
+// Fixed-size ring of completed zones, owned and written to by a single thread only
+class ProfilerThreadBuffer
+{
+	friend class Profiler;
+	friend class ProfilerScopedZone;
+public:
+	ProfilerThreadBuffer(const unsigned int p_threadIndex, const size_t p_capacity) : m_zones(p_capacity), m_writeIndex(0), m_mask(p_capacity - 1), m_threadIndex(p_threadIndex), m_depth(0) { }
+
+	inline unsigned int getThreadIndex() const { return m_threadIndex; }
+
+private:
+	// Appends the zones held in the ring that were recorded in the given frame or later, from the oldest to the newest. Can be called from any thread;
+	// the owning thread keeps recording (and wrapping the ring) meanwhile, so the zones that were overwritten while being copied are discarded
+	void copyZones(std::vector<ProfilerZone> &p_zones, const size_t p_firstFrameIndex) const;
+
+	// Overwrites the oldest zone when the ring is full; the write index is published after the zone is written
+	inline void push(const ProfilerZone &p_zone)
+	{
+		const size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		m_zones[writeIndex & m_mask] = p_zone;
+		m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+	}
+
+	std::vector<ProfilerZone> m_zones;
+	std::atomic<size_t> m_writeIndex;
+	size_t m_mask;
+	unsigned int m_threadIndex;
+	unsigned int m_depth;
+};
+
+// Low-overhead hierarchical frame profiler. Scoped zones are recorded into thread-local ring buffers;
+// at the frame boundary the zones of the finished frame are gathered for the live editor view,
+// and the full contents of all the rings can be exported as a Chrome trace (chrome://tracing) JSON file.
+// All the instrumentation is compiled out when SETTING_PROFILER_ENABLED is set to 0.
+class Profiler
+{
+	friend class ProfilerScopedZone;
+public:
+	// Reads the profiler settings from config; must be called after the config has been loaded
+	static ErrorCode init();
+
+	// Marks the frame boundary; must be called once per frame from the primary thread, while no tasks are running
+	static void newFrame();
+
+	// Writes every zone currently held in the thread rings into a Chrome trace JSON file
+	static ErrorCode exportChromeTrace(const std::string &p_filename);
+
+	// Enables or disables recording of new zones at runtime
+	inline static void setEnabled(const bool p_enabled) { m_enabled.store(p_enabled, std::memory_order_relaxed); }
+
+	// Freezes the zones of the last frame (used by the editor to inspect a single frame)
+	inline static void setPaused(const bool p_paused) { m_paused.store(p_paused, std::memory_order_relaxed); }
+
+	// Getters
+	inline static bool isEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+	inline static bool isPaused() { return m_paused.load(std::memory_order_relaxed); }
+	inline static size_t getFrameIndex() { return m_frameIndex.load(std::memory_order_relaxed); }
+	inline static unsigned int getNumberOfThreads() { return (unsigned int)m_threadBuffers.size(); }
+	inline static int64_t getLastFrameStartTicks() { return m_lastFrameStartTicks; }
+	inline static int64_t getLastFrameEndTicks() { return m_lastFrameEndTicks; }
+	inline static const std::vector<ProfilerZone> &getLastFrameZones() { return m_lastFrameZones; }
+
+	// Converts a duration in performance counter ticks to milliseconds
+	inline static double ticksToMilliseconds(const int64_t p_ticks) { return (double)p_ticks * m_millisecondsPerTick; }
+
+	// Returns the current time in performance counter ticks
+	inline static int64_t getCurrentTicks()
+	{
+		LARGE_INTEGER currentTime;
+		QueryPerformanceCounter(&currentTime);
+		return currentTime.QuadPart;
+	}
+
+private:
+	// Returns the ring buffer of the calling thread, creating and registering it on the first call from that thread
+	inline static ProfilerThreadBuffer *getThreadBuffer()
+	{
+		if(m_threadBuffer == nullptr)
+			m_threadBuffer = registerThreadBuffer();
+
+		return m_threadBuffer;
+	}
+	static ProfilerThreadBuffer *registerThreadBuffer();
+
+	// Read by every thread that records a zone, while being changed from the editor
+	static std::atomic_bool m_enabled;
+	static std::atomic_bool m_paused;
+	static double m_millisecondsPerTick;
+	static size_t m_zonesPerThread;
+	static std::atomic<size_t> m_frameIndex;
+
+	static int64_t m_currentFrameStartTicks;
+	static int64_t m_lastFrameStartTicks;
+	static int64_t m_lastFrameEndTicks;
+	static std::vector<ProfilerZone> m_lastFrameZones;
+
+	// Thread buffers are only ever added, and live until the end of the application, so zones can be recorded without locking
+	static std::vector<ProfilerThreadBuffer *> m_threadBuffers;
+	static SpinWait m_threadBuffersMutex;
+	static thread_local ProfilerThreadBuffer *m_threadBuffer;
+};
+
+// Records the time from construction until destruction as a single profiling zone
+class ProfilerScopedZone
+{
+public:
+	ProfilerScopedZone(const char *p_name) : m_name(p_name), m_buffer(nullptr), m_startTicks(0), m_frameIndex(0), m_depth(0)
+	{
+		if(Profiler::isEnabled())
+		{
+			m_buffer = Profiler::getThreadBuffer();
+			m_depth = m_buffer->m_depth++;
+			m_frameIndex = Profiler::getFrameIndex();
+			m_startTicks = Profiler::getCurrentTicks();
+		}
+	}
+	~ProfilerScopedZone()
+	{
+		if(m_buffer != nullptr)
+		{
+			m_buffer->m_depth--;
+			m_buffer->push(ProfilerZone(m_name, m_startTicks, Profiler::getCurrentTicks(), m_frameIndex, m_buffer->m_threadIndex, m_depth));
+		}
+	}
+
+private:
+	const char *m_name;
+	ProfilerThreadBuffer *m_buffer;
+	int64_t m_startTicks;
+	size_t m_frameIndex;
+	unsigned int m_depth;
+};
+
+#if SETTING_PROFILER_ENABLED
+#define PROFILER_CONCAT_INNER(LEFT, RIGHT) LEFT##RIGHT
+#define PROFILER_CONCAT(LEFT, RIGHT) PROFILER_CONCAT_INNER(LEFT, RIGHT)
+
+// Profiles the rest of the current scope under the given name
+#define PROFILE_ZONE(NAME) ProfilerScopedZone PROFILER_CONCAT(profilerZone_, __LINE__)(NAME)
+#else
+#define PROFILE_ZONE(NAME)
+#endif
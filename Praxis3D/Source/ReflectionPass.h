@@ -28,6 +28,10 @@ public:
 
 		if(returnError == ErrorCode::Success)
 		{
+			// Set the geometry buffer layout
+			if(ErrorCode shaderVariableError = m_shaderReflectionPass->setDefineValue(ShaderType::ShaderType_Fragment, Config::shaderVar().define_gbufferThinLayout, Config::rendererVar().gbuffer_thin_layout ? 1 : 0); shaderVariableError != ErrorCode::Success)
+				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_gbufferThinLayout, ErrorSource::Source_ReflectionPass);
+
 			// Queue the shaders to be loaded to GPU
 			m_renderer.queueForLoading(*m_shaderReflectionPass);
 		}
@@ -0,0 +1,117 @@
+#include <algorithm>
+
+#include "RenderGraph.h"
+
+void RenderGraph::PassBuilder::read(const std::string &p_resourceName)
+{
+	m_renderGraph.m_passes[m_passID].m_reads.push_back(m_renderGraph.getOrAddResource(p_resourceName));
+	m_renderGraph.m_compiled = false;
+}
+
+void RenderGraph::PassBuilder::write(const std::string &p_resourceName)
+{
+	m_renderGraph.m_passes[m_passID].m_writes.push_back(m_renderGraph.getOrAddResource(p_resourceName));
+	m_renderGraph.m_compiled = false;
+}
+
+void RenderGraph::PassBuilder::setSideEffects()
+{
+	m_renderGraph.m_passes[m_passID].m_sideEffects = true;
+	m_renderGraph.m_compiled = false;
+}
+
+RenderGraph::RenderGraph()
+{
+	m_compiled = false;
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+RenderGraph::PassBuilder RenderGraph::addPass(const std::string &p_passName)
+{
+	m_passes.emplace_back(p_passName);
+	m_compiled = false;
+
+	return PassBuilder(*this, (PassID)(m_passes.size() - 1));
+}
+
+void RenderGraph::compile()
+{
+	for(auto &resource : m_resources)
+	{
+		resource.m_firstUse = NullID;
+		resource.m_lastUse = NullID;
+	}
+
+	// Go over the passes in reverse order and keep only those that have side effects or that write a resource still needed by a later pass.
+	// A kept pass fulfills the need for the resources it writes (earlier writes of them are overwritten) and creates the need for the resources it reads
+	std::vector<bool> resourceNeeded(m_resources.size(), false);
+
+	for(std::size_t passIndex = m_passes.size(); passIndex-- > 0;)
+	{
+		Pass &pass = m_passes[passIndex];
+
+		pass.m_culled = !pass.m_sideEffects && std::none_of(pass.m_writes.begin(), pass.m_writes.end(), [&](const ResourceID p_resourceID) { return resourceNeeded[p_resourceID]; });
+
+		if(!pass.m_culled)
+		{
+			for(const ResourceID resourceID : pass.m_writes)
+				resourceNeeded[resourceID] = false;
+			for(const ResourceID resourceID : pass.m_reads)
+				resourceNeeded[resourceID] = true;
+		}
+	}
+
+	// Compute the lifetime of each resource over the remaining passes
+	for(PassID passID = 0, numOfPasses = (PassID)m_passes.size(); passID < numOfPasses; passID++)
+	{
+		if(m_passes[passID].m_culled)
+			continue;
+
+		for(const auto *resourceList : { &m_passes[passID].m_reads, &m_passes[passID].m_writes })
+		{
+			for(const ResourceID resourceID : *resourceList)
+			{
+				Resource &resource = m_resources[resourceID];
+
+				if(resource.m_firstUse == NullID)
+					resource.m_firstUse = passID;
+				resource.m_lastUse = passID;
+			}
+		}
+	}
+
+	m_compiled = true;
+}
+
+void RenderGraph::clear()
+{
+	m_passes.clear();
+	m_resources.clear();
+
+	m_compiled = false;
+}
+
+RenderGraph::ResourceID RenderGraph::getResourceID(const std::string &p_resourceName) const
+{
+	for(ResourceID resourceID = 0, numOfResources = (ResourceID)m_resources.size(); resourceID < numOfResources; resourceID++)
+		if(m_resources[resourceID].m_name == p_resourceName)
+			return resourceID;
+
+	return NullID;
+}
+
+RenderGraph::ResourceID RenderGraph::getOrAddResource(const std::string &p_resourceName)
+{
+	ResourceID resourceID = getResourceID(p_resourceName);
+
+	if(resourceID == NullID)
+	{
+		resourceID = (ResourceID)m_resources.size();
+		m_resources.emplace_back(p_resourceName);
+	}
+
+	return resourceID;
+}
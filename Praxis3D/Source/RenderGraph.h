@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Describes a frame as a sequence of passes and the resources (render targets) each pass reads and writes. When compiled, it:
+//		culls the passes whose output is never used by a pass with side effects (e.g. one that draws to the screen),
+//		computes the lifetime of every resource (the first and the last remaining pass that uses it).
+// Resources are owned elsewhere (e.g. geometry buffer attachments) and stay resident, as passes ping-pong between them and the editor samples them.
+// Contains no graphics API calls, so the culling and lifetimes can be built and validated without a GPU
+class RenderGraph
+{
+public:
+	typedef unsigned int PassID;
+	typedef unsigned int ResourceID;
+
+	static constexpr unsigned int NullID = std::numeric_limits<unsigned int>::max();
+
+	// Used by a pass to declare the resources it uses
+	class PassBuilder
+	{
+		friend class RenderGraph;
+	public:
+		// Declare that the pass reads the resource
+		void read(const std::string &p_resourceName);
+
+		// Declare that the pass writes the resource
+		void write(const std::string &p_resourceName);
+
+		// Declare that the output of the pass leaves the graph (e.g. drawing to the screen), so the pass is never culled
+		void setSideEffects();
+
+		inline PassID getPassID() const { return m_passID; }
+
+	private:
+		PassBuilder(RenderGraph &p_renderGraph, const PassID p_passID) : m_renderGraph(p_renderGraph), m_passID(p_passID) { }
+
+		RenderGraph &m_renderGraph;
+		PassID m_passID;
+	};
+
+	RenderGraph();
+	~RenderGraph();
+
+	// Add a pass to the end of the graph; passes are executed in the order they are added
+	PassBuilder addPass(const std::string &p_passName);
+
+	// Cull unused passes and compute resource lifetimes
+	void compile();
+
+	// Remove all the passes and resources
+	void clear();
+
+	// Getters
+	inline bool isCompiled() const { return m_compiled; }
+	inline bool isPassCulled(const PassID p_passID) const { return p_passID < m_passes.size() ? m_passes[p_passID].m_culled : true; }
+	inline const std::string &getPassName(const PassID p_passID) const { return m_passes[p_passID].m_name; }
+	inline std::size_t getNumOfPasses() const { return m_passes.size(); }
+	inline std::size_t getNumOfResources() const { return m_resources.size(); }
+
+	ResourceID getResourceID(const std::string &p_resourceName) const;
+	inline const std::string &getResourceName(const ResourceID p_resourceID) const { return m_resources[p_resourceID].m_name; }
+
+	// Index of the first and last pass that uses the resource (NullID if the resource is not used by any of the remaining passes)
+	inline PassID getFirstUse(const ResourceID p_resourceID) const { return m_resources[p_resourceID].m_firstUse; }
+	inline PassID getLastUse(const ResourceID p_resourceID) const { return m_resources[p_resourceID].m_lastUse; }
+
+private:
+	struct Pass
+	{
+		Pass(const std::string &p_name) : m_name(p_name), m_sideEffects(false), m_culled(false) { }
+
+		std::string m_name;
+		std::vector<ResourceID> m_reads;
+		std::vector<ResourceID> m_writes;
+		bool m_sideEffects;
+		bool m_culled;
+	};
+	struct Resource
+	{
+		Resource(const std::string &p_name) : m_name(p_name), m_firstUse(NullID), m_lastUse(NullID) { }
+
+		std::string m_name;
+		PassID m_firstUse;
+		PassID m_lastUse;
+	};
+
+	// Returns the ID of the resource with the given name, adding it if it doesn't exist
+	ResourceID getOrAddResource(const std::string &p_resourceName);
+
+	std::vector<Pass> m_passes;
+	std::vector<Resource> m_resources;
+
+	bool m_compiled;
+};
@@ -2,8 +2,23 @@
 
 #include "CommandBuffer.h"
 #include "Config.h"
+#include "RenderGraph.h"
 #include "RendererFrontend.h"
 
+// Names of the render graph resources shared between the rendering passes
+namespace RenderGraphResource
+{
+	constexpr const char *GBufferPosition = "GBufferPosition";
+	constexpr const char *GBufferDiffuse = "GBufferDiffuse";
+	constexpr const char *GBufferNormal = "GBufferNormal";
+	constexpr const char *GBufferEmissive = "GBufferEmissive";
+	constexpr const char *GBufferMatProperties = "GBufferMatProperties";
+	constexpr const char *GBufferDepth = "GBufferDepth";
+	constexpr const char *SceneColor = "SceneColor";	// Final and intermediate buffers, that passes swap between as their color input and output
+	constexpr const char *CSMDepth = "CSMDepth";
+	constexpr const char *Backbuffer = "Backbuffer";
+}
+
 // Used to share data between rendering passes
 struct RenderPassData
 {
@@ -90,6 +105,10 @@ public:
 
 	virtual void update(RenderPassData &p_renderPassData, const SceneObjects &p_sceneObjects, const float p_deltaTime) = 0;
 
+	// Declare the resources that the pass reads and writes, so that the pass can be culled if its output is not used;
+	// passes that don't declare their resources are treated as having side effects, and are never culled
+	virtual void declareResources(RenderGraph::PassBuilder &p_passBuilder) const { p_passBuilder.setSideEffects(); }
+
 	inline CommandBuffer::Commands &getCommands() { return m_commandBuffer.getCommands(); }
 
 	inline void setID(unsigned int p_ID) { m_ID = p_ID; }
@@ -1,4 +1,8 @@
+#include <cstring>
+
+#include "Profiler.h"
 #include "RendererBackend.h"
+#include "TaskManagerLocator.h"
 
 RendererBackend::SingleTriangle RendererBackend::m_fullscreenTriangle;
 
@@ -12,11 +16,15 @@ RendererBackend::RendererBackend()
 	m_materialDataBuffer.m_bufferType = BufferType::BufferType_Uniform;
 	m_materialDataBuffer.m_bufferUsage = BufferUsageHint::BufferUsageHint_DynamicDraw;
 	m_materialDataBuffer.m_size = sizeof(MaterialData);
+
+	m_uploadBytesPerMicrosecond = std::max(Config::rendererVar().gpu_upload_bytes_per_us, 1.0f);
 }
 
 RendererBackend::~RendererBackend()
 {
-	processCommand(UnloadObjectType::UnloadObjectType_Buffer, 1, &m_materialDataBuffer.m_handle);
+	// Only release the buffer if it was created (it is never created when running headless without a GL context)
+	if(m_materialDataBuffer.m_handle != 0)
+		processCommand(UnloadObjectType::UnloadObjectType_Buffer, 1, &m_materialDataBuffer.m_handle);
 
 	if(m_gbuffer != nullptr)
 		delete m_gbuffer;
@@ -59,6 +67,9 @@ ErrorCode RendererBackend::init(const UniformFrameData &p_frameData)
 		// Set depth test function
 		glDepthFunc(Config::rendererVar().depth_test_func);
 
+		// Check the program binary support before any shaders are loaded
+		m_shaderBinaryCache.init();
+
 		// Create the material data buffer
 		LoadCommand bufferLoadCommand(m_materialDataBuffer.m_handle,
 			m_materialDataBuffer.m_bufferType,
@@ -69,6 +80,16 @@ ErrorCode RendererBackend::init(const UniformFrameData &p_frameData)
 			0);
 
 		processCommand(bufferLoadCommand);
+
+		// Create the staging buffer that object data is uploaded from; if it is not supported, objects are uploaded directly from client memory
+		const ErrorCode stagingBufferError = m_stagingBuffer.init(Config::rendererVar().gpu_upload_staging_buffer_size);
+		if(stagingBufferError != ErrorCode::Success)
+			ErrHandlerLoc::get().log(stagingBufferError, ErrorSource::Source_Renderer);
+
+		// Create the ring buffer that per-frame uniform data is written to; if it is not supported, per-frame buffers are updated directly
+		const ErrorCode frameRingBufferError = m_frameRingBuffer.init(Config::rendererVar().frame_ring_buffer_size);
+		if(frameRingBufferError != ErrorCode::Success)
+			ErrHandlerLoc::get().log(frameRingBufferError, ErrorSource::Source_Renderer);
 	}
 	return returnCode;
 }
@@ -121,10 +142,79 @@ void RendererBackend::processUpdate(const BufferUpdateCommands &p_updateCommands
 
 void RendererBackend::processLoading(LoadCommands &p_loadCommands, const UniformFrameData &p_frameData)
 {
+	if(p_loadCommands.empty())
+		return;
+
+	const int64_t startTicks = Profiler::getCurrentTicks();
+	int64_t uploadSize = 0;
+
+	// Free the staging space of previous uploads that the GPU has finished copying from
+	if(m_stagingBuffer.isInitialized())
+		m_stagingBuffer.reclaimCompletedAllocations();
+
+	// Allocate staging space for the data of every load command; data that doesn't fit (or all of it, if the staging buffer
+	// isn't supported) is uploaded directly from client memory
+	m_stagingCopies.clear();
+	for(decltype(p_loadCommands.size()) i = 0, size = p_loadCommands.size(); i < size; i++)
+	{
+		LoadCommand &command = p_loadCommands[i];
+
+		switch(command.m_objectType)
+		{
+			case LoadObject_Buffer:
+				command.m_objectData.m_bufferData.m_stagingOffset = stageData(command.m_objectData.m_bufferData.m_data, command.m_objectData.m_bufferData.m_size);
+				uploadSize += command.m_objectData.m_bufferData.m_size;
+				break;
+
+			case LoadObject_Texture2D:
+				{
+					const int64_t dataSize = getTextureDataSize(command.m_objectData.m_tex2DData.m_texFormat,
+						command.m_objectData.m_tex2DData.m_texDataType,
+						command.m_objectData.m_tex2DData.m_textureWidth,
+						command.m_objectData.m_tex2DData.m_textureHeight);
+
+					command.m_objectData.m_tex2DData.m_stagingOffset = stageData(command.m_objectData.m_tex2DData.m_data, dataSize);
+					uploadSize += dataSize;
+				}
+				break;
+
+			case LoadObject_Model:
+				for(unsigned int bufferType = 0; bufferType < ModelBuffer_NumAllTypes; bufferType++)
+				{
+					command.m_objectData.m_modelData.m_stagingOffset[bufferType] = stageData(command.m_objectData.m_modelData.m_data[bufferType], command.m_objectData.m_modelData.m_size[bufferType]);
+					uploadSize += command.m_objectData.m_modelData.m_size[bufferType];
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	// Copy the data into the mapped staging buffer on worker threads, leaving only the GPU copy commands for this thread
+	TaskManagerLocator::get().parallelFor(std::size_t(0), m_stagingCopies.size(), std::size_t(1), [&](const std::size_t p_index)
+		{
+			std::memcpy(m_stagingBuffer.getMappedData(m_stagingCopies[p_index].m_offset), m_stagingCopies[p_index].m_data, (std::size_t)m_stagingCopies[p_index].m_size);
+		});
+
 	for(decltype(p_loadCommands.size()) i = 0, size = p_loadCommands.size(); i < size; i++)
 	{
 		processCommand(p_loadCommands[i]);
 	}
+
+	// Guard the staging space used by this frame's copies, so it is only reused after the GPU has finished reading from it
+	if(m_stagingBuffer.isInitialized())
+		m_stagingBuffer.fenceAllocations();
+
+	// Refine the upload throughput estimate with the measured duration, excluding the estimated per-object overhead;
+	// only uploads of a meaningful size are taken into account, as the overhead dominates the duration of small ones
+	if(uploadSize >= 65536)
+	{
+		const float elapsedTime = (float)(Profiler::ticksToMilliseconds(Profiler::getCurrentTicks() - startTicks) * 1000.0);
+		const float transferTime = std::max(elapsedTime - Config::rendererVar().gpu_upload_object_cost_us * (float)p_loadCommands.size(), 1.0f);
+
+		m_uploadBytesPerMicrosecond = std::max(glm::mix(m_uploadBytesPerMicrosecond, (float)uploadSize / transferTime, 0.1f), 1.0f);
+	}
 }
 
 void RendererBackend::processUnloading(UnloadCommands &p_unloadCommands)
@@ -146,6 +236,9 @@ void RendererBackend::processDrawing(const DrawCommands &p_drawCommands, const U
 {
 	resetVAO();
 
+	// Materials can be released and their IDs reused between draw batches, so always upload the material data of the first draw command
+	m_rendererState.m_lastMaterialID = NULL_MATERIAL_ID;
+
 	for(decltype(p_drawCommands.size()) i = 0, size = p_drawCommands.size(); i < size; i++)
 	{
 		// Set face culling settings
@@ -172,15 +265,16 @@ void RendererBackend::processDrawing(const DrawCommands &p_drawCommands, const U
 		// Update material data buffer
 		if(p_drawCommands[i].second.m_textureBindingType != DrawCommandTextureBinding_None)
 		{
-			if(m_rendererState.m_materialData != p_drawCommands[i].second.m_materialData)
+			// Draw commands are sorted by material, so the material data is only uploaded once per material run
+			if(m_rendererState.m_lastMaterialID != p_drawCommands[i].second.m_materialID)
 			{
-				m_rendererState.m_materialData = p_drawCommands[i].second.m_materialData;
+				m_rendererState.m_lastMaterialID = p_drawCommands[i].second.m_materialID;
 
 				BufferUpdateCommand materialDataUpdateCommand(
 					m_materialDataBuffer.m_handle,
 					0,
 					m_materialDataBuffer.m_size,
-					(const void *)&p_drawCommands[i].second.m_materialData,
+					(const void *)p_drawCommands[i].second.m_materialData,
 					BufferUpdateType::BufferUpdate_Data,
 					m_materialDataBuffer.m_bufferType,
 					m_materialDataBuffer.m_bufferUsage);
@@ -1,13 +1,17 @@
 #pragma once
 #pragma warning (disable : 4996)
 
+#include <cstring>
 #include <stdint.h>
 
 #include "Config.h"
 #include "CSMFramebuffer.h"
+#include "FrameRingBuffer.h"
 #include "GeometryBuffer.h"
 #include "Loaders.h"
+#include "ShaderBinaryCache.h"
 #include "ShaderUniformUpdater.h"
+#include "StagingRingBuffer.h"
 #include "UniformData.h"
 
 class RendererBackend
@@ -63,7 +67,8 @@ public:
 					const unsigned int p_matEmissive,
 					const unsigned int p_matCombined,
 					const FaceCullingSettings p_faceCulling,
-					const MaterialData p_materialData,
+					const MaterialID p_materialID,
+					const MaterialData &p_materialData,
 					const DrawCommandTextureBinding p_textureBindingType,
 					const int p_matWrapMode) :
 
@@ -79,7 +84,8 @@ public:
 			m_matEmissive(p_matEmissive),
 			m_matCombined(p_matCombined),
 			m_faceCullingSettings(p_faceCulling),
-			m_materialData(p_materialData),
+			m_materialID(p_materialID),
+			m_materialData(&p_materialData),
 			m_textureBindingType(p_textureBindingType),
 			m_matWrapMode(p_matWrapMode) { }
 
@@ -100,7 +106,9 @@ public:
 
 		FaceCullingSettings m_faceCullingSettings;
 
-		MaterialData m_materialData;
+		// Material parameters are referenced from the material registry instead of being copied into each draw command
+		MaterialID m_materialID;
+		const MaterialData *m_materialData;
 		DrawCommandTextureBinding m_textureBindingType;
 
 		int m_matWrapMode;
@@ -176,14 +184,20 @@ public:
 			const void *p_data = NULL,
 			const BufferUpdateType p_updateType = BufferUpdate_Data,
 			const BufferType p_bufferType = BufferType_Uniform,
-			const BufferUsageHint p_bufferUsageHint = BufferUsageHint_DynamicDraw) :
+			const BufferUsageHint p_bufferUsageHint = BufferUsageHint_DynamicDraw,
+			const int64_t p_bufferSize = 0,
+			const unsigned int p_bindingIndex = 0,
+			const bool p_perFrame = false) :
 			m_bufferHandle(p_bufferHandle),
 			m_offset(p_offset),
 			m_size(p_size),
 			m_data(p_data),
 			m_updateType(p_updateType),
 			m_bufferType(p_bufferType),
-			m_bufferUsageHint(p_bufferUsageHint) { }
+			m_bufferUsageHint(p_bufferUsageHint),
+			m_bufferSize(p_bufferSize),
+			m_bindingIndex(p_bindingIndex),
+			m_perFrame(p_perFrame) { }
 		
 		const BufferUpdateType m_updateType;
 		const BufferType m_bufferType;
@@ -193,6 +207,11 @@ public:
 		const void *m_data;
 		const int64_t	m_offset,
 						m_size;
+
+		// Size of the whole buffer and its binding index; used by per-frame buffers, which are written to the frame ring buffer and bound from there
+		const int64_t m_bufferSize;
+		const unsigned int m_bindingIndex;
+		const bool m_perFrame;
 	};
 
 	// Used for loading various objects (i.e. textures, models, shader, etc) to GPU
@@ -219,14 +238,16 @@ public:
 			m_objectType(LoadObject_Model),
 			m_objectData(p_name, p_buffers, p_numElements, p_size, m_data) { }
 
-		LoadCommand(const std::string(&p_names)[ShaderType_NumOfTypes],
+		LoadCommand(const std::string &p_programName,
+					const uint64_t p_defineSetHash,
+					const std::string(&p_names)[ShaderType_NumOfTypes],
 					unsigned int &p_handle,
 					ShaderUniformUpdater &p_uniformUpdater,
 					std::string(&p_source)[ShaderType_NumOfTypes],
 					ErrorMessage(&p_errorMessages)[ShaderType_NumOfTypes]) :
 			m_handle(p_handle),
 			m_objectType(LoadObject_Shader),
-			m_objectData(p_names, p_uniformUpdater, p_source, p_errorMessages) { }
+			m_objectData(p_programName, p_defineSetHash, p_names, p_uniformUpdater, p_source, p_errorMessages) { }
 
 		LoadCommand(const std::string &p_name, 
 					unsigned int &p_handle,
@@ -268,7 +289,8 @@ public:
 				m_bufferUsage(p_bufferUsage),
 				m_bindingIndex(p_bindingIndex),
 				m_size(p_size),
-				m_data(p_data) { }
+				m_data(p_data),
+				m_stagingOffset(-1) { }
 
 			const BufferType m_bufferType;
 			const BufferBindTarget m_bufferBindTarget;
@@ -276,6 +298,9 @@ public:
 			const unsigned int m_bindingIndex;
 			const int64_t m_size;
 			const void *m_data;
+
+			// Offset of the data in the staging buffer, or -1 if the data is uploaded directly
+			int64_t m_stagingOffset;
 		};
 		struct ModelLoadData
 		{
@@ -290,6 +315,7 @@ public:
 			{
 				std::copy(std::begin(p_numElements), std::end(p_numElements), std::begin(m_numElements));
 				std::copy(std::begin(p_size), std::end(p_size), std::begin(m_size));
+				std::fill(std::begin(m_stagingOffset), std::end(m_stagingOffset), -1);
 			}
 
 			const std::string &m_name;
@@ -297,13 +323,20 @@ public:
 			int m_numElements[ModelBuffer_NumAllTypes];
 			int64_t m_size[ModelBuffer_NumAllTypes];
 			const void **m_data;
+
+			// Offset of each buffer's data in the staging buffer, or -1 if the data is uploaded directly
+			int64_t m_stagingOffset[ModelBuffer_NumAllTypes];
 		};
 		struct ShaderLoadData
 		{
-			ShaderLoadData(const std::string(&p_names)[ShaderType_NumOfTypes],
+			ShaderLoadData(const std::string &p_programName,
+						   const uint64_t p_defineSetHash,
+						   const std::string(&p_names)[ShaderType_NumOfTypes],
 						   ShaderUniformUpdater &p_uniformUpdater,
 						   std::string(&p_source)[ShaderType_NumOfTypes],
 						   ErrorMessage(&p_errorMessages)[ShaderType_NumOfTypes]):
+				m_programName(p_programName),
+				m_defineSetHash(p_defineSetHash),
 				m_names(p_names),
 				m_uniformUpdater(p_uniformUpdater),
 				m_errorMessages(p_errorMessages),
@@ -313,6 +346,10 @@ public:
 			std::string(&m_source)[ShaderType_NumOfTypes];
 			ErrorMessage (&m_errorMessages)[ShaderType_NumOfTypes];
 			const std::string (&m_names)[ShaderType_NumOfTypes];
+
+			// Program name and the hash of its #define values, identifying the shader permutation in the program binary cache
+			const std::string &m_programName;
+			const uint64_t m_defineSetHash;
 		};
 		struct Texture2DLoadData
 		{
@@ -337,7 +374,8 @@ public:
 				m_mipmapLevel(p_mipmapLevel),
 				m_textureWidth(p_textureWidth),
 				m_textureHeight(p_textureHeight),
-				m_data(p_data) { }
+				m_data(p_data),
+				m_stagingOffset(-1) { }
 
 			const std::string &m_name;
 			const TextureFormat m_texFormat;
@@ -350,6 +388,9 @@ public:
 			const unsigned int m_textureWidth;
 			const unsigned int m_textureHeight;
 			const void *m_data;
+
+			// Offset of the pixel data in the staging buffer, or -1 if the data is uploaded directly
+			int64_t m_stagingOffset;
 		};
 		struct CubemapLoadData
 		{
@@ -388,11 +429,13 @@ public:
 					   const void **m_data) :
 				m_modelData(p_name, p_buffers, p_numElements, p_size, m_data) { }
 
-			ObjectData(const std::string(&p_names)[ShaderType_NumOfTypes],
+			ObjectData(const std::string &p_programName,
+					   const uint64_t p_defineSetHash,
+					   const std::string(&p_names)[ShaderType_NumOfTypes],
 					   ShaderUniformUpdater &p_uniformUpdater,
 					   std::string(&p_source)[ShaderType_NumOfTypes],
 					   ErrorMessage(&p_errorMessages)[ShaderType_NumOfTypes]) :
-				m_shaderData(p_names, p_uniformUpdater, p_source, p_errorMessages) { }
+				m_shaderData(p_programName, p_defineSetHash, p_names, p_uniformUpdater, p_source, p_errorMessages) { }
 
 			ObjectData(const std::string &p_name, 
 					   const TextureFormat p_texFormat,
@@ -452,6 +495,20 @@ public:
 		glViewport(0, 0, p_frameData.m_screenSize.x, p_frameData.m_screenSize.y);
 	}
 	
+	// Start writing per-frame buffer data into the next region of the frame ring buffer, waiting for the GPU if it is still reading from it
+	inline void beginFrame()
+	{
+		if(m_frameRingBuffer.isInitialized())
+			m_frameRingBuffer.beginFrame();
+	}
+
+	// Guard the region of the frame ring buffer written during this frame, until the GPU has finished the frame
+	inline void endFrame()
+	{
+		if(m_frameRingBuffer.isInitialized())
+			m_frameRingBuffer.endFrame();
+	}
+
 	void processUpdate(const BufferUpdateCommands &p_updateCommands, const UniformFrameData &p_frameData);
 	void processLoading(LoadCommands &p_loadCommands, const UniformFrameData &p_frameData);
 	void processUnloading(UnloadCommands &p_unloadCommands);
@@ -459,6 +516,50 @@ public:
 	void processDrawing(const ScreenSpaceDrawCommands &p_screenSpaceDrawCommands, const UniformFrameData &p_frameData);
 	void processDrawing(const ComputeDispatchCommands &p_computeDispatchCommands, const UniformFrameData &p_frameData);
 
+	// Returns the estimated time (in microseconds) that uploading an object of the given size takes, including the per-object overhead.
+	// The upload throughput starts at the configured value and is refined from the measured duration of uploads
+	inline float getEstimatedUploadTime(const int64_t p_sizeInBytes) const
+	{
+		return Config::rendererVar().gpu_upload_object_cost_us + (float)p_sizeInBytes / m_uploadBytesPerMicrosecond;
+	}
+
+	// Returns the number of bytes of 2D texture pixel data, with rows padded to the default unpack alignment (4 bytes)
+	static inline int64_t getTextureDataSize(const TextureFormat p_format, const TextureDataType p_dataType, const unsigned int p_width, const unsigned int p_height)
+	{
+		int64_t numOfComponents = 4;
+		switch(p_format)
+		{
+			case TextureFormat_Red:
+			case TextureFormat_Green:
+			case TextureFormat_Blue:
+			case TextureFormat_Alpha:
+			case TextureFormat_R:
+				numOfComponents = 1;
+				break;
+			case TextureFormat_RG:
+				numOfComponents = 2;
+				break;
+			case TextureFormat_RGB:
+				numOfComponents = 3;
+				break;
+		}
+
+		int64_t componentSize = 4;
+		switch(p_dataType)
+		{
+			case TextureDataType_UnsignedByte:
+				componentSize = 1;
+				break;
+			case TextureDataType_Short:
+				componentSize = 2;
+				break;
+		}
+
+		const int64_t rowSize = ((int64_t)p_width * numOfComponents * componentSize + 3) / 4 * 4;
+
+		return rowSize * (int64_t)p_height;
+	}
+
 	inline void bindTextureForReadering(const unsigned int p_bindingLocation, const TextureLoader2D::Texture2DHandle &p_texture) const
 	{
 		glActiveTexture(GL_TEXTURE0 + p_bindingLocation);
@@ -490,6 +591,8 @@ protected:
 			m_lastModelUpdate = 0;
 			m_lastMeshUpdate = 0;
 
+			m_lastMaterialID = NULL_MATERIAL_ID;
+
 			resetBoundTextures();
 		}
 
@@ -512,7 +615,8 @@ protected:
 
 		FaceCullingSettings m_lastFaceCullingSettings;
 
-		MaterialData m_materialData;
+		// Material whose parameters are currently in the material data buffer
+		MaterialID m_lastMaterialID;
 	};
 	
 	// Holds buffer parameters
@@ -704,6 +808,28 @@ protected:
 	}
 	inline void processCommand(const BufferUpdateCommand &p_command, const UniformFrameData &p_frameData)
 	{
+		if(p_command.m_perFrame && p_command.m_bufferType == BufferType_Uniform && m_frameRingBuffer.isInitialized())
+		{
+			// Write the data of per-frame uniform buffers into the current frame's region of the frame ring buffer, and bind that range to the
+			// buffer's binding index in place of the buffer itself; the whole size of the buffer is allocated, as shaders may declare all of it
+			int64_t ringOffset = 0;
+			if(p_command.m_offset == 0 && p_command.m_size <= p_command.m_bufferSize && m_frameRingBuffer.allocate(p_command.m_bufferSize, ringOffset))
+			{
+				if(p_command.m_data != nullptr && p_command.m_size > 0)
+					std::memcpy(m_frameRingBuffer.getMappedData(ringOffset), p_command.m_data, (std::size_t)p_command.m_size);
+
+				glBindBufferRange(GL_UNIFORM_BUFFER, p_command.m_bindingIndex, m_frameRingBuffer.getHandle(), ringOffset, p_command.m_bufferSize);
+
+				// Binding a range also binds the buffer to the generic binding point
+				m_rendererState.m_boundUniformBuffer = m_frameRingBuffer.getHandle();
+				return;
+			}
+
+			// The frame ring buffer is full, so rebind the buffer itself (it may have been replaced by a ring range in a previous frame)
+			glBindBufferBase(GL_UNIFORM_BUFFER, p_command.m_bindingIndex, p_command.m_bufferHandle);
+			m_rendererState.m_boundUniformBuffer = p_command.m_bufferHandle;
+		}
+
 		// Bind the buffer
 		bindUniformBuffer(p_command.m_bufferHandle);
 		
@@ -737,12 +863,17 @@ protected:
 					// Bind the buffer
 					glBindBuffer(p_command.m_objectData.m_bufferData.m_bufferType, p_command.m_handle);
 
-					// Fill the buffer
+					// Fill the buffer, either directly or from the staging buffer
 					glBufferData(p_command.m_objectData.m_bufferData.m_bufferType,
 						p_command.m_objectData.m_bufferData.m_size,
-						p_command.m_objectData.m_bufferData.m_data,
+						p_command.m_objectData.m_bufferData.m_stagingOffset < 0 ? p_command.m_objectData.m_bufferData.m_data : nullptr,
 						p_command.m_objectData.m_bufferData.m_bufferUsage);
 
+					if(p_command.m_objectData.m_bufferData.m_stagingOffset >= 0)
+						copyFromStagingBuffer(p_command.m_objectData.m_bufferData.m_bufferType,
+							p_command.m_objectData.m_bufferData.m_stagingOffset,
+							p_command.m_objectData.m_bufferData.m_size);
+
 					// Bind the buffer to the binding index so it can be accessed in a shader
 					glBindBufferBase(p_command.m_objectData.m_bufferData.m_bufferBindTarget,
 						p_command.m_objectData.m_bufferData.m_bindingIndex,
@@ -800,109 +931,124 @@ protected:
 					}
 					else
 					{
-						unsigned int numOfShaders = ShaderType::ShaderType_NumOfTypes;
-
-						// If a compute shader exists, then load ONLY the compute shader
-						if(!p_command.m_objectData.m_shaderData.m_source[ShaderType::ShaderType_Compute].empty())
-							numOfShaders = 1;
+						GLint shaderLinkingResult = 0;
 
-						// Create individual shaders
-						for(unsigned int i = 0; i < numOfShaders; i++)
+						// Try to create the program from its cached binary, which skips compiling and linking the shaders entirely
+						if(m_shaderBinaryCache.loadProgramBinary(p_command.m_handle, p_command.m_objectData.m_shaderData.m_programName, p_command.m_objectData.m_shaderData.m_defineSetHash, p_command.m_objectData.m_shaderData.m_source))
+							shaderLinkingResult = 1;
+						else
 						{
-							if(!p_command.m_objectData.m_shaderData.m_source[i].empty())
-							{
-								// Create a shader handle
-								shaderHandles[i] = glCreateShader(shaderTypes[i]);
+							unsigned int numOfShaders = ShaderType::ShaderType_NumOfTypes;
 
-								// Check for errors
-								glError = glGetError();
-								if(glError != GL_NO_ERROR)
-								{
-									// Log an error with a shader info log
-									p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorCode = ErrorCode::Shader_creation_failed;
-									p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorSource = ErrorSource::Source_ShaderLoader;
-
-									// Log an error with the error handler
-									ErrHandlerLoc::get().log(ErrorCode::Shader_creation_failed,
-										ErrorSource::Source_ShaderLoader,
-										"\"" + p_command.m_objectData.m_shaderData.m_names[i] + "\":\n" + Utilities::toString(glError));
-								}
-								else
-								{
-									// Pass shader source code and compile it
-									const char *shaderSource = p_command.m_objectData.m_shaderData.m_source[i].c_str();
-									glShaderSource(shaderHandles[i], 1, &shaderSource, NULL);
-									glCompileShader(shaderHandles[i]);
+							// If a compute shader exists, then load ONLY the compute shader
+							if(!p_command.m_objectData.m_shaderData.m_source[ShaderType::ShaderType_Compute].empty())
+								numOfShaders = 1;
 
-									// Check for shader compilation errors
-									GLint shaderCompileResult = 0;
-									glGetShaderiv(shaderHandles[i], GL_COMPILE_STATUS, &shaderCompileResult);
+							// Create individual shaders
+							for(unsigned int i = 0; i < numOfShaders; i++)
+							{
+								if(!p_command.m_objectData.m_shaderData.m_source[i].empty())
+								{
+									// Create a shader handle
+									shaderHandles[i] = glCreateShader(shaderTypes[i]);
 
 									// Check for errors
 									glError = glGetError();
-
-									// If compilation failed
-									if(shaderCompileResult == 0)
+									if(glError != GL_NO_ERROR)
 									{
-										// Assign an error
-										int shaderCompileLogLength = 0;
-										glGetShaderiv(shaderHandles[i], GL_INFO_LOG_LENGTH, &shaderCompileLogLength);
-
-										// Get the actual error message
-										std::vector<char> shaderCompileErrorMessage(shaderCompileLogLength);
-										glGetShaderInfoLog(shaderHandles[i], shaderCompileLogLength, NULL, &shaderCompileErrorMessage[0]);
-
-										// Convert vector of chars to a string
-										std::string errorMessageTemp;
-										for(int j = 0; shaderCompileErrorMessage[j]; j++)
-											errorMessageTemp += shaderCompileErrorMessage[j];
-
 										// Log an error with a shader info log
-										p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorCode = ErrorCode::Shader_compile_failed;
+										p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorCode = ErrorCode::Shader_creation_failed;
 										p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorSource = ErrorSource::Source_ShaderLoader;
-										p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorMessage = errorMessageTemp;
 
 										// Log an error with the error handler
-										ErrHandlerLoc::get().log(ErrorCode::Shader_compile_failed,
+										ErrHandlerLoc::get().log(ErrorCode::Shader_creation_failed,
 											ErrorSource::Source_ShaderLoader,
-											"\"" + p_command.m_objectData.m_shaderData.m_names[i] + "\":\n" + errorMessageTemp);
-
-										// Reset the shader handle
-										shaderHandles[i] = 0;
+											"\"" + p_command.m_objectData.m_shaderData.m_names[i] + "\":\n" + Utilities::toString(glError));
 									}
 									else
 									{
-										// Attach shader to the program handle
-										glAttachShader(p_command.m_handle, shaderHandles[i]);
+										// Pass shader source code and compile it
+										const char *shaderSource = p_command.m_objectData.m_shaderData.m_source[i].c_str();
+										glShaderSource(shaderHandles[i], 1, &shaderSource, NULL);
+										glCompileShader(shaderHandles[i]);
+
+										// Check for shader compilation errors
+										GLint shaderCompileResult = 0;
+										glGetShaderiv(shaderHandles[i], GL_COMPILE_STATUS, &shaderCompileResult);
 
 										// Check for errors
 										glError = glGetError();
 
-										if(glError != GL_NO_ERROR)
+										// If compilation failed
+										if(shaderCompileResult == 0)
 										{
-											// Reset the shader handle
-											shaderHandles[i] = 0;
+											// Assign an error
+											int shaderCompileLogLength = 0;
+											glGetShaderiv(shaderHandles[i], GL_INFO_LOG_LENGTH, &shaderCompileLogLength);
+
+											// Get the actual error message
+											std::vector<char> shaderCompileErrorMessage(shaderCompileLogLength);
+											glGetShaderInfoLog(shaderHandles[i], shaderCompileLogLength, NULL, &shaderCompileErrorMessage[0]);
+
+											// Convert vector of chars to a string
+											std::string errorMessageTemp;
+											for(int j = 0; shaderCompileErrorMessage[j]; j++)
+												errorMessageTemp += shaderCompileErrorMessage[j];
 
 											// Log an error with a shader info log
-											p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorCode = ErrorCode::Shader_attach_failed;
+											p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorCode = ErrorCode::Shader_compile_failed;
 											p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorSource = ErrorSource::Source_ShaderLoader;
-											p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorMessage = Utilities::toString(glError);
+											p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorMessage = errorMessageTemp;
 
 											// Log an error with the error handler
 											ErrHandlerLoc::get().log(ErrorCode::Shader_compile_failed,
 												ErrorSource::Source_ShaderLoader,
-												"\"" + p_command.m_objectData.m_shaderData.m_names[i] + "\":\n" + Utilities::toString(glError));
+												"\"" + p_command.m_objectData.m_shaderData.m_names[i] + "\":\n" + errorMessageTemp);
+
+											// Reset the shader handle
+											shaderHandles[i] = 0;
+										}
+										else
+										{
+											// Attach shader to the program handle
+											glAttachShader(p_command.m_handle, shaderHandles[i]);
+
+											// Check for errors
+											glError = glGetError();
+
+											if(glError != GL_NO_ERROR)
+											{
+												// Reset the shader handle
+												shaderHandles[i] = 0;
+
+												// Log an error with a shader info log
+												p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorCode = ErrorCode::Shader_attach_failed;
+												p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorSource = ErrorSource::Source_ShaderLoader;
+												p_command.m_objectData.m_shaderData.m_errorMessages[i].m_errorMessage = Utilities::toString(glError);
+
+												// Log an error with the error handler
+												ErrHandlerLoc::get().log(ErrorCode::Shader_compile_failed,
+													ErrorSource::Source_ShaderLoader,
+													"\"" + p_command.m_objectData.m_shaderData.m_names[i] + "\":\n" + Utilities::toString(glError));
+											}
 										}
 									}
 								}
 							}
-						}
 
-						GLint shaderLinkingResult;
-						glLinkProgram(p_command.m_handle);
+							// Make sure the linked program binary can be retrieved for the binary cache
+							if(m_shaderBinaryCache.isEnabled())
+								glProgramParameteri(p_command.m_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
-						// Check for linking errors. If an error has occurred, get the error message and throw an exception
-						glGetProgramiv(p_command.m_handle, GL_LINK_STATUS, &shaderLinkingResult);
+							glLinkProgram(p_command.m_handle);
+
+							// Check for linking errors. If an error has occurred, get the error message and throw an exception
+							glGetProgramiv(p_command.m_handle, GL_LINK_STATUS, &shaderLinkingResult);
+
+							// Save the linked program, so it doesn't have to be compiled on subsequent runs
+							if(shaderLinkingResult)
+								m_shaderBinaryCache.saveProgramBinary(p_command.m_handle, p_command.m_objectData.m_shaderData.m_programName, p_command.m_objectData.m_shaderData.m_defineSetHash, p_command.m_objectData.m_shaderData.m_source);
+						}
 
 						// If shader loading was successful
 						if(shaderLinkingResult)
@@ -966,6 +1112,12 @@ protected:
 
 			case LoadObject_Texture2D:
 				{
+					const bool staged = p_command.m_objectData.m_tex2DData.m_stagingOffset >= 0;
+
+					// If the pixel data is in the staging buffer, source it from there (the data pointer becomes an offset into the buffer)
+					if(staged)
+						glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_stagingBuffer.getHandle());
+
 					// Generate, bind and upload the texture
 					glGenTextures(1, &p_command.m_handle);
 					glBindTexture(GL_TEXTURE_2D, p_command.m_handle);
@@ -977,7 +1129,11 @@ protected:
 						0,
 						p_command.m_objectData.m_tex2DData.m_texFormat,
 						p_command.m_objectData.m_tex2DData.m_texDataType,
-						p_command.m_objectData.m_tex2DData.m_data);
+						staged ? reinterpret_cast<const void *>(static_cast<uintptr_t>(p_command.m_objectData.m_tex2DData.m_stagingOffset)) : p_command.m_objectData.m_tex2DData.m_data);
+
+					// Unbind the staging buffer, so that uploads from client memory are not affected
+					if(staged)
+						glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
 					// Generate mipmaps if they are enabled
 					if(p_command.m_objectData.m_tex2DData.m_enableMipmap)
@@ -1047,9 +1203,14 @@ protected:
 					glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, p_command.m_objectData.m_modelData.m_buffers[ModelBuffer_Index]);
 					glBufferData(GL_ELEMENT_ARRAY_BUFFER,
 						p_command.m_objectData.m_modelData.m_size[ModelBuffer_Index],
-						p_command.m_objectData.m_modelData.m_data[ModelBuffer_Index],
+						p_command.m_objectData.m_modelData.m_stagingOffset[ModelBuffer_Index] < 0 ? p_command.m_objectData.m_modelData.m_data[ModelBuffer_Index] : nullptr,
 						GL_STATIC_DRAW);
 
+					if(p_command.m_objectData.m_modelData.m_stagingOffset[ModelBuffer_Index] >= 0)
+						copyFromStagingBuffer(GL_ELEMENT_ARRAY_BUFFER,
+							p_command.m_objectData.m_modelData.m_stagingOffset[ModelBuffer_Index],
+							p_command.m_objectData.m_modelData.m_size[ModelBuffer_Index]);
+
 					// Loop over all the buffer types except index buffer 
 					// (since index buffer does not share the same properties as other buffer types)
 					for(unsigned int i = 0; i < ModelBuffer_NumTypesWithoutIndex; i++)
@@ -1058,9 +1219,14 @@ protected:
 						glBindBuffer(GL_ARRAY_BUFFER, p_command.m_objectData.m_modelData.m_buffers[i]);
 						glBufferData(GL_ARRAY_BUFFER,
 							p_command.m_objectData.m_modelData.m_size[i],
-							p_command.m_objectData.m_modelData.m_data[i],
+							p_command.m_objectData.m_modelData.m_stagingOffset[i] < 0 ? p_command.m_objectData.m_modelData.m_data[i] : nullptr,
 							GL_STATIC_DRAW);
 
+						if(p_command.m_objectData.m_modelData.m_stagingOffset[i] >= 0)
+							copyFromStagingBuffer(GL_ARRAY_BUFFER,
+								p_command.m_objectData.m_modelData.m_stagingOffset[i],
+								p_command.m_objectData.m_modelData.m_size[i]);
+
 						// Enable and bind the buffer to a vertex attribute array (so it can be accessed in the shader)
 						glEnableVertexAttribArray(i);
 						glVertexAttribPointer(i, p_command.m_objectData.m_modelData.m_numElements[i], GL_FLOAT, GL_FALSE, 0, 0);
@@ -1072,6 +1238,27 @@ protected:
 				break;
 		}
 	}
+	// Copy the data from the staging buffer to the start of the buffer that is bound to the given target; the copy is done by the GPU
+	inline void copyFromStagingBuffer(const GLenum p_target, const int64_t p_stagingOffset, const int64_t p_size)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, m_stagingBuffer.getHandle());
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, p_target, (GLintptr)p_stagingOffset, 0, (GLsizeiptr)p_size);
+	}
+
+	// Allocate staging space for the given data and queue it to be copied into the staging buffer; returns the staging offset, or -1 if it doesn't fit
+	inline int64_t stageData(const void *p_data, const int64_t p_size)
+	{
+		int64_t offset = -1;
+
+		if(p_data != nullptr && m_stagingBuffer.allocate(p_size, offset))
+		{
+			m_stagingCopies.emplace_back(p_data, offset, p_size);
+			return offset;
+		}
+
+		return -1;
+	}
+
 	inline void processCommand(const UnloadObjectType p_objectType, const int p_count, unsigned int *p_handles)
 	{
 		switch(p_objectType)
@@ -1090,8 +1277,31 @@ protected:
 		}
 	}
 
+	// Data that is copied into the staging buffer by worker threads, before load commands are processed
+	struct StagingCopy
+	{
+		StagingCopy(const void *p_data, const int64_t p_offset, const int64_t p_size) : m_data(p_data), m_offset(p_offset), m_size(p_size) { }
+
+		const void *m_data;
+		int64_t m_offset;
+		int64_t m_size;
+	};
+
 	CurrentState m_rendererState;
 
+	// Linked shader programs saved on disk
+	ShaderBinaryCache m_shaderBinaryCache;
+
+	// Persistently mapped buffer that load command data is uploaded from
+	StagingRingBuffer m_stagingBuffer;
+	std::vector<StagingCopy> m_stagingCopies;
+
+	// Persistently mapped buffer that per-frame uniform buffer data is written to and bound from
+	FrameRingBuffer m_frameRingBuffer;
+
+	// Measured upload throughput, used to estimate the duration of uploads
+	float m_uploadBytesPerMicrosecond;
+
 	static SingleTriangle m_fullscreenTriangle;
 
 	BufferData m_materialDataBuffer;
@@ -14,6 +14,7 @@
 #include "FinalPass.h"
 #include "HdrMappingPass.h"
 #include "PostProcessPass.h"
+#include "Profiler.h"
 #include "ReflectionPass.h"
 #include "RendererFrontend.h"
 #include "ShadowMappingPass.h"
@@ -23,6 +24,8 @@
 RendererFrontend::RendererFrontend() : m_renderPassData(nullptr)
 {
 	m_antialiasingType = AntiAliasingType::AntiAliasingType_None;
+	m_headless = false;
+	m_headlessShader = nullptr;
 
 	// Disable GUI rendering until GUI render pass is set (as calling GUI functions from GUI components will crash without GUI rendering pass)
 	m_guiRenderWasEnabled = Config::GUIVar().gui_render;
@@ -43,6 +46,8 @@ RendererFrontend::~RendererFrontend()
 			delete m_allRenderPasses[i];
 	}
 
+	m_dynamicResolution.release();
+
 	delete m_renderPassData;
 }
 
@@ -75,6 +80,24 @@ ErrorCode RendererFrontend::init()
 	m_frameData.m_screenSize.x = Config::graphicsVar().current_resolution_x;
 	m_frameData.m_screenSize.y = Config::graphicsVar().current_resolution_y;
 
+	// In headless mode there is no GL context, so the backend is never initialized, and all the commands are discarded instead of being passed to it
+	m_headless = Config::engineVar().headless_mode;
+	if(m_headless)
+	{
+		// Draw commands are still generated in headless mode, using the default shader program, which does not require a GL context
+		m_headlessShader = Loaders::shader().load();
+
+		m_renderPassData = new RenderPassData();
+
+		updateProjectionMatrix();
+
+		m_loadCommands.clear();
+
+		ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Renderer, "Running headless, GPU commands will be discarded");
+
+		return returnCode;
+	}
+
 	// Initialize renderer backend and check if it was successful
 	if(!ErrHandlerLoc::get().ifSuccessful(m_backend.init(m_frameData), returnCode))
 		return returnCode;
@@ -82,6 +105,9 @@ ErrorCode RendererFrontend::init()
 	// Create the render pass data struct
 	m_renderPassData = new RenderPassData();
 
+	// Create the GPU timer queries used for dynamic resolution
+	m_dynamicResolution.init();
+
 	updateProjectionMatrix();
 
 	passLoadCommandsToBackend();
@@ -115,6 +141,14 @@ void RendererFrontend::setRenderingPasses(const RenderingPasses &p_renderingPass
 	m_renderingPassesSet = true;
 
 	m_activeRenderPasses.clear();
+	m_culledRenderPasses.clear();
+
+	// Rendering passes require a GL context, so none are created in headless mode; GUI rendering is also disabled, as it relies on the GUI pass
+	if(m_headless)
+	{
+		Config::m_GUIVar.gui_render = false;
+		return;
+	}
 
 	bool guiRenderPassSet = false;
 	bool shadowMappingPassSet = false;
@@ -132,7 +166,6 @@ void RendererFrontend::setRenderingPasses(const RenderingPasses &p_renderingPass
 				if(m_allRenderPasses[RenderPassType::RenderPassType_ShadowMapping] == nullptr)
 					m_allRenderPasses[RenderPassType::RenderPassType_ShadowMapping] = new ShadowMappingPass(*this);
 				m_activeRenderPasses.push_back(m_allRenderPasses[RenderPassType_ShadowMapping]);
-				shadowMappingPassSet = true;
 				break;
 			case RenderPassType::RenderPassType_Lighting:
 				if(m_allRenderPasses[RenderPassType::RenderPassType_Lighting] == nullptr)
@@ -188,7 +221,6 @@ void RendererFrontend::setRenderingPasses(const RenderingPasses &p_renderingPass
 				if(m_allRenderPasses[RenderPassType::RenderPassType_GUI] == nullptr)
 					m_allRenderPasses[RenderPassType::RenderPassType_GUI] = new GUIPass(*this);
 				m_activeRenderPasses.push_back(m_allRenderPasses[RenderPassType::RenderPassType_GUI]);
-				guiRenderPassSet = true;
 				break;
 			case RenderPassType::RenderPassType_AmbientOcclusion:
 				if(m_allRenderPasses[RenderPassType::RenderPassType_AmbientOcclusion] == nullptr)
@@ -203,6 +235,33 @@ void RendererFrontend::setRenderingPasses(const RenderingPasses &p_renderingPass
 		}
 	}
 
+	// Build the render graph from the resources declared by each pass, and remove the passes whose output is not used, before they are initialized
+	m_renderGraph.clear();
+	for(const auto renderPass : m_activeRenderPasses)
+	{
+		RenderGraph::PassBuilder passBuilder = m_renderGraph.addPass(renderPass->getName());
+		renderPass->declareResources(passBuilder);
+	}
+
+	m_renderGraph.compile();
+	for(decltype(m_activeRenderPasses.size()) i = m_activeRenderPasses.size(); i-- > 0;)
+	{
+		if(m_renderGraph.isPassCulled((RenderGraph::PassID)i))
+		{
+			ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Renderer, m_activeRenderPasses[i]->getName() + " culled, as its output is not used.");
+			m_culledRenderPasses.push_back(m_activeRenderPasses[i]);
+			m_activeRenderPasses.erase(m_activeRenderPasses.begin() + i);
+		}
+	}
+
+	for(const auto renderPass : m_activeRenderPasses)
+	{
+		if(renderPass->getRenderPassType() == RenderPassType::RenderPassType_GUI)
+			guiRenderPassSet = true;
+		if(renderPass->getRenderPassType() == RenderPassType::RenderPassType_ShadowMapping)
+			shadowMappingPassSet = true;
+	}
+
 	// Disable GUI rendering if the GUI render pass wasn't set; re-enable GUI rendering if GUI pass was set and if it GUI rendering was enabled before
 	if(!guiRenderPassSet)
 		Config::m_GUIVar.gui_render = false;
@@ -236,11 +295,19 @@ const RenderingPasses RendererFrontend::getRenderingPasses()
 {
 	RenderingPasses renderPasses;
 
-	for(const auto renderPass : m_activeRenderPasses)
+	// Culled passes are still part of the set rendering passes, so they are returned in their original order
+	for(decltype(m_renderGraph.getNumOfPasses()) passID = 0, numOfPasses = m_renderGraph.getNumOfPasses(); passID < numOfPasses; passID++)
 	{
-		if(renderPass != nullptr)
+		for(const auto *renderPassList : { &m_activeRenderPasses, &m_culledRenderPasses })
 		{
-			renderPasses.push_back(renderPass->getRenderPassType());
+			for(const auto renderPass : *renderPassList)
+			{
+				if(renderPass != nullptr && renderPass->getName() == m_renderGraph.getPassName((RenderGraph::PassID)passID))
+				{
+					renderPasses.push_back(renderPass->getRenderPassType());
+					break;
+				}
+			}
 		}
 	}
 
@@ -249,6 +316,8 @@ const RenderingPasses RendererFrontend::getRenderingPasses()
 
 void RendererFrontend::renderFrame(SceneObjects &p_sceneObjects, const float p_deltaTime)
 {
+	PROFILE_ZONE("RendererFrontend::renderFrame");
+
 	bool projectionMatrixNeedsUpdating = false;
 
 	// Check if the anti-aliasing type has changed
@@ -282,7 +351,8 @@ void RendererFrontend::renderFrame(SceneObjects &p_sceneObjects, const float p_d
 			projectionMatrixNeedsUpdating = true;
 
 			// Set screen size in the backend
-			m_backend.setScreenSize(m_frameData);
+			if(!m_headless)
+				m_backend.setScreenSize(m_frameData);
 		}
 	}
 	else
@@ -306,10 +376,23 @@ void RendererFrontend::renderFrame(SceneObjects &p_sceneObjects, const float p_d
 			projectionMatrixNeedsUpdating = true;
 
 			// Set screen size in the backend
-			m_backend.setScreenSize(m_frameData);
+			if(!m_headless)
+				m_backend.setScreenSize(m_frameData);
 		}
 	}
 
+	// Set the size of the sub-rectangle of the framebuffers that the scene is rendered to; with dynamic resolution, its scale is adjusted based on
+	// the measured frame time, without ever reallocating the framebuffers (the final pass upscales the sub-rectangle to the full framebuffer size)
+	if(!m_headless)
+	{
+		const float renderScale = Config::rendererVar().dynamic_resolution ? m_dynamicResolution.update(p_deltaTime) : 1.0f;
+		const glm::ivec2 screenSize = glm::max(m_frameData.m_screenSize, glm::ivec2(1));
+		const glm::ivec2 renderSize = glm::clamp(glm::ivec2(glm::vec2(screenSize) * renderScale + 0.5f), glm::ivec2(1), screenSize);
+
+		m_backend.getGeometryBuffer()->setRenderSize((unsigned int)renderSize.x, (unsigned int)renderSize.y);
+		m_frameData.m_renderScale = glm::vec2(renderSize) / glm::vec2(screenSize);
+	}
+
 	// Set the global variables for the current viewport size
 	Config::m_rendererVar.current_viewport_size_x = m_frameData.m_screenSize.x;
 	Config::m_rendererVar.current_viewport_size_y = m_frameData.m_screenSize.y;
@@ -366,8 +449,14 @@ void RendererFrontend::renderFrame(SceneObjects &p_sceneObjects, const float p_d
 		queueForUnloading(p_sceneObjects.m_unloadFromVideoMemory[i]);
 	}
 
+	// Objects are loaded within a per-frame budget of uploaded bytes and estimated upload time, and are capped by the object count.
+	// At least one object is loaded each frame, so that objects larger than the budget still get loaded
 	unsigned int numLoadedObjectsThisFrame = 0;
+	int64_t uploadSizeThisFrame = 0;
+	float uploadTimeThisFrame = 0.0f;
 	const unsigned int maxLoadedObjectsThisFrame = Config::rendererVar().objects_loaded_per_frame;
+	const int64_t maxUploadSizeThisFrame = Config::rendererVar().gpu_upload_max_bytes_per_frame;
+	const float maxUploadTimeThisFrame = Config::rendererVar().gpu_upload_max_time_per_frame_us;
 
 	// Iterate over all objects that require to be loaded to video memory
 	for(auto entity : p_sceneObjects.m_objectsToLoadToVideoMemory)
@@ -381,6 +470,18 @@ void RendererFrontend::renderFrame(SceneObjects &p_sceneObjects, const float p_d
 
 			LoadableObjectsContainer &loadableObject = component.m_objectsToLoad.front();
 
+			if(!loadableObject.isLoadedToVideoMemory())
+			{
+				const int64_t objectUploadSize = getUploadSize(loadableObject);
+				const float objectUploadTime = m_backend.getEstimatedUploadTime(objectUploadSize);
+
+				if(numLoadedObjectsThisFrame > 1 && (uploadSizeThisFrame + objectUploadSize > maxUploadSizeThisFrame || uploadTimeThisFrame + objectUploadTime > maxUploadTimeThisFrame))
+					goto jumpAfterLoading;
+
+				uploadSizeThisFrame += objectUploadSize;
+				uploadTimeThisFrame += objectUploadTime;
+			}
+
 			switch(loadableObject.getType())
 			{
 			case LoadableObjectsContainer::LoadableObjectType_Model:
@@ -446,19 +547,240 @@ void RendererFrontend::renderFrame(SceneObjects &p_sceneObjects, const float p_d
 	// Calculate the transpose inverse view matrix needed for converting normals (in the normal g-buffer) to view space
 	m_frameData.m_transposeInverseViewMatrix = glm::transpose(glm::inverse(m_frameData.m_viewMatrix));
 
+	// Calculate the inverse view-projection matrix needed for reconstructing world-space positions from the depth buffer
+	m_frameData.m_inverseViewProjMatrix = glm::inverse(m_frameData.m_viewProjMatrix);
+
 	// Set the camera position
 	m_frameData.m_cameraPosition = p_sceneObjects.m_cameraViewMatrix[3];
 
 	// Set the camera target vector
 	m_frameData.m_cameraTarget = normalize(glm::vec3(0.0f, 0.0f, -1.0f) * glm::mat3(p_sceneObjects.m_cameraViewMatrix));
 	
+	// Rasterize the occluders on worker threads before any drawing of this frame is submitted, while the GPU is still processing the previous frame
+	if(Config::rendererVar().occlusion_culling && p_sceneObjects.m_processDrawing)
+	{
+		PROFILE_ZONE("Occlusion Culling");
+		updateOcclusionCulling(p_sceneObjects);
+	}
+	else
+		m_occlusionCuller.reset();
+
+	// There are no rendering passes in headless mode, so generate the geometry draw commands in their place
+	if(m_headless)
+	{
+		PROFILE_ZONE("Headless Draw Command Generation");
+		generateHeadlessDrawCommands(p_sceneObjects);
+	}
+
+	// Measure the GPU time of all the rendering passes
+	if(!m_headless && Config::rendererVar().dynamic_resolution)
+		m_dynamicResolution.beginFrame();
+
+	// Move on to the next region of the frame ring buffer, that the per-frame uniform data of the rendering passes is written to
+	if(!m_headless)
+		m_backend.beginFrame();
+
 	for(decltype(m_activeRenderPasses.size()) i = 0, size = m_activeRenderPasses.size(); i < size; i++)
 	{
+		PROFILE_ZONE(m_activeRenderPasses[i]->getName().c_str());
 		m_activeRenderPasses[i]->update(*m_renderPassData, p_sceneObjects, p_deltaTime);
 	}
+
+	if(!m_headless)
+		m_backend.endFrame();
+
+	m_dynamicResolution.endFrame();
 }
 
 unsigned int RendererFrontend::getFramebufferTextureHandle(GBufferTextureType p_bufferType) const
 {
-	return m_backend.getFramebufferTextureHandle(p_bufferType); 
+	// There are no framebuffers in headless mode
+	return m_headless ? 0 : m_backend.getFramebufferTextureHandle(p_bufferType); 
+}
+
+void RendererFrontend::generateHeadlessDrawCommands(const SceneObjects &p_sceneObjects)
+{
+	if(!p_sceneObjects.m_processDrawing)
+		return;
+
+	// Get the default shader details, used for every draw command
+	const auto shaderHandle = m_headlessShader->getShaderHandle();
+	auto &uniformUpdater = m_headlessShader->getUniformUpdater();
+
+	// Iterate over all models the same way the geometry pass does, so that the CPU cost of the draw command generation and sorting is the same
+	queueForDrawingParallel(p_sceneObjects.m_renderSnapshot->m_models, [&](RendererBackend::DrawCommands &p_drawCommands, const RenderSnapshot::ModelEntry &p_modelEntry)
+		{
+			auto &modelData = p_modelEntry.m_model->getModelData();
+
+			const glm::mat4 &modelMatrix = p_modelEntry.m_modelMatrix;
+			const glm::mat4 modelViewProjMatrix = m_frameData.m_viewProjMatrix * modelMatrix;
+
+			for(decltype(modelData.size()) modelIndex = 0, modelSize = modelData.size(); modelIndex < modelSize; modelIndex++)
+			{
+				for(decltype(modelData[modelIndex].m_model.getNumMeshes()) meshIndex = 0, meshSize = modelData[modelIndex].m_model.getNumMeshes(); meshIndex < meshSize; meshIndex++)
+				{
+					// Only draw active meshes that are not hidden behind occluders
+					if(modelData[modelIndex].m_meshes[meshIndex].m_active && !isMeshOccluded(modelData[modelIndex].m_model[meshIndex], modelMatrix))
+					{
+						queueForDrawing(p_drawCommands,
+							modelData[modelIndex].m_model[meshIndex],
+							modelData[modelIndex].m_meshes[meshIndex],
+							modelData[modelIndex].m_model.getHandle(),
+							shaderHandle,
+							uniformUpdater,
+							DrawCommandTextureBinding::DrawCommandTextureBinding_All,
+							modelData[modelIndex].m_drawFaceCulling,
+							modelMatrix,
+							modelViewProjMatrix);
+					}
+				}
+			}
+		});
+
+	// Sort and discard the draw commands
+	passDrawCommandsToBackend();
+}
+
+void RendererFrontend::releaseUploadedCPUData()
+{
+	if(Config::modelVar().cpuResidencyPolicy == AssetResidencyPolicy::AssetResidencyPolicy_ReleaseAfterUpload)
+	{
+		// Occluders are rasterized from the positions and indices in RAM, and any model can be selected as an occluder
+		// (if occlusion culling is enabled later, the released positions and indices are reloaded by the occluder selection)
+		const bool keepPositionsAndIndices = Config::rendererVar().occlusion_culling;
+
+		for(auto *model : m_uploadedModels)
+			model->releaseCPUData(keepPositionsAndIndices);
+	}
+
+	if(Config::textureVar().texture_cpu_residency_policy == AssetResidencyPolicy::AssetResidencyPolicy_ReleaseAfterUpload)
+	{
+		for(auto *texture : m_uploadedTextures)
+			texture->releaseCPUData();
+	}
+}
+
+void RendererFrontend::updateOcclusionCulling(const SceneObjects &p_sceneObjects)
+{
+	m_occlusionCuller.setBufferSize((unsigned int)std::max(Config::rendererVar().occlusion_buffer_width, 1), (unsigned int)std::max(Config::rendererVar().occlusion_buffer_height, 1));
+	m_occlusionCuller.beginFrame(m_frameData.m_viewProjMatrix);
+
+	const float minScreenSize = Config::rendererVar().occlusion_occluder_min_screen_size;
+	const unsigned int maxNumOfTriangles = (unsigned int)std::max(Config::rendererVar().occlusion_occluder_max_triangles, 0);
+	const std::size_t maxNumOfOccluders = (std::size_t)std::max(Config::rendererVar().occlusion_max_occluders, 0);
+
+	m_occluderCandidates.clear();
+
+	for(const auto &modelEntry : p_sceneObjects.m_renderSnapshot->m_models)
+	{
+		for(const auto &modelData : modelEntry.m_model->getModelData())
+		{
+			// Occluders are rasterized from the vertex data kept in system memory
+			const auto &positions = modelData.m_model.getPositions();
+			const auto &indices = modelData.m_model.getIndices();
+
+			if(positions.empty() || indices.empty())
+			{
+				// Models uploaded while occlusion culling was disabled had their positions and indices released
+				if(modelData.m_model.m_model->isCPUDataReleased())
+					reloadOccluderCPUData(*modelData.m_model.m_model);
+
+				continue;
+			}
+
+			for(decltype(modelData.m_model.getNumMeshes()) meshIndex = 0, meshSize = modelData.m_model.getNumMeshes(); meshIndex < meshSize; meshIndex++)
+			{
+				const Model::Mesh &mesh = modelData.m_model[meshIndex];
+
+				if(!modelData.m_meshes[meshIndex].m_active || mesh.m_numIndices < 3)
+					continue;
+
+				// Meshes of flagged models are always preferred; other meshes are only selected if they are large enough on the screen and simple enough to rasterize
+				float screenSize = std::numeric_limits<float>::max();
+				if(!modelEntry.m_occluder)
+				{
+					if(mesh.m_numIndices / 3 > maxNumOfTriangles)
+						continue;
+
+					// Alpha tested (e.g. foliage, fences) and transparent meshes have holes that the rasterizer would fill in, hiding the objects that are visible through them
+					if(modelData.m_meshes[meshIndex].m_alphaThreshold > 0.0f || modelData.m_meshes[meshIndex].getMaterial().m_materialData.m_parameters[MaterialType_Diffuse].m_color.a < 1.0f)
+						continue;
+
+					const glm::vec3 center = glm::vec3(modelEntry.m_modelMatrix * glm::vec4(mesh.m_boundingSphereCenter, 1.0f));
+					const float scale = std::max(glm::length(glm::vec3(modelEntry.m_modelMatrix[0])), std::max(glm::length(glm::vec3(modelEntry.m_modelMatrix[1])), glm::length(glm::vec3(modelEntry.m_modelMatrix[2]))));
+					const float radius = mesh.m_boundingSphereRadius * scale;
+					const float distance = glm::length(center - m_frameData.m_cameraPosition);
+
+					// Meshes that surround the camera (e.g. the walls of a room) cover the whole screen
+					if(distance > radius)
+						screenSize = radius * m_frameData.m_projMatrix[1][1] / distance;
+
+					if(screenSize < minScreenSize)
+						continue;
+				}
+
+				m_occluderCandidates.emplace_back(screenSize, &positions[mesh.m_baseVertex], &indices[mesh.m_baseIndex], mesh.m_numIndices, modelEntry.m_modelMatrix);
+			}
+		}
+	}
+
+	// Keep the occluders that cover the most of the screen
+	const std::size_t numOfOccluders = std::min(m_occluderCandidates.size(), maxNumOfOccluders);
+	std::partial_sort(m_occluderCandidates.begin(), m_occluderCandidates.begin() + numOfOccluders, m_occluderCandidates.end(), [](const OccluderCandidate &p_left, const OccluderCandidate &p_right) { return p_left.m_screenSize > p_right.m_screenSize; });
+
+	for(std::size_t i = 0; i < numOfOccluders; i++)
+		m_occlusionCuller.addOccluder(m_occluderCandidates[i].m_positions, m_occluderCandidates[i].m_indices, m_occluderCandidates[i].m_numOfIndices, *m_occluderCandidates[i].m_modelMatrix);
+
+	// Transform and rasterize the occluders on worker threads, and build the depth pyramid
+	m_occlusionCuller.rasterize();
+}
+
+void RendererFrontend::reloadOccluderCPUData(Model &p_model)
+{
+	// Only attempt the reload once, so a model file that fails to load is not read every frame
+	if(!m_reloadedOccluderModels.insert(p_model.getFilename()).second)
+		return;
+
+	// Release the rest of the reloaded data right away, keeping only the positions and indices; they are picked up as occluders from the next frame
+	if(p_model.reloadCPUData() == ErrorCode::Success)
+		p_model.releaseCPUData(true);
+}
+
+void RendererFrontend::mergeDrawCommandLists(const std::size_t p_numOfLists)
+{
+	// Count the total number of draw commands, so they can be added without reallocating
+	std::size_t numOfDrawCommands = m_drawCommands.size();
+	for(std::size_t i = 0; i < p_numOfLists; i++)
+		numOfDrawCommands += m_drawCommandLists[i].size();
+	m_drawCommands.reserve(numOfDrawCommands);
+
+	// Min-heap of the sort keys at the current position of each list (the heap comparison is reversed, as standard heap functions keep the largest element on top)
+	const auto heapComparator = [](const auto &p_left, const auto &p_right) { return p_left.first > p_right.first; };
+
+	m_drawCommandListHeap.clear();
+	m_drawCommandListPositions.assign(p_numOfLists, 0);
+
+	for(std::size_t i = 0; i < p_numOfLists; i++)
+		if(!m_drawCommandLists[i].empty())
+			m_drawCommandListHeap.emplace_back(m_drawCommandLists[i].front().first, i);
+
+	std::make_heap(m_drawCommandListHeap.begin(), m_drawCommandListHeap.end(), heapComparator);
+
+	// Repeatedly take the draw command with the smallest sort key, and advance the position of its list
+	while(!m_drawCommandListHeap.empty())
+	{
+		std::pop_heap(m_drawCommandListHeap.begin(), m_drawCommandListHeap.end(), heapComparator);
+		const std::size_t listIndex = m_drawCommandListHeap.back().second;
+		m_drawCommandListHeap.pop_back();
+
+		const auto &drawCommands = m_drawCommandLists[listIndex];
+		auto &position = m_drawCommandListPositions[listIndex];
+		m_drawCommands.push_back(drawCommands[position++]);
+
+		if(position < drawCommands.size())
+		{
+			m_drawCommandListHeap.emplace_back(drawCommands[position].first, listIndex);
+			std::push_heap(m_drawCommandListHeap.begin(), m_drawCommandListHeap.end(), heapComparator);
+		}
+	}
 }
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "Config.h"
+#include "DynamicResolution.h"
 #include "GUIHandler.h"
+#include "OcclusionCuller.h"
+#include "RenderGraph.h"
 #include "RendererBackend.h"
 #include "RendererScene.h"
+#include "TaskManagerLocator.h"
 
 class RenderPass;
 struct RenderPassData;
@@ -40,6 +47,7 @@ public:
 			m_offset = 0;
 			m_handle = 0;
 			m_bindingIndex = 0;
+			m_perFrame = false;
 		}
 
 		int64_t m_size;
@@ -49,6 +57,9 @@ public:
 		unsigned int m_bindingIndex;
 		void *m_data;
 
+		// Set for uniform buffers that are updated every frame, so that their data is written to the frame ring buffer instead
+		bool m_perFrame;
+
 		const BufferType m_bufferType;
 		const BufferBindTarget m_bufferBindTarget;
 		const BufferUsageHint m_bufferUsage;
@@ -71,6 +82,7 @@ public:
 	void setShadowMappingData(const ShadowMappingData &p_shadowMappingData) { m_frameData.m_shadowMappingData = p_shadowMappingData; }
 
 	const RenderingPasses getRenderingPasses();
+	const inline RenderGraph &getRenderGraph() const { return m_renderGraph; }
 	const ShadowMappingData &getShadowMappingData() const { return m_frameData.m_shadowMappingData; }
 
 	// Renders a complete frame
@@ -78,17 +90,31 @@ public:
 
 	unsigned int getFramebufferTextureHandle(GBufferTextureType p_bufferType) const;
 
+	const inline bool isHeadless() const { return m_headless; }
+
 	const inline UniformFrameData &getFrameData() const { return m_frameData; }
 	
 protected:
 	inline void queueForDrawing(const Model::Mesh &p_mesh, const MeshData &p_meshData, const uint32_t p_modelHandle, const uint32_t p_shaderHandle, ShaderUniformUpdater &p_uniformUpdater, const DrawCommandTextureBinding p_textureBindingType, const FaceCullingSettings p_faceCulling, const glm::mat4 &p_modelMatrix, const glm::mat4 &p_modelViewProjMatrix)
 	{
-		// Calculate the sort key, by combining lower 16 bits of shader handle and model handle
+		queueForDrawing(m_drawCommands, p_mesh, p_meshData, p_modelHandle, p_shaderHandle, p_uniformUpdater, p_textureBindingType, p_faceCulling, p_modelMatrix, p_modelViewProjMatrix);
+	}
+	// Queues a draw command into the given draw command list; does not modify the renderer, so it can be called from worker threads (each with its own list)
+	static inline void queueForDrawing(RendererBackend::DrawCommands &p_drawCommands, const Model::Mesh &p_mesh, const MeshData &p_meshData, const uint32_t p_modelHandle, const uint32_t p_shaderHandle, ShaderUniformUpdater &p_uniformUpdater, const DrawCommandTextureBinding p_textureBindingType, const FaceCullingSettings p_faceCulling, const glm::mat4 &p_modelMatrix, const glm::mat4 &p_modelViewProjMatrix, const unsigned int p_lod = 0)
+	{
+		// Calculate the sort key, by combining lower 16 bits of shader handle, the material ID and lower 16 bits of model handle,
+		// so that draw commands using the same material are consecutive, and its textures and parameters are only bound once per run
 		// sortkey = 64 bits total
 		// 64-48 bits = shader handle
-		// 48-32 bits = model handle
-		RendererBackend::DrawCommands::value_type::first_type sortKey = ((p_shaderHandle & 0x0000ffff) << 16) | (p_modelHandle & 0x0000ffff);
-		sortKey = sortKey << 32;
+		// 48-16 bits = material ID
+		// 16-0 bits = model handle
+		RendererBackend::DrawCommands::value_type::first_type sortKey =
+			((RendererBackend::DrawCommands::value_type::first_type)(p_shaderHandle & 0x0000ffff) << 48) |
+			((RendererBackend::DrawCommands::value_type::first_type)p_meshData.m_materialID << 16) |
+			(RendererBackend::DrawCommands::value_type::first_type)(p_modelHandle & 0x0000ffff);
+
+		// Get the shared material of the mesh
+		const auto &material = p_meshData.getMaterial();
 
 		// TODO: per-texture material parameters
 		// Assign the object data that is later passed to the shaders
@@ -97,30 +123,80 @@ protected:
 			p_meshData.m_heightScale,
 			p_meshData.m_alphaThreshold,
 			p_meshData.m_emissiveIntensity,
-			p_meshData.m_materialData.m_parameters[MaterialType::MaterialType_Diffuse].m_scale.x,
+			material.m_materialData.m_parameters[MaterialType::MaterialType_Diffuse].m_scale.x,
 			p_meshData.m_textureRepetitionScale);
 
-		m_drawCommands.emplace_back(
+		p_drawCommands.emplace_back(
 			sortKey,
 			RendererBackend::DrawCommand(
 				p_uniformUpdater,
 				objectData,
 				p_shaderHandle,
 				p_modelHandle,
-				p_mesh.m_numIndices,
+				p_mesh.m_lods[p_lod].m_numIndices,
 				p_mesh.m_baseVertex,
-				p_mesh.m_baseIndex,
-				p_meshData.m_materials[MaterialType::MaterialType_Diffuse].getHandle(),
-				p_meshData.m_materials[MaterialType::MaterialType_Normal].getHandle(),
-				p_meshData.m_materials[MaterialType::MaterialType_Emissive].getHandle(),
-				p_meshData.m_materials[MaterialType::MaterialType_Combined].getHandle(),
+				p_mesh.m_lods[p_lod].m_baseIndex,
+				material.m_textures[MaterialType::MaterialType_Diffuse].getHandle(),
+				material.m_textures[MaterialType::MaterialType_Normal].getHandle(),
+				material.m_textures[MaterialType::MaterialType_Emissive].getHandle(),
+				material.m_textures[MaterialType::MaterialType_Combined].getHandle(),
 				p_faceCulling,
-				p_meshData.m_materialData,
+				p_meshData.m_materialID,
+				material.m_materialData,
 				p_textureBindingType,
 				p_meshData.m_textureWrapMode)
 		);
 	}
+	// Returns the number of pixels that a world space unit at the distance of one unit from the camera covers on the screen (vertically)
+	inline float getLODProjectionScale() const { return m_frameData.m_projMatrix[1][1] * 0.5f * (float)m_frameData.m_screenSize.y; }
+
+	// Selects the coarsest LOD of the mesh, whose simplification error projected onto the screen doesn't exceed the allowed pixel error;
+	// the LOD bias scales the allowed error, so higher values select coarser LODs. Does not modify the renderer, so it can be called from worker threads
+	static inline unsigned int selectMeshLOD(const Model::Mesh &p_mesh, const glm::mat4 &p_modelMatrix, const glm::vec3 &p_cameraPosition, const float p_projectionScale, const float p_lodBias)
+	{
+		if(p_mesh.m_numLODs < 2)
+			return 0;
+
+		// Transform the bounding sphere to world space, scaling its radius by the largest axis scale
+		const glm::vec3 center = glm::vec3(p_modelMatrix * glm::vec4(p_mesh.m_boundingSphereCenter, 1.0f));
+		const float scale = std::max(glm::length(glm::vec3(p_modelMatrix[0])), std::max(glm::length(glm::vec3(p_modelMatrix[1])), glm::length(glm::vec3(p_modelMatrix[2]))));
+		const float radius = p_mesh.m_boundingSphereRadius * scale;
+
+		// Use the most detailed LOD when the camera is inside the bounding sphere
+		const float distance = glm::length(center - p_cameraPosition);
+		if(distance <= radius)
+			return 0;
+
+		// Screen size of the bounding sphere radius, in pixels; LOD errors are relative to the radius
+		const float projectedRadius = radius * p_projectionScale / distance;
+		const float maxError = Config::rendererVar().lod_pixel_error * p_lodBias;
+
+		unsigned int lod = 0;
+		while(lod + 1 < p_mesh.m_numLODs && p_mesh.m_lods[lod + 1].m_error * projectedRadius <= maxError)
+			lod++;
+
+		return lod;
+	}
+
+	// Returns true if the mesh is hidden behind the occluders rasterized for the current frame.
+	// Only reads the occlusion buffer, so it can be called from worker threads while draw commands are generated
+	inline bool isMeshOccluded(const Model::Mesh &p_mesh, const glm::mat4 &p_modelMatrix) const
+	{
+		if(!m_occlusionCuller.isRasterized())
+			return false;
+
+		// Transform the bounding sphere to world space, scaling its radius by the largest axis scale
+		const glm::vec3 center = glm::vec3(p_modelMatrix * glm::vec4(p_mesh.m_boundingSphereCenter, 1.0f));
+		const float scale = std::max(glm::length(glm::vec3(p_modelMatrix[0])), std::max(glm::length(glm::vec3(p_modelMatrix[1])), glm::length(glm::vec3(p_modelMatrix[2]))));
+
+		return m_occlusionCuller.isBoundingSphereOccluded(center, p_mesh.m_boundingSphereRadius * scale);
+	}
+
 	inline void queueForDrawing(const ModelData &p_modelData, const unsigned int p_shaderHandle, ShaderUniformUpdater &p_uniformUpdater, const DrawCommandTextureBinding p_textureBindingType, const glm::mat4 &p_modelMatrix, const glm::mat4 &p_viewProjMatrix)
+	{
+		queueForDrawing(m_drawCommands, p_modelData, p_shaderHandle, p_uniformUpdater, p_textureBindingType, p_modelMatrix, p_viewProjMatrix);
+	}
+	static inline void queueForDrawing(RendererBackend::DrawCommands &p_drawCommands, const ModelData &p_modelData, const unsigned int p_shaderHandle, ShaderUniformUpdater &p_uniformUpdater, const DrawCommandTextureBinding p_textureBindingType, const glm::mat4 &p_modelMatrix, const glm::mat4 &p_viewProjMatrix)
 	{
 		// Get the necessary handles
 		const unsigned int modelHandle = p_modelData.m_model.getHandle();
@@ -133,7 +209,7 @@ protected:
 		{
 			if(p_modelData.m_meshes[meshIndex].m_active)
 			{
-				queueForDrawing(p_modelData.m_model[meshIndex], p_modelData.m_meshes[meshIndex], modelHandle, p_shaderHandle, p_uniformUpdater, p_textureBindingType, p_modelData.m_drawFaceCulling, p_modelMatrix, modelViewProjMatrix);
+				queueForDrawing(p_drawCommands, p_modelData.m_model[meshIndex], p_modelData.m_meshes[meshIndex], modelHandle, p_shaderHandle, p_uniformUpdater, p_textureBindingType, p_modelData.m_drawFaceCulling, p_modelMatrix, modelViewProjMatrix);
 			}
 		}
 	}
@@ -183,7 +259,9 @@ protected:
 	{
 		if(!p_shader.m_loadedToVideoMemory)
 		{
-			m_loadCommands.emplace_back(p_shader.m_shaderFilename,
+			m_loadCommands.emplace_back(p_shader.m_combinedFilename,
+										p_shader.getDefineSetHash(),
+										p_shader.m_shaderFilename,
 										p_shader.m_programHandle,
 										p_shader.getUniformUpdater(),
 										p_shader.m_shaderSource,
@@ -194,6 +272,18 @@ protected:
 	}
 	inline void queueForLoading(ModelLoader::ModelHandle &p_model)
 	{
+		// Data that was released after a previous upload is required again; if it cannot be reloaded, the data already in VRAM is kept
+		if(p_model.m_model->isCPUDataReleased())
+		{
+			if(ErrorCode reloadError = p_model.m_model->reloadCPUData(); reloadError != ErrorCode::Success)
+			{
+				ErrHandlerLoc::get().log(reloadError, p_model.getFilename(), ErrorSource::Source_Renderer);
+				return;
+			}
+		}
+
+		m_uploadedModels.push_back(p_model.m_model);
+
 		m_loadCommands.emplace_back(p_model.getFilename(),
 			p_model.m_model->m_handle,
 			p_model.m_model->m_buffers,
@@ -203,6 +293,15 @@ protected:
 	}
 	inline void queueForLoading(TextureLoader2D::Texture2DHandle &p_texture)
 	{
+		// Data that was released after a previous upload is required again; if it cannot be reloaded, the data already in VRAM is kept
+		if(ErrorCode reloadError = p_texture.reloadReleasedCPUData(); reloadError != ErrorCode::Success)
+		{
+			ErrHandlerLoc::get().log(reloadError, p_texture.getFilename(), ErrorSource::Source_Renderer);
+			return;
+		}
+
+		m_uploadedTextures.push_back(p_texture.m_textureData);
+
 		m_loadCommands.emplace_back(p_texture.getFilename(),
 			p_texture.getHandleRef(),
 			p_texture.getTextureFormat(),
@@ -295,55 +394,129 @@ protected:
 			p_shaderBuffer.m_updateSize == p_shaderBuffer.m_size ?	// If update size is the same as buffer size
 			BufferUpdateType::BufferUpdate_Data :					// Update the whole buffer
 			BufferUpdateType::BufferUpdate_SubData,					// Otherwise update only part of the data
-			p_shaderBuffer.m_bufferType);
+			p_shaderBuffer.m_bufferType,
+			p_shaderBuffer.m_bufferUsage,
+			p_shaderBuffer.m_size,
+			p_shaderBuffer.m_bindingIndex,
+			p_shaderBuffer.m_perFrame);
+	}
+
+	// Returns the number of bytes that loading the object to video memory uploads (zero for shaders and objects that are already loaded)
+	inline int64_t getUploadSize(LoadableObjectsContainer &p_object)
+	{
+		int64_t uploadSize = 0;
+
+		if(!p_object.isLoadedToVideoMemory())
+		{
+			switch(p_object.getType())
+			{
+				case LoadableObjectsContainer::LoadableObjectType_Model:
+					for(unsigned int i = 0; i < ModelBuffer_NumAllTypes; i++)
+						uploadSize += p_object.getModelHandle().m_model->m_bufferSize[i];
+					break;
+
+				case LoadableObjectsContainer::LoadableObjectType_Texture:
+					uploadSize = RendererBackend::getTextureDataSize(p_object.getTextureHandle().getTextureFormat(),
+						p_object.getTextureHandle().getTextureDataType(),
+						p_object.getTextureHandle().getTextureWidth(),
+						p_object.getTextureHandle().getTextureHeight());
+					break;
+
+				default:
+					break;
+			}
+		}
+
+		return uploadSize;
 	}
 
 	inline void passLoadCommandsToBackend()
 	{
-		// Pass the queued load commands to the backend to be loaded to GPU
-		m_backend.processLoading(m_loadCommands, m_frameData);
+		// Pass the queued load commands to the backend to be loaded to GPU (discarded in headless mode)
+		if(!m_headless)
+		{
+			m_backend.processLoading(m_loadCommands, m_frameData);
+
+			// All the data has been copied out of RAM by now (into the staging buffer, or by the driver), so it can be released
+			releaseUploadedCPUData();
+		}
 
 		// Clear load commands, since they have already been passed to backend
 		m_loadCommands.clear();
+		m_uploadedModels.clear();
+		m_uploadedTextures.clear();
 	}
 	inline void passUnloadCommandsToBackend()
 	{
-		// Pass the queued unload commands to the backend to be released from GPU memory
-		m_backend.processUnloading(m_unloadCommands);
+		// Pass the queued unload commands to the backend to be released from GPU memory (discarded in headless mode)
+		if(!m_headless)
+			m_backend.processUnloading(m_unloadCommands);
 
 		// Clear unload commands, since they have already been passed to backend
 		m_unloadCommands.clear();
 	}
+	// Generates draw commands for the given objects in parallel: objects are split into chunks, and for each object of a chunk, the given
+	// function is called on a worker thread, queuing draw commands into the draw command list of that chunk. Each list is sorted on its
+	// worker thread, and all the lists are then merged into the draw command queue. The function must only read the scene data
+	template <typename T_Object, typename Function>
+	inline void queueForDrawingParallel(const std::vector<T_Object> &p_objects, const Function &p_queueFunc)
+	{
+		const std::size_t grainSize = (std::size_t)std::max(Config::rendererVar().draw_command_grain_size, 1);
+		const std::size_t numOfChunks = (p_objects.size() + grainSize - 1) / grainSize;
+
+		if(m_drawCommandLists.size() < numOfChunks)
+			m_drawCommandLists.resize(numOfChunks);
+
+		// Generate and sort the draw commands of each chunk
+		TaskManagerLocator::get().parallelFor(std::size_t(0), numOfChunks, std::size_t(1), [&](const std::size_t p_chunkIndex)
+			{
+				auto &drawCommands = m_drawCommandLists[p_chunkIndex];
+				drawCommands.clear();
+
+				for(std::size_t i = p_chunkIndex * grainSize, end = std::min(i + grainSize, p_objects.size()); i < end; i++)
+					p_queueFunc(drawCommands, p_objects[i]);
+
+				std::sort(drawCommands.begin(), drawCommands.end(), [](const auto &p_left, const auto &p_right) { return p_left.first < p_right.first; });
+			});
+
+		mergeDrawCommandLists(numOfChunks);
+	}
 	inline void passDrawCommandsToBackend()
 	{
-		std::sort(m_drawCommands.begin(), m_drawCommands.end(), [](const auto &p_left, const auto &p_right) { return p_left.first < p_right.first; });
+		// Draw commands are already sorted, if they were only merged from sorted draw command lists
+		if(!std::is_sorted(m_drawCommands.begin(), m_drawCommands.end(), [](const auto &p_left, const auto &p_right) { return p_left.first < p_right.first; }))
+			std::sort(m_drawCommands.begin(), m_drawCommands.end(), [](const auto &p_left, const auto &p_right) { return p_left.first < p_right.first; });
 
-		// Pass the queued draw commands to the backend to be sent to GPU
-		m_backend.processDrawing(m_drawCommands, m_frameData);
+		// Pass the queued draw commands to the backend to be sent to GPU (discarded in headless mode)
+		if(!m_headless)
+			m_backend.processDrawing(m_drawCommands, m_frameData);
 
 		// Clear draw commands
 		m_drawCommands.clear();
 	}
 	inline void passScreenSpaceDrawCommandsToBackend()
 	{
-		// Pass the queued screen-space draw commands to the backend to be sent to GPU
-		m_backend.processDrawing(m_screenSpaceDrawCommands, m_frameData);
+		// Pass the queued screen-space draw commands to the backend to be sent to GPU (discarded in headless mode)
+		if(!m_headless)
+			m_backend.processDrawing(m_screenSpaceDrawCommands, m_frameData);
 
 		// Clear draw commands
 		m_screenSpaceDrawCommands.clear();
 	}	
 	inline void passComputeDispatchCommandsToBackend()
 	{
-		// Pass the queued compute shader dispatch commands to the backend to be sent to GPU
-		m_backend.processDrawing(m_computeDispatchCommands, m_frameData);
+		// Pass the queued compute shader dispatch commands to the backend to be sent to GPU (discarded in headless mode)
+		if(!m_headless)
+			m_backend.processDrawing(m_computeDispatchCommands, m_frameData);
 
 		// Clear compute dispatch commands
 		m_computeDispatchCommands.clear();
 	}
 	inline void passUpdateCommandsToBackend()
 	{
-		// Pass the buffer update commands to the backend, so the buffers are updated on the GPU
-		m_backend.processUpdate(m_bufferUpdateCommands, m_frameData);
+		// Pass the buffer update commands to the backend, so the buffers are updated on the GPU (discarded in headless mode)
+		if(!m_headless)
+			m_backend.processUpdate(m_bufferUpdateCommands, m_frameData);
 
 		// Clear update commands, since they have already been passed to backend
 		m_bufferUpdateCommands.clear();
@@ -384,8 +557,27 @@ protected:
 		}
 	}
 
+	// Generates and sorts the geometry draw commands without any rendering passes, used in headless mode
+	void generateHeadlessDrawCommands(const SceneObjects &p_sceneObjects);
+
+	// Merges the given number of (sorted) draw command lists into the draw command queue, keeping them sorted
+	void mergeDrawCommandLists(const std::size_t p_numOfLists);
+
+	// Selects the occluders of the current frame (meshes of models flagged as occluders, and the largest meshes on the screen) and rasterizes them
+	void updateOcclusionCulling(const SceneObjects &p_sceneObjects);
+
+	// Reloads the positions and indices of a model that were released after the upload (while occlusion culling was disabled), so it can be rasterized as an occluder
+	void reloadOccluderCPUData(Model &p_model);
+
+	// Releases the RAM copies of the data of models and textures that were uploaded this frame, based on the residency policy of each asset type
+	void releaseUploadedCPUData();
+
 	bool m_renderingPassesSet;
 	bool m_guiRenderWasEnabled;
+
+	// No GL context is present in headless mode; all the commands are generated but never passed to the backend
+	bool m_headless;
+	ShaderLoader::ShaderProgram *m_headlessShader;
 	AntiAliasingType m_antialiasingType;
 
 	// Renderer backend, serves as an interface layer to GPU
@@ -402,6 +594,15 @@ protected:
 	RendererBackend::ScreenSpaceDrawCommands m_screenSpaceDrawCommands;
 	RendererBackend::ComputeDispatchCommands m_computeDispatchCommands;
 
+	// Assets whose data is passed to the backend with the current load commands
+	std::vector<Model *> m_uploadedModels;
+	std::vector<Texture2D *> m_uploadedTextures;
+
+	// Draw command lists of each chunk of the parallel draw command generation (kept between frames, to reuse their memory)
+	std::vector<RendererBackend::DrawCommands> m_drawCommandLists;
+	std::vector<std::pair<RendererBackend::DrawCommands::value_type::first_type, std::size_t>> m_drawCommandListHeap;
+	std::vector<std::size_t> m_drawCommandListPositions;
+
 	// Holds info used between rendering passes
 	RenderPassData *m_renderPassData;
 
@@ -410,5 +611,34 @@ protected:
 	
 	// An array of all active rendering passes
 	std::vector<RenderPass*> m_activeRenderPasses;
+
+	// Rendering passes that were set but culled by the render graph, as their output is not used; they are not initialized nor updated
+	std::vector<RenderPass*> m_culledRenderPasses;
+
+	// Resources (render targets) read and written by the set rendering passes; used to cull the passes and compute resource lifetimes
+	RenderGraph m_renderGraph;
+
+	// Scales the rendering resolution based on the measured frame time
+	DynamicResolution m_dynamicResolution;
+
+	// Mesh that can be rasterized as an occluder; screen size is the fraction of the screen height covered by its bounding sphere
+	struct OccluderCandidate
+	{
+		OccluderCandidate(const float p_screenSize, const glm::vec3 *p_positions, const unsigned int *p_indices, const unsigned int p_numOfIndices, const glm::mat4 &p_modelMatrix) :
+			m_screenSize(p_screenSize), m_positions(p_positions), m_indices(p_indices), m_numOfIndices(p_numOfIndices), m_modelMatrix(&p_modelMatrix) { }
+
+		float m_screenSize;
+		const glm::vec3 *m_positions;
+		const unsigned int *m_indices;
+		unsigned int m_numOfIndices;
+		const glm::mat4 *m_modelMatrix;
+	};
+
+	// Rasterizes occluders into a low-resolution depth buffer on the CPU, used to skip the meshes hidden behind them
+	OcclusionCuller m_occlusionCuller;
+	std::vector<OccluderCandidate> m_occluderCandidates;
+
+	// Filenames of models whose released positions and indices were reloaded for occlusion culling; each model is only reloaded once, even if it fails
+	std::unordered_set<std::string> m_reloadedOccluderModels;
 	RenderPass* m_allRenderPasses[RenderPassType::RenderPassType_NumOfTypes];
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 
 #include "ComponentConstructorInfo.h"
 #include "WorldScene.h"
+#include "Profiler.h"
 #include "RendererScene.h"
 #include "RendererSystem.h"
 #include "SceneLoader.h"
@@ -610,6 +611,8 @@ void RendererScene::loadInBackground()
 
 void RendererScene::update(const float p_deltaTime)
 {
+	PROFILE_ZONE("RendererScene::update");
+
 	// Get the world scene required for getting the entity registry
 	WorldScene *worldScene = static_cast<WorldScene*>(m_sceneLoader->getSystemScene(Systems::World));
 
@@ -618,68 +621,6 @@ void RendererScene::update(const float p_deltaTime)
 
 	bool loadingStatus = false;
 
-	//	 _______________________________
-	//	|							    |
-	//	|	 CHECK FOR LOAD PENDING		|
-	//	|_______________________________|
-	//
-	// Go over each not-loading components and check whether they have anything that needs to be loaded
-	auto modelNoLoadView = entityRegistry.view<ModelComponent, SpatialComponent>(entt::exclude<ShaderComponent, GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>);
-	for(auto entity : modelNoLoadView)
-	{
-		// Get the component
-		auto &component = modelNoLoadView.get<ModelComponent>(entity);
-
-		// Check if there is anything that needs to be loaded
-		if(component.getLoadPending())
-		{
-			component.importModels();
-			if(!component.getModelsNeedsLoading())
-			{
-				component.importTextures();
-				if(!component.getTexturesNeedsLoading())
-				{
-					// Reset load pending flag
-					component.resetLoadPending();
-					component.setLoadedToMemory(true);
-					component.setLoadedToVideoMemory(true);
-				}
-				else
-				{
-					// Add load to memory component, to mark the entity as loading
-					worldScene->addComponent<GraphicsLoadToMemoryComponent>(entity, entity);
-
-					// Set the loading status flag to true
-					loadingStatus = true;
-
-					// Reset load pending flag
-					component.resetLoadPending();
-					component.setLoadedToMemory(false);
-					component.setLoadedToVideoMemory(false);
-
-					// Start loading the component to memory in the background
-					TaskManagerLocator::get().startBackgroundThread(std::bind(&ModelComponent::loadTexturesToMemory, &component));
-				}
-			}
-			else
-			{
-				// Add load to memory component, to mark the entity as loading
-				worldScene->addComponent<GraphicsLoadToMemoryComponent>(entity, entity);
-
-				// Set the loading status flag to true
-				loadingStatus = true;
-
-				// Reset load pending flag
-				component.resetLoadPending();
-				component.setLoadedToMemory(false);
-				component.setLoadedToVideoMemory(false);
-
-				// Start loading the component to memory in the background
-				TaskManagerLocator::get().startBackgroundThread(std::bind(&ModelComponent::loadModelsToMemory, &component));
-			}
-		}
-	}
-
 	//	 _______________________________
 	//	|							    |
 	//	| CURRENTLY LOADING COMPONENTS	|
@@ -850,27 +791,108 @@ void RendererScene::update(const float p_deltaTime)
 		m_sceneObjects.m_processDrawing = !m_loadingStatus;
 	}
 
-	//	 ___________________________
-	//	|							|
-	//	|	  COMPONENT UPDATES		|
-	//	|___________________________|
-	//
+	m_sceneObjects.m_objectsToLoadToVideoMemory = entityRegistry.view<GraphicsLoadToVideoMemoryComponent>(entt::exclude<GraphicsLoadToMemoryComponent>);
+
+	// When rendering is not pipelined, the frame is rendered from the scene state of the same frame
+	if(!Config::engineVar().pipelined_rendering)
+		captureRenderSnapshot();
+
+	// Render the last captured snapshot
+	const RenderSnapshot &renderSnapshot = m_renderSnapshots.getFront();
+	m_sceneObjects.m_renderSnapshot = &renderSnapshot;
+	m_sceneObjects.m_cameraViewMatrix = renderSnapshot.m_cameraViewMatrix;
+	m_sceneObjects.m_fov = renderSnapshot.m_fov;
+	m_sceneObjects.m_zFar = renderSnapshot.m_zFar;
+	m_sceneObjects.m_zNear = renderSnapshot.m_zNear;
+}
+
+void RendererScene::captureRenderSnapshot()
+{
+	PROFILE_ZONE("RendererScene::captureRenderSnapshot");
+
+	// Get the entity registry 
+	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
+
+	// Start loading the models that have changed before capturing them, as nothing is being rendered from the snapshot at this point
+	if(processLoadPending())
+		m_loadingStatus = true;
+
+	RenderSnapshot &renderSnapshot = m_renderSnapshots.getBack();
+	renderSnapshot.clear();
 
 	//	 ___________________________
 	//	|							|
 	//	|	  MODEL COMPONENTS		|
 	//	|___________________________|
 	//
-	m_sceneObjects.m_models = entityRegistry.view<ModelComponent, SpatialComponent>(entt::exclude<ShaderComponent, GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>);
-	m_sceneObjects.m_modelsWithShaders = entityRegistry.view<ModelComponent, ShaderComponent, SpatialComponent>(entt::exclude<GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>);
-	m_sceneObjects.m_objectsToLoadToVideoMemory = entityRegistry.view<GraphicsLoadToVideoMemoryComponent>(entt::exclude<GraphicsLoadToMemoryComponent>);
+	auto modelView = entityRegistry.view<ModelComponent, SpatialComponent>(entt::exclude<ShaderComponent, GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>);
+	for(auto entity : modelView)
+	{
+		auto &modelComponent = modelView.get<ModelComponent>(entity);
+
+		// Models of entities with static rigid bodies (zero mass and not kinematic) never move, so their shadows can be cached
+		if(Config::rendererVar().csm_static_caster_caching)
+		{
+			const auto *rigidBodyComponent = entityRegistry.try_get<RigidBodyComponent>(entity);
+			const btRigidBody *rigidBody = rigidBodyComponent != nullptr ? rigidBodyComponent->getRigidBody() : nullptr;
+
+			modelComponent.setStaticRigidBody(rigidBody != nullptr && rigidBody->isStaticObject() && !rigidBody->isKinematicObject());
+		}
+
+		if(modelComponent.isObjectActive())
+		{
+			const auto &spatialDataManager = modelView.get<SpatialComponent>(entity).getSpatialDataChangeManager();
+			renderSnapshot.m_models.emplace_back(entity, modelComponent, spatialDataManager.getWorldTransformWithScale(), spatialDataManager.getUpdateCount());
+		}
+	}
+
+	auto modelWithShaderView = entityRegistry.view<ModelComponent, ShaderComponent, SpatialComponent>(entt::exclude<GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>);
+	for(auto entity : modelWithShaderView)
+	{
+		auto &modelComponent = modelWithShaderView.get<ModelComponent>(entity);
+		auto &shaderComponent = modelWithShaderView.get<ShaderComponent>(entity);
+
+		if(modelComponent.isObjectActive() && shaderComponent.isLoadedToVideoMemory())
+			renderSnapshot.m_modelsWithShaders.emplace_back(modelComponent, shaderComponent, modelWithShaderView.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransformWithScale());
+	}
 
 	//	 ___________________________
 	//	|							|
 	//	|	  LIGHT COMPONENTS		|
 	//	|___________________________|
 	//
-	m_sceneObjects.m_lights = entityRegistry.view<LightComponent, SpatialComponent>();
+	auto lightView = entityRegistry.view<LightComponent, SpatialComponent>();
+	for(auto entity : lightView)
+	{
+		auto &lightComponent = lightView.get<LightComponent>(entity);
+
+		// Check if the light is enabled
+		if(!lightComponent.isObjectActive())
+			continue;
+
+		const glm::mat4 &worldTransform = lightView.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransform();
+
+		// Copy the light data to the corresponding array, based on the light type, with the position and direction from the transform
+		switch(lightComponent.getLightType())
+		{
+			case LightComponent::LightComponentType_point:
+				renderSnapshot.m_pointLights.push_back(*lightComponent.getPointLight());
+				renderSnapshot.m_pointLights.back().m_position = worldTransform[3];
+				break;
+
+			case LightComponent::LightComponentType_spot:
+				renderSnapshot.m_spotLights.push_back(*lightComponent.getSpotLight());
+				renderSnapshot.m_spotLights.back().m_position = worldTransform[3];
+				renderSnapshot.m_spotLights.back().m_direction = worldTransform[2];
+				break;
+
+			case LightComponent::LightComponentType_directional:
+				renderSnapshot.m_directionalLight = *lightComponent.getDirectionalLight();
+				renderSnapshot.m_directionalLight.m_direction = worldTransform[2];
+				renderSnapshot.m_directionalLightPresent = true;
+				break;
+		}
+	}
 
 	//	 ___________________________
 	//	|							|
@@ -887,6 +909,8 @@ void RendererScene::update(const float p_deltaTime)
 			break;
 	}
 
+	// Keep the previous camera settings if there is no camera
+	const RenderSnapshot &previousSnapshot = m_renderSnapshots.getFront();
 	if(activeCameraEntityID != NULL_ENTITY_ID)
 	{
 		m_sceneObjects.m_activeCameraEntityID = activeCameraEntityID;
@@ -894,16 +918,102 @@ void RendererScene::update(const float p_deltaTime)
 		auto &cameraComponent = cameraView.get<CameraComponent>(m_sceneObjects.m_activeCameraEntityID);
 		auto &spatialComponent = cameraView.get<SpatialComponent>(m_sceneObjects.m_activeCameraEntityID);
 
-		m_sceneObjects.m_fov = cameraComponent.m_fov;
-		m_sceneObjects.m_zFar = cameraComponent.m_zFar;
-		m_sceneObjects.m_zNear = cameraComponent.m_zNear;
-		m_sceneObjects.m_cameraViewMatrix = spatialComponent.getSpatialDataChangeManager().getWorldTransform();
+		renderSnapshot.m_fov = cameraComponent.m_fov;
+		renderSnapshot.m_zFar = cameraComponent.m_zFar;
+		renderSnapshot.m_zNear = cameraComponent.m_zNear;
+		renderSnapshot.m_cameraViewMatrix = spatialComponent.getSpatialDataChangeManager().getWorldTransform();
+	}
+	else
+	{
+		renderSnapshot.m_fov = previousSnapshot.m_fov;
+		renderSnapshot.m_zFar = previousSnapshot.m_zFar;
+		renderSnapshot.m_zNear = previousSnapshot.m_zNear;
+		renderSnapshot.m_cameraViewMatrix = previousSnapshot.m_cameraViewMatrix;
+	}
+
+	// Make the captured snapshot the one to be rendered
+	m_renderSnapshots.swapBuffer();
+}
+
+bool RendererScene::processLoadPending()
+{
+	// Get the world scene required for getting the entity registry
+	WorldScene *worldScene = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World));
+
+	// Get the entity registry 
+	auto &entityRegistry = worldScene->getEntityRegistry();
+
+	bool loadingStatus = false;
+
+	//	 _______________________________
+	//	|							    |
+	//	|	 CHECK FOR LOAD PENDING		|
+	//	|_______________________________|
+	//
+	// Go over each not-loading components and check whether they have anything that needs to be loaded.
+	// Importing replaces the model data, and the background loading keeps changing it, so the entities are marked as loading (and left out of the snapshot) right away
+	auto modelNoLoadView = entityRegistry.view<ModelComponent, SpatialComponent>(entt::exclude<ShaderComponent, GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>);
+	for(auto entity : modelNoLoadView)
+	{
+		// Get the component
+		auto &component = modelNoLoadView.get<ModelComponent>(entity);
+
+		// Check if there is anything that needs to be loaded
+		if(component.getLoadPending())
+		{
+			component.importModels();
+			if(!component.getModelsNeedsLoading())
+			{
+				component.importTextures();
+				if(!component.getTexturesNeedsLoading())
+				{
+					// Reset load pending flag
+					component.resetLoadPending();
+					component.setLoadedToMemory(true);
+					component.setLoadedToVideoMemory(true);
+				}
+				else
+				{
+					// Add load to memory component, to mark the entity as loading
+					worldScene->addComponent<GraphicsLoadToMemoryComponent>(entity, entity);
+
+					// Set the loading status flag to true
+					loadingStatus = true;
+
+					// Reset load pending flag
+					component.resetLoadPending();
+					component.setLoadedToMemory(false);
+					component.setLoadedToVideoMemory(false);
+
+					// Start loading the component to memory in the background
+					TaskManagerLocator::get().startBackgroundThread(std::bind(&ModelComponent::loadTexturesToMemory, &component));
+				}
+			}
+			else
+			{
+				// Add load to memory component, to mark the entity as loading
+				worldScene->addComponent<GraphicsLoadToMemoryComponent>(entity, entity);
+
+				// Set the loading status flag to true
+				loadingStatus = true;
+
+				// Reset load pending flag
+				component.resetLoadPending();
+				component.setLoadedToMemory(false);
+				component.setLoadedToVideoMemory(false);
+
+				// Start loading the component to memory in the background
+				TaskManagerLocator::get().startBackgroundThread(std::bind(&ModelComponent::loadModelsToMemory, &component));
+			}
+		}
 	}
+
+	return loadingStatus;
 }
 
-std::vector<SystemObject *> RendererScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> RendererScene::getComponents(const EntityID p_entityID)
 {
-	std::vector<SystemObject *> returnVector;
+	FrameVector<SystemObject *> returnVector;
 
 	// Get the entity registry 
 	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
@@ -1112,6 +1222,8 @@ SystemObject *RendererScene::createComponent(const EntityID &p_entityID, const M
 		{
 			component.m_setActiveAfterLoading = p_constructionInfo.m_active;
 			component.setActive(false);
+			component.setStaticShadowCasterFlag(p_constructionInfo.m_staticShadowCaster);
+			component.setOccluderFlag(p_constructionInfo.m_occluder);
 
 			component.m_modelsProperties = new ModelComponent::ModelsProperties(p_constructionInfo.m_modelsProperties);
 
@@ -1225,7 +1337,8 @@ void RendererScene::releaseObject(SystemObject *p_systemObject)
 			{
 				auto *component = static_cast<ModelComponent *>(p_systemObject);
 
-				// Nothing to release
+				// Release the shared materials of the component meshes
+				component->releaseMaterials();
 			}
 			break;
 
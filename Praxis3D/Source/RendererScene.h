@@ -6,6 +6,7 @@
 
 #include <list>
 
+#include "Containers.h"
 #include "EntityViewDefinitions.h"
 #include "GraphicsDataSets.h"
 #include "GraphicsLoadComponents.h"
@@ -81,16 +82,75 @@ struct LoadableComponentContainer
 	EntityID m_entityID;
 };
 
+// Compact copy of the scene state needed to render a frame: transforms of the visible models, lights and camera.
+// Captured once the simulation of a frame is finished, so the frame can be rendered while the next one is being simulated,
+// without reading the components that the simulation is modifying. Model components are referenced rather than copied,
+// as their model data only changes while the snapshot is being captured (when nothing is being rendered), or while they are loading (and left out of the snapshot)
+struct RenderSnapshot
+{
+	struct ModelEntry
+	{
+		ModelEntry(const EntityID p_entity, const ModelComponent &p_model, const glm::mat4 &p_modelMatrix, const UpdateCount p_updateCount) :
+			m_entity(p_entity), m_model(&p_model), m_modelMatrix(p_modelMatrix), m_updateCount(p_updateCount), m_staticShadowCaster(p_model.isStaticShadowCaster()), m_occluder(p_model.getOccluderFlag()) { }
+
+		EntityID m_entity;
+		const ModelComponent *m_model;
+		glm::mat4 m_modelMatrix;
+
+		// Transform update count of the spatial component at the time of capture, used to detect moved objects
+		UpdateCount m_updateCount;
+		bool m_staticShadowCaster;
+		bool m_occluder;
+	};
+	struct ModelWithShaderEntry
+	{
+		ModelWithShaderEntry(const ModelComponent &p_model, const ShaderComponent &p_shader, const glm::mat4 &p_modelMatrix) : m_model(&p_model), m_shader(&p_shader), m_modelMatrix(p_modelMatrix) { }
+
+		const ModelComponent *m_model;
+		const ShaderComponent *m_shader;
+		glm::mat4 m_modelMatrix;
+	};
+
+	RenderSnapshot() : m_directionalLightPresent(false), m_cameraViewMatrix(1.0f), m_fov(Config::graphicsVar().fov), m_zFar(Config::graphicsVar().z_far), m_zNear(Config::graphicsVar().z_near) { }
+
+	// Clears the arrays while keeping their memory, so it is reused each frame
+	void clear()
+	{
+		m_models.clear();
+		m_modelsWithShaders.clear();
+		m_pointLights.clear();
+		m_spotLights.clear();
+		m_directionalLight.clear();
+		m_directionalLightPresent = false;
+	}
+
+	// Active models that are loaded to video memory
+	std::vector<ModelEntry> m_models;
+	std::vector<ModelWithShaderEntry> m_modelsWithShaders;
+
+	// Active lights, with their positions and directions taken from their transforms
+	std::vector<PointLightDataSet> m_pointLights;
+	std::vector<SpotLightDataSet> m_spotLights;
+	DirectionalLightDataSet m_directionalLight;
+	bool m_directionalLightPresent;
+
+	// Camera
+	glm::mat4 m_cameraViewMatrix;
+	float m_fov;
+	float m_zFar;
+	float m_zNear;
+};
+
 // Used to store processed objects, so they can be sent to the renderer
 struct SceneObjects
 {
-	SceneObjects() : m_processDrawing(true), m_activeCameraEntityID(NULL_ENTITY_ID), m_activeCameraID(0), m_fov(Config::graphicsVar().fov), m_zFar(Config::graphicsVar().z_far), m_zNear(Config::graphicsVar().z_near) { }
+	SceneObjects() : m_renderSnapshot(nullptr), m_processDrawing(true), m_activeCameraEntityID(NULL_ENTITY_ID), m_activeCameraID(0), m_fov(Config::graphicsVar().fov), m_zFar(Config::graphicsVar().z_far), m_zNear(Config::graphicsVar().z_near) { }
 
 	// ECS registry views
-	decltype(std::declval<entt::basic_registry<EntityID>>().view<ModelComponent, SpatialComponent>(entt::exclude<ShaderComponent, GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>)) m_models;
-	decltype(std::declval<entt::basic_registry<EntityID>>().view<ModelComponent, ShaderComponent, SpatialComponent>(entt::exclude<GraphicsLoadToMemoryComponent, GraphicsLoadToVideoMemoryComponent>)) m_modelsWithShaders;
 	decltype(std::declval<entt::basic_registry<EntityID>>().view<GraphicsLoadToVideoMemoryComponent>(entt::exclude<GraphicsLoadToMemoryComponent>)) m_objectsToLoadToVideoMemory;
-	decltype(std::declval<entt::basic_registry<EntityID>>().view<LightComponent, SpatialComponent>(entt::exclude<>)) m_lights;
+
+	// Scene state of the frame being rendered; never null while rendering
+	const RenderSnapshot *m_renderSnapshot;
 
 	// Camera
 	glm::mat4 m_cameraViewMatrix;
@@ -138,8 +198,12 @@ public:
 	// Processes all the objects and puts them in the separate vectors
 	void update(const float p_deltaTime);
 
+	// Captures the state of the scene that is needed for rendering into the back render snapshot, and makes it the front one.
+	// Must be called while no system is modifying the scene (after the changes of the frame have been distributed)
+	void captureRenderSnapshot();
+
 	// Get all the created components of the given entity that belong to this scene
-	std::vector<SystemObject *> getComponents(const EntityID p_entityID);
+	FrameVector<SystemObject *> getComponents(const EntityID p_entityID);
 
 	std::vector<SystemObject*> createComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true);
 	std::vector<SystemObject*> createComponents(const EntityID p_entityID, const GraphicsComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true)
@@ -208,6 +272,8 @@ public:
 	{
 		p_constructionInfo.m_active = p_component.isObjectActive();
 		p_constructionInfo.m_name = p_component.getName();
+		p_constructionInfo.m_staticShadowCaster = p_component.getStaticShadowCasterFlag();
+		p_constructionInfo.m_occluder = p_component.getOccluderFlag();
 
 		p_component.getModelsProperties(p_constructionInfo.m_modelsProperties);
 	}
@@ -300,6 +366,10 @@ public:
 	}
 
 private:
+	// Imports the models and textures of the model components that have changed, and starts loading them in background threads if they need to be;
+	// replaces the model data that render snapshots point to, so must only be called while nothing is being rendered. Returns true if any loading was started
+	bool processLoadPending();
+
 	MaterialData loadMaterialData(PropertySet &p_materialProperty, Model::MaterialArrays &p_materialArraysFromModel, MaterialType p_materialType, std::size_t p_meshIndex);
 
 	void loadAtmosphericDensityLayer(const PropertySet &p_densityProperty, AtmosphericScatteringData::AtmosphericDensityLayer &p_densityProfileLayer)
@@ -333,6 +403,9 @@ private:
 	// Used to store processed objects
 	SceneObjects m_sceneObjects;
 
+	// Front snapshot is being rendered, while the back one is being captured
+	DoubleBufferedContainer<RenderSnapshot> m_renderSnapshots;
+
 	// Task responsible for initiating rendering each frame
 	RenderTask *m_renderTask;
 
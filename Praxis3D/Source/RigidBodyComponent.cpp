@@ -78,28 +78,13 @@ void RigidBodyComponent::changeOccurred(ObservedSubject *p_subject, BitMask p_ch
 
 	if(CheckBitmask(p_changeType, Systems::Changes::Physics::CollisionShapeSize))
 	{
+		// Collision shapes are shared between rigid bodies, so instead of resizing the current shape, switch to a shape of the new size
 		switch(m_collisionShapeType)
 		{
 		case CollisionShapeType::CollisionShapeType_Box:
-			m_collisionShape.m_boxShape->setImplicitShapeDimensions(Math::toBtVector3(
-				p_subject->getVec3(this, Systems::Changes::Physics::CollisionShapeSize) - glm::vec3(m_collisionShape.m_boxShape->getMargin())));
-			static_cast<PhysicsScene *>(m_systemScene)->cleanProxyFromPairs(*m_rigidBody);
-			break;
-		case CollisionShapeType::CollisionShapeType_Capsule:
-			break;
-		case CollisionShapeType::CollisionShapeType_Cone:
-			break;
-		case CollisionShapeType::CollisionShapeType_ConvexHull:
-			break;
 		case CollisionShapeType::CollisionShapeType_Cylinder:
-			m_collisionShape.m_cylinderShape->setImplicitShapeDimensions(Math::toBtVector3(
-				p_subject->getVec3(this, Systems::Changes::Physics::CollisionShapeSize) - glm::vec3(m_collisionShape.m_cylinderShape->getMargin())));
-			static_cast<PhysicsScene *>(m_systemScene)->cleanProxyFromPairs(*m_rigidBody);
-			break;
 		case CollisionShapeType::CollisionShapeType_Sphere:
-			m_collisionShape.m_sphereShape->setImplicitShapeDimensions(Math::toBtVector3(
-				p_subject->getVec3(this, Systems::Changes::Physics::CollisionShapeSize)));
-			static_cast<PhysicsScene *>(m_systemScene)->cleanProxyFromPairs(*m_rigidBody);
+			replaceCollisionShape(m_collisionShapeType, p_subject->getVec3(this, Systems::Changes::Physics::CollisionShapeSize));
 			break;
 		}
 	}
@@ -109,40 +94,8 @@ void RigidBodyComponent::changeOccurred(ObservedSubject *p_subject, BitMask p_ch
 		auto collisionShapeTypeNumber = p_subject->getUnsignedInt(this, Systems::Changes::Physics::CollisionShapeType);
 		if(collisionShapeTypeNumber >= 0 && collisionShapeTypeNumber < CollisionShapeType::CollisionShapeType_NumOfTypes)
 		{
-			// Save the current collision shape size for the new shape
-			const auto oldCollisionShapeSize = getCollisionShapeSize();
-
-			// Get the new collision shape type
-			m_collisionShapeType = static_cast<CollisionShapeType>(collisionShapeTypeNumber);
-
-			// Delete the old collision shape
-			delete m_rigidBody->getCollisionShape();
-
-			// Create the new collision shape
-			switch(m_collisionShapeType)
-			{
-				case CollisionShapeType::CollisionShapeType_Box:
-					m_collisionShape.m_boxShape = new btBoxShape(Math::toBtVector3(oldCollisionShapeSize));
-					m_rigidBody->setCollisionShape(m_collisionShape.m_boxShape);
-					break;
-				case CollisionShapeType::CollisionShapeType_Capsule:
-					break;
-				case CollisionShapeType::CollisionShapeType_Cone:
-					break;
-				case CollisionShapeType::CollisionShapeType_ConvexHull:
-					break;
-				case CollisionShapeType::CollisionShapeType_Cylinder:
-					m_collisionShape.m_cylinderShape = new btCylinderShape(Math::toBtVector3(oldCollisionShapeSize));
-					m_rigidBody->setCollisionShape(m_collisionShape.m_cylinderShape);
-					break;
-				case CollisionShapeType::CollisionShapeType_Sphere:
-					m_collisionShape.m_sphereShape = new btSphereShape(oldCollisionShapeSize.x);
-					m_rigidBody->setCollisionShape(m_collisionShape.m_sphereShape);
-					break;
-			}
-
-			// Reload physics scene pairs
-			static_cast<PhysicsScene *>(m_systemScene)->cleanProxyFromPairs(*m_rigidBody);
+			// Keep the current collision shape size for the new shape
+			replaceCollisionShape(static_cast<CollisionShapeType>(collisionShapeTypeNumber), getCollisionShapeSize());
 		}
 	}
 
@@ -163,7 +116,15 @@ void RigidBodyComponent::changeOccurred(ObservedSubject *p_subject, BitMask p_ch
 
 	if(CheckBitmask(p_changeType, Systems::Changes::Physics::Mass))
 	{
-		const auto mass = p_subject->getFloat(this, Systems::Changes::Physics::Mass);
+		auto mass = p_subject->getFloat(this, Systems::Changes::Physics::Mass);
+
+		// Triangle mesh shapes can only be used by static objects, so they must have a mass of zero
+		if(mass != 0.0f && m_collisionShapeType == CollisionShapeType::CollisionShapeType_TriangleMesh)
+		{
+			mass = 0.0f;
+			ErrHandlerLoc().get().log(ErrorCode::Collision_mesh_has_mass, getName(), ErrorSource::Source_RigidBodyComponent);
+		}
+
 		getCollisionShape()->calculateLocalInertia(mass, m_constructionInfo->m_localInertia);
 		m_rigidBody->setMassProps(mass, m_constructionInfo->m_localInertia);
 	}
@@ -225,3 +186,41 @@ void RigidBodyComponent::changeOccurred(ObservedSubject *p_subject, BitMask p_ch
 
 	postChanges(newChanges);
 }
+
+void RigidBodyComponent::replaceCollisionShape(const CollisionShapeType p_collisionShapeType, const glm::vec3 &p_collisionShapeSize)
+{
+	auto &collisionShapeCache = static_cast<PhysicsScene *>(m_systemScene)->getCollisionShapeCache();
+
+	// Acquire the new shape first, so the current shape is kept if the new one could not be created
+	auto *newCollisionShape = collisionShapeCache.acquireShape(p_collisionShapeType, p_collisionShapeSize, m_collisionMeshFilename);
+	if(newCollisionShape != nullptr)
+	{
+		collisionShapeCache.releaseShape(getCollisionShape());
+
+		setCollisionShape(p_collisionShapeType, newCollisionShape);
+		m_rigidBody->setCollisionShape(newCollisionShape);
+
+		// Local inertia depends on the collision shape, so the mass properties of dynamic objects must be recalculated (static and kinematic objects have no mass)
+		if(const auto mass = m_rigidBody->getMass(); mass != 0.0f)
+		{
+			if(p_collisionShapeType == CollisionShapeType::CollisionShapeType_TriangleMesh)
+			{
+				// Triangle mesh shapes can only be used by static objects, so they must have a mass of zero
+				m_constructionInfo->m_localInertia = btVector3(0.0f, 0.0f, 0.0f);
+				m_rigidBody->setMassProps(0.0f, m_constructionInfo->m_localInertia);
+				m_rigidBody->setLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
+				m_rigidBody->setAngularVelocity(btVector3(0.0f, 0.0f, 0.0f));
+				ErrHandlerLoc().get().log(ErrorCode::Collision_mesh_has_mass, getName(), ErrorSource::Source_RigidBodyComponent);
+			}
+			else
+			{
+				newCollisionShape->calculateLocalInertia(mass, m_constructionInfo->m_localInertia);
+				m_rigidBody->setMassProps(mass, m_constructionInfo->m_localInertia);
+			}
+			m_rigidBody->updateInertiaTensor();
+		}
+
+		// Reload physics scene pairs
+		static_cast<PhysicsScene *>(m_systemScene)->cleanProxyFromPairs(*m_rigidBody);
+	}
+}
@@ -16,6 +16,7 @@ public:
 		CollisionShapeType_ConvexHull,
 		CollisionShapeType_Cylinder,
 		CollisionShapeType_Sphere,
+		CollisionShapeType_TriangleMesh,
 		CollisionShapeType_NumOfTypes
 	};
 
@@ -42,6 +43,9 @@ public:
 		CollisionShapeType m_collisionShapeType;
 		glm::vec3 m_collisionShapeSize;
 		glm::vec3 m_linearVelocity;
+
+		// Model filename of mesh collision shapes (convex hull and triangle mesh)
+		std::string m_collisionMeshFilename;
 	};
 
 	RigidBodyComponent(SystemScene *p_systemScene, std::string p_name, const EntityID p_entityID, std::size_t p_id = 0) : SystemObject(p_systemScene, p_name, Properties::PropertyID::RigidBodyComponent, p_entityID)
@@ -254,6 +258,9 @@ public:
 			case CollisionShapeType::CollisionShapeType_Sphere:
 				collisionShape = m_collisionShape.m_sphereShape;
 				break;
+			case CollisionShapeType::CollisionShapeType_TriangleMesh:
+				collisionShape = m_collisionShape.m_triangleMeshShape;
+				break;
 		}
 
 		return collisionShape;
@@ -264,6 +271,8 @@ public:
 	inline btConvexHullShape *getCollisionShapeConvexHull() { return m_collisionShapeType == CollisionShapeType::CollisionShapeType_ConvexHull ? m_collisionShape.m_convexHullShape : nullptr; }
 	inline btCylinderShape *getCollisionShapeCylinder()     { return m_collisionShapeType == CollisionShapeType::CollisionShapeType_Cylinder   ? m_collisionShape.m_cylinderShape   : nullptr; }
 	inline btSphereShape *getCollisionShapeSphere()         { return m_collisionShapeType == CollisionShapeType::CollisionShapeType_Sphere     ? m_collisionShape.m_sphereShape     : nullptr; }
+	inline btBvhTriangleMeshShape *getCollisionShapeTriangleMesh() { return m_collisionShapeType == CollisionShapeType::CollisionShapeType_TriangleMesh ? m_collisionShape.m_triangleMeshShape : nullptr; }
+	inline const std::string &getCollisionMeshFilename() const { return m_collisionMeshFilename; }
 	inline const std::vector<const char *> &getCollisionTypeText() const { return m_collisionShapeTypeText; }
 	inline const btRigidBody *getRigidBody() const { return m_rigidBody; }
 	inline const glm::vec3 getCollisionShapeSize() const
@@ -288,6 +297,9 @@ public:
 			case CollisionShapeType::CollisionShapeType_Sphere:
 				return glm::vec3(m_collisionShape.m_sphereShape->getRadius());
 				break;
+			case CollisionShapeType::CollisionShapeType_TriangleMesh:
+				return Math::toGlmVec3(m_collisionShape.m_triangleMeshShape->getLocalScaling());
+				break;
 		}
 
 		return glm::vec3(0.5f);
@@ -300,6 +312,43 @@ public:
 	const glm::vec3 &getVec3(const Observer *p_observer, BitMask p_changedBits)								const override { return m_motionState.getPosition(); }
 
 private:
+	// Assigns a collision shape of the given type (shapes are shared and owned by the physics scene collision shape cache)
+	inline void setCollisionShape(const CollisionShapeType p_collisionShapeType, btCollisionShape *p_collisionShape)
+	{
+		m_collisionShapeType = p_collisionShapeType;
+
+		switch(m_collisionShapeType)
+		{
+			case CollisionShapeType::CollisionShapeType_Box:
+				m_collisionShape.m_boxShape = static_cast<btBoxShape *>(p_collisionShape);
+				break;
+			case CollisionShapeType::CollisionShapeType_Capsule:
+				m_collisionShape.m_capsuleShape = static_cast<btCapsuleShape *>(p_collisionShape);
+				break;
+			case CollisionShapeType::CollisionShapeType_Cone:
+				m_collisionShape.m_coneShape = static_cast<btConeShape *>(p_collisionShape);
+				break;
+			case CollisionShapeType::CollisionShapeType_ConvexHull:
+				m_collisionShape.m_convexHullShape = static_cast<btConvexHullShape *>(p_collisionShape);
+				break;
+			case CollisionShapeType::CollisionShapeType_Cylinder:
+				m_collisionShape.m_cylinderShape = static_cast<btCylinderShape *>(p_collisionShape);
+				break;
+			case CollisionShapeType::CollisionShapeType_Sphere:
+				m_collisionShape.m_sphereShape = static_cast<btSphereShape *>(p_collisionShape);
+				break;
+			case CollisionShapeType::CollisionShapeType_TriangleMesh:
+				m_collisionShape.m_triangleMeshShape = static_cast<btBvhTriangleMeshShape *>(p_collisionShape);
+				break;
+			default:
+				m_collisionShape.m_boxShape = nullptr;
+				break;
+		}
+	}
+
+	// Switches the rigid body to a collision shape of the given type and size, acquired from the collision shape cache; keeps the current shape on failure
+	void replaceCollisionShape(const CollisionShapeType p_collisionShapeType, const glm::vec3 &p_collisionShapeSize);
+
 	union
 	{
 		btBoxShape *m_boxShape;
@@ -308,11 +357,13 @@ private:
 		btConvexHullShape *m_convexHullShape;
 		btCylinderShape *m_cylinderShape;
 		btSphereShape *m_sphereShape;
+		btBvhTriangleMeshShape *m_triangleMeshShape;
 	} m_collisionShape;
 
 	CollisionShapeType m_collisionShapeType;
+	std::string m_collisionMeshFilename;
 
-	std::vector<const char *> m_collisionShapeTypeText { "null", "Box", "Capsule", "Cone", "Convex hull", "Cylinder", "Sphere" };
+	std::vector<const char *> m_collisionShapeTypeText { "null", "Box", "Capsule", "Cone", "Convex hull", "Cylinder", "Sphere", "Triangle mesh" };
 
 	btRigidBody *m_rigidBody; 
 	
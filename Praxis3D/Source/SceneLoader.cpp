@@ -9,12 +9,13 @@
 #include "SceneLoader.h"
 #include "Version.h"
 
-SceneLoader::SceneLoader(const EngineStateType p_engineStateType) : m_engineStateType(p_engineStateType)
+SceneLoader::SceneLoader(const EngineStateType p_engineStateType) : m_worldStreamer(*this), m_engineStateType(p_engineStateType)
 {
 	m_changeController = nullptr;
 	m_loadInBackground = false;
 	m_loadingStatus = true;
 	m_firstLoad = true;
+	m_saveRequested = false;
 
 	for(int i = 0; i < Systems::NumberOfSystems; i++)
 		m_systemScenes[i] = g_nullSystemBase.createScene(this, EngineStateType::EngineStateType_Default);
@@ -70,6 +71,9 @@ ErrorCode SceneLoader::loadFromProperties(const PropertySet &p_sceneProperties)
 		m_systemScenes[sysIndex]->setup(scenePropertySet);
 	}
 
+	// Get world streaming cells; their entities are loaded around the camera once the scene is running
+	m_worldStreamer.setup(p_sceneProperties.getPropertySetByID(Properties::WorldStreaming));
+
 	// Get Game Objects
 	auto &gameObjects = p_sceneProperties.getPropertySetByID(Properties::GameObject);
 	if(gameObjects)
@@ -149,6 +153,30 @@ ErrorCode SceneLoader::loadFromFile(const std::string &p_filename)
 	return returnError;
 }
 
+void SceneLoader::requestSaveToFile(const std::string &p_filename)
+{
+	SpinWait::Lock lock(m_saveRequestMutex);
+
+	m_saveRequestFilename = p_filename;
+	m_saveRequested = true;
+}
+
+void SceneLoader::processSaveRequest()
+{
+	std::string filename;
+	{
+		SpinWait::Lock lock(m_saveRequestMutex);
+
+		if(!m_saveRequested)
+			return;
+
+		filename = m_saveRequestFilename;
+		m_saveRequested = false;
+	}
+
+	saveToFile(filename);
+}
+
 ErrorCode SceneLoader::saveToFile(const std::string p_filename)
 {
 	if(!p_filename.empty())
@@ -179,6 +207,9 @@ ErrorCode SceneLoader::saveToFile(const std::string p_filename)
 		// Add root property set game objects
 		auto &gameObjects = rootPropertySet.addPropertySet(Properties::GameObject);
 
+		// Make sure every entity of the streamed cells that are going to be written is present in the entity registry
+		m_worldStreamer.prepareForExport();
+
 		// An array holding all of the entities
 		std::vector<EntityID> allEntities;
 
@@ -189,18 +220,26 @@ ErrorCode SceneLoader::saveToFile(const std::string p_filename)
 		// Sort the entities so they are written to file in order
 		std::sort(allEntities.begin(), allEntities.end());
 
-		// Iterate every entity
-		for(auto &entity : allEntities)
+		if(m_worldStreamer.isEnabled())
 		{
-			// Create an array entry for the entity
-			auto &gameObjectEntry = gameObjects.addPropertySet(Properties::ArrayEntry);
+			// Export resident entities to the scene file and streamed entities to the cell files
+			m_worldStreamer.exportEntities(allEntities, gameObjects, rootPropertySet, m_filename);
+		}
+		else
+		{
+			// Iterate every entity
+			for(auto &entity : allEntities)
+			{
+				// Create an array entry for the entity
+				auto &gameObjectEntry = gameObjects.addPropertySet(Properties::ArrayEntry);
 
-			// Export the entity to the Construction Info
-			ComponentsConstructionInfo constructionInfo;
-			worldScene->exportEntity(entity, constructionInfo);
+				// Export the entity to the Construction Info
+				ComponentsConstructionInfo constructionInfo;
+				worldScene->exportEntity(entity, constructionInfo);
 
-			// Export the Construction Info to the Property Set
-			exportToProperties(constructionInfo, gameObjectEntry);
+				// Export the Construction Info to the Property Set
+				exportToProperties(constructionInfo, gameObjectEntry);
+			}
 		}
 
 		// Add root property set for systems
@@ -263,58 +302,81 @@ ErrorCode SceneLoader::importPrefab(ComponentsConstructionInfo &p_constructionIn
 	// Check if the given filename isn't empty
 	if(!p_filename.empty())
 	{
-		//m_mtx.lock();
 		// Make sure calls from other threads are locked, while current call is in progress
 		// This is needed as the prefab that is being requested might be currently being imported
 		// Mutex prevents duplicate prefabs being loaded, and same data being changed.
 		SpinWait::Lock lock(m_mutex);
 
-		// Search for the given prefab (it might have been loaded before, already)
-		auto prefabIterator = m_prefabs.find(p_filename);
+		const ComponentsConstructionInfo *prefabTemplate = nullptr;
+		returnError = compilePrefab(p_filename, &prefabTemplate, p_forceReload);
 
-		// If the prefab was already imported and exists in the map, use it
-		if(prefabIterator != m_prefabs.end())
-		{
-			if(p_forceReload)
-				returnError = importFromFile(p_constructionInfo, Config::filepathVar().prefab_path + p_filename);
-			else
-				p_constructionInfo.completeCopy(prefabIterator->second);
-		}
-		else // If the prefab doesn't exist in the map, import it
-		{
+		if(returnError == ErrorCode::Success)
+			p_constructionInfo.completeCopy(*prefabTemplate);
+	}
+	else
+		returnError = ErrorCode::Filename_empty;
 
-			// Search for the prefab again, as it might have been imported from another thread call before mutex lock was released
-			auto prefabIteratorNew = m_prefabs.find(p_filename);
-			if(prefabIteratorNew != m_prefabs.end())
-			{
-				if(p_forceReload)
-					returnError = importFromFile(p_constructionInfo, Config::filepathVar().prefab_path + p_filename);
-				else
-					p_constructionInfo.completeCopy(prefabIterator->second);
-			}
-			else
-			{
-				// Load properties from file
-				PropertyLoader loadedProperties(Config::filepathVar().prefab_path + p_filename);
-				returnError = loadedProperties.loadFromFile();
+	return returnError;
+}
 
-				if(returnError == ErrorCode::Success)
-				{
-					// Insert a new prefab into the map
-					ComponentsConstructionInfo &constructionInfo = m_prefabs.try_emplace(p_filename).first->second;
+ErrorCode SceneLoader::getPrefabTemplate(const std::string &p_filename, const ComponentsConstructionInfo **p_prefabTemplate)
+{
+	if(p_filename.empty())
+		return ErrorCode::Filename_empty;
 
-					// Populate the newly imported prefab
-					importFromProperties(constructionInfo, loadedProperties.getPropertySet());
+	SpinWait::Lock lock(m_mutex);
 
-					p_constructionInfo.completeCopy(constructionInfo);
-				}
+	return compilePrefab(p_filename, p_prefabTemplate);
+}
+
+ErrorCode SceneLoader::spawnPrefab(const std::string &p_filename, const std::span<const PrefabSpawnTransform> p_transforms, std::vector<EntityID> *p_spawnedEntities)
+{
+	// Get the compiled prefab, only locking the mutex once for the whole batch
+	const ComponentsConstructionInfo *prefabTemplate = nullptr;
+	ErrorCode returnError = getPrefabTemplate(p_filename, &prefabTemplate);
+
+	if(returnError == ErrorCode::Success)
+		static_cast<WorldScene *>(m_systemScenes[Systems::World])->createEntities(*prefabTemplate, p_transforms, p_spawnedEntities);
+	else
+		ErrHandlerLoc::get().log(returnError, ErrorSource::Source_SceneLoader, "Prefab \"" + p_filename + "\" could not be spawned");
+
+	return returnError;
+}
+
+ErrorCode SceneLoader::compilePrefab(const std::string &p_filename, const ComponentsConstructionInfo **p_prefabTemplate, const bool p_forceReload)
+{
+	ErrorCode returnError = ErrorCode::Success;
+
+	// Search for the given prefab (it might have been imported before, already)
+	auto prefabIterator = m_prefabs.find(p_filename);
+
+	// Import the prefab from file if it hasn't been imported yet, or if a reload is requested
+	if(prefabIterator == m_prefabs.end() || p_forceReload)
+	{
+		// Load properties from file
+		PropertyLoader loadedProperties(Config::filepathVar().prefab_path + p_filename);
+		returnError = loadedProperties.loadFromFile();
+
+		if(returnError == ErrorCode::Success)
+		{
+			// Populate the newly imported prefab
+			auto prefab = std::make_unique<ComponentsConstructionInfo>();
+			importFromProperties(*prefab, loadedProperties.getPropertySet());
+			prefab->m_prefab = p_filename;
+
+			if(prefabIterator == m_prefabs.end())
+				prefabIterator = m_prefabs.try_emplace(p_filename, std::move(prefab)).first;
+			else
+			{
+				// Keep the previous compiled prefab alive, as pointers to it might still be held; later imports use the reloaded one
+				m_replacedPrefabs.push_back(std::move(prefabIterator->second));
+				prefabIterator->second = std::move(prefab);
 			}
 		}
-
-		//m_mtx.unlock();
 	}
-	else
-		returnError = ErrorCode::Filename_empty;
+
+	if(returnError == ErrorCode::Success)
+		*p_prefabTemplate = prefabIterator->second.get();
 
 	return returnError;
 }
@@ -669,6 +731,8 @@ void SceneLoader::importFromProperties(GraphicsComponentsConstructionInfo &p_con
 
 				p_constructionInfo.m_modelConstructionInfo->m_name = p_name + Config::componentVar().component_name_separator + GetString(Properties::PropertyID::ModelComponent);
 				p_properties.getValueByID(Properties::Active, p_constructionInfo.m_modelConstructionInfo->m_active);
+				p_properties.getValueByID(Properties::Static, p_constructionInfo.m_modelConstructionInfo->m_staticShadowCaster);
+				p_properties.getValueByID(Properties::Occluder, p_constructionInfo.m_modelConstructionInfo->m_occluder);
 
 				bool modelDataPresent = false;
 
@@ -959,6 +1023,22 @@ void SceneLoader::importFromProperties(PhysicsComponentsConstructionInfo &p_cons
 							}
 							break;
 
+						case Properties::ConvexHull:
+						case Properties::TriangleMesh:
+							{
+								// Mesh collision shapes are created from the given model
+								auto const &filenameProperty = collisionShapeProperty.getPropertyByID(Properties::Filename);
+
+								if(filenameProperty)
+									p_constructionInfo.m_rigidBodyConstructionInfo->m_collisionMeshFilename = filenameProperty.getString();
+								else
+									ErrHandlerLoc().get().log(ErrorCode::Property_no_filename, p_name, ErrorSource::Source_RigidBodyComponent);
+
+								p_constructionInfo.m_rigidBodyConstructionInfo->m_collisionShapeType = typeProperty.getID() == Properties::ConvexHull ?
+									RigidBodyComponent::CollisionShapeType::CollisionShapeType_ConvexHull : RigidBodyComponent::CollisionShapeType::CollisionShapeType_TriangleMesh;
+							}
+							break;
+
 						case Properties::Cylinder:
 							{
 								// Get the size property
@@ -1345,6 +1425,14 @@ void SceneLoader::exportToProperties(const GraphicsComponentsConstructionInfo &p
 			// Add active flag
 			componentPropertySet.addProperty(Properties::PropertyID::Active, p_constructionInfo.m_modelConstructionInfo->m_active);
 
+			// Add static shadow caster flag
+			if(p_constructionInfo.m_modelConstructionInfo->m_staticShadowCaster)
+				componentPropertySet.addProperty(Properties::PropertyID::Static, true);
+
+			// Add occluder flag
+			if(p_constructionInfo.m_modelConstructionInfo->m_occluder)
+				componentPropertySet.addProperty(Properties::PropertyID::Occluder, true);
+
 			// Create Models entry
 			auto &modelsPropertySet = componentPropertySet.addPropertySet(Properties::PropertyID::Models);
 
@@ -1533,6 +1621,9 @@ void SceneLoader::exportToProperties(const PhysicsComponentsConstructionInfo &p_
 				case RigidBodyComponent::CollisionShapeType_Sphere:
 					collisionShapeType = Properties::Sphere;
 					break;
+				case RigidBodyComponent::CollisionShapeType_TriangleMesh:
+					collisionShapeType = Properties::TriangleMesh;
+					break;
 			}
 
 			// Add collision shape data, if it's valid
@@ -1541,6 +1632,9 @@ void SceneLoader::exportToProperties(const PhysicsComponentsConstructionInfo &p_
 				auto &collisionShapePropertySet = componentPropertySet.addPropertySet(Properties::PropertyID::CollisionShape);
 				collisionShapePropertySet.addProperty(Properties::PropertyID::Type, collisionShapeType);
 				collisionShapePropertySet.addProperty(Properties::PropertyID::Size, p_constructionInfo.m_rigidBodyConstructionInfo->m_collisionShapeSize);
+
+				if(!p_constructionInfo.m_rigidBodyConstructionInfo->m_collisionMeshFilename.empty())
+					collisionShapePropertySet.addProperty(Properties::PropertyID::Filename, p_constructionInfo.m_rigidBodyConstructionInfo->m_collisionMeshFilename);
 			}
 		}
 	}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include <mutex>          // std::mutex
+#include <span>
 
 #include "ErrorHandlerLocator.h"
 #include "NullSystemObjects.h"
 #include "PropertySet.h"
 #include "Universal.h"
+#include "WorldStreamer.h"
 
 struct ComponentsConstructionInfo;
 struct AudioComponentsConstructionInfo;
@@ -14,11 +17,13 @@ struct GUIComponentsConstructionInfo;
 struct PhysicsComponentsConstructionInfo;
 struct ScriptComponentsConstructionInfo;
 struct WorldComponentsConstructionInfo;
+struct PrefabSpawnTransform;
 
 // Loads and links various objects by requesting them from registered scenes.
 // Uses property sets to send data to scenes (about specific objects).
 class SceneLoader
 {
+	friend class WorldStreamer;
 public:
 	SceneLoader(const EngineStateType p_engineStateType);
 	~SceneLoader();
@@ -45,17 +50,35 @@ public:
 	// Load a scene from file, pass it along to every system scene and create every entity
 	ErrorCode loadFromFile(const std::string &p_filename);
 
-	// Export the entire entity registry and system scene settings to file
+	// Export the entire entity registry and system scene settings to file; must only be called in the serial phase of a frame,
+	// as exporting streamed world cells creates their entities. Use requestSaveToFile from system updates instead
 	ErrorCode saveToFile(const std::string p_filename = "");
 
+	// Queue the scene to be exported to file in the serial phase of the frame (by processSaveRequest). Can be called from multiple threads
+	void requestSaveToFile(const std::string &p_filename = "");
+
+	// Export the scene to file, if it was requested during the frame; must only be called in the serial phase of a frame, after the changes have been distributed
+	void processSaveRequest();
+
+	// Stream world cells in and out around the active camera; must only be called in the serial phase of a frame
+	inline void updateWorldStreaming() { m_worldStreamer.update(); }
+
 	// Load a single prefab from file
 	ErrorCode importPrefab(ComponentsConstructionInfo &p_constructionInfo, const std::string &p_filename, const bool p_forceReload = false);
 
+	// Get the compiled (imported once and never modified afterwards) construction info of a prefab, importing it if it hasn't been imported yet.
+	// The returned construction info is owned by the scene loader, must not be modified and stays valid for the lifetime of the scene loader
+	ErrorCode getPrefabTemplate(const std::string &p_filename, const ComponentsConstructionInfo **p_prefabTemplate);
+
+	// Create an entity of the given prefab for every given transform, in a single batch, without copying the prefab construction info per instance.
+	// Created entity IDs are appended to the given array, if it is provided
+	ErrorCode spawnPrefab(const std::string &p_filename, const std::span<const PrefabSpawnTransform> p_transforms, std::vector<EntityID> *p_spawnedEntities = nullptr);
+
 	// Export component as a prefab
 	ErrorCode exportPrefab(const EntityID p_entityID, const std::string &p_filename);
 
 	// Returns all prefabs that have been loaded during scene loading
-	const std::map<std::string, ComponentsConstructionInfo> &getPrefabs() { return m_prefabs; }
+	const std::map<std::string, std::unique_ptr<ComponentsConstructionInfo>> &getPrefabs() { return m_prefabs; }
 
 	// Returns the last loaded scene filename
 	const std::string &getSceneFilename() const { return m_filename; }
@@ -87,6 +110,9 @@ public:
 private:
 	ErrorCode importFromFile(ComponentsConstructionInfo &p_constructionInfo, const std::string &p_filename);
 	void importFromProperties(ComponentsConstructionInfo &p_constructionInfo, const PropertySet &p_properties);
+
+	// Find the prefab in the imported prefab map, or import it from file and insert it into the map (replacing the imported one, if a reload is forced). Mutex must be locked by the caller
+	ErrorCode compilePrefab(const std::string &p_filename, const ComponentsConstructionInfo **p_prefabTemplate, const bool p_forceReload = false);
 	void importFromProperties(AudioComponentsConstructionInfo &p_constructionInfo, const PropertySet &p_properties, const std::string &p_name);
 	void importFromProperties(GraphicsComponentsConstructionInfo &p_constructionInfo, const PropertySet &p_properties, const std::string &p_name);
 	void importFromProperties(GUIComponentsConstructionInfo &p_constructionInfo, const PropertySet &p_properties, const std::string &p_name);
@@ -106,12 +132,23 @@ private:
 	SpinWait m_mutex;
 	std::mutex m_mtx;
 
-	// Contains all the prefabs that have already been imported before. Saves the time of importing them again, upon requesting
-	std::map<std::string, ComponentsConstructionInfo> m_prefabs;
+	// Contains all the prefabs that have already been imported before. Saves the time of importing them again, upon requesting.
+	// Compiled prefabs are never modified or deleted, so pointers to them can be held without the mutex being locked;
+	// a force-reloaded prefab replaces the map entry, and the previous compiled prefab is moved to the replaced prefabs array
+	std::map<std::string, std::unique_ptr<ComponentsConstructionInfo>> m_prefabs;
+	std::vector<std::unique_ptr<ComponentsConstructionInfo>> m_replacedPrefabs;
 
 	// All of the engine's system scenes
 	SystemScene *m_systemScenes[Systems::NumberOfSystems];
 
+	// Loads and unloads the entities of world cells around the active camera
+	WorldStreamer m_worldStreamer;
+
+	// Scene export requested during the parallel update of the systems, to be done in the serial phase of the frame
+	SpinWait m_saveRequestMutex;
+	std::string m_saveRequestFilename;
+	bool m_saveRequested;
+
 	// Change controller, used for storing and distributing messages between subjects and observers
 	UniversalScene *m_changeController;
 
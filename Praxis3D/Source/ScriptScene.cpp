@@ -3,6 +3,7 @@
 
 #include "ComponentConstructorInfo.h"
 #include "NullSystemObjects.h"
+#include "Profiler.h"
 #include "ScriptSystem.h"
 #include "ScriptScene.h"
 #include "TaskManagerLocator.h"
@@ -53,6 +54,8 @@ void ScriptScene::exportSetup(PropertySet &p_propertySet)
 
 void ScriptScene::update(const float p_deltaTime)
 {
+	PROFILE_ZONE("ScriptScene::update");
+
 	// Get the world scene required for getting components
 	WorldScene *worldScene = static_cast<WorldScene*>(m_sceneLoader->getSystemScene(Systems::World));
 
@@ -129,9 +132,9 @@ ErrorCode ScriptScene::preload()
 	return ErrorCode::Success;
 }
 
-std::vector<SystemObject *> ScriptScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> ScriptScene::getComponents(const EntityID p_entityID)
 {
-	std::vector<SystemObject *> returnVector;
+	FrameVector<SystemObject *> returnVector;
 
 	// Get the entity registry 
 	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
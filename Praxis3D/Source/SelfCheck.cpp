@@ -0,0 +1,310 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+#include "EngineDefinitions.h"
+#include "ErrorHandlerLocator.h"
+#include "OcclusionCuller.h"
+#include "RenderGraph.h"
+#include "SelfCheck.h"
+#include "SpatialTransformBatch.h"
+#include "Utilities.h"
+
+SelfCheck::SelfCheck()
+{
+	m_numOfChecks = 0;
+	m_numOfFailedChecks = 0;
+}
+
+SelfCheck::~SelfCheck()
+{
+}
+
+ErrorCode SelfCheck::run()
+{
+	m_numOfChecks = 0;
+	m_numOfFailedChecks = 0;
+
+	checkOcclusionCuller();
+	checkSpatialTransformBatch();
+	checkRenderGraph();
+
+	if(m_numOfFailedChecks > 0)
+	{
+		ErrHandlerLoc::get().log(ErrorType::Error, ErrorSource::Source_Engine, "Self-check failed: " + Utilities::toString((int)m_numOfFailedChecks) + " of " + Utilities::toString((int)m_numOfChecks) + " checks");
+		return ErrorCode::Failure;
+	}
+
+	ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Engine, "Self-check passed: " + Utilities::toString((int)m_numOfChecks) + " checks");
+	return ErrorCode::Success;
+}
+
+void SelfCheck::check(const bool p_condition, const std::string &p_description)
+{
+	m_numOfChecks++;
+
+	if(!p_condition)
+	{
+		m_numOfFailedChecks++;
+		ErrHandlerLoc::get().log(ErrorType::Error, ErrorSource::Source_Engine, "Self-check: " + p_description);
+	}
+}
+
+void SelfCheck::checkOcclusionCuller()
+{
+	// Camera at the origin, looking down the negative Z axis
+	const glm::mat4 viewProjMatrix = glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+
+	// Quads facing the camera, 10 units in front of it; the first one covers the whole screen, and the second one only its left half
+	const glm::vec3 fullScreenQuad[] = { glm::vec3(-100.0f, -100.0f, -10.0f), glm::vec3(100.0f, -100.0f, -10.0f), glm::vec3(100.0f, 100.0f, -10.0f), glm::vec3(-100.0f, 100.0f, -10.0f) };
+	const glm::vec3 halfScreenQuad[] = { glm::vec3(-100.0f, -100.0f, -10.0f), glm::vec3(0.0f, -100.0f, -10.0f), glm::vec3(0.0f, 100.0f, -10.0f), glm::vec3(-100.0f, 100.0f, -10.0f) };
+	const unsigned int quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+	OcclusionCuller occlusionCuller;
+	occlusionCuller.setBufferSize(256, 128);
+
+	occlusionCuller.beginFrame(viewProjMatrix);
+	occlusionCuller.addOccluder(fullScreenQuad, quadIndices, 6, glm::mat4(1.0f));
+	occlusionCuller.rasterize(false);
+
+	bool allPixelsCovered = true;
+	for(unsigned int y = 0; y < occlusionCuller.getBufferHeight(); y++)
+		for(unsigned int x = 0; x < occlusionCuller.getBufferWidth(); x++)
+			allPixelsCovered = allPixelsCovered && occlusionCuller.getDepth(0, x, y) < 1.0f;
+
+	check(allPixelsCovered, "OcclusionCuller: a full-screen occluder does not cover every pixel of the depth buffer");
+	check(occlusionCuller.isBoundingBoxOccluded(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -19.0f)), "OcclusionCuller: a box behind a full-screen occluder is not occluded");
+	check(!occlusionCuller.isBoundingBoxOccluded(glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -4.0f)), "OcclusionCuller: a box in front of a full-screen occluder is occluded");
+	check(!occlusionCuller.isBoundingBoxOccluded(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)), "OcclusionCuller: a box intersecting a full-screen occluder is occluded");
+
+	occlusionCuller.beginFrame(viewProjMatrix);
+	occlusionCuller.addOccluder(halfScreenQuad, quadIndices, 6, glm::mat4(1.0f));
+	occlusionCuller.rasterize(false);
+
+	check(occlusionCuller.isBoundingBoxOccluded(glm::vec3(-4.0f, -1.0f, -21.0f), glm::vec3(-2.0f, 1.0f, -19.0f)), "OcclusionCuller: a box behind a half-screen occluder is not occluded");
+	check(!occlusionCuller.isBoundingBoxOccluded(glm::vec3(2.0f, -1.0f, -21.0f), glm::vec3(4.0f, 1.0f, -19.0f)), "OcclusionCuller: a box beside a half-screen occluder is occluded");
+
+#if SETTING_OCCLUSION_CULLING_SIMD >= 1
+	// Small random triangles of both windings, some of them crossing the screen edges and the near plane
+	std::mt19937 randomGenerator(0);
+	std::uniform_real_distribution<float> horizontalDistribution(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> depthDistribution(-60.0f, 1.0f);
+	std::uniform_real_distribution<float> vertexOffsetDistribution(-3.0f, 3.0f);
+
+	std::vector<glm::vec3> positions(3 * 256);
+	std::vector<unsigned int> indices(positions.size());
+	for(std::size_t i = 0, size = positions.size(); i < size; i += 3)
+	{
+		const glm::vec3 center(horizontalDistribution(randomGenerator), horizontalDistribution(randomGenerator), depthDistribution(randomGenerator));
+
+		for(std::size_t v = i; v < i + 3; v++)
+		{
+			positions[v] = center + glm::vec3(vertexOffsetDistribution(randomGenerator), vertexOffsetDistribution(randomGenerator), vertexOffsetDistribution(randomGenerator));
+			indices[v] = (unsigned int)v;
+		}
+	}
+
+	std::vector<float> depthBuffers[2];
+	for(unsigned int simdEnabled = 0; simdEnabled < 2; simdEnabled++)
+	{
+		occlusionCuller.setSIMDEnabled(simdEnabled == 1);
+		occlusionCuller.beginFrame(viewProjMatrix);
+		occlusionCuller.addOccluder(positions.data(), indices.data(), (unsigned int)indices.size(), glm::mat4(1.0f));
+		occlusionCuller.rasterize(false);
+
+		for(unsigned int y = 0; y < occlusionCuller.getBufferHeight(); y++)
+			for(unsigned int x = 0; x < occlusionCuller.getBufferWidth(); x++)
+				depthBuffers[simdEnabled].push_back(occlusionCuller.getDepth(0, x, y));
+	}
+	occlusionCuller.setSIMDEnabled(true);
+
+	check(depthBuffers[0] == depthBuffers[1], "OcclusionCuller: the SSE and scalar rasterization produce different depth buffers");
+#endif
+}
+
+void SelfCheck::checkSpatialTransformBatch()
+{
+	// Matrices are equal if every element is within an epsilon, relative to the magnitude of the elements
+	const auto matricesEqual = [](const glm::mat4 &p_left, const glm::mat4 &p_right) -> bool
+	{
+		for(glm::length_t column = 0; column < 4; column++)
+			for(glm::length_t row = 0; row < 4; row++)
+				if(std::abs(p_left[column][row] - p_right[column][row]) > 1e-4f * std::max(1.0f, std::max(std::abs(p_left[column][row]), std::abs(p_right[column][row]))))
+					return false;
+
+		return true;
+	};
+
+	std::mt19937 randomGenerator(0);
+	std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> rotationDistribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> scaleDistribution(0.1f, 4.0f);
+
+	const auto randomVector = [&](std::uniform_real_distribution<float> &p_distribution) { return glm::vec3(p_distribution(randomGenerator), p_distribution(randomGenerator), p_distribution(randomGenerator)); };
+	const auto randomRotation = [&]() { return glm::normalize(glm::quat(rotationDistribution(randomGenerator), rotationDistribution(randomGenerator), rotationDistribution(randomGenerator), rotationDistribution(randomGenerator))); };
+
+	// Sizes with and without a remainder after the groups of 8 (AVX2) and 4 (SSE) entries
+	const std::size_t batchSizes[] = { 1, 3, 4, 5, 8, 11, 16, 37 };
+
+	SpatialTransformBatch batch;
+	std::vector<glm::mat4> parentTransforms;
+	std::vector<glm::vec3> positions;
+	std::vector<glm::quat> rotations;
+	std::vector<glm::vec3> scales;
+	std::vector<int> parentIndices;
+	std::vector<glm::mat4> simdTransforms;
+
+	for(const std::size_t batchSize : batchSizes)
+	{
+		batch.clear();
+		parentTransforms.clear();
+		positions.clear();
+		rotations.clear();
+		scales.clear();
+		parentIndices.clear();
+
+		// Parent transforms with a non-uniform scale
+		for(unsigned int i = 0; i < 3; i++)
+		{
+			parentTransforms.push_back(Math::createTransformMat(randomVector(positionDistribution), randomRotation(), randomVector(scaleDistribution)));
+			batch.addParentTransform(parentTransforms.back());
+		}
+
+		// Every fourth entry has no parent
+		for(std::size_t i = 0; i < batchSize; i++)
+		{
+			positions.push_back(randomVector(positionDistribution));
+			rotations.push_back(randomRotation());
+			scales.push_back(randomVector(scaleDistribution));
+			parentIndices.push_back(i % 4 == 0 ? -1 : (int)(i % parentTransforms.size()));
+
+			batch.addEntry(positions.back(), rotations.back(), scales.back(), parentIndices.back());
+		}
+
+		batch.computeTransforms();
+
+		simdTransforms.clear();
+		for(std::size_t i = 0; i < batchSize; i++)
+		{
+			simdTransforms.push_back(batch.getLocalTransform(i));
+			simdTransforms.push_back(batch.getWorldTransformNoScale(i));
+			simdTransforms.push_back(batch.getWorldTransformWithScale(i));
+		}
+
+		batch.computeTransformsScalar();
+
+		bool simdMatchesScalar = true;
+		bool scalarMatchesReference = true;
+		for(std::size_t i = 0; i < batchSize; i++)
+		{
+			simdMatchesScalar = simdMatchesScalar &&
+				matricesEqual(simdTransforms[i * 3], batch.getLocalTransform(i)) &&
+				matricesEqual(simdTransforms[i * 3 + 1], batch.getWorldTransformNoScale(i)) &&
+				matricesEqual(simdTransforms[i * 3 + 2], batch.getWorldTransformWithScale(i));
+
+			const glm::mat4 parentTransform = parentIndices[i] < 0 ? glm::mat4(1.0f) : parentTransforms[parentIndices[i]];
+
+			scalarMatchesReference = scalarMatchesReference &&
+				matricesEqual(batch.getLocalTransform(i), Math::createTransformMat(positions[i], rotations[i])) &&
+				matricesEqual(batch.getWorldTransformNoScale(i), parentTransform * Math::createTransformMat(positions[i], rotations[i])) &&
+				matricesEqual(batch.getWorldTransformWithScale(i), parentTransform * Math::createTransformMat(positions[i], rotations[i], scales[i]));
+		}
+
+		check(simdMatchesScalar, "SpatialTransformBatch: the SIMD and scalar transforms of a batch of " + Utilities::toString((int)batchSize) + " entries differ");
+		check(scalarMatchesReference, "SpatialTransformBatch: the transforms of a batch of " + Utilities::toString((int)batchSize) + " entries differ from Math::createTransformMat");
+	}
+}
+
+void SelfCheck::checkRenderGraph()
+{
+	RenderGraph renderGraph;
+
+	auto geometryPass = renderGraph.addPass("Geometry");
+	geometryPass.write("GBuffer");
+	geometryPass.write("Depth");
+
+	auto shadowPass = renderGraph.addPass("Shadow");
+	shadowPass.write("ShadowMap");
+
+	// Output is never read
+	auto debugPass = renderGraph.addPass("Debug");
+	debugPass.read("GBuffer");
+	debugPass.write("DebugView");
+
+	auto lightingPass = renderGraph.addPass("Lighting");
+	lightingPass.read("GBuffer");
+	lightingPass.read("Depth");
+	lightingPass.read("ShadowMap");
+	lightingPass.write("Color");
+
+	// Output is overwritten before it is read
+	auto overwrittenPass = renderGraph.addPass("Overwritten");
+	overwrittenPass.write("Bloom");
+
+	auto bloomPass = renderGraph.addPass("Bloom");
+	bloomPass.read("Color");
+	bloomPass.write("Bloom");
+
+	auto compositePass = renderGraph.addPass("Composite");
+	compositePass.read("Color");
+	compositePass.read("Bloom");
+	compositePass.write("Color");
+
+	auto finalPass = renderGraph.addPass("Final");
+	finalPass.read("Color");
+	finalPass.write("Backbuffer");
+	finalPass.setSideEffects();
+
+	// Output is only read by a pass whose output is never read
+	auto scratchPass = renderGraph.addPass("Scratch");
+	scratchPass.read("Color");
+	scratchPass.write("Scratch");
+
+	auto chainedPass = renderGraph.addPass("Chained");
+	chainedPass.read("Scratch");
+	chainedPass.write("ChainedScratch");
+
+	check(!renderGraph.isCompiled(), "RenderGraph: graph is compiled before compile() is called");
+	renderGraph.compile();
+	check(renderGraph.isCompiled(), "RenderGraph: graph is not compiled after compile() is called");
+	check(renderGraph.getNumOfPasses() == 10, "RenderGraph: wrong number of passes");
+
+	const bool expectedCulled[] = { false, false, true, false, true, false, false, false, true, true };
+	for(RenderGraph::PassID passID = 0; passID < 10; passID++)
+		check(renderGraph.isPassCulled(passID) == expectedCulled[passID], "RenderGraph: " + renderGraph.getPassName(passID) + " pass is " + (expectedCulled[passID] ? "not culled" : "culled"));
+
+	// Lifetimes span the remaining passes only
+	const struct { const char *m_name; RenderGraph::PassID m_firstUse; RenderGraph::PassID m_lastUse; } expectedLifetimes[] = {
+		{ "GBuffer", 0, 3 },
+		{ "Depth", 0, 3 },
+		{ "ShadowMap", 1, 3 },
+		{ "Color", 3, 7 },
+		{ "Bloom", 5, 6 },
+		{ "Backbuffer", 7, 7 },
+		{ "DebugView", RenderGraph::NullID, RenderGraph::NullID },
+		{ "Scratch", RenderGraph::NullID, RenderGraph::NullID },
+		{ "ChainedScratch", RenderGraph::NullID, RenderGraph::NullID } };
+
+	check(renderGraph.getNumOfResources() == sizeof(expectedLifetimes) / sizeof(expectedLifetimes[0]), "RenderGraph: wrong number of resources");
+
+	for(const auto &lifetime : expectedLifetimes)
+	{
+		const RenderGraph::ResourceID resourceID = renderGraph.getResourceID(lifetime.m_name);
+		check(resourceID != RenderGraph::NullID, std::string("RenderGraph: ") + lifetime.m_name + " resource is missing");
+
+		if(resourceID != RenderGraph::NullID)
+			check(renderGraph.getFirstUse(resourceID) == lifetime.m_firstUse && renderGraph.getLastUse(resourceID) == lifetime.m_lastUse, std::string("RenderGraph: wrong lifetime of the ") + lifetime.m_name + " resource");
+	}
+
+	// Adding a pass invalidates the compiled graph; without any side effects, every pass is culled
+	renderGraph.clear();
+	auto unusedPass = renderGraph.addPass("Unused");
+	unusedPass.write("Color");
+	renderGraph.compile();
+
+	check(renderGraph.isPassCulled(0) && renderGraph.getFirstUse(0) == RenderGraph::NullID, "RenderGraph: pass without side effects or readers is not culled");
+
+	unusedPass.setSideEffects();
+	check(!renderGraph.isCompiled(), "RenderGraph: graph is still compiled after a pass has changed");
+	renderGraph.compile();
+	check(!renderGraph.isPassCulled(0) && renderGraph.getFirstUse(0) == 0, "RenderGraph: pass with side effects is culled");
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+#include "ErrorCodes.h"
+
+// Checks of the engine modules that contain no graphics API calls, so they can be validated without a GPU or a loaded scene
+// (software occlusion culling, batched spatial transforms, render graph compilation, etc.). Enabled by setting the self_check config variable (e.g. passing "self_check 1" as the
+// command line arguments, together with "headless_mode 1"), in which case the engine runs the checks and exits, instead of starting.
+class SelfCheck
+{
+public:
+	SelfCheck();
+	~SelfCheck();
+
+	// Runs every check, logging each one that fails; returns success only if all of them have passed
+	ErrorCode run();
+
+	// Getters
+	const inline size_t getNumOfChecks() const { return m_numOfChecks; }
+	const inline size_t getNumOfFailedChecks() const { return m_numOfFailedChecks; }
+
+private:
+	// Counts the check, and logs it as failed if the condition is false
+	void check(const bool p_condition, const std::string &p_description);
+
+	// Occluded and visible bounding boxes around a full-screen and a half-screen occluder, and identical depth buffers from the SSE and scalar rasterization
+	void checkOcclusionCuller();
+
+	// Transforms of randomized batches (of sizes that are and are not a multiple of the SIMD width) computed with the SIMD and scalar code, against Math::createTransformMat
+	void checkSpatialTransformBatch();
+
+	// Culled passes (unread, overwritten and transitively unused outputs) and resource lifetimes of a synthetic frame graph
+	void checkRenderGraph();
+
+	size_t m_numOfChecks;
+	size_t m_numOfFailedChecks;
+};
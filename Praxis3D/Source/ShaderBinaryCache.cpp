@@ -0,0 +1,142 @@
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "Config.h"
+#include "ErrorHandlerLocator.h"
+#include "Filesystem.h"
+#include "ShaderBinaryCache.h"
+
+// Program binary file identifier and version; the version must be increased whenever the file layout changes
+static constexpr char g_programBinaryMagic[4] = { 'P', '3', 'S', 'B' };
+static constexpr unsigned int g_programBinaryVersion = 1;
+
+ShaderBinaryCache::ShaderBinaryCache()
+{
+	m_driverHash = 0;
+	m_enabled = false;
+}
+
+ShaderBinaryCache::~ShaderBinaryCache()
+{
+}
+
+void ShaderBinaryCache::init()
+{
+	m_enabled = false;
+
+	if(!Config::rendererVar().shader_binary_cache)
+		return;
+
+	// Program binaries can only be used if the driver supports at least one binary format
+	GLint numOfBinaryFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numOfBinaryFormats);
+
+	if(numOfBinaryFormats > 0)
+	{
+		// Binaries are only valid for the driver that created them
+		const char *vendor = reinterpret_cast<const char *>(glGetString(GL_VENDOR));
+		const char *renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+		const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+
+		m_driverHash = Utilities::getHashKey64(std::string(vendor != nullptr ? vendor : "") + "\n" + (renderer != nullptr ? renderer : "") + "\n" + (version != nullptr ? version : ""));
+		m_enabled = true;
+	}
+}
+
+bool ShaderBinaryCache::loadProgramBinary(const unsigned int p_programHandle, const std::string &p_programName, const uint64_t p_defineSetHash, const std::string(&p_source)[ShaderType_NumOfTypes])
+{
+	if(!m_enabled)
+		return false;
+
+	std::ifstream binaryFile(getProgramBinaryFilename(p_programName, p_defineSetHash), std::ios::in | std::ios::binary);
+	if(binaryFile.fail())
+		return false;
+
+	ProgramBinaryHeader header;
+	binaryFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+	// Make sure the binary was created from the same source code and by the same driver
+	if(binaryFile.fail() ||
+		std::memcmp(header.m_magic, g_programBinaryMagic, sizeof(g_programBinaryMagic)) != 0 ||
+		header.m_version != g_programBinaryVersion ||
+		header.m_driverHash != m_driverHash ||
+		header.m_sourceHash != getSourceHash(p_source) ||
+		header.m_binarySize == 0)
+		return false;
+
+	std::vector<char> binary(header.m_binarySize);
+	binaryFile.read(binary.data(), binary.size());
+
+	if(binaryFile.fail())
+		return false;
+
+	glProgramBinary(p_programHandle, (GLenum)header.m_binaryFormat, binary.data(), (GLsizei)binary.size());
+
+	// The driver can still reject the binary (for example, after an update that didn't change the version string)
+	GLint linkStatus = 0;
+	glGetProgramiv(p_programHandle, GL_LINK_STATUS, &linkStatus);
+
+	return linkStatus != 0;
+}
+
+ErrorCode ShaderBinaryCache::saveProgramBinary(const unsigned int p_programHandle, const std::string &p_programName, const uint64_t p_defineSetHash, const std::string(&p_source)[ShaderType_NumOfTypes])
+{
+	if(!m_enabled)
+		return ErrorCode::Success;
+
+	GLint binarySize = 0;
+	glGetProgramiv(p_programHandle, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+
+	if(binarySize <= 0)
+		return ErrorCode::Failure;
+
+	std::vector<char> binary(binarySize);
+	GLenum binaryFormat = 0;
+	GLsizei binaryLength = 0;
+	glGetProgramBinary(p_programHandle, binarySize, &binaryLength, &binaryFormat, binary.data());
+
+	if(binaryLength <= 0)
+		return ErrorCode::Failure;
+
+	const std::string filename = getProgramBinaryFilename(p_programName, p_defineSetHash);
+
+	Filesystem::createDirectories(Utilities::stripFilePath(filename));
+
+	std::ofstream binaryFile(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(binaryFile.fail())
+		return ErrorCode::Ifstream_failed;
+
+	ProgramBinaryHeader header;
+	std::memcpy(header.m_magic, g_programBinaryMagic, sizeof(g_programBinaryMagic));
+	header.m_version = g_programBinaryVersion;
+	header.m_sourceHash = getSourceHash(p_source);
+	header.m_driverHash = m_driverHash;
+	header.m_binaryFormat = (unsigned int)binaryFormat;
+	header.m_binarySize = (unsigned int)binaryLength;
+
+	binaryFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	binaryFile.write(binary.data(), binaryLength);
+
+	return binaryFile.fail() ? ErrorCode::Failure : ErrorCode::Success;
+}
+
+uint64_t ShaderBinaryCache::getSourceHash(const std::string(&p_source)[ShaderType_NumOfTypes])
+{
+	std::string combinedSource;
+	for(unsigned int i = 0; i < ShaderType_NumOfTypes; i++)
+		combinedSource += Utilities::toString(i) + ":" + p_source[i] + "\n";
+
+	return Utilities::getHashKey64(combinedSource);
+}
+
+std::string ShaderBinaryCache::getProgramBinaryFilename(const std::string &p_programName, const uint64_t p_defineSetHash)
+{
+	// Program names can contain characters that are not valid in filenames, so the permutation is identified by a hash only
+	std::stringstream filename;
+	filename << Config::filepathVar().shader_cache_path << std::hex << std::setw(16) << std::setfill('0') << Utilities::getHashKey64(p_programName + "\n" + Utilities::toString(p_defineSetHash)) << ".bin";
+
+	return filename.str();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "CommonDefinitions.h"
+#include "ErrorCodes.h"
+
+// Saves linked shader programs to disk as program binaries, so that on subsequent runs programs are created directly from the binary,
+// without compiling and linking the shaders. Binaries are identified by the shader permutation (program name and the hash of its #define set);
+// each file also holds a hash of the program's source code and of the graphics driver, and is ignored (and later overwritten) if either of them
+// doesn't match, e.g. after a shader file has been edited or the driver has been updated. Must only be used on the thread that owns the GL context
+class ShaderBinaryCache
+{
+public:
+	ShaderBinaryCache();
+	~ShaderBinaryCache();
+
+	// Check if the driver supports program binaries and identify the driver
+	void init();
+
+	// Create the program from its cached binary; returns true if the program was created and linked successfully
+	bool loadProgramBinary(const unsigned int p_programHandle, const std::string &p_programName, const uint64_t p_defineSetHash, const std::string(&p_source)[ShaderType_NumOfTypes]);
+
+	// Retrieve the binary of the linked program and save it to disk
+	ErrorCode saveProgramBinary(const unsigned int p_programHandle, const std::string &p_programName, const uint64_t p_defineSetHash, const std::string(&p_source)[ShaderType_NumOfTypes]);
+
+	inline bool isEnabled() const { return m_enabled; }
+
+private:
+	// Program binary file header
+	struct ProgramBinaryHeader
+	{
+		char m_magic[4];
+		unsigned int m_version;
+		uint64_t m_sourceHash;
+		uint64_t m_driverHash;
+		unsigned int m_binaryFormat;
+		unsigned int m_binarySize;
+	};
+
+	// Returns a hash of the source code of every shader in the program (which already has the #define values applied)
+	static uint64_t getSourceHash(const std::string(&p_source)[ShaderType_NumOfTypes]);
+
+	// Returns the filename of the program binary of the given shader permutation
+	static std::string getProgramBinaryFilename(const std::string &p_programName, const uint64_t p_defineSetHash);
+
+	// Hash of the driver vendor, renderer and version strings
+	uint64_t m_driverHash;
+
+	// Set if the program binary cache is enabled in the config and the driver supports at least one binary format
+	bool m_enabled;
+};
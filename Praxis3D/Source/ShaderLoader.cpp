@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include "Config.h"
 #include "ErrorHandlerLocator.h"
 #include "ShaderLoader.h"
@@ -6,6 +8,8 @@
 #include "Utilities.h"
 
 unsigned int ShaderLoader::ShaderProgram::m_defaultProgramHandle = 0;
+std::unordered_map<std::string, std::string> ShaderLoader::m_sourceCache;
+SpinWait ShaderLoader::m_sourceCacheMutex;
 
 ShaderLoader::ShaderLoader()
 {
@@ -158,6 +162,76 @@ ErrorCode ShaderLoader::reload(ShaderProgram *p_shaderProgram)
 	return ErrorCode();
 }
 
+ErrorCode ShaderLoader::getShaderSource(const std::string &p_filename, std::string &p_source)
+{
+	SpinWait::Lock lock(m_sourceCacheMutex);
+
+	// Read and preprocess the file only if it hasn't been read before
+	auto sourceIterator = m_sourceCache.find(p_filename);
+	if(sourceIterator == m_sourceCache.end())
+	{
+		std::string source;
+		std::vector<std::string> includedFiles;
+
+		if(ErrorCode sourceError = readShaderSource(p_filename, source, includedFiles, 0); sourceError != ErrorCode::Success)
+			return sourceError;
+
+		sourceIterator = m_sourceCache.emplace(p_filename, std::move(source)).first;
+	}
+
+	p_source += sourceIterator->second;
+
+	return ErrorCode::Success;
+}
+
+void ShaderLoader::clearSourceCache()
+{
+	SpinWait::Lock lock(m_sourceCacheMutex);
+
+	m_sourceCache.clear();
+}
+
+ErrorCode ShaderLoader::readShaderSource(const std::string &p_filename, std::string &p_source, std::vector<std::string> &p_includedFiles, const unsigned int p_includeDepth)
+{
+	// Load shader's source code from a file
+	std::ifstream sourceStream(Config::PathsVariables().shader_path + p_filename, std::ios::in);
+
+	if(!sourceStream.is_open())
+		return ErrorCode::Ifstream_failed;
+
+	std::string singleLine = "";
+	while(std::getline(sourceStream, singleLine))
+	{
+		// Check if the line is an #include directive
+		const auto directivePosition = singleLine.find_first_not_of(" \t");
+		if(directivePosition != std::string::npos && singleLine.compare(directivePosition, 8, "#include") == 0)
+		{
+			const auto filenameStart = singleLine.find('"', directivePosition + 8);
+			const auto filenameEnd = filenameStart != std::string::npos ? singleLine.find('"', filenameStart + 1) : std::string::npos;
+
+			if(filenameEnd != std::string::npos)
+			{
+				const std::string includeFilename = singleLine.substr(filenameStart + 1, filenameEnd - filenameStart - 1);
+
+				// Replace the directive with the contents of the included file; every file is included only once, which also guards against recursive includes
+				if(std::find(p_includedFiles.begin(), p_includedFiles.end(), includeFilename) == p_includedFiles.end())
+				{
+					p_includedFiles.push_back(includeFilename);
+
+					if(p_includeDepth >= 16 || readShaderSource(includeFilename, p_source, p_includedFiles, p_includeDepth + 1) != ErrorCode::Success)
+						ErrHandlerLoc::get().log(ErrorCode::Ifstream_failed, ErrorSource::Source_ShaderLoader, "(Filename - \"" + includeFilename + "\", included in \"" + p_filename + "\"): ");
+				}
+
+				continue;
+			}
+		}
+
+		p_source += "\n" + singleLine;
+	}
+
+	return ErrorCode::Success;
+}
+
 ShaderLoader::ShaderProgram::~ShaderProgram()
 {
 	delete m_uniformUpdater;
@@ -6,9 +6,11 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "CommonDefinitions.h"
 #include "ErrorCodes.h"
+#include "Profiler.h"
 #include "PropertySet.h"
 #include "SpinWait.h"
 
@@ -62,23 +64,14 @@ public:
 
 		inline ErrorCode loadToMemory()
 		{
+			PROFILE_ZONE("Shader::loadToMemory");
+
 			if(!m_loadedToMemory)
 			{
 				m_loadedToMemory = true;
 
-				// Load shader's source code from a file
-				std::ifstream sourceStream(Config::PathsVariables().shader_path + m_filename, std::ios::in);
-
-				// Check if it was loaded successfully
-				if(sourceStream.is_open())
-				{
-					std::string singleLine = "";
-					while(std::getline(sourceStream, singleLine))
-						m_shaderSource += "\n" + singleLine;
-
-					sourceStream.close();
-				}
-				else
+				// Get the shader's preprocessed source code
+				if(ShaderLoader::getShaderSource(m_filename, m_shaderSource) != ErrorCode::Success)
 				{
 					ErrHandlerLoc::get().log(ErrorCode::Ifstream_failed, ErrorSource::Source_ShaderLoader, "(Filename - \"" + m_filename + "\"): ");
 					return ErrorCode::Ifstream_failed;
@@ -175,6 +168,8 @@ public:
 		// Loads shader source code to memory
 		inline ErrorCode loadToMemory()
 		{
+			PROFILE_ZONE("ShaderProgram::loadToMemory");
+
 			ErrorCode returnError = ErrorCode::Success;
 
 			// Check if the shader hasn't been already loaded
@@ -190,18 +185,9 @@ public:
 						// Make sure the shader source string is empty
 						m_shaderSource[i].clear();
 
-						// Load shader's source code from a file
-						std::ifstream sourceStream(Config::PathsVariables().shader_path + m_shaderFilename[i], std::ios::in);
-
-						// Check if it was loaded successfully
-						if(sourceStream.is_open())
+						// Get the shader's preprocessed source code; each file is only read once and shared between all programs (permutations) using it
+						if(ShaderLoader::getShaderSource(m_shaderFilename[i], m_shaderSource[i]) == ErrorCode::Success)
 						{
-							std::string singleLine = "";
-							while(std::getline(sourceStream, singleLine))
-								m_shaderSource[i] += "\n" + singleLine;
-
-							sourceStream.close();
-
 							m_defaultShader = false;
 						}
 						else
@@ -230,6 +216,9 @@ public:
 			// Reset the loaded flag
 			m_loadedToMemory = false;
 
+			// Make sure the source code is read from the files again, instead of the source cache
+			ShaderLoader::clearSourceCache();
+
 			// Load shader to memory
 			return loadToMemory();
 		}
@@ -243,6 +232,15 @@ public:
 		const inline unsigned int getShaderHandle() const { return m_programHandle; }
 		inline ShaderUniformUpdater &getUniformUpdater() const { return *m_uniformUpdater; }
 
+		// Returns a hash of all the #define variable values that are set in the program; together with the program name, it identifies the shader permutation
+		inline uint64_t getDefineSetHash() const
+		{
+			std::string defineSet;
+			for(const auto &variable : m_variableDefinitions)
+				defineSet += Utilities::toString((int)variable.m_shaderType) + ":" + variable.m_variableName + "=" + variable.m_variableValue + "\n";
+			return Utilities::getHashKey64(defineSet);
+		}
+
 		const inline bool isDefaultProgram() const		{ return m_defaultShader;				}
 		const inline bool isLoadedToVideoMemory() const { return m_loadedToVideoMemory;			}
 		const inline bool isNameAutoGenerated() const	{ return m_combinedFilenameGenerated;	}
@@ -392,9 +390,23 @@ public:
 
 	ErrorCode reload(ShaderProgram *p_shaderProgram);
 
+	// Get the source code of the given shader file (relative to the shader path), with all #include directives resolved, appended to the given string.
+	// Each file is read and preprocessed only once; the result is cached and shared between all the programs that use the same file
+	static ErrorCode getShaderSource(const std::string &p_filename, std::string &p_source);
+
+	// Remove all the cached shader source code, so that shader files are read again (used when reloading shaders)
+	static void clearSourceCache();
+
 	const inline std::vector<ShaderProgram *> &getObjectPool() const { return m_shaderPrograms; }
 
 private:
+	// Read the shader file and append its contents to the source string, replacing #include directives with the contents of the included files (each included only once)
+	static ErrorCode readShaderSource(const std::string &p_filename, std::string &p_source, std::vector<std::string> &p_includedFiles, const unsigned int p_includeDepth);
+
+	// Preprocessed source code of every shader file that has been read, identified by the filename
+	static std::unordered_map<std::string, std::string> m_sourceCache;
+	static SpinWait m_sourceCacheMutex;
+
 	SpinWait	m_vertFragMutex,
 				m_geomMutex;
 
@@ -118,6 +118,7 @@ ErrorCode ShaderUniformUpdater::generatePerFrameList()
 	uniformList.push_back(new ViewProjectionMatUniform(m_shaderHandle));
 	uniformList.push_back(new TransposeViewMatUniform(m_shaderHandle));
 	uniformList.push_back(new TransposeInverseViewMatUniform(m_shaderHandle));
+	uniformList.push_back(new InverseViewProjectionMatUniform(m_shaderHandle));
 	uniformList.push_back(new DirShadowMapMVPUniform(m_shaderHandle));
 	uniformList.push_back(new DirShadowMapBiasMVPUniform(m_shaderHandle));
 
@@ -146,6 +147,7 @@ ErrorCode ShaderUniformUpdater::generatePerFrameList()
 	uniformList.push_back(new ScreenSizeUniform(m_shaderHandle));
 	uniformList.push_back(new InverseScreenSizeUniform(m_shaderHandle));
 	uniformList.push_back(new ScreenNumOfPixelsUniform(m_shaderHandle));
+	uniformList.push_back(new RenderScaleUniform(m_shaderHandle));
 
 	// Misc
 	uniformList.push_back(new DeltaTimeMSUniform(m_shaderHandle));
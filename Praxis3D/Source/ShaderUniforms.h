@@ -227,6 +227,18 @@ public:
 		glUniformMatrix4fv(m_uniformHandle, 1, GL_FALSE, &p_uniformData.m_frameData.m_transposeInverseViewMatrix[0][0]);
 	}
 };
+class InverseViewProjectionMatUniform : public BaseUniform
+{
+public:
+	InverseViewProjectionMatUniform(unsigned int p_shaderHandle) : BaseUniform(Config::shaderVar().inverseViewProjectionMatUniform, p_shaderHandle)
+	{
+	}
+
+	void update(const UniformData &p_uniformData)
+	{
+		glUniformMatrix4fv(m_uniformHandle, 1, GL_FALSE, &p_uniformData.m_frameData.m_inverseViewProjMatrix[0][0]);
+	}
+};
 
 class ScreenSizeUniform : public BaseUniform
 {
@@ -264,6 +276,24 @@ public:
 private:
 	glm::vec2 m_inverseScreenSize;
 };
+class RenderScaleUniform : public BaseUniform
+{
+public:
+	RenderScaleUniform(unsigned int p_shaderHandle) : BaseUniform(Config::shaderVar().renderScaleUniform, p_shaderHandle) { }
+
+	void update(const UniformData &p_uniformData)
+	{
+		if(m_renderScale != p_uniformData.m_frameData.m_renderScale)
+		{
+			m_renderScale = p_uniformData.m_frameData.m_renderScale;
+
+			glUniform2f(m_uniformHandle, m_renderScale.x, m_renderScale.y);
+		}
+	}
+
+private:
+	glm::vec2 m_renderScale;
+};
 class ScreenNumOfPixelsUniform : public BaseUniform
 {
 public:
@@ -271,16 +301,19 @@ public:
 
 	void update(const UniformData &p_uniformData)
 	{
-		if(m_screenSize != p_uniformData.m_frameData.m_screenSize)
+		// Only the pixels of the rendered sub-rectangle are counted
+		const glm::ivec2 renderSize = glm::ivec2(glm::vec2(p_uniformData.m_frameData.m_screenSize) * p_uniformData.m_frameData.m_renderScale + 0.5f);
+
+		if(m_renderSize != renderSize)
 		{
-			m_screenSize = p_uniformData.m_frameData.m_screenSize;
+			m_renderSize = renderSize;
 
-			glUniform1ui(m_uniformHandle, (unsigned int)(m_screenSize.x * m_screenSize.y));
+			glUniform1ui(m_uniformHandle, (unsigned int)(m_renderSize.x * m_renderSize.y));
 		}
 	}
 
 private:
-	glm::ivec2 m_screenSize;
+	glm::ivec2 m_renderSize;
 };
 class ProjPlaneRangeUniform : public BaseUniform
 {
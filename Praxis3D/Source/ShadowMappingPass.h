@@ -13,10 +13,14 @@ public:
 		RenderPass(p_renderer, RenderPassType::RenderPassType_ShadowMapping),
 		m_csmPassShader(nullptr),
 		m_csmPassAlphaDiscardShader(nullptr),
+		m_csmStaticPassShader(nullptr),
+		m_csmStaticPassAlphaDiscardShader(nullptr),
 		m_csmDataSetUniformBuffer(BufferType_Uniform, BufferBindTarget_Uniform, BufferUsageHint_DynamicDraw)
 	{
 		m_numOfCascades = (unsigned int)p_renderer.m_frameData.m_shadowMappingData.m_shadowCascadePlaneDistances.size();
 		m_csmResolution = p_renderer.m_frameData.m_shadowMappingData.m_csmResolution;
+		m_staticShadowCastersSignature = 0;
+		m_staticCasterCacheValid = false;
 	}
 
 	~ShadowMappingPass() 
@@ -109,12 +113,25 @@ public:
 				returnError = shaderError;
 		}
 
+#if CSM_USE_MULTILAYER_DRAW
+		// Create the single-layer pass shaders, used to render static shadow casters into one cascade of the static shadow caster cache at a time
+		if(ErrorCode shaderError = createSingleLayerPassShader("csmStaticPass", false, m_csmStaticPassShader); shaderError != ErrorCode::Success)
+			returnError = shaderError;
+		if(ErrorCode shaderError = createSingleLayerPassShader("csmStaticPass_AlphaDiscard", true, m_csmStaticPassAlphaDiscardShader); shaderError != ErrorCode::Success)
+			returnError = shaderError;
+#else
+		// Pass shaders already render a single layer at a time
+		m_csmStaticPassShader = m_csmPassShader;
+		m_csmStaticPassAlphaDiscardShader = m_csmPassAlphaDiscardShader;
+#endif
+
 		// Initialize CSM dataset
 		m_csmDataSet.reserve(m_numOfCascades);
-		updateCSMDataSet(shadowMappingData);
+		updateCSMDataSet(shadowMappingData, Config::rendererVar().csm_static_caster_caching);
 
 		// Set data for CSM buffer
 		m_csmDataSetUniformBuffer.m_bindingIndex = UniformBufferBinding::UniformBufferBinding_CSMMatrixBuffer;
+		m_csmDataSetUniformBuffer.m_perFrame = true;
 		m_csmDataSetUniformBuffer.m_size = sizeof(CascadedShadowMapDataSet) * m_csmDataSet.size();
 		m_csmDataSetUniformBuffer.m_data = (void *)&m_csmDataSet[0];
 
@@ -138,6 +155,8 @@ public:
 		// Get the current shadow mapping data
 		const auto &shadowMappingData = m_renderer.m_frameData.m_shadowMappingData;
 
+		m_lastFrameNumOfCascadeReRenders = 0;
+
 		if(p_sceneObjects.m_processDrawing && shadowMappingData.m_shadowMappingEnabled && !shadowMappingData.m_shadowCascadePlaneDistances.empty())
 		{
 			// If the number of shadow cascades has changed, set the new define inside the shader source and recompile the shader
@@ -147,6 +166,7 @@ public:
 				m_numOfCascades = (unsigned int)shadowMappingData.m_shadowCascadePlaneDistances.size();
 
 				m_renderer.m_backend.getCSMFramebuffer()->setNumOfCascades(m_numOfCascades);
+				m_staticCasterCacheValid = false;
 
 				if(m_numOfCascades > 0)
 				{
@@ -168,10 +188,19 @@ public:
 			{
 				m_csmResolution = shadowMappingData.m_csmResolution;
 				m_renderer.m_backend.getCSMFramebuffer()->setBufferSize(m_csmResolution, m_csmResolution);
+				m_staticCasterCacheValid = false;
+			}
+
+			// Create or delete the static shadow caster cache, if the caching was turned on or off
+			const bool staticCasterCaching = Config::rendererVar().csm_static_caster_caching;
+			if(staticCasterCaching != m_renderer.m_backend.getCSMFramebuffer()->staticDepthBuffersEnabled())
+			{
+				m_renderer.m_backend.getCSMFramebuffer()->setStaticDepthBuffersEnabled(staticCasterCaching);
+				m_staticCasterCacheValid = false;
 			}
 
 			// Update the CSM data set
-			updateCSMDataSet(shadowMappingData);
+			updateCSMDataSet(shadowMappingData, staticCasterCaching);
 
 			// Send the CSM data set to the GPU
 			m_csmDataSetUniformBuffer.m_updateSize = sizeof(CascadedShadowMapDataSet) * m_csmDataSet.size();
@@ -180,134 +209,92 @@ public:
 			m_renderer.queueForUpdate(m_csmDataSetUniformBuffer);
 			m_renderer.passUpdateCommandsToBackend();
 
-			// Prepare CSM framebuffer for rendering
-			m_renderer.m_backend.getCSMFramebuffer()->initFrame();
-
 			// Enable z clipping
 			if(shadowMappingData.m_zClipping)
 				glEnable(GL_DEPTH_CLAMP);
 
-#if CSM_USE_MULTILAYER_DRAW
-
-			// Iterate over all objects to be rendered with CSM shader
-			for(auto entity : p_sceneObjects.m_models)
+			if(staticCasterCaching)
 			{
-				ModelComponent &model = p_sceneObjects.m_models.get<ModelComponent>(entity);
-				if(model.isObjectActive())
+				// Invalidate the cache of every cascade if any static shadow caster was added, removed or has moved
+				const std::size_t staticShadowCastersSignature = calcStaticShadowCastersSignature(p_sceneObjects);
+				if(m_staticShadowCastersSignature != staticShadowCastersSignature)
 				{
-					SpatialComponent &spatialData = p_sceneObjects.m_models.get<SpatialComponent>(entity);
-					auto &modelData = model.getModelData();
+					m_staticShadowCastersSignature = staticShadowCastersSignature;
+					m_staticCasterCacheValid = false;
+				}
 
-					// Go over each model
-					for(decltype(modelData.size()) modelIndex = 0, modelSize = modelData.size(); modelIndex < modelSize; modelIndex++)
+				if(!m_staticCasterCacheValid)
+					m_cachedLightSpaceMatrices.clear();
+
+				m_cachedLightSpaceMatrices.resize(m_csmDataSet.size());
+
+				// Prepare CSM framebuffer for rendering; depth buffers are not cleared, as they are overwritten by the static depth buffers
+				m_renderer.m_backend.getCSMFramebuffer()->initCachedFrame();
+
+				// Render the static shadow casters of each cascade, whose snapped light space matrix has changed, into the static depth buffers
+				for(decltype(m_csmDataSet.size()) i = 0, size = m_csmDataSet.size(); i < size; i++)
+				{
+					if(!m_staticCasterCacheValid || m_cachedLightSpaceMatrices[i] != m_csmDataSet[i].m_lightSpaceMatrix)
 					{
-						// Calculate model-view-projection matrix
-						const glm::mat4 &modelMatrix = p_sceneObjects.m_models.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransformWithScale();
+						m_renderer.m_backend.getCSMFramebuffer()->bindStaticDepthLayerForWriting((unsigned int)i);
 
-						// Go over each mesh
-						for(decltype(modelData[modelIndex].m_model.getNumMeshes()) meshIndex = 0, meshSize = modelData[modelIndex].m_model.getNumMeshes(); meshIndex < meshSize; meshIndex++)
-						{
-							// Only draw active meshes
-							if(modelData[modelIndex].m_meshes[meshIndex].m_active)
-							{
-								if(modelData[modelIndex].m_meshes[meshIndex].m_alphaThreshold > 0.0f)
-								{
-									// ALPHA DISCARD enabled
-									m_renderer.queueForDrawing(
-										modelData[modelIndex].m_model[meshIndex], 
-										modelData[modelIndex].m_meshes[meshIndex], 
-										modelData[modelIndex].m_model.getHandle(), 
-										m_csmPassAlphaDiscardShader->getShaderHandle(), 
-										m_csmPassAlphaDiscardShader->getUniformUpdater(), 
-										DrawCommandTextureBinding::DrawCommandTextureBinding_DiffuseOnly,
-										modelData[modelIndex].m_shadowFaceCulling, 
-										modelMatrix, 
-										modelMatrix);
-								}
-								else
-								{
-									// ALPHA DISCARD disabled
-									m_renderer.queueForDrawing(
-										modelData[modelIndex].m_model[meshIndex], 
-										modelData[modelIndex].m_meshes[meshIndex], 
-										modelData[modelIndex].m_model.getHandle(), 
-										m_csmPassShader->getShaderHandle(), 
-										m_csmPassShader->getUniformUpdater(), 
-										DrawCommandTextureBinding::DrawCommandTextureBinding_None,
-										modelData[modelIndex].m_shadowFaceCulling,
-										modelMatrix, 
-										modelMatrix);
-								}
-							}
-						}
+						queueShadowCasters(p_sceneObjects, *m_csmStaticPassShader, *m_csmStaticPassAlphaDiscardShader, &m_csmDataSet[i].m_lightSpaceMatrix, ShadowCasterFilter::ShadowCasterFilter_Static);
+
+						// Pass all the draw commands to be executed
+						m_renderer.passDrawCommandsToBackend();
+
+						m_cachedLightSpaceMatrices[i] = m_csmDataSet[i].m_lightSpaceMatrix;
+						m_lastFrameNumOfCascadeReRenders++;
 					}
 				}
-			}
+
+				m_staticCasterCacheValid = true;
+
+				// Reattach the depth buffers, if the static depth buffers were rendered to
+				if(m_lastFrameNumOfCascadeReRenders > 0)
+					m_renderer.m_backend.getCSMFramebuffer()->bindDepthBuffersForWriting();
+
+				// Start each frame with the cached depth of static shadow casters
+				m_renderer.m_backend.getCSMFramebuffer()->copyStaticDepthBuffers();
+
+#if CSM_USE_MULTILAYER_DRAW
+				// Draw the dynamic shadow casters on top of the cached depth
+				queueShadowCasters(p_sceneObjects, *m_csmPassShader, *m_csmPassAlphaDiscardShader, nullptr, ShadowCasterFilter::ShadowCasterFilter_Dynamic);
 #else
-			for(decltype(m_csmDataSet.size()) i = 0, size = m_csmDataSet.size(); i < size; i++)
+				for(decltype(m_csmDataSet.size()) i = 0, size = m_csmDataSet.size(); i < size; i++)
+				{
+					glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_renderer.m_backend.getCSMFramebuffer()->m_depthBuffers, 0, (GLint)i);
+
+					// Draw the dynamic shadow casters on top of the cached depth
+					queueShadowCasters(p_sceneObjects, *m_csmPassShader, *m_csmPassAlphaDiscardShader, &m_csmDataSet[i].m_lightSpaceMatrix, ShadowCasterFilter::ShadowCasterFilter_Dynamic);
+
+					// Pass all the draw commands to be executed
+					m_renderer.passDrawCommandsToBackend();
+				}
+#endif
+			}
+			else
 			{
-				glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_renderer.m_backend.getCSMFramebuffer()->m_depthBuffers, 0, (GLint)i);
-				glClear(GL_DEPTH_BUFFER_BIT);	// Make sure to clear the depth buffer for the new frame
+				// Prepare CSM framebuffer for rendering
+				m_renderer.m_backend.getCSMFramebuffer()->initFrame();
 
+#if CSM_USE_MULTILAYER_DRAW
 				// Iterate over all objects to be rendered with CSM shader
-				for(auto entity : p_sceneObjects.m_models)
+				queueShadowCasters(p_sceneObjects, *m_csmPassShader, *m_csmPassAlphaDiscardShader, nullptr, ShadowCasterFilter::ShadowCasterFilter_All);
+#else
+				for(decltype(m_csmDataSet.size()) i = 0, size = m_csmDataSet.size(); i < size; i++)
 				{
-					ModelComponent &model = p_sceneObjects.m_models.get<ModelComponent>(entity);
-					if(model.isObjectActive())
-					{
-						SpatialComponent &spatialData = p_sceneObjects.m_models.get<SpatialComponent>(entity);
-						auto &modelData = model.getModelData();
+					glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_renderer.m_backend.getCSMFramebuffer()->m_depthBuffers, 0, (GLint)i);
+					glClear(GL_DEPTH_BUFFER_BIT);	// Make sure to clear the depth buffer for the new frame
 
-						// Go over each model
-						for(decltype(modelData.size()) modelIndex = 0, modelSize = modelData.size(); modelIndex < modelSize; modelIndex++)
-						{
-							// Calculate model-view-projection matrix
-							const glm::mat4 &modelMatrix = m_csmDataSet[i].m_lightSpaceMatrix * p_sceneObjects.m_models.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransformWithScale();
-
-							// Go over each mesh
-							for(decltype(modelData[modelIndex].m_model.getNumMeshes()) meshIndex = 0, meshSize = modelData[modelIndex].m_model.getNumMeshes(); meshIndex < meshSize; meshIndex++)
-							{
-								// Only draw active meshes
-								if(modelData[modelIndex].m_meshes[meshIndex].m_active)
-								{
-									if(modelData[modelIndex].m_meshes[meshIndex].m_alphaThreshold > 0.0f)
-									{
-										// ALPHA DISCARD enabled
-										m_renderer.queueForDrawing(
-											modelData[modelIndex].m_model[meshIndex], 
-											modelData[modelIndex].m_meshes[meshIndex], 
-											modelData[modelIndex].m_model.getHandle(), 
-											m_csmPassAlphaDiscardShader->getShaderHandle(),
-											m_csmPassAlphaDiscardShader->getUniformUpdater(),
-											DrawCommandTextureBinding::DrawCommandTextureBinding_DiffuseOnly,
-											modelData[modelIndex].m_shadowFaceCulling,
-											modelMatrix, 
-											modelMatrix);
-									}
-									else
-									{
-										// ALPHA DISCARD disabled
-										m_renderer.queueForDrawing(
-											modelData[modelIndex].m_model[meshIndex], 
-											modelData[modelIndex].m_meshes[meshIndex], 
-											modelData[modelIndex].m_model.getHandle(), 
-											m_csmPassShader->getShaderHandle(),
-											m_csmPassShader->getUniformUpdater(),
-											DrawCommandTextureBinding::DrawCommandTextureBinding_None,
-											modelData[modelIndex].m_shadowFaceCulling,
-											modelMatrix, 
-											modelMatrix);
-									}
-								}
-							}
-						}
-					}
-				}
+					// Iterate over all objects to be rendered with CSM shader
+					queueShadowCasters(p_sceneObjects, *m_csmPassShader, *m_csmPassAlphaDiscardShader, &m_csmDataSet[i].m_lightSpaceMatrix, ShadowCasterFilter::ShadowCasterFilter_All);
 
-				// Pass all the draw commands to be executed
-				m_renderer.passDrawCommandsToBackend();
-			}
+					// Pass all the draw commands to be executed
+					m_renderer.passDrawCommandsToBackend();
+				}
 #endif
+			}
 
 			// Iterate over all objects to be rendered with a custom shader
 			//for(auto entity : p_sceneObjects.m_modelsWithShaders)
@@ -342,7 +329,136 @@ public:
 		}
 	}
 
+	// Number of cascades, whose static shadow casters were rendered again during the last frame (zero when none of the cached cascades have changed)
+	const inline static unsigned int getLastFrameNumOfCascadeReRenders() { return m_lastFrameNumOfCascadeReRenders; }
+
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.write(RenderGraphResource::CSMDepth);
+	}
+
 private:
+	enum ShadowCasterFilter : unsigned int
+	{
+		ShadowCasterFilter_All,
+		ShadowCasterFilter_Static,
+		ShadowCasterFilter_Dynamic
+	};
+
+	ErrorCode createSingleLayerPassShader(const std::string &p_name, const bool p_alphaDiscard, ShaderLoader::ShaderProgram *&p_shader)
+	{
+		// Create a property-set used to load the shader
+		PropertySet shaderProperties(Properties::Shaders);
+		shaderProperties.addProperty(Properties::Name, p_name);
+		shaderProperties.addProperty(Properties::FragmentShader, Config::rendererVar().csm_pass_single_frag_shader);
+		shaderProperties.addProperty(Properties::VertexShader, Config::rendererVar().csm_pass_single_vert_shader);
+
+		// Create the shader
+		p_shader = Loaders::shader().load(shaderProperties);
+
+		// Load the shader to memory
+		ErrorCode shaderError = p_shader->loadToMemory();
+		if(shaderError == ErrorCode::Success)
+		{
+			// Enable or disable alpha discard in the shader
+			if(ErrorCode shaderVariableError = p_shader->setDefineValue(Config::shaderVar().define_alpha_discard, p_alphaDiscard ? 1 : 0); shaderVariableError != ErrorCode::Success)
+				ErrHandlerLoc::get().log(shaderVariableError, Config::shaderVar().define_alpha_discard, ErrorSource::Source_ShadowMappingPass);
+
+			// Queue the shader to be loaded to GPU
+			m_renderer.queueForLoading(*p_shader);
+		}
+
+		return shaderError;
+	}
+
+	// Queues every active mesh of the filtered models for drawing; if the light space matrix is given, it is premultiplied with the model matrix
+	// (for rendering a single cascade), otherwise the model matrix is passed as is (for rendering all cascades at once, in a geometry shader)
+	void queueShadowCasters(const SceneObjects &p_sceneObjects, ShaderLoader::ShaderProgram &p_shader, ShaderLoader::ShaderProgram &p_alphaDiscardShader, const glm::mat4 *p_lightSpaceMatrix, const ShadowCasterFilter p_filter)
+	{
+		// Levels of detail are selected by the screen size of the shadow casters as seen from the camera, with a separate bias for shadows
+		const glm::vec3 cameraPosition = m_renderer.getFrameData().m_cameraPosition;
+		const float lodProjectionScale = m_renderer.getLODProjectionScale();
+		const float lodBias = Config::rendererVar().lod_shadow_bias;
+
+		// Draw commands are generated in parallel, in chunks of objects
+		m_renderer.queueForDrawingParallel(p_sceneObjects.m_renderSnapshot->m_models, [&](RendererBackend::DrawCommands &p_drawCommands, const RenderSnapshot::ModelEntry &p_modelEntry)
+		{
+			if(p_filter != ShadowCasterFilter::ShadowCasterFilter_All && p_modelEntry.m_staticShadowCaster != (p_filter == ShadowCasterFilter::ShadowCasterFilter_Static))
+				return;
+
+			auto &modelData = p_modelEntry.m_model->getModelData();
+
+			// Calculate model-view-projection matrix
+			const glm::mat4 &worldTransform = p_modelEntry.m_modelMatrix;
+			const glm::mat4 modelMatrix = p_lightSpaceMatrix != nullptr ? *p_lightSpaceMatrix * worldTransform : worldTransform;
+
+			// Go over each model
+			for(decltype(modelData.size()) modelIndex = 0, modelSize = modelData.size(); modelIndex < modelSize; modelIndex++)
+			{
+				// Go over each mesh
+				for(decltype(modelData[modelIndex].m_model.getNumMeshes()) meshIndex = 0, meshSize = modelData[modelIndex].m_model.getNumMeshes(); meshIndex < meshSize; meshIndex++)
+				{
+					// Only draw active meshes
+					if(modelData[modelIndex].m_meshes[meshIndex].m_active)
+					{
+						const unsigned int lod = RendererFrontend::selectMeshLOD(modelData[modelIndex].m_model[meshIndex], worldTransform, cameraPosition, lodProjectionScale, lodBias);
+
+						if(modelData[modelIndex].m_meshes[meshIndex].m_alphaThreshold > 0.0f)
+						{
+							// ALPHA DISCARD enabled
+							RendererFrontend::queueForDrawing(
+								p_drawCommands,
+								modelData[modelIndex].m_model[meshIndex], 
+								modelData[modelIndex].m_meshes[meshIndex], 
+								modelData[modelIndex].m_model.getHandle(), 
+								p_alphaDiscardShader.getShaderHandle(), 
+								p_alphaDiscardShader.getUniformUpdater(), 
+								DrawCommandTextureBinding::DrawCommandTextureBinding_DiffuseOnly,
+								modelData[modelIndex].m_shadowFaceCulling, 
+								modelMatrix, 
+								modelMatrix,
+								lod);
+						}
+						else
+						{
+							// ALPHA DISCARD disabled
+							RendererFrontend::queueForDrawing(
+								p_drawCommands,
+								modelData[modelIndex].m_model[meshIndex], 
+								modelData[modelIndex].m_meshes[meshIndex], 
+								modelData[modelIndex].m_model.getHandle(), 
+								p_shader.getShaderHandle(), 
+								p_shader.getUniformUpdater(), 
+								DrawCommandTextureBinding::DrawCommandTextureBinding_None,
+								modelData[modelIndex].m_shadowFaceCulling,
+								modelMatrix, 
+								modelMatrix,
+								lod);
+						}
+					}
+				}
+			}
+		});
+	}
+
+	// Combines the entity IDs and transform update counts of all active static shadow casters; the order of entities does not matter
+	std::size_t calcStaticShadowCastersSignature(const SceneObjects &p_sceneObjects) const
+	{
+		std::size_t signature = 0;
+
+		for(const auto &modelEntry : p_sceneObjects.m_renderSnapshot->m_models)
+		{
+			if(modelEntry.m_staticShadowCaster)
+			{
+				// Mix the values of each entity before adding them together, so that different entities do not cancel each other out
+				std::size_t entitySignature = std::hash<std::size_t>{}(((std::size_t)modelEntry.m_entity << 32) | modelEntry.m_updateCount) * 0x9e3779b97f4a7c15ull;
+				signature += entitySignature ^ (entitySignature >> 29);
+			}
+		}
+
+		return signature;
+	}
+
 	void calculateSplitPositions(std::vector<float> &p_splits, const float p_numOfSplits, const float p_zNear, const float p_zFar)
 	{
 		// Practical split scheme:
@@ -465,6 +581,78 @@ private:
 		return lightProjection * lightView;
 	}
 
+	// Calculates a light space matrix that only changes when the cascade moves by a whole snapping step (a fraction of the cascade size, in whole texels),
+	// so the shadows of static casters can be cached until then. The projection covers the bounding sphere of the cascade frustum, extended by a margin,
+	// so its size does not depend on the camera orientation, and the light view has a fixed origin, so the camera position only affects the snapped offset
+	glm::mat4 calcSnappedLightSpaceMatrix(const ShadowMappingData &p_shadowMappingData, const float p_zNear, const float p_zFar)
+	{
+		// Calculate the camera projection matrix with the given z near and far clip distances
+		const auto cameraProjection = glm::perspectiveFov(
+			glm::radians(m_renderer.m_frameData.m_fov),
+			(float)m_renderer.m_frameData.m_screenSize.x,
+			(float)m_renderer.m_frameData.m_screenSize.y,
+			p_zNear,
+			p_zFar);
+
+		// Get the frustum corners of the camera projection
+		const auto frustumCorners = getFrustumCornersWorldSpace(cameraProjection * m_renderer.m_frameData.m_viewMatrix);
+
+		// Calculate frustum center position
+		glm::vec3 center = glm::vec3(0, 0, 0);
+		for(const auto &position : frustumCorners)
+			center += glm::vec3(position);
+		center /= frustumCorners.size();
+
+		// Calculate the frustum bounding sphere radius; round it up, so that floating point errors do not change it from frame to frame
+		float radius = 0.0f;
+		for(const auto &position : frustumCorners)
+			radius = std::max(radius, glm::length(glm::vec3(position) - center));
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+
+		// Calculate the light-view matrix with a fixed origin, looking in the directional light direction
+		const glm::vec3 lightDir = glm::normalize(m_renderer.m_frameData.m_directionalLight.m_direction);
+		const auto lightView = glm::lookAt(lightDir, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		// Extend the projection by a margin, that allows the frustum to move inside it without changing the projection
+		const float margin = std::max(Config::rendererVar().csm_static_caster_cache_margin, 0.0f);
+		const float halfExtent = radius * (1.0f + margin);
+		const float texelSize = (2.0f * halfExtent) / (float)std::max(m_csmResolution, 1u);
+
+		// Snapping step is a whole number of texels, so that rasterization of the cached shadow casters does not shift between texels when the projection moves
+		const float snapStep = texelSize * std::max(std::floor((float)m_csmResolution * margin / (1.0f + margin)), 1.0f);
+
+		// Snap the projection center (in light space) to the snapping step
+		const glm::vec3 lightSpaceCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+		const float centerX = std::round(lightSpaceCenter.x / snapStep) * snapStep;
+		const float centerY = std::round(lightSpaceCenter.y / snapStep) * snapStep;
+
+		float minZ = std::numeric_limits<float>::max();
+		float maxZ = std::numeric_limits<float>::lowest();
+
+		// Calculate the depth range of the frustum in light space
+		for(const auto &position : frustumCorners)
+		{
+			const auto trf = lightView * position;
+			minZ = std::min(minZ, trf.z);
+			maxZ = std::max(maxZ, trf.z);
+		}
+
+		// Scale the directional light orthogonal projection frustum z plane clip distances
+		minZ = minZ < 0 ? minZ * p_shadowMappingData.m_csmCascadePlaneZMultiplier : minZ / p_shadowMappingData.m_csmCascadePlaneZMultiplier;
+		maxZ = maxZ < 0 ? maxZ / p_shadowMappingData.m_csmCascadePlaneZMultiplier : maxZ * p_shadowMappingData.m_csmCascadePlaneZMultiplier;
+
+		// Snap the depth range outwards to the projection size
+		const float depthSnapStep = 2.0f * halfExtent;
+		minZ = std::floor(minZ / depthSnapStep) * depthSnapStep;
+		maxZ = std::ceil(maxZ / depthSnapStep) * depthSnapStep;
+
+		// Calculate the orthogonal light projection around the snapped center
+		const glm::mat4 lightProjection = glm::ortho(centerX - halfExtent, centerX + halfExtent, centerY - halfExtent, centerY + halfExtent, minZ, maxZ);
+
+		// Calculate the complete light space matrix (light view-projection)
+		return lightProjection * lightView;
+	}
+
 	glm::mat4 calcLightSpaceMatrix2(const float p_zNear, const float p_zFar)
 	{
 		glm::vec3 lightDir = glm::normalize(m_renderer.m_frameData.m_directionalLight.m_direction);
@@ -549,7 +737,7 @@ private:
 		}
 	}
 
-	void updateCSMDataSet(const ShadowMappingData &p_shadowMappingData)
+	void updateCSMDataSet(const ShadowMappingData &p_shadowMappingData, const bool p_snapLightSpaceMatrices)
 	{
 		// Clear the old data
 		m_csmDataSet.clear();
@@ -578,7 +766,7 @@ private:
 
 			// Add the light space matrix and cascade plane distance to the CSM dataset
 			m_csmDataSet.emplace_back(
-				calcLightSpaceMatrix(p_shadowMappingData, planeZNear, planeZFar), 
+				p_snapLightSpaceMatrices ? calcSnappedLightSpaceMatrix(p_shadowMappingData, planeZNear, planeZFar) : calcLightSpaceMatrix(p_shadowMappingData, planeZNear, planeZFar), 
 				planeZFar, 
 				p_shadowMappingData.m_shadowCascadePlaneDistances[i].m_maxBias, 
 				poissonSampleScale, 
@@ -595,9 +783,20 @@ private:
 	ShaderLoader::ShaderProgram *m_csmPassShader;
 	ShaderLoader::ShaderProgram *m_csmPassAlphaDiscardShader;
 
+	// Single-layer pass shaders used to render static shadow casters into the static shadow caster cache
+	ShaderLoader::ShaderProgram *m_csmStaticPassShader;
+	ShaderLoader::ShaderProgram *m_csmStaticPassAlphaDiscardShader;
+
 	// CSM uniform buffer
 	RendererFrontend::ShaderBuffer m_csmDataSetUniformBuffer;
 
 	// CSM dataset
 	std::vector<CascadedShadowMapDataSet> m_csmDataSet;
+
+	// Static shadow caster cache: light space matrices each cascade was last rendered with, and a signature of the static shadow casters it contains
+	std::vector<glm::mat4> m_cachedLightSpaceMatrices;
+	std::size_t m_staticShadowCastersSignature;
+	bool m_staticCasterCacheValid;
+
+	inline static unsigned int m_lastFrameNumOfCascadeReRenders = 0;
 };
\ No newline at end of file
@@ -61,56 +61,7 @@ public:
 		// Calculate local spatial variables if any of them are out-of-date
 		if(!m_localEverythingUpToDate)
 		{
-			if(!m_localPositionUpToDate)
-			{
-				m_localSpace.m_spatialData.m_position = m_localSpace.m_transformMatNoScale[3];
-				m_localPositionUpToDate = true;
-
-				if(m_trackLocalChanges)
-					m_changes |= Systems::Changes::Spatial::LocalPosition;
-			}
-
-			//if(!m_localEulerUpToDate)
-			//{
-			//	m_localSpace.m_spatialData.m_rotationEuler = glm::degrees(glm::eulerAngles(m_localSpace.m_spatialData.m_rotationQuat));
-			//	m_localEulerUpToDate = true;
-			//}
-
-			if(!m_localQuaternionUpToDate)
-			{
-				if(m_localTransformUpToDate)
-				{
-					m_localSpace.m_spatialData.m_rotationQuat = glm::toQuat(m_localSpace.m_transformMatNoScale);
-					const glm::mat3 rotMtx(
-						glm::vec3(m_localSpace.m_transformMatNoScale[0]),
-						glm::vec3(m_localSpace.m_transformMatNoScale[1]),
-						glm::vec3(m_localSpace.m_transformMatNoScale[2]));
-					m_localSpace.m_spatialData.m_rotationQuat = glm::quat_cast(rotMtx);
-				}
-				else
-					m_localSpace.m_spatialData.m_rotationQuat = Math::eulerDegreesToQuaterion(m_localSpace.m_spatialData.m_rotationEuler);
-
-				m_localQuaternionUpToDate = true;
-
-				if(m_trackLocalChanges)
-					m_changes |= Systems::Changes::Spatial::LocalRotation;
-			}
-
-			// Scale SHOULD NEVER need an update, but in case it somehow happens, update it anyway
-			/*/ VERY computationally expensive!
-			if(!m_localScaleUpToDate)
-			{
-				glm::quat rotation;
-				glm::vec3 translation;
-				glm::vec3 skew;
-				glm::vec4 perspective;
-
-				glm::decompose(m_localSpace.m_transformMatNoScale, m_localSpace.m_spatialData.m_scale, rotation, translation, skew, perspective);
-				m_localScaleUpToDate = true;
-
-				if(m_trackLocalChanges)
-					m_changes |= Systems::Changes::Spatial::LocalScale;
-			}*/
+			updateLocalSpatialData();
 
 			if(!m_localTransformUpToDate)
 			{
@@ -144,6 +95,85 @@ public:
 		}
 	}
 
+	// Returns true if the local transform needs to be rebuilt from the local position and rotation. Such updates can be performed in a batch
+	// (SpatialTransformBatch), by calling updateLocalSpatialData(), computing the transforms and passing them to setBatchedTransforms()
+	const inline bool isLocalTransformOutdated() const { return !m_localTransformUpToDate; }
+
+	// Calculate the local position and rotation, if they are out-of-date; local transform is not updated
+	void updateLocalSpatialData()
+	{
+		if(!m_localPositionUpToDate)
+		{
+			m_localSpace.m_spatialData.m_position = m_localSpace.m_transformMatNoScale[3];
+			m_localPositionUpToDate = true;
+
+			if(m_trackLocalChanges)
+				m_changes |= Systems::Changes::Spatial::LocalPosition;
+		}
+
+		//if(!m_localEulerUpToDate)
+		//{
+		//	m_localSpace.m_spatialData.m_rotationEuler = glm::degrees(glm::eulerAngles(m_localSpace.m_spatialData.m_rotationQuat));
+		//	m_localEulerUpToDate = true;
+		//}
+
+		if(!m_localQuaternionUpToDate)
+		{
+			if(m_localTransformUpToDate)
+			{
+				m_localSpace.m_spatialData.m_rotationQuat = glm::toQuat(m_localSpace.m_transformMatNoScale);
+				const glm::mat3 rotMtx(
+					glm::vec3(m_localSpace.m_transformMatNoScale[0]),
+					glm::vec3(m_localSpace.m_transformMatNoScale[1]),
+					glm::vec3(m_localSpace.m_transformMatNoScale[2]));
+				m_localSpace.m_spatialData.m_rotationQuat = glm::quat_cast(rotMtx);
+			}
+			else
+				m_localSpace.m_spatialData.m_rotationQuat = Math::eulerDegreesToQuaterion(m_localSpace.m_spatialData.m_rotationEuler);
+
+			m_localQuaternionUpToDate = true;
+
+			if(m_trackLocalChanges)
+				m_changes |= Systems::Changes::Spatial::LocalRotation;
+		}
+
+		// Scale SHOULD NEVER need an update, but in case it somehow happens, update it anyway
+		/*/ VERY computationally expensive!
+		if(!m_localScaleUpToDate)
+		{
+			glm::quat rotation;
+			glm::vec3 translation;
+			glm::vec3 skew;
+			glm::vec4 perspective;
+
+			glm::decompose(m_localSpace.m_transformMatNoScale, m_localSpace.m_spatialData.m_scale, rotation, translation, skew, perspective);
+			m_localScaleUpToDate = true;
+
+			if(m_trackLocalChanges)
+				m_changes |= Systems::Changes::Spatial::LocalScale;
+		}*/
+	}
+
+	// Set the local and world transforms that were computed in a batch from the current local data, completing the update
+	void setBatchedTransforms(const glm::mat4 &p_localTransform, const glm::mat4 &p_worldTransformNoScale, const glm::mat4 &p_worldTransformWithScale)
+	{
+		m_localSpace.m_transformMatNoScale = p_localTransform;
+		m_localTransformUpToDate = true;
+		m_localEverythingUpToDate = true;
+
+		if(m_trackLocalChanges)
+			m_changes |= Systems::Changes::Spatial::LocalTransformNoScale;
+
+		m_worldTransformNoScale = p_worldTransformNoScale;
+		m_worldTransformWithScale = p_worldTransformWithScale;
+		m_worldTransformUpToDate = true;
+
+		incrementUpdateCount();
+
+		if(!m_trackLocalChanges)
+			m_changes |= Systems::Changes::Spatial::WorldTransformNoScale;
+	}
+
 	// Process spatial changes from the given subject and change type
 	// Returns the changes that have been made; RETURNS ONLY WORLD-SPACE CHANGES BY DEFAULT!
 	BitMask changeOccurred(const ObservedSubject &p_subject, const BitMask p_changeType)
@@ -0,0 +1,277 @@
+#include <algorithm>
+
+#include "Config.h"
+#include "Profiler.h"
+#include "SpatialQueryService.h"
+#include "TaskManagerLocator.h"
+
+namespace
+{
+	// Returns the collision object of a broadphase tree leaf
+	inline btCollisionObject *getLeafCollisionObject(const btDbvtNode *p_leaf)
+	{
+		return static_cast<btCollisionObject *>(static_cast<btBroadphaseProxy *>(p_leaf->data)->m_clientObject);
+	}
+
+	// Finds the closest ray hit among the leaves that the ray passes through
+	struct RayQueryCollider : public btDbvt::ICollide
+	{
+		RayQueryCollider(const btVector3 &p_from, const btVector3 &p_to) : m_fromTransform(btQuaternion::getIdentity(), p_from), m_toTransform(btQuaternion::getIdentity(), p_to), m_resultCallback(p_from, p_to) { }
+
+		void Process(const btDbvtNode *p_leaf)
+		{
+			btCollisionObject *collisionObject = getLeafCollisionObject(p_leaf);
+
+			if(m_resultCallback.needsCollision(collisionObject->getBroadphaseHandle()))
+				btCollisionWorld::rayTestSingle(m_fromTransform, m_toTransform, collisionObject, collisionObject->getCollisionShape(), collisionObject->getWorldTransform(), m_resultCallback);
+		}
+
+		btTransform m_fromTransform;
+		btTransform m_toTransform;
+		btCollisionWorld::ClosestRayResultCallback m_resultCallback;
+	};
+
+	// Finds the closest sweep hit among the leaves that overlap the swept volume
+	struct SphereSweepQueryCollider : public btDbvt::ICollide
+	{
+		SphereSweepQueryCollider(const btVector3 &p_from, const btVector3 &p_to, const btScalar p_radius) : m_sphereShape(p_radius), m_fromTransform(btQuaternion::getIdentity(), p_from), m_toTransform(btQuaternion::getIdentity(), p_to), m_resultCallback(p_from, p_to) { }
+
+		void Process(const btDbvtNode *p_leaf)
+		{
+			btCollisionObject *collisionObject = getLeafCollisionObject(p_leaf);
+
+			if(m_resultCallback.needsCollision(collisionObject->getBroadphaseHandle()))
+				btCollisionWorld::objectQuerySingle(&m_sphereShape, m_fromTransform, m_toTransform, collisionObject, collisionObject->getCollisionShape(), collisionObject->getWorldTransform(), m_resultCallback, btScalar(0.0));
+		}
+
+		btSphereShape m_sphereShape;
+		btTransform m_fromTransform;
+		btTransform m_toTransform;
+		btCollisionWorld::ClosestConvexResultCallback m_resultCallback;
+	};
+
+	// Gathers the entities whose bounds overlap the AABB
+	struct AabbOverlapQueryCollider : public btDbvt::ICollide
+	{
+		AabbOverlapQueryCollider(const btVector3 &p_min, const btVector3 &p_max, FrameVector<EntityID> &p_overlaps) : m_min(p_min), m_max(p_max), m_overlaps(p_overlaps), m_numOfOverlaps(0) { }
+
+		void Process(const btDbvtNode *p_leaf)
+		{
+			const btBroadphaseProxy *proxy = static_cast<const btBroadphaseProxy *>(p_leaf->data);
+
+			// Tree volumes of moving objects are enlarged, so test against the actual bounds of the object
+			if(TestAabbAgainstAabb2(m_min, m_max, proxy->m_aabbMin, proxy->m_aabbMax))
+			{
+				const btCollisionObject *collisionObject = static_cast<const btCollisionObject *>(proxy->m_clientObject);
+
+				if(collisionObject != nullptr && collisionObject->getUserPointer() != nullptr)
+				{
+					m_overlaps.push_back(*static_cast<const EntityID *>(collisionObject->getUserPointer()));
+					m_numOfOverlaps++;
+				}
+			}
+		}
+
+		btVector3 m_min;
+		btVector3 m_max;
+		FrameVector<EntityID> &m_overlaps;
+		unsigned int m_numOfOverlaps;
+	};
+}
+
+SpatialQueryService::SpatialQueryService()
+{
+	m_frontResults = 0;
+	m_nextBatchID = 1;
+	m_lastFrameNumOfQueries = 0;
+}
+
+SpatialQueryService::~SpatialQueryService()
+{
+}
+
+SpatialQueryBatchID SpatialQueryService::submitBatch(const std::span<const SpatialQuery> p_queries)
+{
+	SpinWait::Lock lock(m_pendingMutex);
+
+	if(m_pendingQueries.size() + p_queries.size() > (size_t)std::max(Config::physicsVar().spatial_query_max_queries_per_frame, 0))
+		return 0;
+
+	// Batch ID of zero is reserved for an invalid batch
+	const SpatialQueryBatchID batchID = m_nextBatchID++;
+	if(m_nextBatchID == 0)
+		m_nextBatchID = 1;
+
+	m_pendingBatches.emplace_back(batchID, BatchRange(m_pendingQueries.size(), p_queries.size()));
+	m_pendingQueries.insert(m_pendingQueries.end(), p_queries.begin(), p_queries.end());
+
+	return batchID;
+}
+
+void SpatialQueryService::executeQueries(const btDbvtBroadphase &p_broadphase)
+{
+	// Take the queries submitted so far, so that new batches can be submitted while these are being executed
+	{
+		SpinWait::Lock lock(m_pendingMutex);
+
+		std::swap(m_pendingQueries, m_executingQueries);
+		std::swap(m_pendingBatches, m_executingBatches);
+
+		m_pendingQueries.clear();
+		m_pendingBatches.clear();
+	}
+
+	m_lastFrameNumOfQueries = m_executingQueries.size();
+
+	// Fill the back buffer; the front buffer can still be read while doing so
+	QueryResults &queryResults = m_queryResults[1 - m_frontResults];
+	queryResults.clear();
+
+	if(!m_executingQueries.empty())
+	{
+		PROFILE_ZONE("SpatialQueryService::executeQueries");
+
+		const size_t numOfQueries = m_executingQueries.size();
+		const size_t grainSize = (size_t)std::max(Config::physicsVar().spatial_query_grain_size, 1);
+		const size_t numOfChunks = (numOfQueries + grainSize - 1) / grainSize;
+
+		queryResults.m_results.resize(numOfQueries);
+		m_chunkOverlaps.resize(numOfChunks);
+
+		// Execute each chunk of queries in parallel; the broadphase and the collision objects are only read, as the simulation step has already finished
+		TaskManagerLocator::get().parallelFor(size_t(0), numOfQueries, grainSize, [&](const size_t p_firstQuery)
+			{
+				FrameVector<EntityID> &chunkOverlaps = m_chunkOverlaps[p_firstQuery / grainSize];
+				const size_t lastQuery = std::min(p_firstQuery + grainSize, numOfQueries);
+
+				for(size_t i = p_firstQuery; i < lastQuery; i++)
+					executeQuery(m_executingQueries[i], p_broadphase, queryResults.m_results[i], chunkOverlaps);
+			});
+
+		// Concatenate the overlaps of each chunk in query order, so the overlaps of every batch are contiguous
+		size_t numOfOverlaps = 0;
+		for(const auto &chunkOverlaps : m_chunkOverlaps)
+			numOfOverlaps += chunkOverlaps.size();
+
+		queryResults.m_overlaps.reserve(numOfOverlaps);
+
+		for(const auto &batch : m_executingBatches)
+		{
+			BatchRange batchRange = batch.second;
+			batchRange.m_firstOverlap = queryResults.m_overlaps.size();
+
+			for(size_t i = batchRange.m_firstQuery, lastQuery = batchRange.m_firstQuery + batchRange.m_numOfQueries; i < lastQuery; i++)
+			{
+				SpatialQueryResult &result = queryResults.m_results[i];
+
+				if(result.m_numOfOverlaps > 0)
+				{
+					const auto &chunkOverlaps = m_chunkOverlaps[i / grainSize];
+					const size_t firstOverlap = queryResults.m_overlaps.size();
+
+					queryResults.m_overlaps.insert(queryResults.m_overlaps.end(), chunkOverlaps.begin() + result.m_firstOverlap, chunkOverlaps.begin() + result.m_firstOverlap + result.m_numOfOverlaps);
+
+					// Overlap index is relative to the first overlap of the batch
+					result.m_firstOverlap = (unsigned int)(firstOverlap - batchRange.m_firstOverlap);
+				}
+				else
+					result.m_firstOverlap = 0;
+			}
+
+			batchRange.m_numOfOverlaps = queryResults.m_overlaps.size() - batchRange.m_firstOverlap;
+			queryResults.m_batches[batch.first] = batchRange;
+		}
+
+		// Chunk overlaps were allocated from the frame allocator, so they cannot be kept
+		m_chunkOverlaps.clear();
+	}
+
+	// Publish the results
+	SpinWait::Lock lock(m_resultsMutex);
+	m_frontResults = 1 - m_frontResults;
+}
+
+bool SpatialQueryService::getBatchResults(const SpatialQueryBatchID p_batchID, std::span<const SpatialQueryResult> &p_results, std::span<const EntityID> &p_overlaps)
+{
+	SpinWait::Lock lock(m_resultsMutex);
+
+	const QueryResults &queryResults = m_queryResults[m_frontResults];
+
+	auto batch = queryResults.m_batches.find(p_batchID);
+	if(batch == queryResults.m_batches.end())
+		return false;
+
+	p_results = std::span<const SpatialQueryResult>(queryResults.m_results.data() + batch->second.m_firstQuery, batch->second.m_numOfQueries);
+	p_overlaps = std::span<const EntityID>(queryResults.m_overlaps.data() + batch->second.m_firstOverlap, batch->second.m_numOfOverlaps);
+
+	return true;
+}
+
+void SpatialQueryService::executeQuery(const SpatialQuery &p_query, const btDbvtBroadphase &p_broadphase, SpatialQueryResult &p_result, FrameVector<EntityID> &p_overlaps) const
+{
+	const btVector3 from = Math::toBtVector3(p_query.m_from);
+	const btVector3 to = Math::toBtVector3(p_query.m_to);
+
+	switch(p_query.m_type)
+	{
+		case SpatialQueryType::SpatialQueryType_Ray:
+		{
+			// Traverse both the dynamic and the static broadphase trees; the traversal stack is local, unlike btDbvtBroadphase::rayTest
+			RayQueryCollider rayCollider(from, to);
+			btDbvt::rayTest(p_broadphase.m_sets[0].m_root, from, to, rayCollider);
+			btDbvt::rayTest(p_broadphase.m_sets[1].m_root, from, to, rayCollider);
+
+			if(rayCollider.m_resultCallback.hasHit())
+			{
+				p_result.m_hit = true;
+				p_result.m_entityID = getEntityID(rayCollider.m_resultCallback.m_collisionObject);
+				p_result.m_hitPosition = Math::toGlmVec3(rayCollider.m_resultCallback.m_hitPointWorld);
+				p_result.m_hitNormal = Math::toGlmVec3(rayCollider.m_resultCallback.m_hitNormalWorld);
+				p_result.m_hitFraction = rayCollider.m_resultCallback.m_closestHitFraction;
+			}
+		}
+		break;
+
+		case SpatialQueryType::SpatialQueryType_SphereSweep:
+		{
+			// Bounds of the whole sweep
+			const btVector3 radius(p_query.m_radius, p_query.m_radius, p_query.m_radius);
+			const btDbvtVolume sweepVolume = btDbvtVolume::FromMM(from.min(to) - radius, from.max(to) + radius);
+
+			SphereSweepQueryCollider sweepCollider(from, to, p_query.m_radius);
+			p_broadphase.m_sets[0].collideTV(p_broadphase.m_sets[0].m_root, sweepVolume, sweepCollider);
+			p_broadphase.m_sets[1].collideTV(p_broadphase.m_sets[1].m_root, sweepVolume, sweepCollider);
+
+			if(sweepCollider.m_resultCallback.hasHit())
+			{
+				p_result.m_hit = true;
+				p_result.m_entityID = getEntityID(sweepCollider.m_resultCallback.m_hitCollisionObject);
+				p_result.m_hitPosition = Math::toGlmVec3(sweepCollider.m_resultCallback.m_hitPointWorld);
+				p_result.m_hitNormal = Math::toGlmVec3(sweepCollider.m_resultCallback.m_hitNormalWorld);
+				p_result.m_hitFraction = sweepCollider.m_resultCallback.m_closestHitFraction;
+			}
+		}
+		break;
+
+		case SpatialQueryType::SpatialQueryType_AabbOverlap:
+		{
+			const btDbvtVolume aabbVolume = btDbvtVolume::FromMM(from, to);
+
+			// Overlap index is relative to the chunk overlap array, until the overlaps are concatenated
+			p_result.m_firstOverlap = (unsigned int)p_overlaps.size();
+
+			AabbOverlapQueryCollider overlapCollider(from, to, p_overlaps);
+			p_broadphase.m_sets[0].collideTV(p_broadphase.m_sets[0].m_root, aabbVolume, overlapCollider);
+			p_broadphase.m_sets[1].collideTV(p_broadphase.m_sets[1].m_root, aabbVolume, overlapCollider);
+
+			p_result.m_numOfOverlaps = overlapCollider.m_numOfOverlaps;
+
+			if(p_result.m_numOfOverlaps > 0)
+			{
+				p_result.m_hit = true;
+				p_result.m_entityID = p_overlaps[p_result.m_firstOverlap];
+			}
+		}
+		break;
+	}
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <bullet3/btBulletDynamicsCommon.h>
+#include <bullet3/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+
+#include "CommonDefinitions.h"
+#include "FrameAllocator.h"
+#include "Math.h"
+#include "SpinWait.h"
+
+// Identifies a submitted batch of spatial queries; zero is never a valid batch
+typedef unsigned int SpatialQueryBatchID;
+
+enum SpatialQueryType : unsigned int
+{
+	SpatialQueryType_Ray = 0,
+	SpatialQueryType_SphereSweep,
+	SpatialQueryType_AabbOverlap,
+	SpatialQueryType_NumOfTypes
+};
+
+// A single spatial query: a ray (from -> to), a sphere sweep (sphere of radius moved from -> to), or an AABB overlap (min = from, max = to)
+struct SpatialQuery
+{
+	SpatialQuery() : m_type(SpatialQueryType::SpatialQueryType_Ray), m_from(0.0f), m_to(0.0f), m_radius(0.0f) { }
+	SpatialQuery(const SpatialQueryType p_type, const glm::vec3 &p_from, const glm::vec3 &p_to, const float p_radius = 0.0f) : m_type(p_type), m_from(p_from), m_to(p_to), m_radius(p_radius) { }
+
+	static inline SpatialQuery ray(const glm::vec3 &p_from, const glm::vec3 &p_to) { return SpatialQuery(SpatialQueryType::SpatialQueryType_Ray, p_from, p_to); }
+	static inline SpatialQuery sphereSweep(const glm::vec3 &p_from, const glm::vec3 &p_to, const float p_radius) { return SpatialQuery(SpatialQueryType::SpatialQueryType_SphereSweep, p_from, p_to, p_radius); }
+	static inline SpatialQuery aabbOverlap(const glm::vec3 &p_min, const glm::vec3 &p_max) { return SpatialQuery(SpatialQueryType::SpatialQueryType_AabbOverlap, p_min, p_max); }
+
+	SpatialQueryType m_type;
+	glm::vec3 m_from;
+	glm::vec3 m_to;
+	float m_radius;
+};
+
+// Result of a single spatial query. Ray and sweep queries report the closest hit; AABB overlap queries report the range
+// of overlapping entities inside the overlap array of the batch (and the first overlapping entity as the hit entity)
+struct SpatialQueryResult
+{
+	SpatialQueryResult() : m_hitPosition(0.0f), m_hitNormal(0.0f), m_hitFraction(1.0f), m_entityID(NULL_ENTITY_ID), m_firstOverlap(0), m_numOfOverlaps(0), m_hit(false) { }
+
+	glm::vec3 m_hitPosition;
+	glm::vec3 m_hitNormal;
+	float m_hitFraction;
+	EntityID m_entityID;
+	unsigned int m_firstOverlap;
+	unsigned int m_numOfOverlaps;
+	bool m_hit;
+};
+
+// Collects batches of spatial queries (raycasts, sphere sweeps and AABB overlaps) submitted from any thread during a frame,
+// executes them all in parallel after the physics simulation step, and publishes the results in contiguous arrays that
+// can be read during the next frame. Queries go directly through the broadphase trees (with a local traversal stack per query),
+// as the broadphase ray test itself uses a shared stack and is not safe to call from multiple threads.
+class SpatialQueryService
+{
+public:
+	SpatialQueryService();
+	~SpatialQueryService();
+
+	// Queues a batch of queries for execution after the next simulation step; can be called from any thread.
+	// Returns the ID of the batch, used to retrieve its results, or zero if the per-frame query limit was reached
+	SpatialQueryBatchID submitBatch(const std::span<const SpatialQuery> p_queries);
+
+	// Executes all queued queries and publishes their results; must only be called by the physics scene, after the simulation step
+	void executeQueries(const btDbvtBroadphase &p_broadphase);
+
+	// Retrieves the results of a batch (one result per query, in the submitted order), and the overlapping entities of its AABB overlap queries.
+	// Returns false if the batch has not been executed yet or its results are no longer available (results are kept for one frame).
+	// Returned arrays stay valid until the end of the next frame
+	bool getBatchResults(const SpatialQueryBatchID p_batchID, std::span<const SpatialQueryResult> &p_results, std::span<const EntityID> &p_overlaps);
+
+	// Getters
+	inline size_t getLastFrameNumOfQueries() const { return m_lastFrameNumOfQueries; }
+
+private:
+	struct BatchRange
+	{
+		BatchRange() : m_firstQuery(0), m_numOfQueries(0), m_firstOverlap(0), m_numOfOverlaps(0) { }
+		BatchRange(const size_t p_firstQuery, const size_t p_numOfQueries) : m_firstQuery(p_firstQuery), m_numOfQueries(p_numOfQueries), m_firstOverlap(0), m_numOfOverlaps(0) { }
+
+		size_t m_firstQuery;
+		size_t m_numOfQueries;
+		size_t m_firstOverlap;
+		size_t m_numOfOverlaps;
+	};
+
+	// Results of all the batches of a single frame
+	struct QueryResults
+	{
+		void clear()
+		{
+			m_results.clear();
+			m_overlaps.clear();
+			m_batches.clear();
+		}
+
+		std::vector<SpatialQueryResult> m_results;
+		std::vector<EntityID> m_overlaps;
+		std::unordered_map<SpatialQueryBatchID, BatchRange> m_batches;
+	};
+
+	// Executes a single query; overlapping entities of an AABB overlap query are appended to the given array
+	void executeQuery(const SpatialQuery &p_query, const btDbvtBroadphase &p_broadphase, SpatialQueryResult &p_result, FrameVector<EntityID> &p_overlaps) const;
+
+	// Returns the entity ID of the collision object, if it belongs to a rigid body
+	static inline EntityID getEntityID(const btCollisionObject *p_collisionObject)
+	{
+		if(p_collisionObject != nullptr && p_collisionObject->getUserPointer() != nullptr)
+			return *static_cast<const EntityID *>(p_collisionObject->getUserPointer());
+
+		return NULL_ENTITY_ID;
+	}
+
+	// Queries submitted during the current frame, and the batches they belong to
+	std::vector<SpatialQuery> m_pendingQueries;
+	std::vector<std::pair<SpatialQueryBatchID, BatchRange>> m_pendingBatches;
+	SpinWait m_pendingMutex;
+
+	// Queries taken out of the pending array for execution (kept, to reuse their memory)
+	std::vector<SpatialQuery> m_executingQueries;
+	std::vector<std::pair<SpatialQueryBatchID, BatchRange>> m_executingBatches;
+
+	// Overlapping entities gathered by each chunk of queries during the parallel execution, before being concatenated
+	std::vector<FrameVector<EntityID>> m_chunkOverlaps;
+
+	// Double-buffered results: the front buffer is read while the back buffer is filled during the execution
+	QueryResults m_queryResults[2];
+	unsigned int m_frontResults;
+	SpinWait m_resultsMutex;
+
+	SpatialQueryBatchID m_nextBatchID;
+	size_t m_lastFrameNumOfQueries;
+};
@@ -0,0 +1,313 @@
+#include "SpatialTransformBatch.h"
+
+#if SETTING_TRANSFORM_BATCH_SIMD > 0
+#include <immintrin.h>
+#endif
+
+void SpatialTransformBatch::clear()
+{
+	m_positionX.clear();
+	m_positionY.clear();
+	m_positionZ.clear();
+	m_rotationX.clear();
+	m_rotationY.clear();
+	m_rotationZ.clear();
+	m_rotationW.clear();
+	m_scaleX.clear();
+	m_scaleY.clear();
+	m_scaleZ.clear();
+	m_parentIndices.clear();
+	m_parentTransforms.clear();
+}
+
+void SpatialTransformBatch::reserve(const std::size_t p_numOfEntries)
+{
+	m_positionX.reserve(p_numOfEntries);
+	m_positionY.reserve(p_numOfEntries);
+	m_positionZ.reserve(p_numOfEntries);
+	m_rotationX.reserve(p_numOfEntries);
+	m_rotationY.reserve(p_numOfEntries);
+	m_rotationZ.reserve(p_numOfEntries);
+	m_rotationW.reserve(p_numOfEntries);
+	m_scaleX.reserve(p_numOfEntries);
+	m_scaleY.reserve(p_numOfEntries);
+	m_scaleZ.reserve(p_numOfEntries);
+	m_parentIndices.reserve(p_numOfEntries);
+	m_parentTransforms.reserve(p_numOfEntries);
+}
+
+void SpatialTransformBatch::computeTransforms()
+{
+	resizeOutput();
+
+	std::size_t numOfProcessed = 0;
+
+#if SETTING_TRANSFORM_BATCH_SIMD >= 2
+	const std::size_t numOfAVX2 = size() - size() % 8;
+	computeTransformsAVX2(0, numOfAVX2);
+	numOfProcessed = numOfAVX2;
+#endif
+
+#if SETTING_TRANSFORM_BATCH_SIMD >= 1
+	const std::size_t numOfSSE = numOfProcessed + (size() - numOfProcessed) - (size() - numOfProcessed) % 4;
+	computeTransformsSSE(numOfProcessed, numOfSSE);
+	numOfProcessed = numOfSSE;
+#endif
+
+	computeTransformsScalar(numOfProcessed, size());
+}
+
+void SpatialTransformBatch::computeTransformsScalar()
+{
+	resizeOutput();
+
+	computeTransformsScalar(0, size());
+}
+
+void SpatialTransformBatch::computeTransformsScalar(const std::size_t p_begin, const std::size_t p_end)
+{
+	for(std::size_t i = p_begin; i < p_end; i++)
+	{
+		const float x = m_rotationX[i];
+		const float y = m_rotationY[i];
+		const float z = m_rotationZ[i];
+		const float w = m_rotationW[i];
+
+		const float xx = x * x, yy = y * y, zz = z * z;
+		const float xy = x * y, xz = x * z, yz = y * z;
+		const float wx = w * x, wy = w * y, wz = w * z;
+
+		// Translation multiplied by the rotation matrix of the quaternion (same as glm::mat3_cast)
+		glm::mat4 &localTransform = m_localTransforms[i];
+		localTransform[0] = glm::vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f);
+		localTransform[1] = glm::vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f);
+		localTransform[2] = glm::vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f);
+		localTransform[3] = glm::vec4(m_positionX[i], m_positionY[i], m_positionZ[i], 1.0f);
+
+		const glm::mat4 &parentTransform = getParentTransform(i);
+
+		glm::mat4 &worldTransform = m_worldTransformsNoScale[i];
+		worldTransform[0] = parentTransform[0] * localTransform[0][0] + parentTransform[1] * localTransform[0][1] + parentTransform[2] * localTransform[0][2];
+		worldTransform[1] = parentTransform[0] * localTransform[1][0] + parentTransform[1] * localTransform[1][1] + parentTransform[2] * localTransform[1][2];
+		worldTransform[2] = parentTransform[0] * localTransform[2][0] + parentTransform[1] * localTransform[2][1] + parentTransform[2] * localTransform[2][2];
+		worldTransform[3] = parentTransform[0] * localTransform[3][0] + parentTransform[1] * localTransform[3][1] + parentTransform[2] * localTransform[3][2] + parentTransform[3];
+
+		glm::mat4 &worldTransformWithScale = m_worldTransformsWithScale[i];
+		worldTransformWithScale[0] = worldTransform[0] * m_scaleX[i];
+		worldTransformWithScale[1] = worldTransform[1] * m_scaleY[i];
+		worldTransformWithScale[2] = worldTransform[2] * m_scaleZ[i];
+		worldTransformWithScale[3] = worldTransform[3];
+	}
+}
+
+#if SETTING_TRANSFORM_BATCH_SIMD >= 1
+// Transposes the given rows (one element of four matrices each) and stores them as the given column of four consecutive matrices
+static inline void storeColumnsSSE(__m128 p_row0, __m128 p_row1, __m128 p_row2, __m128 p_row3, glm::mat4 *p_matrices, const int p_column)
+{
+	_MM_TRANSPOSE4_PS(p_row0, p_row1, p_row2, p_row3);
+
+	_mm_storeu_ps(&p_matrices[0][p_column][0], p_row0);
+	_mm_storeu_ps(&p_matrices[1][p_column][0], p_row1);
+	_mm_storeu_ps(&p_matrices[2][p_column][0], p_row2);
+	_mm_storeu_ps(&p_matrices[3][p_column][0], p_row3);
+}
+#endif
+
+void SpatialTransformBatch::computeTransformsSSE(const std::size_t p_begin, const std::size_t p_end)
+{
+#if SETTING_TRANSFORM_BATCH_SIMD >= 1
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+
+	for(std::size_t i = p_begin; i < p_end; i += 4)
+	{
+		const __m128 x = _mm_loadu_ps(&m_rotationX[i]);
+		const __m128 y = _mm_loadu_ps(&m_rotationY[i]);
+		const __m128 z = _mm_loadu_ps(&m_rotationZ[i]);
+		const __m128 w = _mm_loadu_ps(&m_rotationW[i]);
+
+		const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+		const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+		const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+		// Local transform, each variable holds one element of the four matrices (column, row)
+		__m128 local[4][3];
+		local[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+		local[0][1] = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+		local[0][2] = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+		local[1][0] = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+		local[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+		local[1][2] = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+		local[2][0] = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+		local[2][1] = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+		local[2][2] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+		local[3][0] = _mm_loadu_ps(&m_positionX[i]);
+		local[3][1] = _mm_loadu_ps(&m_positionY[i]);
+		local[3][2] = _mm_loadu_ps(&m_positionZ[i]);
+
+		// Load the parent transforms, transposing each column of the four matrices into rows
+		__m128 parent[4][4];
+		for(int column = 0; column < 4; column++)
+		{
+			parent[column][0] = _mm_loadu_ps(&getParentTransform(i + 0)[column][0]);
+			parent[column][1] = _mm_loadu_ps(&getParentTransform(i + 1)[column][0]);
+			parent[column][2] = _mm_loadu_ps(&getParentTransform(i + 2)[column][0]);
+			parent[column][3] = _mm_loadu_ps(&getParentTransform(i + 3)[column][0]);
+			_MM_TRANSPOSE4_PS(parent[column][0], parent[column][1], parent[column][2], parent[column][3]);
+		}
+
+		// World transform = parent transform * local transform
+		__m128 world[4][4];
+		for(int column = 0; column < 4; column++)
+			for(int row = 0; row < 4; row++)
+			{
+				world[column][row] = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(parent[0][row], local[column][0]),
+					_mm_mul_ps(parent[1][row], local[column][1])),
+					_mm_mul_ps(parent[2][row], local[column][2]));
+
+				if(column == 3)
+					world[column][row] = _mm_add_ps(world[column][row], parent[3][row]);
+			}
+
+		const __m128 scale[3] = { _mm_loadu_ps(&m_scaleX[i]), _mm_loadu_ps(&m_scaleY[i]), _mm_loadu_ps(&m_scaleZ[i]) };
+
+		for(int column = 0; column < 3; column++)
+		{
+			storeColumnsSSE(local[column][0], local[column][1], local[column][2], zero, &m_localTransforms[i], column);
+			storeColumnsSSE(world[column][0], world[column][1], world[column][2], world[column][3], &m_worldTransformsNoScale[i], column);
+			storeColumnsSSE(
+				_mm_mul_ps(world[column][0], scale[column]),
+				_mm_mul_ps(world[column][1], scale[column]),
+				_mm_mul_ps(world[column][2], scale[column]),
+				_mm_mul_ps(world[column][3], scale[column]),
+				&m_worldTransformsWithScale[i], column);
+		}
+		storeColumnsSSE(local[3][0], local[3][1], local[3][2], one, &m_localTransforms[i], 3);
+		storeColumnsSSE(world[3][0], world[3][1], world[3][2], world[3][3], &m_worldTransformsNoScale[i], 3);
+		storeColumnsSSE(world[3][0], world[3][1], world[3][2], world[3][3], &m_worldTransformsWithScale[i], 3);
+	}
+#else
+	computeTransformsScalar(p_begin, p_end);
+#endif
+}
+
+#if SETTING_TRANSFORM_BATCH_SIMD >= 2
+// Transposes the given rows (one element of eight matrices each) and stores them as the given column of eight consecutive matrices
+static inline void storeColumnsAVX2(const __m256 p_row0, const __m256 p_row1, const __m256 p_row2, const __m256 p_row3, glm::mat4 *p_matrices, const int p_column)
+{
+	const __m256 row01Low = _mm256_unpacklo_ps(p_row0, p_row1);
+	const __m256 row01High = _mm256_unpackhi_ps(p_row0, p_row1);
+	const __m256 row23Low = _mm256_unpacklo_ps(p_row2, p_row3);
+	const __m256 row23High = _mm256_unpackhi_ps(p_row2, p_row3);
+
+	// Each result holds the column of a matrix in the lower lane, and the column of the matrix four places further in the upper lane
+	const __m256 column04 = _mm256_shuffle_ps(row01Low, row23Low, _MM_SHUFFLE(1, 0, 1, 0));
+	const __m256 column15 = _mm256_shuffle_ps(row01Low, row23Low, _MM_SHUFFLE(3, 2, 3, 2));
+	const __m256 column26 = _mm256_shuffle_ps(row01High, row23High, _MM_SHUFFLE(1, 0, 1, 0));
+	const __m256 column37 = _mm256_shuffle_ps(row01High, row23High, _MM_SHUFFLE(3, 2, 3, 2));
+
+	_mm_storeu_ps(&p_matrices[0][p_column][0], _mm256_castps256_ps128(column04));
+	_mm_storeu_ps(&p_matrices[1][p_column][0], _mm256_castps256_ps128(column15));
+	_mm_storeu_ps(&p_matrices[2][p_column][0], _mm256_castps256_ps128(column26));
+	_mm_storeu_ps(&p_matrices[3][p_column][0], _mm256_castps256_ps128(column37));
+	_mm_storeu_ps(&p_matrices[4][p_column][0], _mm256_extractf128_ps(column04, 1));
+	_mm_storeu_ps(&p_matrices[5][p_column][0], _mm256_extractf128_ps(column15, 1));
+	_mm_storeu_ps(&p_matrices[6][p_column][0], _mm256_extractf128_ps(column26, 1));
+	_mm_storeu_ps(&p_matrices[7][p_column][0], _mm256_extractf128_ps(column37, 1));
+}
+#endif
+
+void SpatialTransformBatch::computeTransformsAVX2(const std::size_t p_begin, const std::size_t p_end)
+{
+#if SETTING_TRANSFORM_BATCH_SIMD >= 2
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 two = _mm256_set1_ps(2.0f);
+	const __m256i noParent = _mm256_set1_epi32(-1);
+
+	for(std::size_t i = p_begin; i < p_end; i += 8)
+	{
+		const __m256 x = _mm256_loadu_ps(&m_rotationX[i]);
+		const __m256 y = _mm256_loadu_ps(&m_rotationY[i]);
+		const __m256 z = _mm256_loadu_ps(&m_rotationZ[i]);
+		const __m256 w = _mm256_loadu_ps(&m_rotationW[i]);
+
+		const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+		const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+		const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+		// Local transform, each variable holds one element of the eight matrices (column, row)
+		__m256 local[4][3];
+		local[0][0] = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+		local[0][1] = _mm256_mul_ps(two, _mm256_add_ps(xy, wz));
+		local[0][2] = _mm256_mul_ps(two, _mm256_sub_ps(xz, wy));
+		local[1][0] = _mm256_mul_ps(two, _mm256_sub_ps(xy, wz));
+		local[1][1] = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+		local[1][2] = _mm256_mul_ps(two, _mm256_add_ps(yz, wx));
+		local[2][0] = _mm256_mul_ps(two, _mm256_add_ps(xz, wy));
+		local[2][1] = _mm256_mul_ps(two, _mm256_sub_ps(yz, wx));
+		local[2][2] = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+		local[3][0] = _mm256_loadu_ps(&m_positionX[i]);
+		local[3][1] = _mm256_loadu_ps(&m_positionY[i]);
+		local[3][2] = _mm256_loadu_ps(&m_positionZ[i]);
+
+		// Gather the parent transforms; entries without a parent are masked out and get the identity matrix elements instead
+		const __m256i parentIndices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&m_parentIndices[i]));
+		const __m256 parentMask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(parentIndices, noParent));
+		const __m256i parentOffsets = _mm256_slli_epi32(parentIndices, 4);
+		const float *parentData = m_parentTransforms.empty() ? nullptr : &m_parentTransforms[0][0][0];
+
+		__m256 parent[4][4];
+		for(int column = 0; column < 4; column++)
+			for(int row = 0; row < 4; row++)
+				parent[column][row] = _mm256_mask_i32gather_ps(
+					column == row ? one : zero,
+					parentData,
+					_mm256_add_epi32(parentOffsets, _mm256_set1_epi32(column * 4 + row)),
+					parentMask,
+					4);
+
+		// World transform = parent transform * local transform
+		__m256 world[4][4];
+		for(int column = 0; column < 4; column++)
+			for(int row = 0; row < 4; row++)
+			{
+				world[column][row] = _mm256_add_ps(_mm256_add_ps(
+					_mm256_mul_ps(parent[0][row], local[column][0]),
+					_mm256_mul_ps(parent[1][row], local[column][1])),
+					_mm256_mul_ps(parent[2][row], local[column][2]));
+
+				if(column == 3)
+					world[column][row] = _mm256_add_ps(world[column][row], parent[3][row]);
+			}
+
+		const __m256 scale[3] = { _mm256_loadu_ps(&m_scaleX[i]), _mm256_loadu_ps(&m_scaleY[i]), _mm256_loadu_ps(&m_scaleZ[i]) };
+
+		for(int column = 0; column < 3; column++)
+		{
+			storeColumnsAVX2(local[column][0], local[column][1], local[column][2], zero, &m_localTransforms[i], column);
+			storeColumnsAVX2(world[column][0], world[column][1], world[column][2], world[column][3], &m_worldTransformsNoScale[i], column);
+			storeColumnsAVX2(
+				_mm256_mul_ps(world[column][0], scale[column]),
+				_mm256_mul_ps(world[column][1], scale[column]),
+				_mm256_mul_ps(world[column][2], scale[column]),
+				_mm256_mul_ps(world[column][3], scale[column]),
+				&m_worldTransformsWithScale[i], column);
+		}
+		storeColumnsAVX2(local[3][0], local[3][1], local[3][2], one, &m_localTransforms[i], 3);
+		storeColumnsAVX2(world[3][0], world[3][1], world[3][2], world[3][3], &m_worldTransformsNoScale[i], 3);
+		storeColumnsAVX2(world[3][0], world[3][1], world[3][2], world[3][3], &m_worldTransformsWithScale[i], 3);
+	}
+#else
+	computeTransformsSSE(p_begin, p_end);
+#endif
+}
+
+void SpatialTransformBatch::resizeOutput()
+{
+	m_localTransforms.resize(size());
+	m_worldTransformsNoScale.resize(size());
+	m_worldTransformsWithScale.resize(size());
+}
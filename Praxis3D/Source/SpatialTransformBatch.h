@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+
+#include "EngineDefinitions.h"
+#include "Math.h"
+
+// Structure-of-arrays batch of spatial transforms, that computes the local and world transform matrices of all its entries at once.
+// Each entry consists of a local position, rotation quaternion and scale, and an index of its parent world transform (or -1 for no parent).
+// Entries are processed 8 (AVX2) or 4 (SSE) at a time, depending on SETTING_TRANSFORM_BATCH_SIMD, with a scalar fallback for the remaining entries.
+// Produces the same matrices as building the local transform with Math::createTransformMat, multiplying it by the parent transform and applying scale.
+// Parent transforms must already be final (they are not computed within the same batch), as parent-child transforms are propagated by the change controller
+class SpatialTransformBatch
+{
+public:
+	SpatialTransformBatch() { }
+	~SpatialTransformBatch() { }
+
+	// Remove all entries and parent transforms, keeping the allocated memory
+	void clear();
+
+	void reserve(const std::size_t p_numOfEntries);
+
+	// Add a parent world transform, that can be referenced by entries; returns the index of the parent transform
+	inline int addParentTransform(const glm::mat4 &p_transform)
+	{
+		m_parentTransforms.push_back(p_transform);
+		return (int)m_parentTransforms.size() - 1;
+	}
+
+	// Add an entry; returns the index of the entry, used for retrieving the computed transforms
+	inline std::size_t addEntry(const glm::vec3 &p_position, const glm::quat &p_rotation, const glm::vec3 &p_scale, const int p_parentIndex)
+	{
+		m_positionX.push_back(p_position.x);
+		m_positionY.push_back(p_position.y);
+		m_positionZ.push_back(p_position.z);
+		m_rotationX.push_back(p_rotation.x);
+		m_rotationY.push_back(p_rotation.y);
+		m_rotationZ.push_back(p_rotation.z);
+		m_rotationW.push_back(p_rotation.w);
+		m_scaleX.push_back(p_scale.x);
+		m_scaleY.push_back(p_scale.y);
+		m_scaleZ.push_back(p_scale.z);
+		m_parentIndices.push_back(p_parentIndex);
+
+		return m_parentIndices.size() - 1;
+	}
+
+	// Compute the transforms of all entries, using the widest instruction set that is enabled
+	void computeTransforms();
+
+	// Compute the transforms of all entries, using scalar code only
+	void computeTransformsScalar();
+
+	inline std::size_t size() const { return m_parentIndices.size(); }
+	inline bool empty() const { return m_parentIndices.empty(); }
+
+	// Local transform without scale (translation and rotation)
+	const inline glm::mat4 &getLocalTransform(const std::size_t p_index) const { return m_localTransforms[p_index]; }
+
+	// Parent transform multiplied by the local transform
+	const inline glm::mat4 &getWorldTransformNoScale(const std::size_t p_index) const { return m_worldTransformsNoScale[p_index]; }
+
+	// World transform with the local scale applied
+	const inline glm::mat4 &getWorldTransformWithScale(const std::size_t p_index) const { return m_worldTransformsWithScale[p_index]; }
+
+private:
+	// Compute the transforms of the entries in the given range
+	void computeTransformsScalar(const std::size_t p_begin, const std::size_t p_end);
+	void computeTransformsSSE(const std::size_t p_begin, const std::size_t p_end);
+	void computeTransformsAVX2(const std::size_t p_begin, const std::size_t p_end);
+
+	// Resize the output arrays to match the number of entries
+	void resizeOutput();
+
+	inline const glm::mat4 &getParentTransform(const std::size_t p_index) const
+	{
+		static const glm::mat4 identity(1.0f);
+		return m_parentIndices[p_index] < 0 ? identity : m_parentTransforms[m_parentIndices[p_index]];
+	}
+
+	// Input
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_positionZ;
+	std::vector<float> m_rotationX;
+	std::vector<float> m_rotationY;
+	std::vector<float> m_rotationZ;
+	std::vector<float> m_rotationW;
+	std::vector<float> m_scaleX;
+	std::vector<float> m_scaleY;
+	std::vector<float> m_scaleZ;
+	std::vector<int> m_parentIndices;
+	std::vector<glm::mat4> m_parentTransforms;
+
+	// Output
+	std::vector<glm::mat4> m_localTransforms;
+	std::vector<glm::mat4> m_worldTransformsNoScale;
+	std::vector<glm::mat4> m_worldTransformsWithScale;
+};
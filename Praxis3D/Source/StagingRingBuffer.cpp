@@ -0,0 +1,158 @@
+#include "StagingRingBuffer.h"
+
+StagingRingBuffer::StagingRingBuffer() : m_memoryTracker(MemoryTag_RendererBuffers)
+{
+	m_handle = 0;
+	m_mappedData = nullptr;
+	m_size = 0;
+	m_head = 0;
+	m_tail = 0;
+	m_allocatedSize = 0;
+	m_unfencedSize = 0;
+}
+
+StagingRingBuffer::~StagingRingBuffer()
+{
+	release();
+}
+
+ErrorCode StagingRingBuffer::init(const int64_t p_size)
+{
+	// Make sure there is only one buffer
+	release();
+
+	if(p_size <= 0)
+		return ErrorCode::Staging_buffer_failed;
+
+	// Immutable buffer storage is required for persistent mapping
+	if(!(GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) || glBufferStorage == nullptr)
+		return ErrorCode::Staging_buffer_failed;
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	// Create the buffer and keep it mapped for its whole lifetime
+	glGenBuffers(1, &m_handle);
+	glBindBuffer(GL_COPY_READ_BUFFER, m_handle);
+	glBufferStorage(GL_COPY_READ_BUFFER, p_size, nullptr, flags);
+	m_mappedData = static_cast<unsigned char *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, p_size, flags));
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+	if(m_mappedData == nullptr)
+	{
+		glDeleteBuffers(1, &m_handle);
+		m_handle = 0;
+		return ErrorCode::Staging_buffer_failed;
+	}
+
+	m_size = p_size;
+	m_memoryTracker.setSize(MemoryType_VRAM, m_size);
+
+	return ErrorCode::Success;
+}
+
+void StagingRingBuffer::release()
+{
+	// Delete all the fences; the GL defers the deletion of the buffer until the GPU is done with it
+	while(!m_fencedRegions.empty())
+	{
+		glDeleteSync(m_fencedRegions.front().m_fence);
+		m_fencedRegions.pop();
+	}
+
+	if(m_handle != 0)
+	{
+		if(m_mappedData != nullptr)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, m_handle);
+			glUnmapBuffer(GL_COPY_READ_BUFFER);
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		}
+
+		glDeleteBuffers(1, &m_handle);
+	}
+
+	m_handle = 0;
+	m_mappedData = nullptr;
+	m_size = 0;
+	m_head = 0;
+	m_tail = 0;
+	m_allocatedSize = 0;
+	m_unfencedSize = 0;
+	m_memoryTracker.setSize(MemoryType_VRAM, 0);
+}
+
+bool StagingRingBuffer::allocate(const int64_t p_size, int64_t &p_offset)
+{
+	if(!isInitialized() || p_size <= 0 || p_size > m_size)
+		return false;
+
+	// When nothing is in use, start from the beginning of the buffer, to get the largest contiguous region
+	if(m_allocatedSize == 0)
+	{
+		m_head = 0;
+		m_tail = 0;
+	}
+
+	const int64_t alignedHead = (m_head + m_alignment - 1) / m_alignment * m_alignment;
+	int64_t offset = 0;
+
+	if(m_head > m_tail || m_allocatedSize == 0)
+	{
+		// Free space is after the head and before the tail
+		if(alignedHead + p_size <= m_size)
+			offset = alignedHead;
+		else
+			if(p_size <= m_tail)
+				offset = 0;
+			else
+				return false;
+	}
+	else
+	{
+		// Free space is between the head and the tail
+		if(alignedHead + p_size <= m_tail)
+			offset = alignedHead;
+		else
+			return false;
+	}
+
+	// Count the alignment padding, or the skipped space at the end of the buffer when wrapping around, as allocated
+	const int64_t allocatedSize = offset >= m_head ? offset + p_size - m_head : m_size - m_head + p_size;
+
+	m_head = offset + p_size;
+	m_allocatedSize += allocatedSize;
+	m_unfencedSize += allocatedSize;
+
+	p_offset = offset;
+
+	return true;
+}
+
+void StagingRingBuffer::fenceAllocations()
+{
+	if(m_unfencedSize > 0)
+	{
+		m_fencedRegions.emplace(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_head, m_unfencedSize);
+		m_unfencedSize = 0;
+	}
+}
+
+void StagingRingBuffer::reclaimCompletedAllocations()
+{
+	while(!m_fencedRegions.empty())
+	{
+		FencedRegion &region = m_fencedRegions.front();
+
+		// Poll the fence without waiting; fences are signaled in order, so stop at the first one that is still pending
+		const GLenum result = glClientWaitSync(region.m_fence, 0, 0);
+		if(result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+			break;
+
+		glDeleteSync(region.m_fence);
+
+		m_tail = region.m_end;
+		m_allocatedSize -= region.m_size;
+
+		m_fencedRegions.pop();
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <queue>
+#include <stdint.h>
+
+#include "ErrorCodes.h"
+#include "MemoryTracker.h"
+
+// Persistently mapped buffer, used as the source of GPU uploads, so that object data can be copied into it from worker threads and
+// transferred to video memory by the driver asynchronously (with glCopyBufferSubData and pixel-unpack texture uploads).
+// Space is allocated linearly and wraps around; all the allocations made between two fences are guarded by a single fence sync,
+// and their space is only reused after the GPU has signaled that it has finished reading from it.
+// Requires ARB_buffer_storage (OpenGL 4.4); when it is not supported, the buffer fails to initialize and uploads are done directly
+class StagingRingBuffer
+{
+public:
+	StagingRingBuffer();
+	~StagingRingBuffer();
+
+	// Create the buffer and map it persistently; must be called on the thread that owns the GL context
+	ErrorCode init(const int64_t p_size);
+
+	// Unmap and delete the buffer, and delete all pending fences
+	void release();
+
+	// Allocate a contiguous region of the given size; returns false if there is not enough free space (the region is not allocated)
+	bool allocate(const int64_t p_size, int64_t &p_offset);
+
+	// Place a fence after all the GPU commands issued so far, that guards every allocation made since the last fence
+	void fenceAllocations();
+
+	// Free the space of every fenced allocation that the GPU has finished with; never waits for the GPU
+	void reclaimCompletedAllocations();
+
+	// Returns a CPU pointer to the given offset in the buffer; the memory is write-only and coherent
+	inline unsigned char *getMappedData(const int64_t p_offset) const { return m_mappedData + p_offset; }
+
+	inline unsigned int getHandle() const { return m_handle; }
+	inline int64_t getSize() const { return m_size; }
+	inline int64_t getAllocatedSize() const { return m_allocatedSize; }
+	inline bool isInitialized() const { return m_mappedData != nullptr; }
+
+private:
+	struct FencedRegion
+	{
+		FencedRegion(GLsync p_fence, const int64_t p_end, const int64_t p_size) : m_fence(p_fence), m_end(p_end), m_size(p_size) { }
+
+		GLsync m_fence;
+
+		// Buffer position right after the last allocation guarded by the fence
+		int64_t m_end;
+
+		// Number of bytes guarded by the fence (including the space skipped when wrapping around)
+		int64_t m_size;
+	};
+
+	// Alignment of each allocation; satisfies the alignment requirements of vertex data and pixel unpack offsets
+	static constexpr int64_t m_alignment = 256;
+
+	unsigned int m_handle;
+	unsigned char *m_mappedData;
+	int64_t m_size;
+
+	// Position of the next allocation
+	int64_t m_head;
+
+	// Position of the oldest allocation that is still in use
+	int64_t m_tail;
+
+	// Number of bytes in use, both fenced and not yet fenced
+	int64_t m_allocatedSize;
+
+	// Number of bytes allocated since the last fence
+	int64_t m_unfencedSize;
+
+	std::queue<FencedRegion> m_fencedRegions;
+
+	MemoryTrackerEntry m_memoryTracker;
+};
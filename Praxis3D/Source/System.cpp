@@ -26,9 +26,9 @@ SystemObject::~SystemObject()
 	}
 }
 
-std::vector<SystemObject*> SystemScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> SystemScene::getComponents(const EntityID p_entityID)
 {
-	return std::vector<SystemObject *>();
+	return FrameVector<SystemObject *>();
 }
 
 std::vector<SystemObject*> SystemScene::createComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading)
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "Config.h"
+#include "FrameAllocator.h"
 #include "ObserverBase.h"
 #include "PropertySet.h"
 
@@ -95,7 +96,8 @@ public:
 	virtual void loadInBackground() = 0;
 
 	// Get all the created components of the given entity that belong to this scene
-	virtual std::vector<SystemObject*> getComponents(const EntityID p_entityID);
+	// The returned array is allocated from the frame allocator, so it must not be kept beyond the next frame
+	virtual FrameVector<SystemObject *> getComponents(const EntityID p_entityID);
 
 	// Create all the components that belong to this scene, that are contained in ComponentsConstructionInfo; return a vector of all created components
 	virtual std::vector<SystemObject*> createComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true);
@@ -12,6 +12,7 @@
 #include "Window.h"
 
 #include "EngineDefinitions.h"
+#include "FrameAllocator.h"
 #include "System.h"
 #include "SpinWait.h"
 
@@ -200,12 +201,17 @@ public:
 	void parallelFor(SystemTask *p_systemTask, ParallelForFunc p_jobFunc, void *p_param, unsigned int p_begin, unsigned int p_end, unsigned int p_minGrainSize = 1);
 
 	// Passed function is executed in a parallel thread; returns before the passed function has been completed
+	// The function can run across frame boundaries, so it is not given any frame allocator memory
 	template<typename Function>
 	inline void startBackgroundThread(const Function& p_func)
 	{
 		// If multi-threading is enabled 
 #if SETTING_MULTITHREADING_ENABLED
-		m_backgroundTaskGroup.run(p_func);
+		m_backgroundTaskGroup.run([p_func]()
+			{
+				FrameAllocator::BackgroundScope backgroundScope;
+				p_func();
+			});
 #else
 		p_func();
 #endif
@@ -1,4 +1,5 @@
 
+#include "Profiler.h"
 #include "TaskManager.h"
 #include "TaskScheduler.h"
 
@@ -58,6 +59,8 @@ void TaskScheduler::setScene(const UniversalScene *p_scene)
 
 void TaskScheduler::execute(float p_deltaTime)
 {
+	PROFILE_ZONE("TaskScheduler::execute");
+
 	// If multithreading is enabled, execute tasks over threads in parallel
 	if(m_multithreadingEnabled)
 	{
@@ -2,6 +2,8 @@
 
 #include <map>
 
+#include "FrameAllocator.h"
+#include "Profiler.h"
 #include "System.h"
 #include "Universal.h"
 
@@ -23,6 +25,8 @@ public:
 	template<typename T_Func, typename... T_Args>
 	void execute(T_Func &&p_func, T_Args&&... p_args)
 	{
+		PROFILE_ZONE("TaskScheduler::execute");
+
 		// If multithreading is enabled, execute tasks over threads in parallel
 		if(m_multithreadingEnabled)
 		{
@@ -65,7 +69,7 @@ public:
 	void executeViaBackgroundThreads(std::function<void(SystemTask *, T_Type...)> p_func, T_Type&&... p_args)
 	{
 		// Contains tasks that can only be executed in the primary thread
-		std::vector<SystemTask*> primaryThreadTasks;
+		FrameVector<SystemTask*> primaryThreadTasks;
 
 		// Iterate over all the system scenes and get their tasks
 		for(auto it = m_systemScenes.begin(); it != m_systemScenes.end(); it++)
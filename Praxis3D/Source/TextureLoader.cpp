@@ -10,7 +10,7 @@
 #include "Utilities.h"
 
 
-TextureLoader2D::TextureLoader2D()
+TextureLoader2D::TextureLoader2D() : LoaderBase(MemoryTag_Textures, ErrorSource::Source_TextureLoader)
 {
 	m_defaultTextures[DefaultTextureType::DefaultTextureType_Diffuse] = new Texture2D(this, Config::filepathVar().engine_assets_path + Config::textureVar().default_texture, m_objectPool.size(), 0, MaterialType::MaterialType_Diffuse);
 	m_defaultTextures[DefaultTextureType::DefaultTextureType_Emissive] = new Texture2D(this, Config::filepathVar().engine_assets_path + Config::textureVar().default_emissive_texture, m_objectPool.size(), 0, MaterialType::MaterialType_Emissive);
@@ -210,7 +210,7 @@ void TextureLoader2D::unload(Texture2D &p_object, SceneLoader &p_sceneLoader)
 	p_sceneLoader.getChangeController()->sendData(p_sceneLoader.getSystemScene(Systems::Graphics), DataType::DataType_UnloadTexture2D, (void*)textureHandle, true);
 }
 
-TextureLoaderCubemap::TextureLoaderCubemap()
+TextureLoaderCubemap::TextureLoaderCubemap() : LoaderBase(MemoryTag_Textures, ErrorSource::Source_TextureLoader)
 {
 	std::string defaultFilenames[CubemapFace_NumOfFaces];
 	for(unsigned int face = CubemapFace_PositiveX; face < CubemapFace_NumOfFaces; face++)
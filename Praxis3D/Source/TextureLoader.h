@@ -10,6 +10,7 @@
 #include "ErrorCodes.h"
 #include "ErrorHandlerLocator.h"
 #include "LoaderBase.h"
+#include "Profiler.h"
 
 enum TextureColorChannelOffset : unsigned int
 {
@@ -144,14 +145,16 @@ protected:
 	// Loads pixel data (using the filename) from HDD to RAM, re-factors it
 	ErrorCode loadToMemory()
 	{
+		PROFILE_ZONE("Texture::loadToMemory");
+
 		ErrorCode returnError = ErrorCode::Success;
 
 		// If the same texture is being used in multiple objects, loadToMemory might be called
 		// from multiple threads at the same time. Use a spin wait to deal with it
 		SpinWait::Lock lock(m_mutex);
 
-		// Texture might have already been loaded when called from a different thread. Check if it was
-		if(!isLoadedToMemory())
+		// Texture might have already been loaded when called from a different thread. Check if it was (pixel data that was released after uploading is loaded again)
+		if(!isLoadedToMemory() || m_cpuDataReleased)
 		{
 			// Read the format of the texture
 			FREE_IMAGE_FORMAT imageFormat = FreeImage_GetFileType((Config::PathsVariables().texture_path + m_filename).c_str(), 0);
@@ -347,6 +350,10 @@ protected:
 				//	m_pixelData = newData;
 				//}
 
+				setMemorySize(MemoryType_RAM, (int64_t)FreeImage_GetPitch(m_bitmap) * m_textureHeight);
+				setSavedMemorySize(0);
+				m_cpuDataReleased = false;
+
 				setLoadedToMemory(true);
 				m_loadedFromFile = true;
 			}
@@ -371,11 +378,32 @@ protected:
 			FreeImage_Unload(m_bitmap);
 			m_bitmap = nullptr;
 			m_pixelData = nullptr;
+
+			setMemorySize(MemoryType_RAM, 0);
 		}
 
 		return returnError;
 	}
 
+	// Deletes pixel data stored in RAM after it was uploaded to VRAM, unless a consumer registered interest in it
+	void releaseCPUData()
+	{
+		SpinWait::Lock lock(m_mutex);
+
+		if(m_cpuDataInterest > 0 || m_bitmap == nullptr)
+			return;
+
+		const int64_t memorySize = getMemorySize(MemoryType_RAM);
+
+		unloadMemory();
+		m_cpuDataReleased = true;
+
+		setSavedMemorySize(memorySize);
+	}
+
+	// Reloads the released pixel data from the texture file
+	inline ErrorCode reloadCPUData() { return loadToMemory(); }
+
 	// Set whether the mipmapping is enabled. Also sets the appropriate magnification and minification filtering
 	void setEnableMipmapping(const bool p_enableCompression)
 	{
@@ -471,6 +499,10 @@ public:
 		Texture2DHandle(Texture2DHandle &&p_textureHandle) noexcept : m_textureData(p_textureHandle.m_textureData) { m_textureData->incRefCounter(); }
 		~Texture2DHandle() { m_textureData->decRefCounter(); }
 
+		// Register a consumer that reads the pixel data in RAM, so it is kept after uploading to VRAM (and reloaded, if it was released)
+		inline ErrorCode registerCPUDataInterest() { return m_textureData->registerCPUDataInterest(); }
+		inline void unregisterCPUDataInterest() { m_textureData->unregisterCPUDataInterest(); }
+
 		// Loads data from HDD to RAM and restructures it to be used to fill buffers later
 		ErrorCode loadToMemory()
 		{
@@ -564,10 +596,23 @@ public:
 
 		// Setters
 		inline void setLoadedToMemory(bool p_loaded) { m_textureData->setLoadedToMemory(p_loaded); }
-		inline void setLoadedToVideoMemory(bool p_loaded) { m_textureData->setLoadedToVideoMemory(p_loaded); }
+		inline void setLoadedToVideoMemory(bool p_loaded)
+		{
+			m_textureData->setLoadedToVideoMemory(p_loaded);
+			m_textureData->setMemorySize(MemoryType_VRAM, p_loaded ? MemoryTracker::getTextureMemorySize(m_textureData->m_textureDataFormat, m_textureData->m_textureWidth, m_textureData->m_textureHeight, 1, m_textureData->m_enableMipmap) : 0);
+		}
 
 		inline unsigned int &getHandleRef() { return m_textureData->m_handle; }
 
+		// Reloads the pixel data, if it was released after a previous upload to VRAM
+		inline ErrorCode reloadReleasedCPUData()
+		{
+			if(m_textureData->isCPUDataReleased())
+				return m_textureData->reloadCPUData();
+
+			return ErrorCode::Success;
+		}
+
 		// Returns a void pointer to the pixel data
 		const inline void *getData() { return m_textureData->getData(); }
 
@@ -796,6 +841,8 @@ protected:
 	// Loads pixel data (using the filename) from HDD to RAM, re-factors it
 	ErrorCode loadToMemory()
 	{
+		PROFILE_ZONE("Texture::loadToMemory");
+
 		ErrorCode returnError = ErrorCode::Success;
 
 		// If the same texture is being used in multiple objects, loadToMemory might be called
@@ -83,6 +83,12 @@ public:
 		p_renderPassData.swapColorInputOutputMaps();
 	}
 
+	void declareResources(RenderGraph::PassBuilder &p_passBuilder) const
+	{
+		p_passBuilder.read(RenderGraphResource::SceneColor);
+		p_passBuilder.write(RenderGraphResource::SceneColor);
+	}
+
 private:
 	ErrorCode loadTonemappingPassShaderToMemory(ShaderLoader::ShaderProgram *p_shader)
 	{
@@ -13,6 +13,8 @@ struct UniformFrameData
 
 		m_deltaTime = 0.0f;
 
+		m_renderScale = glm::vec2(1.0f);
+
 		m_numPointLights = 0;
 		m_numSpotLights = 0;
 
@@ -28,6 +30,9 @@ struct UniformFrameData
 	glm::ivec2 m_screenSize;
 	glm::vec2 m_inverseScreenSize;
 
+	// Fraction of the framebuffer size that the scene is rendered at (the size of the rendered sub-rectangle divided by the framebuffer size)
+	glm::vec2 m_renderScale;
+
 	// Camera's position in the scene
 	glm::vec3 m_cameraPosition;
 
@@ -40,7 +45,8 @@ struct UniformFrameData
 				m_viewProjMatrix,
 				m_atmScatProjMatrix,
 				m_transposeViewMatrix,
-				m_transposeInverseViewMatrix;
+				m_transposeInverseViewMatrix,
+				m_inverseViewProjMatrix;
 
 	// Parameters of directional light, since there can be only one of it
 	DirectionalLightDataSet m_directionalLight;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <sstream>
+#include <stdint.h>
 #include <string>
 
 #include "Scancodes.h"
@@ -220,6 +221,18 @@ namespace Utilities
 		return hash;
 	}
 
+	// 64-bit FNV-1a hash; used where collisions must be practically impossible (e.g. identifying cached data on disk)
+	static uint64_t getHashKey64(const std::string &p_string)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+		for(decltype(p_string.size()) i = 0, size = p_string.size(); i < size; i++)
+		{
+			hash ^= (unsigned char)p_string[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
 	// Template std::pair comparator, only compares the first element
 	template<class T1, class T2, class Pred = std::less<T2>>
 	struct sort_pair_first 
@@ -45,6 +45,18 @@ ErrorCode Window::init()
 	// Add the current version number to the window name
 	Config::m_windowVar.name = Config::m_windowVar.name + " v" + PRAXIS3D_VERSION_STRING;
 
+	// In headless mode, there are no displays to query; only initialize the event subsystem, so the event loop still runs
+	if(Config::engineVar().headless_mode)
+	{
+		if(SDL_Init(SDL_INIT_EVENTS) < 0)
+			return ErrorCode::SDL_video_init_failed;
+
+		Config::setGraphicsVar().current_resolution_x = Config::windowVar().window_size_windowed_x;
+		Config::setGraphicsVar().current_resolution_y = Config::windowVar().window_size_windowed_y;
+
+		return returnError;
+	}
+
 	auto sdlError = SDL_Init(SDL_INIT_VIDEO);
 
 	if(sdlError < 0)
@@ -108,6 +120,13 @@ ErrorCode Window::createWindow()
 {
 	ErrorCode returnError = ErrorCode::Success;
 
+	// No window or GL context is created in headless mode
+	if(Config::engineVar().headless_mode)
+	{
+		ErrHandlerLoc::get().log(ErrorType::Info, ErrorSource::Source_Window, "Running in headless mode, window creation skipped");
+		return returnError;
+	}
+
 	// Set OpenGL context versions (if the version is not supported, no context will be created)
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, Config::engineVar().gl_context_major_version);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, Config::engineVar().gl_context_minor_version);
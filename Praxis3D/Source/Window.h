@@ -150,6 +150,10 @@ public:
 	// Spawns a simple message box with "yes" and "no" buttons. Block execution until a button is clicked
 	bool spawnYesNoInfoBox(std::string p_title, std::string p_message)
 	{
+		// Message boxes would block a headless run, so always continue
+		if(Config::engineVar().headless_mode)
+			return true;
+
 		// Define buttons
 		const SDL_MessageBoxButtonData buttons[] = 
 		{
@@ -200,6 +204,10 @@ public:
 	// Spawns a simple message box with "yes" and "no" buttons. Block execution until a button is clicked
 	bool spawnYesNoErrorBox(std::string p_title, std::string p_message)
 	{
+		// Message boxes would block a headless run, so always continue
+		if(Config::engineVar().headless_mode)
+			return true;
+
 		// Define buttons
 		const SDL_MessageBoxButtonData buttons[] =
 		{
@@ -250,6 +258,10 @@ public:
 	// Spawns an error box with only an "ok" button
 	void spawnErrorBox(std::string p_title, std::string p_message)
 	{
+		// Message boxes would block a headless run; the error is still logged to the console
+		if(Config::engineVar().headless_mode)
+			return;
+
 		// Define buttons
 		const SDL_MessageBoxButtonData buttons[] =
 		{
@@ -401,7 +413,9 @@ public:
 	// Swap front and back screen buffers
 	inline void swapBuffers()
 	{
-		SDL_GL_SwapWindow(m_SDLWindow);
+		// There is no window to present to in headless mode
+		if(m_SDLWindow != nullptr)
+			SDL_GL_SwapWindow(m_SDLWindow);
 	}
 
 	// Current screen size (can be either windowed or full-screen)
@@ -178,7 +178,7 @@ public:
 					m_saveKey.deactivate();
 
 					if(WindowLocator::get().spawnYesNoErrorBox("World Editor", "Export the scene to \"" + Config::gameplayVar().default_map + "\"?"))
-						m_sceneLoader->saveToFile(Config::gameplayVar().default_map);
+						m_sceneLoader->requestSaveToFile(Config::gameplayVar().default_map);
 				}
 			}
 
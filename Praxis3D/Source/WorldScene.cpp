@@ -2,6 +2,7 @@
 #include "ComponentConstructorInfo.h"
 #include "GameObjectComponent.h"
 #include "NullSystemObjects.h"
+#include "Profiler.h"
 #include "SceneLoader.h"
 #include "SpatialComponent.h"
 #include "WorldScene.h"
@@ -9,6 +10,26 @@
 WorldScene::WorldScene(SystemBase *p_system, SceneLoader *p_sceneLoader) : SystemScene(p_system, p_sceneLoader, Properties::PropertyID::World)
 {
 	m_worldTask = new WorldTask(this);
+	m_entityChangesOverflowed = false;
+
+	// Track the creation, modification and removal of metadata components, as every entity has one
+	m_entityRegistry.on_construct<MetadataComponent>().connect<&WorldScene::entityChanged>(this);
+	m_entityRegistry.on_update<MetadataComponent>().connect<&WorldScene::entityChanged>(this);
+	m_entityRegistry.on_destroy<MetadataComponent>().connect<&WorldScene::entityChanged>(this);
+
+	// Track the addition and removal of all other components, so that the entity component lists can also be updated incrementally
+	setComponentChangeTracking(true);
+}
+
+void WorldScene::setComponentChangeTracking(const bool p_enabled)
+{
+	setComponentChangeTracking<
+		SoundComponent, SoundListenerComponent,
+		GUISequenceComponent,
+		CameraComponent, LightComponent, ModelComponent, ShaderComponent,
+		CollisionShapeComponent, RigidBodyComponent,
+		LuaComponent,
+		ObjectMaterialComponent, SpatialComponent>(p_enabled);
 }
 
 ErrorCode WorldScene::init() 
@@ -44,12 +65,49 @@ void WorldScene::exportSetup(PropertySet &p_propertySet)
 
 void WorldScene::update(const float p_deltaTime)
 {
+	PROFILE_ZONE("WorldScene::update");
+
 	//	 ___________________________
 	//	|							|
 	//	|	  SPATIAL COMPONENT		|
 	//	|___________________________|
 	//
 	auto spatialView = m_entityRegistry.view<SpatialComponent>();
+
+	// Gather the components whose local transform must be rebuilt, so their transforms can be computed in a single batch
+	m_spatialTransformBatch.clear();
+	m_batchedSpatialComponents.clear();
+	for(auto entity : spatialView)
+	{
+		auto &component = spatialView.get<SpatialComponent>(entity);
+
+		if(component.m_spatialData.isLocalTransformOutdated())
+		{
+			component.m_spatialData.updateLocalSpatialData();
+
+			const auto &localSpatialData = component.m_spatialData.getLocalSpaceData().m_spatialData;
+			m_spatialTransformBatch.addEntry(
+				localSpatialData.m_position, 
+				localSpatialData.m_rotationQuat, 
+				localSpatialData.m_scale, 
+				m_spatialTransformBatch.addParentTransform(component.m_spatialData.getParentTransform()));
+
+			m_batchedSpatialComponents.push_back(&component);
+		}
+	}
+
+	if(!m_spatialTransformBatch.empty())
+	{
+		m_spatialTransformBatch.computeTransforms();
+
+		for(decltype(m_batchedSpatialComponents.size()) i = 0, size = m_batchedSpatialComponents.size(); i < size; i++)
+			m_batchedSpatialComponents[i]->m_spatialData.setBatchedTransforms(
+				m_spatialTransformBatch.getLocalTransform(i), 
+				m_spatialTransformBatch.getWorldTransformNoScale(i), 
+				m_spatialTransformBatch.getWorldTransformWithScale(i));
+	}
+
+	// Update the rest of the spatial data and post the changes
 	for(auto entity : spatialView)
 	{
 		auto &component = spatialView.get<SpatialComponent>(entity);
@@ -58,9 +116,9 @@ void WorldScene::update(const float p_deltaTime)
 	}
 }
 
-std::vector<SystemObject *> WorldScene::getComponents(const EntityID p_entityID)
+FrameVector<SystemObject *> WorldScene::getComponents(const EntityID p_entityID)
 {
-	std::vector<SystemObject *> returnVector;
+	FrameVector<SystemObject *> returnVector;
 
 	// Get the entity registry 
 	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader->getSystemScene(Systems::World))->getEntityRegistry();
@@ -105,23 +163,23 @@ ErrorCode WorldScene::addComponents(const EntityID p_entityID, const ComponentsC
 
 		// Add AUDIO components
 		std::vector<SystemObject *> newAudioComponents = m_sceneLoader->getSystemScene(Systems::Audio)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
-		std::vector<SystemObject *> oldAudioComponents = m_sceneLoader->getSystemScene(Systems::Audio)->getComponents(p_entityID);
+		FrameVector<SystemObject *> oldAudioComponents = m_sceneLoader->getSystemScene(Systems::Audio)->getComponents(p_entityID);
 
 		// Add RENDERING components
 		std::vector<SystemObject *> newRenderingComponents = m_sceneLoader->getSystemScene(Systems::Graphics)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
-		std::vector<SystemObject *> oldRenderingComponents = m_sceneLoader->getSystemScene(Systems::Graphics)->getComponents(p_entityID);
+		FrameVector<SystemObject *> oldRenderingComponents = m_sceneLoader->getSystemScene(Systems::Graphics)->getComponents(p_entityID);
 
 		// Add GUI components
 		std::vector<SystemObject *> newGuiComponents = m_sceneLoader->getSystemScene(Systems::GUI)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
-		std::vector<SystemObject *> oldGuiComponents = m_sceneLoader->getSystemScene(Systems::GUI)->getComponents(p_entityID);
+		FrameVector<SystemObject *> oldGuiComponents = m_sceneLoader->getSystemScene(Systems::GUI)->getComponents(p_entityID);
 
 		// Add PHYSICS components
 		std::vector<SystemObject *> newPhysicsComponents = m_sceneLoader->getSystemScene(Systems::Physics)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
-		std::vector<SystemObject *> oldPhysicsComponents = m_sceneLoader->getSystemScene(Systems::Physics)->getComponents(p_entityID);
+		FrameVector<SystemObject *> oldPhysicsComponents = m_sceneLoader->getSystemScene(Systems::Physics)->getComponents(p_entityID);
 
 		// Add SCRIPTING components
 		std::vector<SystemObject *> newScriptingComponents = m_sceneLoader->getSystemScene(Systems::Script)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
-		std::vector<SystemObject *> oldScriptingComponents = m_sceneLoader->getSystemScene(Systems::Script)->getComponents(p_entityID);
+		FrameVector<SystemObject *> oldScriptingComponents = m_sceneLoader->getSystemScene(Systems::Script)->getComponents(p_entityID);
 
 		// Link subjects and observers of different components
 		// Link NEW components to both NEW and OLD components
@@ -273,11 +331,54 @@ EntityID WorldScene::createEntity(const ComponentsConstructionInfo &p_constructi
 	else // Do not request a specific entity ID if the requested ID is null
 		newEntity = addEntity();
 
+	createEntityComponents(newEntity, p_constructionInfo, p_startLoading);
+
+	return newEntity;
+}
+
+void WorldScene::createEntities(const ComponentsConstructionInfo &p_prefabConstructionInfo, const std::span<const PrefabSpawnTransform> p_transforms, std::vector<EntityID> *p_createdEntities, const bool p_startLoading)
+{
+	if(p_transforms.empty())
+		return;
+
+	// Create all entity IDs at once
+	FrameVector<EntityID> newEntities(p_transforms.size());
+	m_entityRegistry.create(newEntities.begin(), newEntities.end());
+
+	// Shallow copy of the prefab construction info (assignment operator only copies the pointers), shared by all instances
+	ComponentsConstructionInfo instanceConstructionInfo;
+	instanceConstructionInfo = p_prefabConstructionInfo;
+	instanceConstructionInfo.m_prefab = p_prefabConstructionInfo.m_prefab;
+
+	// The spatial construction info is the only per-instance data; it is overwritten for each instance, instead of being copied
+	SpatialComponent::SpatialComponentConstructionInfo instanceSpatialConstructionInfo;
+	if(p_prefabConstructionInfo.m_worldComponents.m_spatialConstructionInfo != nullptr)
+		instanceSpatialConstructionInfo = *p_prefabConstructionInfo.m_worldComponents.m_spatialConstructionInfo;
+	instanceConstructionInfo.m_worldComponents.m_spatialConstructionInfo = &instanceSpatialConstructionInfo;
+
+	// Rotation is always given as a quaternion; clear the Euler angles, as they are used instead of an empty (identity) quaternion
+	instanceSpatialConstructionInfo.m_localRotationEuler = glm::vec3(0.0f);
+
+	for(decltype(newEntities.size()) i = 0, size = newEntities.size(); i < size; i++)
+	{
+		instanceSpatialConstructionInfo.m_localPosition = p_transforms[i].m_position;
+		instanceSpatialConstructionInfo.m_localRotationQuaternion = p_transforms[i].m_rotation;
+		instanceSpatialConstructionInfo.m_localScale = p_transforms[i].m_scale;
+
+		createEntityComponents(newEntities[i], instanceConstructionInfo, p_startLoading);
+	}
+
+	if(p_createdEntities != nullptr)
+		p_createdEntities->insert(p_createdEntities->end(), newEntities.begin(), newEntities.end());
+}
+
+void WorldScene::createEntityComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading)
+{
 	// Create the metadata component by passing all of the construction info
-	createComponent(newEntity, p_constructionInfo, p_startLoading);
+	createComponent(p_entityID, p_constructionInfo, p_startLoading);
 
 	// Add WORLD components
-	std::vector<SystemObject*> worldComponents = createComponents(newEntity, p_constructionInfo.m_worldComponents, p_startLoading);
+	std::vector<SystemObject*> worldComponents = createComponents(p_entityID, p_constructionInfo.m_worldComponents, p_startLoading);
 
 	SystemObject *spatialComponent = nullptr;
 
@@ -290,19 +391,19 @@ EntityID WorldScene::createEntity(const ComponentsConstructionInfo &p_constructi
 		}
 
 	// Add AUDIO components
-	std::vector<SystemObject*> audioComponents = m_sceneLoader->getSystemScene(Systems::Audio)->createComponents(newEntity, p_constructionInfo, p_startLoading);
+	std::vector<SystemObject*> audioComponents = m_sceneLoader->getSystemScene(Systems::Audio)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
 
 	// Add RENDERING components
-	std::vector<SystemObject*> renderingComponents = m_sceneLoader->getSystemScene(Systems::Graphics)->createComponents(newEntity, p_constructionInfo, p_startLoading);
+	std::vector<SystemObject*> renderingComponents = m_sceneLoader->getSystemScene(Systems::Graphics)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
 
 	// Add GUI components
-	std::vector<SystemObject*> guiComponents = m_sceneLoader->getSystemScene(Systems::GUI)->createComponents(newEntity, p_constructionInfo, p_startLoading);
+	std::vector<SystemObject*> guiComponents = m_sceneLoader->getSystemScene(Systems::GUI)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
 
 	// Add PHYSICS components
-	std::vector<SystemObject*> physicsComponents = m_sceneLoader->getSystemScene(Systems::Physics)->createComponents(newEntity, p_constructionInfo, p_startLoading);
+	std::vector<SystemObject*> physicsComponents = m_sceneLoader->getSystemScene(Systems::Physics)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
 
 	// Add SCRIPTING components
-	std::vector<SystemObject*> scriptingComponents = m_sceneLoader->getSystemScene(Systems::Script)->createComponents(newEntity, p_constructionInfo, p_startLoading);
+	std::vector<SystemObject*> scriptingComponents = m_sceneLoader->getSystemScene(Systems::Script)->createComponents(p_entityID, p_constructionInfo, p_startLoading);
 
 	// Link subjects and observers of different components
 
@@ -316,10 +417,10 @@ EntityID WorldScene::createEntity(const ComponentsConstructionInfo &p_constructi
 
 		// Link PARENT SPATIAL -> CHILD SPATIAL
 		// Do not process the root node (Entity ID 0)
-		if(auto *parentSpatialComponent = m_entityRegistry.try_get<SpatialComponent>(p_constructionInfo.m_parent); parentSpatialComponent != nullptr && newEntity != 0)
+		if(auto *parentSpatialComponent = m_entityRegistry.try_get<SpatialComponent>(p_constructionInfo.m_parent); parentSpatialComponent != nullptr && p_entityID != 0)
 		{
 			// Set the parent transform
-			auto *currentSpatialComponent = m_entityRegistry.try_get<SpatialComponent>(newEntity);
+			auto *currentSpatialComponent = m_entityRegistry.try_get<SpatialComponent>(p_entityID);
 			currentSpatialComponent->m_spatialData.setParentTransform(parentSpatialComponent->m_spatialData.getWorldTransform());
 			currentSpatialComponent->m_spatialData.update();
 
@@ -362,8 +463,6 @@ EntityID WorldScene::createEntity(const ComponentsConstructionInfo &p_constructi
 			m_sceneLoader->getChangeController()->createObjectLink(scriptingComponents[scriptingIndex], guiComponents[guiIndex]);
 		}
 	}
-
-	return newEntity;
 }
 
 void WorldScene::exportEntity(const EntityID p_entityID, ComponentsConstructionInfo &p_constructionInfo)
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <span>
+
 #include "EntityViewDefinitions.h"
 #include "GameObject.h"
 #include "MetadataComponent.h"
 #include "ObjectMaterialComponent.h"
 #include "ObjectPool.h"
 #include "ObjectRegister.h"
+#include "SpatialTransformBatch.h"
+#include "SpinWait.h"
 #include "System.h"
 #include "WorldTask.h"
 
@@ -46,12 +50,30 @@ struct WorldComponentsConstructionInfo
 	ObjectMaterialComponent::ObjectMaterialComponentConstructionInfo *m_objectMaterialConstructionInfo;
 };
 
+// Spatial transform of a single prefab instance, that overrides the transform of the prefab when spawning it
+struct PrefabSpawnTransform
+{
+	PrefabSpawnTransform() : m_position(0.0f), m_rotation(1.0f, 0.0f, 0.0f, 0.0f), m_scale(1.0f) { }
+	PrefabSpawnTransform(const glm::vec3 &p_position) : m_position(p_position), m_rotation(1.0f, 0.0f, 0.0f, 0.0f), m_scale(1.0f) { }
+	PrefabSpawnTransform(const glm::vec3 &p_position, const glm::quat &p_rotation, const glm::vec3 &p_scale) : m_position(p_position), m_rotation(p_rotation), m_scale(p_scale) { }
+
+	glm::vec3 m_position;
+	glm::quat m_rotation;
+	glm::vec3 m_scale;
+};
+
 class WorldScene : public SystemScene
 {
 public:
 	WorldScene(SystemBase *p_system, SceneLoader *p_sceneLoader);
 	~WorldScene()
 	{
+		// Stop tracking entity changes, as nothing will be reading them anymore
+		m_entityRegistry.on_construct<MetadataComponent>().disconnect(this);
+		m_entityRegistry.on_update<MetadataComponent>().disconnect(this);
+		m_entityRegistry.on_destroy<MetadataComponent>().disconnect(this);
+		setComponentChangeTracking(false);
+
 		// Delete all entities
 		m_entityRegistry.clear();
 	}
@@ -69,11 +91,15 @@ public:
 	void loadInBackground() { }
 
 	// Get all the created components of the given entity that belong to this scene
-	std::vector<SystemObject *> getComponents(const EntityID p_entityID);
+	FrameVector<SystemObject *> getComponents(const EntityID p_entityID);
 
 	// Add a components to an existing entity. Fails if the entity doesn't exist
 	ErrorCode addComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true);
 	EntityID createEntity(const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true);
+
+	// Create an entity for each given transform, all from the same (compiled) prefab construction info; entity IDs are created in a single registry call.
+	// The prefab construction info is only read and shared by all instances, so no construction info is copied per instance
+	void createEntities(const ComponentsConstructionInfo &p_prefabConstructionInfo, const std::span<const PrefabSpawnTransform> p_transforms, std::vector<EntityID> *p_createdEntities = nullptr, const bool p_startLoading = true);
 	void exportEntity(const EntityID p_entityID, ComponentsConstructionInfo &p_constructionInfo);
 
 	std::vector<SystemObject*> createComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading = true);
@@ -211,6 +237,25 @@ public:
 
 	inline entt::basic_registry<EntityID> &getEntityRegistry() { return m_entityRegistry; }
 
+	// Appends the IDs of all entities whose metadata component was created, changed or destroyed since the last call to the given array
+	// (used by the editor to update its entity list incrementally, instead of rebuilding it every frame). Entity IDs may be repeated.
+	// Returns true if too many changes have accumulated to be tracked individually, in which case the whole entity list should be rebuilt
+	bool getEntityChanges(std::vector<EntityID> &p_changedEntities)
+	{
+		SpinWait::Lock lock(m_entityChangesMutex);
+
+		const bool changesOverflowed = m_entityChangesOverflowed;
+		m_entityChangesOverflowed = false;
+
+		if(p_changedEntities.empty())
+			std::swap(p_changedEntities, m_entityChanges);
+		else
+			p_changedEntities.insert(p_changedEntities.end(), m_entityChanges.begin(), m_entityChanges.end());
+		m_entityChanges.clear();
+
+		return changesOverflowed;
+	}
+
 private:
 	struct GameObjectAndParent
 	{
@@ -243,6 +288,9 @@ private:
 		std::vector<decltype(GameObject::m_GameObjectID)> m_children;
 	};
 
+	// Create all components of an already added entity, and link them together
+	void createEntityComponents(const EntityID p_entityID, const ComponentsConstructionInfo &p_constructionInfo, const bool p_startLoading);
+
 	inline EntityID addEntity()
 	{
 		return m_entityRegistry.create();
@@ -252,11 +300,56 @@ private:
 		return m_entityRegistry.create(p_entityID);
 	}
 
+	// Connects (or disconnects) the entity changed signal handler to the construction and destruction of every component type other than metadata
+	void setComponentChangeTracking(const bool p_enabled);
+
+	template <typename... T_Components>
+	void setComponentChangeTracking(const bool p_enabled)
+	{
+		if(p_enabled)
+		{
+			(m_entityRegistry.on_construct<T_Components>().template connect<&WorldScene::entityChanged>(this), ...);
+			(m_entityRegistry.on_destroy<T_Components>().template connect<&WorldScene::entityChanged>(this), ...);
+		}
+		else
+		{
+			(m_entityRegistry.on_construct<T_Components>().disconnect(this), ...);
+			(m_entityRegistry.on_destroy<T_Components>().disconnect(this), ...);
+		}
+	}
+
+	// Entity registry signal handler; records the entity as changed. Can be called from multiple threads
+	void entityChanged(entt::basic_registry<EntityID> &p_registry, const EntityID p_entityID)
+	{
+		SpinWait::Lock lock(m_entityChangesMutex);
+
+		// If the changes are not being read, stop recording them once the limit is reached, and only flag that everything has to be rebuilt
+		if(!m_entityChangesOverflowed)
+		{
+			if(m_entityChanges.size() < (size_t)Config::GUIVar().editor_entity_changes_max_pending)
+				m_entityChanges.push_back(p_entityID);
+			else
+			{
+				m_entityChanges.clear();
+				m_entityChangesOverflowed = true;
+			}
+		}
+	}
+
 	entt::basic_registry<EntityID> m_entityRegistry;
 
+	// Entities that had their metadata component changed since the last time they were retrieved
+	std::vector<EntityID> m_entityChanges;
+	SpinWait m_entityChangesMutex;
+	bool m_entityChangesOverflowed;
+
 	std::vector<GameObjectAndParent> m_unassignedParents;
 	std::vector<GameObjectAndChildren> m_unassignedChildren;
 
+	// Transforms of spatial components that had their local data changed, computed together each update, and the components they belong to
+	SpatialTransformBatch m_spatialTransformBatch;
+	std::vector<SpatialComponent *> m_batchedSpatialComponents;
+
 	WorldTask *m_worldTask;
 
 	ObjectRegisterConcurrent<GameObject*> m_objectRegister;
@@ -0,0 +1,404 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+
+#include "ComponentConstructorInfo.h"
+#include "Profiler.h"
+#include "PropertyLoader.h"
+#include "SceneLoader.h"
+#include "TaskManagerLocator.h"
+#include "Version.h"
+#include "WorldStreamer.h"
+
+WorldStreamer::WorldStreamer(SceneLoader &p_sceneLoader) : m_sceneLoader(p_sceneLoader)
+{
+	m_numOfCellsParsing = 0;
+	m_cellSize = 0.0f;
+}
+
+WorldStreamer::~WorldStreamer()
+{
+	clear();
+}
+
+void WorldStreamer::setup(const PropertySet &p_properties)
+{
+	clear();
+
+	m_cellSize = Config::engineVar().world_streaming_cell_size;
+
+	if(p_properties)
+	{
+		if(auto &cellSizeProperty = p_properties.getPropertyByID(Properties::CellSize); cellSizeProperty)
+			m_cellSize = cellSizeProperty.getFloat();
+
+		if(auto &cellsPropertySet = p_properties.getPropertySetByID(Properties::Cells); cellsPropertySet)
+		{
+			for(decltype(cellsPropertySet.getNumPropertySets()) i = 0, size = cellsPropertySet.getNumPropertySets(); i < size; i++)
+			{
+				auto &cellEntry = cellsPropertySet.getPropertySetUnsafe(i);
+
+				const glm::ivec2 coordinates = cellEntry.getPropertyByID(Properties::Coordinates).getVec2i();
+				const std::string filename = cellEntry.getPropertyByID(Properties::Filename).getString();
+
+				if(filename.empty())
+					continue;
+
+				auto &cell = m_cells[CellKey(coordinates.x, coordinates.y)];
+				cell.m_coordinates = coordinates;
+				cell.m_filename = filename;
+			}
+		}
+	}
+}
+
+void WorldStreamer::update()
+{
+	if(!isEnabled() || m_cells.empty())
+		return;
+
+	PROFILE_ZONE("WorldStreamer::update");
+
+	glm::vec3 cameraPosition;
+	if(!getCameraPosition(cameraPosition))
+		return;
+
+	const float loadRadius = Config::engineVar().world_streaming_load_radius;
+	const float unloadRadius = std::max(Config::engineVar().world_streaming_unload_radius, loadRadius);
+
+	// Start loading the unloaded cells that are within the load radius
+	const CellKey minCell = getCellKey(cameraPosition - glm::vec3(loadRadius));
+	const CellKey maxCell = getCellKey(cameraPosition + glm::vec3(loadRadius));
+	for(auto cellIterator = m_cells.lower_bound(CellKey(minCell.first, std::numeric_limits<int>::min())); cellIterator != m_cells.end() && cellIterator->first.first <= maxCell.first; cellIterator++)
+	{
+		auto &cell = cellIterator->second;
+
+		if(cellIterator->first.second < minCell.second || cellIterator->first.second > maxCell.second)
+			continue;
+
+		if(cell.m_state.load(std::memory_order_acquire) == StreamingCellState_Unloaded && getDistanceToCell(cell, cameraPosition) <= loadRadius)
+			startLoadingCell(cell);
+	}
+
+	// Unload the cells that are beyond the unload radius; cells that are still being parsed are unloaded once parsing has finished
+	for(decltype(m_activeCells.size()) i = 0; i < m_activeCells.size();)
+	{
+		auto &cell = *m_activeCells[i];
+
+		if(cell.m_state.load(std::memory_order_acquire) != StreamingCellState_Parsing && getDistanceToCell(cell, cameraPosition) > unloadRadius)
+		{
+			unloadCell(cell);
+
+			m_activeCells[i] = m_activeCells.back();
+			m_activeCells.pop_back();
+		}
+		else
+			i++;
+	}
+
+	// Create the entities of parsed cells, closest cells first, until the time budget runs out; at least one entity is created each frame,
+	// so that loading always progresses
+	const int64_t deadlineTicks = Profiler::getCurrentTicks() + (int64_t)(Config::engineVar().world_streaming_instantiation_budget_ms / std::max(Profiler::ticksToMilliseconds(1), 1.0e-9));
+
+	std::sort(m_activeCells.begin(), m_activeCells.end(), [&](const StreamingCell *p_a, const StreamingCell *p_b)
+		{
+			return getDistanceToCell(*p_a, cameraPosition) < getDistanceToCell(*p_b, cameraPosition);
+		});
+
+	for(auto *cell : m_activeCells)
+	{
+		const StreamingCellState state = cell->m_state.load(std::memory_order_acquire);
+
+		if(state == StreamingCellState_Parsed || state == StreamingCellState_Instantiating)
+			if(!instantiateCell(*cell, deadlineTicks))
+				break;
+	}
+}
+
+ErrorCode WorldStreamer::exportEntities(const std::vector<EntityID> &p_entities, PropertySet &p_gameObjects, PropertySet &p_rootPropertySet, const std::string &p_sceneFilename)
+{
+	ErrorCode returnError = ErrorCode::Success;
+
+	WorldScene *worldScene = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World));
+	auto &entityRegistry = worldScene->getEntityRegistry();
+
+	const auto parentEntities = getParentEntities();
+
+	// Cell files are named after the scene file, with the cell coordinates appended
+	const std::string cellFilenameBase = p_sceneFilename.substr(0, p_sceneFilename.find_last_of('.'));
+
+	// Cells that will be written, with the entities that belong to them
+	std::map<CellKey, PropertySet> exportedCells;
+
+	for(auto entity : p_entities)
+	{
+		// Streamable entities are written to the cell that their position falls into, the rest of them are resident
+		PropertySet *gameObjects = &p_gameObjects;
+		if(isStreamable(entity, parentEntities))
+		{
+			const CellKey cellKey = getCellKey(glm::vec3(entityRegistry.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransform()[3]));
+
+			auto cellIterator = exportedCells.find(cellKey);
+			if(cellIterator == exportedCells.end())
+				cellIterator = exportedCells.try_emplace(cellKey, Properties::GameObject).first;
+
+			gameObjects = &cellIterator->second;
+		}
+
+		ComponentsConstructionInfo constructionInfo;
+		worldScene->exportEntity(entity, constructionInfo);
+
+		m_sceneLoader.exportToProperties(constructionInfo, gameObjects->addPropertySet(Properties::ArrayEntry));
+
+		constructionInfo.deleteConstructionInfo();
+	}
+
+	// Add the cell list to the scene file
+	auto &worldStreamingPropertySet = p_rootPropertySet.addPropertySet(Properties::WorldStreaming);
+	worldStreamingPropertySet.addProperty(Properties::CellSize, m_cellSize);
+	auto &cellsPropertySet = worldStreamingPropertySet.addPropertySet(Properties::Cells);
+
+	// Write every cell that has entities in it
+	for(auto &exportedCell : exportedCells)
+	{
+		auto &cell = m_cells[exportedCell.first];
+		cell.m_coordinates = glm::ivec2(exportedCell.first.first, exportedCell.first.second);
+		cell.m_filename = cellFilenameBase + ".cell_" + Utilities::toString(cell.m_coordinates.x) + "_" + Utilities::toString(cell.m_coordinates.y) + ".pmap";
+
+		PropertySet cellRootPropertySet(Properties::Default);
+
+		auto &versionPropertySet = cellRootPropertySet.addPropertySet(Properties::Version);
+		versionPropertySet.addProperty(Properties::Major, (int)PRAXIS3D_VERSION_MAJOR);
+		versionPropertySet.addProperty(Properties::Minor, (int)PRAXIS3D_VERSION_MINOR);
+		versionPropertySet.addProperty(Properties::Patch, (int)PRAXIS3D_VERSION_PATCH);
+
+		// The entities of an exported cell are all present in the entity registry, so the cell is now loaded and owns them
+		if(cell.m_state.load(std::memory_order_acquire) == StreamingCellState_Unloaded)
+			m_activeCells.push_back(&cell);
+		cell.m_state.store(StreamingCellState_Loaded, std::memory_order_release);
+		cell.m_entities.clear();
+
+		auto &cellGameObjects = exportedCell.second;
+		for(decltype(cellGameObjects.getNumPropertySets()) i = 0, size = cellGameObjects.getNumPropertySets(); i < size; i++)
+			cell.m_entities.push_back((EntityID)cellGameObjects.getPropertySetUnsafe(i).getPropertyByID(Properties::ID).getInt());
+
+		cellRootPropertySet.addPropertySet(std::move(cellGameObjects));
+
+		PropertyLoader savedProperties(Config::filepathVar().map_path + cell.m_filename);
+		if(ErrorCode loaderError = savedProperties.saveToFile(cellRootPropertySet); loaderError != ErrorCode::Success)
+		{
+			ErrHandlerLoc::get().log(loaderError, cell.m_filename, ErrorSource::Source_SceneLoader);
+			returnError = loaderError;
+		}
+	}
+
+	// Write the cell list, including unloaded cells that have kept their files; loaded cells that have no entities left are dropped
+	for(auto cellIterator = m_cells.begin(); cellIterator != m_cells.end();)
+	{
+		auto &cell = cellIterator->second;
+
+		if(exportedCells.find(cellIterator->first) == exportedCells.end() && cell.m_state.load(std::memory_order_acquire) != StreamingCellState_Unloaded)
+		{
+			m_activeCells.erase(std::remove(m_activeCells.begin(), m_activeCells.end(), &cell), m_activeCells.end());
+			cellIterator = m_cells.erase(cellIterator);
+			continue;
+		}
+
+		auto &cellEntry = cellsPropertySet.addPropertySet(Properties::ArrayEntry);
+		cellEntry.addProperty(Properties::Coordinates, cell.m_coordinates);
+		cellEntry.addProperty(Properties::Filename, cell.m_filename);
+
+		cellIterator++;
+	}
+
+	return returnError;
+}
+
+void WorldStreamer::prepareForExport()
+{
+	if(!isEnabled())
+		return;
+
+	// Finish loading the cells that are in progress
+	waitForParsing();
+
+	for(auto *cell : m_activeCells)
+		if(cell->m_state.load(std::memory_order_acquire) != StreamingCellState_Loaded)
+			instantiateCell(*cell, std::numeric_limits<int64_t>::max());
+
+	WorldScene *worldScene = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World));
+	auto &entityRegistry = worldScene->getEntityRegistry();
+
+	const auto parentEntities = getParentEntities();
+
+	// Unloaded cells are written again only if entities have been moved into them, in which case they must be loaded first,
+	// so that their existing entities are written together with the moved ones
+	std::vector<StreamingCell *> cellsToLoad;
+	for(auto entity : entityRegistry.view<SpatialComponent>())
+	{
+		if(!isStreamable(entity, parentEntities))
+			continue;
+
+		auto cellIterator = m_cells.find(getCellKey(glm::vec3(entityRegistry.get<SpatialComponent>(entity).getSpatialDataChangeManager().getWorldTransform()[3])));
+
+		if(cellIterator != m_cells.end() && cellIterator->second.m_state.load(std::memory_order_acquire) == StreamingCellState_Unloaded)
+			if(std::find(cellsToLoad.begin(), cellsToLoad.end(), &cellIterator->second) == cellsToLoad.end())
+				cellsToLoad.push_back(&cellIterator->second);
+	}
+
+	for(auto *cell : cellsToLoad)
+	{
+		startLoadingCell(*cell);
+		waitForParsing();
+		instantiateCell(*cell, std::numeric_limits<int64_t>::max());
+	}
+}
+
+void WorldStreamer::clear()
+{
+	waitForParsing();
+
+	for(auto &cell : m_cells)
+		for(auto &constructionInfo : cell.second.m_constructionInfo)
+			constructionInfo.deleteConstructionInfo();
+
+	m_cells.clear();
+	m_activeCells.clear();
+}
+
+void WorldStreamer::parseCell(StreamingCell &p_cell)
+{
+	PropertyLoader loadedProperties(Config::filepathVar().map_path + p_cell.m_filename);
+
+	if(ErrorCode loaderError = loadedProperties.loadFromFile(); loaderError == ErrorCode::Success)
+	{
+		if(auto &gameObjects = loadedProperties.getPropertySet().getPropertySetByID(Properties::GameObject); gameObjects)
+		{
+			p_cell.m_constructionInfo.resize(gameObjects.getNumPropertySets());
+
+			for(decltype(gameObjects.getNumPropertySets()) i = 0, size = gameObjects.getNumPropertySets(); i < size; i++)
+				m_sceneLoader.importFromProperties(p_cell.m_constructionInfo[i], gameObjects.getPropertySetUnsafe(i));
+		}
+	}
+	else
+		ErrHandlerLoc::get().log(loaderError, p_cell.m_filename, ErrorSource::Source_SceneLoader);
+
+	p_cell.m_state.store(StreamingCellState_Parsed, std::memory_order_release);
+	m_numOfCellsParsing.fetch_sub(1, std::memory_order_release);
+}
+
+void WorldStreamer::startLoadingCell(StreamingCell &p_cell)
+{
+	p_cell.m_state.store(StreamingCellState_Parsing, std::memory_order_release);
+	p_cell.m_numOfInstantiated = 0;
+	m_activeCells.push_back(&p_cell);
+
+	m_numOfCellsParsing.fetch_add(1, std::memory_order_acquire);
+	TaskManagerLocator::get().startBackgroundThread(std::bind(&WorldStreamer::parseCell, this, std::ref(p_cell)));
+}
+
+bool WorldStreamer::instantiateCell(StreamingCell &p_cell, const int64_t p_deadlineTicks)
+{
+	WorldScene *worldScene = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World));
+
+	p_cell.m_state.store(StreamingCellState_Instantiating, std::memory_order_release);
+
+	do
+	{
+		if(p_cell.m_numOfInstantiated >= p_cell.m_constructionInfo.size())
+		{
+			for(auto &constructionInfo : p_cell.m_constructionInfo)
+				constructionInfo.deleteConstructionInfo();
+			p_cell.m_constructionInfo.clear();
+
+			p_cell.m_state.store(StreamingCellState_Loaded, std::memory_order_release);
+			return true;
+		}
+
+		p_cell.m_entities.push_back(worldScene->createEntity(p_cell.m_constructionInfo[p_cell.m_numOfInstantiated++], true));
+	}
+	while(Profiler::getCurrentTicks() < p_deadlineTicks);
+
+	return false;
+}
+
+void WorldStreamer::unloadCell(StreamingCell &p_cell)
+{
+	WorldScene *worldScene = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World));
+	auto &entityRegistry = worldScene->getEntityRegistry();
+
+	// Entities might have been removed by other means (e.g. deleted in the editor) after they were created
+	for(auto entity : p_cell.m_entities)
+		if(entityRegistry.valid(entity))
+			worldScene->removeEntity(entity);
+	p_cell.m_entities.clear();
+
+	for(auto &constructionInfo : p_cell.m_constructionInfo)
+		constructionInfo.deleteConstructionInfo();
+	p_cell.m_constructionInfo.clear();
+	p_cell.m_numOfInstantiated = 0;
+
+	p_cell.m_state.store(StreamingCellState_Unloaded, std::memory_order_release);
+}
+
+void WorldStreamer::waitForParsing()
+{
+	while(m_numOfCellsParsing.load(std::memory_order_acquire) > 0)
+		std::this_thread::yield();
+}
+
+bool WorldStreamer::isStreamable(const EntityID p_entity, const std::unordered_set<EntityID> &p_parentEntities) const
+{
+	// Root entity is never streamed
+	if(p_entity == 0 || p_parentEntities.count(p_entity) != 0)
+		return false;
+
+	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World))->getEntityRegistry();
+
+	if(!entityRegistry.all_of<SpatialComponent>(p_entity))
+		return false;
+
+	if(auto *metadataComponent = entityRegistry.try_get<MetadataComponent>(p_entity); metadataComponent != nullptr && metadataComponent->getParentEntityID() != 0)
+		return false;
+
+	if(entityRegistry.any_of<CameraComponent, SoundListenerComponent, GUISequenceComponent, LuaComponent>(p_entity))
+		return false;
+
+	if(auto *lightComponent = entityRegistry.try_get<LightComponent>(p_entity); lightComponent != nullptr && lightComponent->getLightType() == LightComponent::LightComponentType_directional)
+		return false;
+
+	return true;
+}
+
+std::unordered_set<EntityID> WorldStreamer::getParentEntities() const
+{
+	std::unordered_set<EntityID> parentEntities;
+
+	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World))->getEntityRegistry();
+	for(auto entity : entityRegistry.view<MetadataComponent>())
+		parentEntities.insert(entityRegistry.get<MetadataComponent>(entity).getParentEntityID());
+
+	return parentEntities;
+}
+
+bool WorldStreamer::getCameraPosition(glm::vec3 &p_position) const
+{
+	// Graphics scene is a null scene until a renderer scene is created
+	SystemScene *graphicsScene = m_sceneLoader.getSystemScene(Systems::Graphics);
+	if(graphicsScene->getSystemType() != Systems::Graphics)
+		return false;
+
+	const EntityID cameraEntity = static_cast<RendererScene *>(graphicsScene)->getSceneObjects().m_activeCameraEntityID;
+	if(cameraEntity == NULL_ENTITY_ID)
+		return false;
+
+	auto &entityRegistry = static_cast<WorldScene *>(m_sceneLoader.getSystemScene(Systems::World))->getEntityRegistry();
+	if(auto *spatialComponent = entityRegistry.try_get<SpatialComponent>(cameraEntity); spatialComponent != nullptr)
+	{
+		p_position = glm::vec3(spatialComponent->getSpatialDataChangeManager().getWorldTransform()[3]);
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+#include "CommonDefinitions.h"
+#include "ErrorCodes.h"
+#include "Math.h"
+#include "PropertySet.h"
+
+class SceneLoader;
+struct ComponentsConstructionInfo;
+
+// Streams entities in and out of the world scene, in square cells on the XZ plane, around the active camera.
+// When streaming is enabled, saving a scene partitions every streamable entity into a separate file per cell (listed in the scene file),
+// while the rest of the entities stay resident in the scene file. Cells within the load radius are parsed in a background thread and their
+// entities are created in the serial (distribution) phase of a frame, within a time budget; cells beyond the (larger) unload radius have their
+// entities removed, which releases their assets once nothing else references them
+class WorldStreamer
+{
+public:
+	enum StreamingCellState : int
+	{
+		StreamingCellState_Unloaded,
+		StreamingCellState_Parsing,
+		StreamingCellState_Parsed,
+		StreamingCellState_Instantiating,
+		StreamingCellState_Loaded
+	};
+
+	struct StreamingCell
+	{
+		StreamingCell() : m_coordinates(0), m_state(StreamingCellState_Unloaded), m_numOfInstantiated(0) { }
+
+		glm::ivec2 m_coordinates;
+
+		// Cell filename, relative to the map directory
+		std::string m_filename;
+
+		// Written by the background parsing thread; the construction info is only accessed by the main thread after it reads the Parsed state
+		std::atomic<StreamingCellState> m_state;
+
+		// Parsed entities that are waiting to be created
+		std::vector<ComponentsConstructionInfo> m_constructionInfo;
+		std::size_t m_numOfInstantiated;
+
+		// Entities that have been created from the cell
+		std::vector<EntityID> m_entities;
+	};
+
+	WorldStreamer(SceneLoader &p_sceneLoader);
+	~WorldStreamer();
+
+	// Read the cell size and the cell list from the scene properties; the cell size falls back to the config value, if it isn't present
+	void setup(const PropertySet &p_properties);
+
+	// Load and unload cells around the active camera, and create entities of loaded cells within the time budget.
+	// Must only be called in the serial phase of a frame (after changes have been distributed), as it creates and removes entities
+	void update();
+
+	// Export the given entities, writing the resident ones to the game object property set and the streamable ones to their cell files.
+	// Adds the cell list to the root property set of the scene
+	ErrorCode exportEntities(const std::vector<EntityID> &p_entities, PropertySet &p_gameObjects, PropertySet &p_rootPropertySet, const std::string &p_sceneFilename);
+
+	// Finish loading all cells that are currently loading and load every unloaded cell that a streamable entity has been moved into,
+	// so that all the entities of the cells that are going to be exported are present in the entity registry. Called before exporting
+	void prepareForExport();
+
+	// Wait for background parsing to finish and forget all cells, without removing any entities
+	void clear();
+
+	inline bool isEnabled() const { return m_cellSize > 0.0f; }
+	inline float getCellSize() const { return m_cellSize; }
+
+private:
+	typedef std::pair<int, int> CellKey;
+
+	// Parse the cell file into construction info; executed in a background thread
+	void parseCell(StreamingCell &p_cell);
+
+	// Start parsing the cell in a background thread
+	void startLoadingCell(StreamingCell &p_cell);
+
+	// Create entities of the parsed cell, until the given time (in performance counter ticks) is reached; returns true if all entities have been created
+	bool instantiateCell(StreamingCell &p_cell, const int64_t p_deadlineTicks);
+
+	// Remove all the created entities of the cell and discard its parsed construction info
+	void unloadCell(StreamingCell &p_cell);
+
+	void waitForParsing();
+
+	// Returns true if the entity should be streamed in a cell, instead of being resident in the scene file: it must be a root entity with a spatial
+	// component and no children, and must not hold any scene-wide components (camera, sound listener, directional light, GUI or scripts)
+	bool isStreamable(const EntityID p_entity, const std::unordered_set<EntityID> &p_parentEntities) const;
+
+	// Returns the IDs of all entities that are parents of other entities
+	std::unordered_set<EntityID> getParentEntities() const;
+
+	// Returns the active camera position, or false if there is no camera
+	bool getCameraPosition(glm::vec3 &p_position) const;
+
+	inline CellKey getCellKey(const glm::vec3 &p_position) const
+	{
+		return CellKey((int)glm::floor(p_position.x / m_cellSize), (int)glm::floor(p_position.z / m_cellSize));
+	}
+
+	// Distance on the XZ plane from the given position to the closest point of the cell
+	inline float getDistanceToCell(const StreamingCell &p_cell, const glm::vec3 &p_position) const
+	{
+		const glm::vec2 cellMin = glm::vec2(p_cell.m_coordinates) * m_cellSize;
+		const glm::vec2 cellMax = cellMin + glm::vec2(m_cellSize);
+		const glm::vec2 position = glm::vec2(p_position.x, p_position.z);
+
+		return glm::length(glm::max(glm::max(cellMin - position, position - cellMax), glm::vec2(0.0f)));
+	}
+
+	SceneLoader &m_sceneLoader;
+
+	// Every cell of the scene, whether it's loaded or not; map nodes are never moved, so cells can be referenced by background threads
+	std::map<CellKey, StreamingCell> m_cells;
+
+	// Cells that are not in the unloaded state
+	std::vector<StreamingCell *> m_activeCells;
+
+	// Number of cells that are currently being parsed in background threads
+	std::atomic<int> m_numOfCellsParsing;
+
+	float m_cellSize;
+};
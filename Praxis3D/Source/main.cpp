@@ -5,7 +5,7 @@ int main(int argc, char* argv[])
 {
 	Engine engineInstance;
 
-	if(engineInstance.init() == ErrorCode::Success)
+	if(engineInstance.init(argc, argv) == ErrorCode::Success)
 	{
 		engineInstance.run();
 	}